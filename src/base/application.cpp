@@ -56,6 +56,7 @@ Application::Application(const Options &options)
     {
         throw std::runtime_error("glad initialization OpenGL failure");
     }
+    GLCounters::install();
 
     std::cout << "OpenGL\n";
     std::cout << "+ version:    " << glGetString(GL_VERSION) << '\n';
@@ -102,7 +103,7 @@ void Application::run()
         handleInput();
         renderFrame();
 
-        glfwSwapBuffers(_window);
+        presentFrame();
         glfwPollEvents();
     }
 }
@@ -119,7 +120,7 @@ void Application::updateTime()
     _lastTimeStamp = now;
     if (_deltaTime != 0.0f)
     {
-        _fpsIndicator.push(1.0f / _deltaTime);
+        _fpsIndicator.push(_deltaTime * 1000.0f);
     }
 }
 
@@ -141,7 +142,11 @@ void Application::framebufferResizeCallback(GLFWwindow *window, int width, int h
     app->_windowWidth = width;
     app->_windowHeight = height;
     app->_windowReized = true;
-    glViewport(0, 0, width, height);
+    // 窗口上下文可能在渲染线程上，此时由渲染线程每帧自己设置视口
+    if (glfwGetCurrentContext() == window)
+    {
+        glViewport(0, 0, width, height);
+    }
 }
 
 void Application::cursorPosCallback(GLFWwindow *window, double xPos, double yPos)
@@ -10,6 +10,7 @@
 #include <glm/glm.hpp>
 
 #include "frame_rate_indicator.h"
+#include "gl_counters.h"
 #include "gl_utility.h"
 #include "input.h"
 
@@ -60,10 +61,10 @@ protected:
     int _storedXPos = 0, _storedYPos = 0;
     int _storedWidth = 0, _storedHeight = 0;
 
-    /* timer for fps */
+    /* timer for fps (frame times of the last few seconds) */
     std::chrono::time_point<std::chrono::high_resolution_clock> _lastTimeStamp;
     float _deltaTime = 0.0f;
-    FrameRateIndicator _fpsIndicator{64};
+    FrameRateIndicator _fpsIndicator{512};
 
     /* input handler */
     Input _input;
@@ -81,6 +82,12 @@ protected:
     /* derived class can override this function to render a frame */
     virtual void renderFrame() = 0;
 
+    /* derived class can override this function when frames are presented elsewhere (e.g. a render thread) */
+    virtual void presentFrame()
+    {
+        glfwSwapBuffers(_window);
+    }
+
     void showFpsInWindowTitle();
 
     static void errorCallback(int error, const char *description);
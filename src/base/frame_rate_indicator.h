@@ -1,45 +1,101 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
 
+// 帧耗时的统计值 (毫秒)
+struct FrameTimeStats {
+    float averageMs = 0.0f;
+    float p50Ms = 0.0f;
+    float p95Ms = 0.0f;
+    float p99Ms = 0.0f;
+    float maxMs = 0.0f;
+    int count = 0;
+
+    float getAverageFrameRate() const { return averageMs > 0.0f ? 1000.0f / averageMs : 0.0f; }
+};
+
+// 最近 capacity 帧的帧耗时 (环形缓冲区，push 为 O(1)，容量用满后不再分配内存)
 class FrameRateIndicator {
 public:
     FrameRateIndicator(int capacity) : _capacity(capacity) {
-        _frameRates.reserve(capacity);
+        _frameTimes.reserve(capacity);
+        _sorted.reserve(capacity);
     }
 
     ~FrameRateIndicator() = default;
 
-    void push(float frameRate) {
-        if (_frameRates.size() == _capacity) {
-            _frameRates.erase(_frameRates.begin());
+    void push(float frameTimeMs) {
+        if (static_cast<int>(_frameTimes.size()) < _capacity) {
+            _frameTimes.push_back(frameTimeMs);
+        } else {
+            _frameTimes[_next] = frameTimeMs;
         }
-        _frameRates.push_back(frameRate);
+        _next = (_next + 1) % _capacity;
+    }
+
+    void clear() {
+        _frameTimes.clear();
+        _next = 0;
     }
 
     float getAverageFrameRate() const {
-        float avg = 0.0f;
-        for (size_t i = 0; i < _frameRates.size(); ++i) {
-            avg += _frameRates[i];
+        float total = 0.0f;
+        for (float ms : _frameTimes) {
+            total += ms;
         }
+        return total > 0.0f ? 1000.0f * _frameTimes.size() / total : 0.0f;
+    }
 
-        size_t count = _frameRates.size();
-        if (count == 0) {
-            count = 1;
+    // 平均值与分位数 (最近秩法)；在复用的数组上排序一次
+    FrameTimeStats computeStats() const {
+        FrameTimeStats stats;
+        stats.count = getSize();
+        if (stats.count == 0) {
+            return stats;
         }
 
-        return avg / count;
+        _sorted.assign(_frameTimes.begin(), _frameTimes.end());
+        std::sort(_sorted.begin(), _sorted.end());
+
+        float total = 0.0f;
+        for (float ms : _sorted) {
+            total += ms;
+        }
+        stats.averageMs = total / stats.count;
+        stats.p50Ms = percentile(0.50f);
+        stats.p95Ms = percentile(0.95f);
+        stats.p99Ms = percentile(0.99f);
+        stats.maxMs = _sorted.back();
+        return stats;
     }
 
+    // 与 ImGui::PlotLines 的 values / values_count / values_offset 对应 (offset 处为最旧的一帧)
     const float* getDataPtr() const {
-        return _frameRates.data();
+        return _frameTimes.data();
     }
 
     int getSize() const {
-        return static_cast<int>(_frameRates.size());
+        return static_cast<int>(_frameTimes.size());
+    }
+
+    int getOffset() const {
+        return getSize() < _capacity ? 0 : _next;
+    }
+
+    int getCapacity() const {
+        return _capacity;
     }
 
 private:
-    std::vector<float> _frameRates;
+    std::vector<float> _frameTimes;
+    mutable std::vector<float> _sorted; // computeStats 的排序缓冲区
     const int _capacity;
-};
\ No newline at end of file
+    int _next = 0;                      // 下一次写入的位置
+
+    float percentile(float p) const {
+        size_t rank = static_cast<size_t>(p * _sorted.size() + 0.999999f);
+        rank = std::min(std::max<size_t>(rank, 1), _sorted.size());
+        return _sorted[rank - 1];
+    }
+};
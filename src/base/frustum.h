@@ -105,6 +105,16 @@ public:
         }
         return true;
     }
+
+    // 包围球 (世界空间) 与视锥求交，保守判断：可能把视锥角落外的球算作相交
+    bool intersectSphere(const glm::vec3& center, float radius) const {
+        for (int i = 0; i < 6; ++i) {
+            if (planes[i].getSignedDistanceToPoint(center) < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Frustum& frustum) {
@@ -0,0 +1,212 @@
+#include "gl_counters.h"
+
+#include <glad/gl.h>
+
+namespace {
+    thread_local GLCallCounters tCounters;
+    bool gInstalled = false;
+
+    // 一次 draw 提交的三角形 (线、点计 0)
+    uint64_t trianglesOf(GLenum mode, GLsizei count)
+    {
+        switch (mode) {
+        case GL_TRIANGLES: return static_cast<uint64_t>(count) / 3;
+        case GL_TRIANGLE_STRIP:
+        case GL_TRIANGLE_FAN: return count > 2 ? static_cast<uint64_t>(count) - 2 : 0;
+        default: return 0;
+        }
+    }
+
+    void countDraw(GLenum mode, GLsizei count, GLsizei instances)
+    {
+        tCounters.drawCalls++;
+        tCounters.instances += static_cast<uint64_t>(instances);
+        tCounters.triangles += trianglesOf(mode, count) * static_cast<uint64_t>(instances);
+    }
+
+    // 原函数指针换成计数版本 (这个函数不存在时保持为空)
+    template <typename Proc>
+    void hook(Proc& slot, Proc& original, Proc counted)
+    {
+        if (!slot) return;
+        original = slot;
+        slot = counted;
+    }
+
+    // ------------------------------------------
+    // 绘制
+    // ------------------------------------------
+    PFNGLDRAWARRAYSPROC originalDrawArrays = nullptr;
+    void GLAD_API_PTR countedDrawArrays(GLenum mode, GLint first, GLsizei count)
+    {
+        countDraw(mode, count, 1);
+        originalDrawArrays(mode, first, count);
+    }
+
+    PFNGLDRAWARRAYSINSTANCEDPROC originalDrawArraysInstanced = nullptr;
+    void GLAD_API_PTR countedDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount)
+    {
+        countDraw(mode, count, instancecount);
+        originalDrawArraysInstanced(mode, first, count, instancecount);
+    }
+
+    PFNGLDRAWELEMENTSPROC originalDrawElements = nullptr;
+    void GLAD_API_PTR countedDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+    {
+        countDraw(mode, count, 1);
+        originalDrawElements(mode, count, type, indices);
+    }
+
+    PFNGLDRAWELEMENTSBASEVERTEXPROC originalDrawElementsBaseVertex = nullptr;
+    void GLAD_API_PTR countedDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices,
+                                                    GLint basevertex)
+    {
+        countDraw(mode, count, 1);
+        originalDrawElementsBaseVertex(mode, count, type, indices, basevertex);
+    }
+
+    PFNGLDRAWRANGEELEMENTSPROC originalDrawRangeElements = nullptr;
+    void GLAD_API_PTR countedDrawRangeElements(GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type,
+                                               const void* indices)
+    {
+        countDraw(mode, count, 1);
+        originalDrawRangeElements(mode, start, end, count, type, indices);
+    }
+
+    PFNGLDRAWELEMENTSINSTANCEDPROC originalDrawElementsInstanced = nullptr;
+    void GLAD_API_PTR countedDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices,
+                                                   GLsizei instancecount)
+    {
+        countDraw(mode, count, instancecount);
+        originalDrawElementsInstanced(mode, count, type, indices, instancecount);
+    }
+
+    PFNGLMULTIDRAWARRAYSPROC originalMultiDrawArrays = nullptr;
+    void GLAD_API_PTR countedMultiDrawArrays(GLenum mode, const GLint* first, const GLsizei* count, GLsizei drawcount)
+    {
+        tCounters.drawCalls++;
+        tCounters.instances += static_cast<uint64_t>(drawcount);
+        for (GLsizei i = 0; i < drawcount; ++i) tCounters.triangles += trianglesOf(mode, count[i]);
+        originalMultiDrawArrays(mode, first, count, drawcount);
+    }
+
+    PFNGLMULTIDRAWELEMENTSPROC originalMultiDrawElements = nullptr;
+    void GLAD_API_PTR countedMultiDrawElements(GLenum mode, const GLsizei* count, GLenum type,
+                                               const void* const* indices, GLsizei drawcount)
+    {
+        tCounters.drawCalls++;
+        tCounters.instances += static_cast<uint64_t>(drawcount);
+        for (GLsizei i = 0; i < drawcount; ++i) tCounters.triangles += trianglesOf(mode, count[i]);
+        originalMultiDrawElements(mode, count, type, indices, drawcount);
+    }
+
+    // ------------------------------------------
+    // 绑定
+    // ------------------------------------------
+    PFNGLUSEPROGRAMPROC originalUseProgram = nullptr;
+    void GLAD_API_PTR countedUseProgram(GLuint program)
+    {
+        if (program != 0) tCounters.programBinds++;
+        originalUseProgram(program);
+    }
+
+    PFNGLBINDTEXTUREPROC originalBindTexture = nullptr;
+    void GLAD_API_PTR countedBindTexture(GLenum target, GLuint texture)
+    {
+        if (texture != 0) tCounters.textureBinds++;
+        originalBindTexture(target, texture);
+    }
+
+    PFNGLBINDVERTEXARRAYPROC originalBindVertexArray = nullptr;
+    void GLAD_API_PTR countedBindVertexArray(GLuint array)
+    {
+        if (array != 0) tCounters.vaoBinds++;
+        originalBindVertexArray(array);
+    }
+
+    // ------------------------------------------
+    // Uniform 上传 (参数表各不相同，用宏生成)
+    // ------------------------------------------
+#define COUNTED_UNIFORM(Name, Proc, Params, Args)            \
+    Proc original##Name = nullptr;                           \
+    void GLAD_API_PTR counted##Name Params                   \
+    {                                                        \
+        tCounters.uniformUploads++;                          \
+        original##Name Args;                                 \
+    }
+
+    COUNTED_UNIFORM(Uniform1i, PFNGLUNIFORM1IPROC, (GLint location, GLint v0), (location, v0))
+    COUNTED_UNIFORM(Uniform1ui, PFNGLUNIFORM1UIPROC, (GLint location, GLuint v0), (location, v0))
+    COUNTED_UNIFORM(Uniform1f, PFNGLUNIFORM1FPROC, (GLint location, GLfloat v0), (location, v0))
+    COUNTED_UNIFORM(Uniform2f, PFNGLUNIFORM2FPROC, (GLint location, GLfloat v0, GLfloat v1), (location, v0, v1))
+    COUNTED_UNIFORM(Uniform3f, PFNGLUNIFORM3FPROC, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2),
+                    (location, v0, v1, v2))
+    COUNTED_UNIFORM(Uniform4f, PFNGLUNIFORM4FPROC, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3),
+                    (location, v0, v1, v2, v3))
+    COUNTED_UNIFORM(Uniform1iv, PFNGLUNIFORM1IVPROC, (GLint location, GLsizei count, const GLint* value),
+                    (location, count, value))
+    COUNTED_UNIFORM(Uniform1fv, PFNGLUNIFORM1FVPROC, (GLint location, GLsizei count, const GLfloat* value),
+                    (location, count, value))
+    COUNTED_UNIFORM(Uniform2fv, PFNGLUNIFORM2FVPROC, (GLint location, GLsizei count, const GLfloat* value),
+                    (location, count, value))
+    COUNTED_UNIFORM(Uniform3fv, PFNGLUNIFORM3FVPROC, (GLint location, GLsizei count, const GLfloat* value),
+                    (location, count, value))
+    COUNTED_UNIFORM(Uniform4fv, PFNGLUNIFORM4FVPROC, (GLint location, GLsizei count, const GLfloat* value),
+                    (location, count, value))
+    COUNTED_UNIFORM(UniformMatrix2fv, PFNGLUNIFORMMATRIX2FVPROC,
+                    (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value),
+                    (location, count, transpose, value))
+    COUNTED_UNIFORM(UniformMatrix3fv, PFNGLUNIFORMMATRIX3FVPROC,
+                    (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value),
+                    (location, count, transpose, value))
+    COUNTED_UNIFORM(UniformMatrix4fv, PFNGLUNIFORMMATRIX4FVPROC,
+                    (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value),
+                    (location, count, transpose, value))
+
+#undef COUNTED_UNIFORM
+}
+
+void GLCounters::install()
+{
+    if (gInstalled) return;
+
+    hook(glad_glDrawArrays, originalDrawArrays, countedDrawArrays);
+    hook(glad_glDrawArraysInstanced, originalDrawArraysInstanced, countedDrawArraysInstanced);
+    hook(glad_glDrawElements, originalDrawElements, countedDrawElements);
+    hook(glad_glDrawElementsBaseVertex, originalDrawElementsBaseVertex, countedDrawElementsBaseVertex);
+    hook(glad_glDrawRangeElements, originalDrawRangeElements, countedDrawRangeElements);
+    hook(glad_glDrawElementsInstanced, originalDrawElementsInstanced, countedDrawElementsInstanced);
+    hook(glad_glMultiDrawArrays, originalMultiDrawArrays, countedMultiDrawArrays);
+    hook(glad_glMultiDrawElements, originalMultiDrawElements, countedMultiDrawElements);
+
+    hook(glad_glUseProgram, originalUseProgram, countedUseProgram);
+    hook(glad_glBindTexture, originalBindTexture, countedBindTexture);
+    hook(glad_glBindVertexArray, originalBindVertexArray, countedBindVertexArray);
+
+    hook(glad_glUniform1i, originalUniform1i, countedUniform1i);
+    hook(glad_glUniform1ui, originalUniform1ui, countedUniform1ui);
+    hook(glad_glUniform1f, originalUniform1f, countedUniform1f);
+    hook(glad_glUniform2f, originalUniform2f, countedUniform2f);
+    hook(glad_glUniform3f, originalUniform3f, countedUniform3f);
+    hook(glad_glUniform4f, originalUniform4f, countedUniform4f);
+    hook(glad_glUniform1iv, originalUniform1iv, countedUniform1iv);
+    hook(glad_glUniform1fv, originalUniform1fv, countedUniform1fv);
+    hook(glad_glUniform2fv, originalUniform2fv, countedUniform2fv);
+    hook(glad_glUniform3fv, originalUniform3fv, countedUniform3fv);
+    hook(glad_glUniform4fv, originalUniform4fv, countedUniform4fv);
+    hook(glad_glUniformMatrix2fv, originalUniformMatrix2fv, countedUniformMatrix2fv);
+    hook(glad_glUniformMatrix3fv, originalUniformMatrix3fv, countedUniformMatrix3fv);
+    hook(glad_glUniformMatrix4fv, originalUniformMatrix4fv, countedUniformMatrix4fv);
+
+    gInstalled = true;
+}
+
+bool GLCounters::isInstalled()
+{
+    return gInstalled;
+}
+
+const GLCallCounters& GLCounters::getThreadCounters()
+{
+    return tCounters;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// 一段时间内提交的 GL 调用计数
+struct GLCallCounters {
+    uint64_t drawCalls = 0;      // glDraw* / glMultiDraw* 调用次数 (一次 MultiDraw 计 1 次)
+    uint64_t triangles = 0;      // 提交的三角形 (含实例)
+    uint64_t instances = 0;      // 绘制的实例数 (非实例化 draw 计 1，MultiDraw 按子 draw 数计)
+    uint64_t programBinds = 0;   // glUseProgram (非 0)
+    uint64_t textureBinds = 0;   // glBindTexture (非 0)
+    uint64_t vaoBinds = 0;       // glBindVertexArray (非 0)
+    uint64_t uniformUploads = 0; // glUniform* / glUniformMatrix*
+
+    GLCallCounters& operator+=(const GLCallCounters& rhs)
+    {
+        drawCalls += rhs.drawCalls;
+        triangles += rhs.triangles;
+        instances += rhs.instances;
+        programBinds += rhs.programBinds;
+        textureBinds += rhs.textureBinds;
+        vaoBinds += rhs.vaoBinds;
+        uniformUploads += rhs.uniformUploads;
+        return *this;
+    }
+
+    GLCallCounters operator-(const GLCallCounters& rhs) const
+    {
+        GLCallCounters result;
+        result.drawCalls = drawCalls - rhs.drawCalls;
+        result.triangles = triangles - rhs.triangles;
+        result.instances = instances - rhs.instances;
+        result.programBinds = programBinds - rhs.programBinds;
+        result.textureBinds = textureBinds - rhs.textureBinds;
+        result.vaoBinds = vaoBinds - rhs.vaoBinds;
+        result.uniformUploads = uniformUploads - rhs.uniformUploads;
+        return result;
+    }
+};
+
+// ==========================================
+// GL 调用计数
+// ==========================================
+// install() 把 glad 中绘制、绑定与 uniform 上传的函数指针换成先计数再转发的版本，
+// 调用处不需要任何改动。计数按线程累计 (只有持有上下文的线程会调用 GL)。
+// 必须在 gladLoadGL 之后调用；ImGui 后端使用自己的加载器，它的调用不计入。
+class GLCounters
+{
+public:
+    static void install();
+    static bool isInstalled();
+
+    // 当前线程累计的计数
+    static const GLCallCounters& getThreadCounters();
+};
+
+// 统计一段代码在当前线程上提交的 GL 调用 (可以嵌套)
+class GLCounterScope
+{
+public:
+    GLCounterScope() : _start(GLCounters::getThreadCounters()) {}
+
+    GLCallCounters getCounters() const { return GLCounters::getThreadCounters() - _start; }
+
+private:
+    GLCallCounters _start;
+};
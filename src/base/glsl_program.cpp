@@ -16,7 +16,8 @@ GLSLProgram::GLSLProgram() {
 }
 
 GLSLProgram::GLSLProgram(GLSLProgram&& rhs) noexcept
-    : _handle(rhs._handle), _vertexShaders(std::move(rhs._vertexShaders)),
+    : _handle(rhs._handle), _vertexDecodeLocations(rhs._vertexDecodeLocations),
+      _vertexShaders(std::move(rhs._vertexShaders)),
       _geometryShaders(std::move(rhs._geometryShaders)),
       _fragmentShaders(std::move(rhs._fragmentShaders)) {
     rhs._handle = 0;
@@ -108,6 +109,10 @@ void GLSLProgram::link() {
         glGetProgramInfoLog(_handle, sizeof(buffer), NULL, buffer);
         throw std::runtime_error("link program error: " + std::string(buffer));
     }
+
+    _vertexDecodeLocations.packedVertex = glGetUniformLocation(_handle, "packedVertex");
+    _vertexDecodeLocations.positionScale = glGetUniformLocation(_handle, "positionScale");
+    _vertexDecodeLocations.positionOffset = glGetUniformLocation(_handle, "positionOffset");
 }
 
 void GLSLProgram::use() {
@@ -153,96 +158,136 @@ int GLSLProgram::getUniformBlockVariableOffset(const std::string& name) const {
     return offset;
 }
 
-void GLSLProgram::setUniformBool(const std::string& name, bool value) const {
-    GLint location = glGetUniformLocation(_handle, name.c_str());
+void GLSLProgram::setUniformBool(const char* name, bool value) const {
+    GLint location = glGetUniformLocation(_handle, name);
     if (location == -1) {
-        std::cerr << "find uniform " + name + " location failure" << std::endl;
+        std::cerr << "find uniform " << name << " location failure" << std::endl;
     }
 
     glUniform1i(location, static_cast<int>(value));
 }
 
-void GLSLProgram::setUniformInt(const std::string& name, int value) const {
-    GLint location = glGetUniformLocation(_handle, name.c_str());
+void GLSLProgram::setUniformBool(const std::string& name, bool value) const {
+    setUniformBool(name.c_str(), value);
+}
+
+void GLSLProgram::setUniformInt(const char* name, int value) const {
+    GLint location = glGetUniformLocation(_handle, name);
     if (location == -1) {
-        std::cerr << "find uniform " + name + " location failure" << std::endl;
+        std::cerr << "find uniform " << name << " location failure" << std::endl;
     }
 
     glUniform1i(location, value);
 }
 
-void GLSLProgram::setUniformUint(const std::string& name, uint32_t value) const {
-    GLint location = glGetUniformLocation(_handle, name.c_str());
+void GLSLProgram::setUniformInt(const std::string& name, int value) const {
+    setUniformInt(name.c_str(), value);
+}
+
+void GLSLProgram::setUniformUint(const char* name, uint32_t value) const {
+    GLint location = glGetUniformLocation(_handle, name);
     if (location == -1) {
-        std::cerr << "find uniform " + name + " location failure" << std::endl;
+        std::cerr << "find uniform " << name << " location failure" << std::endl;
     }
 
     glUniform1ui(location, value);
 }
 
-void GLSLProgram::setUniformFloat(const std::string& name, float value) const {
-    GLint location = glGetUniformLocation(_handle, name.c_str());
+void GLSLProgram::setUniformUint(const std::string& name, uint32_t value) const {
+    setUniformUint(name.c_str(), value);
+}
+
+void GLSLProgram::setUniformFloat(const char* name, float value) const {
+    GLint location = glGetUniformLocation(_handle, name);
     if (location == -1) {
-        std::cerr << "find uniform " + name + " location failure" << std::endl;
+        std::cerr << "find uniform " << name << " location failure" << std::endl;
     }
 
     glUniform1f(location, value);
 }
 
-void GLSLProgram::setUniformVec2(const std::string& name, const glm::vec2& v2) const {
-    GLint location = glGetUniformLocation(_handle, name.c_str());
+void GLSLProgram::setUniformFloat(const std::string& name, float value) const {
+    setUniformFloat(name.c_str(), value);
+}
+
+void GLSLProgram::setUniformVec2(const char* name, const glm::vec2& v2) const {
+    GLint location = glGetUniformLocation(_handle, name);
     if (location == -1) {
-        std::cerr << "find uniform " + name + " location failure" << std::endl;
+        std::cerr << "find uniform " << name << " location failure" << std::endl;
     }
 
     glUniform2fv(location, 1, glm::value_ptr(v2));
 }
 
-void GLSLProgram::setUniformVec3(const std::string& name, const glm::vec3& v3) const {
-    GLint location = glGetUniformLocation(_handle, name.c_str());
+void GLSLProgram::setUniformVec2(const std::string& name, const glm::vec2& v2) const {
+    setUniformVec2(name.c_str(), v2);
+}
+
+void GLSLProgram::setUniformVec3(const char* name, const glm::vec3& v3) const {
+    GLint location = glGetUniformLocation(_handle, name);
     if (location == -1) {
-        std::cerr << "find uniform " + name + " location failure" << std::endl;
+        std::cerr << "find uniform " << name << " location failure" << std::endl;
     }
 
     glUniform3fv(location, 1, glm::value_ptr(v3));
 }
 
-void GLSLProgram::setUniformVec4(const std::string& name, const glm::vec4& v4) const {
-    GLint location = glGetUniformLocation(_handle, name.c_str());
+void GLSLProgram::setUniformVec3(const std::string& name, const glm::vec3& v3) const {
+    setUniformVec3(name.c_str(), v3);
+}
+
+void GLSLProgram::setUniformVec4(const char* name, const glm::vec4& v4) const {
+    GLint location = glGetUniformLocation(_handle, name);
     if (location == -1) {
-        std::cerr << "find uniform " + name + " location failure" << std::endl;
+        std::cerr << "find uniform " << name << " location failure" << std::endl;
     }
 
     glUniform4fv(location, 1, glm::value_ptr(v4));
 }
 
-void GLSLProgram::setUniformMat2(const std::string& name, const glm::mat2& mat2) const {
-    GLint location = glGetUniformLocation(_handle, name.c_str());
+void GLSLProgram::setUniformVec4(const std::string& name, const glm::vec4& v4) const {
+    setUniformVec4(name.c_str(), v4);
+}
+
+void GLSLProgram::setUniformMat2(const char* name, const glm::mat2& mat2) const {
+    GLint location = glGetUniformLocation(_handle, name);
     if (location == -1) {
-        std::cerr << "find uniform " + name + " location failure" << std::endl;
+        std::cerr << "find uniform " << name << " location failure" << std::endl;
     }
 
     glUniformMatrix2fv(location, 1, GL_FALSE, glm::value_ptr(mat2));
 }
 
-void GLSLProgram::setUniformMat3(const std::string& name, const glm::mat3& mat3) const {
-    GLint location = glGetUniformLocation(_handle, name.c_str());
+void GLSLProgram::setUniformMat2(const std::string& name, const glm::mat2& mat2) const {
+    setUniformMat2(name.c_str(), mat2);
+}
+
+void GLSLProgram::setUniformMat3(const char* name, const glm::mat3& mat3) const {
+    GLint location = glGetUniformLocation(_handle, name);
     if (location == -1) {
-        std::cerr << "find uniform " + name + " location failure" << std::endl;
+        std::cerr << "find uniform " << name << " location failure" << std::endl;
     }
 
     glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(mat3));
 }
 
-void GLSLProgram::setUniformMat4(const std::string& name, const glm::mat4& mat4) const {
-    GLint location = glGetUniformLocation(_handle, name.c_str());
+void GLSLProgram::setUniformMat3(const std::string& name, const glm::mat3& mat3) const {
+    setUniformMat3(name.c_str(), mat3);
+}
+
+void GLSLProgram::setUniformMat4(const char* name, const glm::mat4& mat4) const {
+    GLint location = glGetUniformLocation(_handle, name);
     if (location == -1) {
-        std::cerr << "find uniform " + name + " location failure" << std::endl;
+        std::cerr << "find uniform " << name << " location failure" << std::endl;
     }
 
     glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(mat4));
 }
 
+void GLSLProgram::setUniformMat4(const std::string& name, const glm::mat4& mat4) const {
+    setUniformMat4(name.c_str(), mat4);
+}
+
 void GLSLProgram::setUniformBlockBinding(const std::string& name, uint32_t binding) const {
     GLuint blockIndex = glGetUniformBlockIndex(_handle, name.c_str());
     if (blockIndex == GL_INVALID_INDEX) {
@@ -41,33 +41,65 @@ public:
 
     int getUniformBlockVariableOffset(const std::string& name) const;
 
+    // 名字为字符串字面量时走 const char* 版本，不会构造临时 std::string
     void setUniformBool(const std::string& name, bool value) const;
 
+    void setUniformBool(const char* name, bool value) const;
+
     void setUniformInt(const std::string& name, int value) const;
 
+    void setUniformInt(const char* name, int value) const;
+
     void setUniformUint(const std::string& name, uint32_t value) const;
 
+    void setUniformUint(const char* name, uint32_t value) const;
+
     void setUniformFloat(const std::string& name, float value) const;
 
+    void setUniformFloat(const char* name, float value) const;
+
     void setUniformVec2(const std::string& name, const glm::vec2& v2) const;
 
+    void setUniformVec2(const char* name, const glm::vec2& v2) const;
+
     void setUniformVec3(const std::string& name, const glm::vec3& v3) const;
 
+    void setUniformVec3(const char* name, const glm::vec3& v3) const;
+
     void setUniformVec4(const std::string& name, const glm::vec4& v4) const;
 
+    void setUniformVec4(const char* name, const glm::vec4& v4) const;
+
     void setUniformMat2(const std::string& name, const glm::mat2& mat2) const;
 
+    void setUniformMat2(const char* name, const glm::mat2& mat2) const;
+
     void setUniformMat3(const std::string& name, const glm::mat3& mat3) const;
 
+    void setUniformMat3(const char* name, const glm::mat3& mat3) const;
+
     void setUniformMat4(const std::string& name, const glm::mat4& mat4) const;
 
+    void setUniformMat4(const char* name, const glm::mat4& mat4) const;
+
     void setUniformBlockBinding(const std::string& name, uint32_t binding) const;
 
     GLuint getHandle() const { return _handle; }
 
+    // 压缩顶点解码用的 uniform 位置 (link 时查询一次，每次绘制直接使用；着色器中没有时为 -1)
+    struct VertexDecodeLocations {
+        GLint packedVertex = -1;
+        GLint positionScale = -1;
+        GLint positionOffset = -1;
+    };
+
+    const VertexDecodeLocations& getVertexDecodeLocations() const { return _vertexDecodeLocations; }
+
 private:
     GLuint _handle = 0;
 
+    VertexDecodeLocations _vertexDecodeLocations;
+
     std::vector<GLuint> _vertexShaders;
 
     std::vector<GLuint> _geometryShaders;
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <stb_image.h>
@@ -42,7 +43,7 @@ void Texture2D::setDefaultParameters() {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 }
 
-ImageTexture2D::ImageTexture2D(const std::string& path) : _uri(path) {
+ImageTexture2D::ImageTexture2D(const std::string& path, bool srgb) : _uri(path), _srgb(srgb) {
     // load image to the memory
     stbi_set_flip_vertically_on_load(true);
     int width = 0, height = 0, channels = 0;
@@ -53,17 +54,17 @@ ImageTexture2D::ImageTexture2D(const std::string& path) : _uri(path) {
     }
 
     // choose image format
-    GLenum format = GL_RGB;
-    switch (channels) {
-    case 1: format = GL_RED; break;
-    case 3: format = GL_RGB; break;
-    case 4: format = GL_RGBA; break;
-    default:
+    GLenum format = formatForChannels(channels);
+    if (format == 0) {
         cleanup();
         stbi_image_free(data);
         throw std::runtime_error("unsupported format");
     }
-    GLint internalFormat = static_cast<GLint>(format);
+    GLint internalFormat = sizedFormatForChannels(channels, srgb);
+    _width = width;
+    _height = height;
+    _channels = channels;
+    _gpuBytes = static_cast<size_t>(width) * height * channels * 4 / 3;
 
     glBindTexture(GL_TEXTURE_2D, _handle);
 
@@ -72,6 +73,7 @@ ImageTexture2D::ImageTexture2D(const std::string& path) : _uri(path) {
 
     // transfer the image data to GPU
     upload(data, width, height, channels, internalFormat, format, GL_UNSIGNED_BYTE);
+    glGenerateMipmap(GL_TEXTURE_2D);
 
     glBindTexture(GL_TEXTURE_2D, 0);
 
@@ -85,7 +87,8 @@ ImageTexture2D::ImageTexture2D(const std::string& path) : _uri(path) {
 ImageTexture2D::ImageTexture2D(
     const void* data, int width, int height, int channels, GLint internalformat, GLenum format,
     GLenum type, const std::string& uri)
-    : _uri(uri) {
+    : _uri(uri), _width(width), _height(height), _channels(channels),
+      _gpuBytes(static_cast<size_t>(width) * height * channels * 4 / 3) {
     glBindTexture(GL_TEXTURE_2D, _handle);
 
     // set texture parameters
@@ -93,6 +96,7 @@ ImageTexture2D::ImageTexture2D(
 
     // transfer the image data to GPU
     upload(data, width, height, channels, internalformat, format, type);
+    glGenerateMipmap(GL_TEXTURE_2D);
 
     glBindTexture(GL_TEXTURE_2D, 0);
 
@@ -100,19 +104,105 @@ ImageTexture2D::ImageTexture2D(
     check();
 }
 
+ImageTexture2D::ImageTexture2D(const std::string& uri, GLuint placeholder)
+    : _uri(uri), _resident(false), _placeholder(placeholder) {
+    glBindTexture(GL_TEXTURE_2D, _handle);
+    setDefaultParameters();
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 ImageTexture2D::ImageTexture2D(ImageTexture2D&& rhs) noexcept
-    : Texture2D(std::move(rhs)), _uri(std::move(rhs._uri)) {
+    : Texture2D(std::move(rhs)), _uri(std::move(rhs._uri)), _width(rhs._width),
+      _height(rhs._height), _channels(rhs._channels), _srgb(rhs._srgb),
+      _resident(rhs._resident), _placeholder(rhs._placeholder), _gpuBytes(rhs._gpuBytes),
+      _shared(std::move(rhs._shared)) {
     rhs._uri = "";
 }
 
+void ImageTexture2D::swapContents(ImageTexture2D& other) {
+    std::swap(_handle, other._handle);
+    std::swap(_width, other._width);
+    std::swap(_height, other._height);
+    std::swap(_channels, other._channels);
+    std::swap(_srgb, other._srgb);
+    std::swap(_resident, other._resident);
+    std::swap(_placeholder, other._placeholder);
+    std::swap(_gpuBytes, other._gpuBytes);
+    std::swap(_shared, other._shared);
+}
+
+void ImageTexture2D::shareStorage(std::shared_ptr<const ImageTexture2D> storage) {
+    _shared = std::move(storage);
+}
+
 const std::string& ImageTexture2D::getUri() const {
     return _uri;
 }
 
+void ImageTexture2D::bind(int slot) const {
+    if (_shared) {
+        _shared->bind(slot);
+        return;
+    }
+    glActiveTexture(GL_TEXTURE0 + slot);
+    glBindTexture(GL_TEXTURE_2D, (_resident || _placeholder == 0) ? _handle : _placeholder);
+}
+
+void ImageTexture2D::allocateLevels(
+    int width, int height, int levelCount, GLenum internalFormat, GLenum format, int blockBytes,
+    int channels, bool srgb) {
+    _width = width;
+    _height = height;
+    _channels = channels;
+    _srgb = srgb;
+    _gpuBytes = 0;
+
+    glBindTexture(GL_TEXTURE_2D, _handle);
+    for (int level = 0; level < levelCount; ++level) {
+        int w = std::max(1, width >> level);
+        int h = std::max(1, height >> level);
+        if (blockBytes > 0) {
+            // 只分配存储：数据指针为空时 imageSize 仍需与格式匹配
+            GLsizei size = ((w + 3) / 4) * ((h + 3) / 4) * blockBytes;
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, w, h, 0, size, nullptr);
+            _gpuBytes += static_cast<size_t>(size);
+        } else {
+            _gpuBytes += static_cast<size_t>(w) * h * channels;
+            glTexImage2D(
+                GL_TEXTURE_2D, level, static_cast<GLint>(internalFormat), w, h, 0, format,
+                GL_UNSIGNED_BYTE, nullptr);
+        }
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+    glTexParameteri(
+        GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+GLint ImageTexture2D::sizedFormatForChannels(int channels, bool srgb) {
+    switch (channels) {
+    case 1: return GL_R8;
+    case 3: return srgb ? GL_SRGB8 : GL_RGB8;
+    case 4: return srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+    default: return 0;
+    }
+}
+
+GLenum ImageTexture2D::formatForChannels(int channels) {
+    switch (channels) {
+    case 1: return GL_RED;
+    case 3: return GL_RGB;
+    case 4: return GL_RGBA;
+    default: return 0;
+    }
+}
+
 void ImageTexture2D::setDefaultParameters() {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    // 三线性过滤：远处的平铺纹理 (地板等) 不再闪烁，也更省纹理缓存
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 }
 
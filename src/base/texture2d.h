@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "texture.h"
@@ -32,21 +33,75 @@ private:
 
 class ImageTexture2D : public Texture2D {
 public:
-    ImageTexture2D(const std::string& path);
+    // srgb: 颜色贴图使用 sRGB 内部格式，由硬件在采样时线性化
+    ImageTexture2D(const std::string& path, bool srgb = false);
 
     ImageTexture2D(
         const void* data, int width, int height, int channels, GLint internalformat, GLenum format,
         GLenum type, const std::string& uri);
 
+    // 延迟上传的纹理：只创建 GL 句柄，像素数据稍后由流式上传器分批写入
+    // 在数据驻留之前，bind() 会绑定 placeholder 纹理
+    ImageTexture2D(const std::string& uri, GLuint placeholder);
+
     ImageTexture2D(ImageTexture2D&& rhs) noexcept;
 
     ~ImageTexture2D() = default;
 
     const std::string& getUri() const;
 
+    void bind(int slot = 0) const override;
+
+    // 数据是否已经完整上传到 GPU
+    bool isResident() const { return _shared ? _shared->isResident() : _resident; }
+
+    void markResident() { _resident = true; }
+
+    // [主线程] 与另一张纹理交换 GL 句柄与格式信息 (URI 不变)
+    // 热重载时新数据上传到临时纹理，驻留后再原地换进来，使用者无感知
+    void swapContents(ImageTexture2D& other);
+
+    // 改为使用另一张 (内容完全相同的) 纹理的 GPU 存储，bind / 尺寸 / 驻留状态都转发给它
+    // 本对象保留自己的 URI，热重载时 swapContents 只换掉本对象的引用，不影响其他共享者
+    void shareStorage(std::shared_ptr<const ImageTexture2D> storage);
+    const std::shared_ptr<const ImageTexture2D>& getSharedStorage() const { return _shared; }
+
+    // 为延迟上传的纹理分配 levelCount 级 mip 的存储 (不传数据)
+    // blockBytes: 压缩格式每个 4x4 块的字节数，未压缩传 0
+    // 同时设置 GL_TEXTURE_MAX_LEVEL，保证 mip 链不完整时纹理依然 complete
+    void allocateLevels(
+        int width, int height, int levelCount, GLenum internalFormat, GLenum format,
+        int blockBytes, int channels, bool srgb);
+
+    int getWidth() const { return _shared ? _shared->getWidth() : _width; }
+    int getHeight() const { return _shared ? _shared->getHeight() : _height; }
+    int getChannels() const { return _shared ? _shared->getChannels() : _channels; }
+    // bind() 实际绑定的纹理是否为 sRGB 格式 (占位图始终是线性 RGBA8)
+    bool isSRGB() const { return _shared ? _shared->isSRGB() : (_resident && _srgb); }
+
+    // 自身存储占用的显存 (含 mip 链，共享存储时为 0)
+    size_t getGpuByteSize() const { return _shared ? 0 : _gpuBytes; }
+
+    // 通道数 -> GL 像素格式 (不支持时返回 0)
+    static GLenum formatForChannels(int channels);
+
+    // 通道数 -> 带尺寸的内部格式 (GL_R8 / GL_RGB8 / GL_SRGB8_ALPHA8 ...)
+    static GLint sizedFormatForChannels(int channels, bool srgb);
+
 private:
     std::string _uri;
 
+    int _width = 0;
+    int _height = 0;
+    int _channels = 0;
+    bool _srgb = false;
+
+    bool _resident = true;
+    GLuint _placeholder = 0;
+
+    size_t _gpuBytes = 0;
+    std::shared_ptr<const ImageTexture2D> _shared;
+
     void setDefaultParameters();
 
     void upload(
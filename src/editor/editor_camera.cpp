@@ -426,18 +426,23 @@ void EditorCamera::frameObject(GameObject* obj)
     glm::vec3 centerOffset(0.0f); 
     float objectRadius = 1.0f;    
 
+    // 按世界变换计算 (物体可能挂在别的物体下面)
+    const glm::mat4& world = obj->getWorldMatrix();
+    glm::vec3 worldPos = obj->getWorldPosition();
+
     if (auto mesh = obj->getComponent<MeshComponent>()) {
         bounds = mesh->model->getBoundingBox();
         // hasBounds = true;
 
         glm::vec3 localCenter = (bounds.min + bounds.max) * 0.5f;
-        centerOffset = obj->transform.rotation * (localCenter * obj->transform.scale);
+        centerOffset = glm::vec3(world * glm::vec4(localCenter, 1.0f)) - worldPos;
 
-        glm::vec3 size = (bounds.max - bounds.min) * obj->transform.scale;
+        glm::vec3 worldScale(glm::length(glm::vec3(world[0])), glm::length(glm::vec3(world[1])), glm::length(glm::vec3(world[2])));
+        glm::vec3 size = (bounds.max - bounds.min) * worldScale;
         objectRadius = glm::length(size) * 0.5f; 
     }
 
-    glm::vec3 targetPivot = obj->transform.position + centerOffset;
+    glm::vec3 targetPivot = worldPos + centerOffset;
 
     if (objectRadius < 0.5f) objectRadius = 0.5f;
     
@@ -2,6 +2,9 @@
 #include "panel.h"
 #include "engine/scene.h"
 #include "engine/renderer.h"
+#include "engine/render_thread.h"
+#include "engine/mesh_simplifier.h"
+#include "engine/mesh_clusters.h"
 
 class EnvironmentPanel : public Panel {
 public:
@@ -46,9 +49,12 @@ public:
                 ImGui::DragFloat("Energy", &env.skyEnergy, 0.1f, 0.0f, 10.0f);
                 if (ImGui::IsItemDeactivatedAfterEdit()) editFinished = true;
 
-                // 只有在编辑动作“完成”时，才触发昂贵的 IBL 烘焙
+                // 只有在编辑动作“完成”时，才触发昂贵的 IBL 烘焙 (在渲染上下文中执行，拷贝一份当前设置)
                 if (editFinished) {
-                    renderer->updateProceduralSkybox(env);
+                    SceneEnvironment snapshot = env;
+                    RenderThread::Get().runOnRenderContext([renderer, snapshot]() {
+                        renderer->updateProceduralSkybox(snapshot);
+                    });
                 }
             } 
             else if (env.type == SkyboxType::CubeMap) {
@@ -67,7 +73,9 @@ public:
                         if (strPath.find(".hdr") != std::string::npos) {
                             env.hdrFilePath = strPath;
                             // 触发加载
-                            renderer->loadSkyboxHDR(env.hdrFilePath);
+                            RenderThread::Get().runOnRenderContext([renderer, strPath]() {
+                                renderer->loadSkyboxHDR(strPath);
+                            });
                         } else {
                             std::cout << "[UI] Only .hdr files are supported for Skybox!" << std::endl;
                         }
@@ -79,10 +87,55 @@ public:
 
             ImGui::Separator();
             ImGui::DragFloat("Global Exposure", &env.globalExposure, 0.1f, 0.1f, 10.0f);
+
+            // 渲染器设置在面板里编辑一份拷贝，改动后交给渲染上下文 (渲染线程可能正在读它们)
+            if (!_settingsLoaded) {
+                _lod = renderer->getLodSettings();
+                _clusters = renderer->getClusterCullSettings();
+                _settingsLoaded = true;
+            }
+
+            // 网格 LOD (渲染器全局设置，不随场景保存)
+            if (ImGui::CollapsingHeader("Mesh LOD")) {
+                LodSettings& lod = _lod;
+                bool changed = false;
+                changed |= ImGui::Checkbox("Enable LOD", &lod.enabled);
+                ImGui::BeginDisabled(!lod.enabled);
+                changed |= ImGui::DragFloat("Max Error (px)", &lod.maxErrorPixels, 0.05f, 0.1f, 16.0f);
+                changed |= ImGui::SliderFloat("Hysteresis", &lod.hysteresis, 0.3f, 1.0f);
+                changed |= ImGui::DragFloat("Cull Below (px)", &lod.cullPixels, 0.1f, 0.0f, 32.0f);
+                changed |= ImGui::SliderInt("Shadow LOD Bias", &lod.shadowLodBias, 0, MeshSimplifier::kMaxLods);
+                changed |= ImGui::SliderInt("Probe LOD Bias", &lod.probeLodBias, 0, MeshSimplifier::kMaxLods);
+                ImGui::EndDisabled();
+
+                if (changed) {
+                    RenderThread::Get().runOnRenderContext([renderer, lod]() { renderer->getLodSettings() = lod; });
+                }
+            }
+
+            if (ImGui::CollapsingHeader("Cluster Culling")) {
+                ClusterCullSettings& clusters = _clusters;
+                bool changed = false;
+                changed |= ImGui::Checkbox("Enable Cluster Culling", &clusters.enabled);
+                ImGui::BeginDisabled(!clusters.enabled);
+                changed |= ImGui::Checkbox("Normal Cone Culling", &clusters.coneCulling);
+                changed |= ImGui::Checkbox("Shadow Cascades", &clusters.shadows);
+                ImGui::EndDisabled();
+                if (changed) {
+                    RenderThread::Get().runOnRenderContext([renderer, clusters]() { renderer->getClusterCullSettings() = clusters; });
+                }
+                ImGui::TextDisabled("Meshes with %zu+ triangles are split into %u-triangle clusters on import",
+                                    MeshClusters::kMinTriangles, MeshClusters::kTrianglesPerCluster);
+            }
         }
         ImGui::End();
     }
     
     // 占位实现
     void onImGuiRender() override {}
+
+private:
+    LodSettings _lod;
+    ClusterCullSettings _clusters;
+    bool _settingsLoaded = false;
 };
\ No newline at end of file
@@ -2,8 +2,87 @@
 #include <imgui.h>
 #include <imgui_internal.h>
 
+namespace {
+constexpr const char* kHierarchyPayload = "HIERARCHY_OBJECT";
+}
+
 HierarchyPanel::HierarchyPanel() : Panel("Scene Hierarchy") {}
 
+void HierarchyPanel::drawObjectNode(Scene& scene, GameObject* go, GameObject*& selectedObject, HierarchyActions& actions)
+{
+    ImGui::TableNextRow();
+    ImGui::TableSetColumnIndex(0);
+
+    ImGui::PushID(go->getInstanceID());
+
+    // SpanAllColumns: 依然保留，让选中高亮条横跨整个表格
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanAllColumns | ImGuiTreeNodeFlags_OpenOnArrow |
+                               ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_FramePadding;
+    if (go->getChildren().empty()) flags |= ImGuiTreeNodeFlags_Leaf;
+    if (selectedObject == go) flags |= ImGuiTreeNodeFlags_Selected;
+
+    bool open = ImGui::TreeNodeEx("##node", flags, "%s", go->name.c_str());
+
+    if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen()) {
+        selectedObject = go;
+    }
+
+    // 拖拽：把物体拖到另一个物体上成为它的子对象
+    if (ImGui::BeginDragDropSource())
+    {
+        GameObjectHandle handle = go->getHandle();
+        ImGui::SetDragDropPayload(kHierarchyPayload, &handle, sizeof(handle));
+        ImGui::Text("%s", go->name.c_str());
+        ImGui::EndDragDropSource();
+    }
+    if (ImGui::BeginDragDropTarget())
+    {
+        if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload(kHierarchyPayload)) {
+            GameObjectHandle handle = *static_cast<const GameObjectHandle*>(payload->Data);
+            actions.reparentChild = scene.find(handle);
+            actions.reparentTarget = go;
+        }
+        ImGui::EndDragDropTarget();
+    }
+
+    // 右键菜单
+    if (ImGui::BeginPopupContextItem())
+    {
+        selectedObject = go;
+        if (ImGui::MenuItem("Delete")) {
+            actions.toDelete = go;
+        }
+        if (ImGui::MenuItem("Unparent", nullptr, false, scene.getParent(go) != nullptr)) {
+            actions.reparentChild = go;
+            actions.reparentTarget = nullptr;
+        }
+        ImGui::Separator();
+        ImGui::MenuItem("Duplicate (TODO)", nullptr, false, false);
+        ImGui::EndPopup();
+    }
+
+    // 第二列：类型
+    ImGui::TableSetColumnIndex(1);
+    ImGui::AlignTextToFramePadding(); 
+
+    const char* typeStr = "-";
+    if (go->getComponent<LightComponent>()) typeStr = "Light";
+    else if (go->getComponent<MeshComponent>()) typeStr = "Mesh";
+    else if (go->getComponent<ReflectionProbeComponent>()) typeStr = "Probe";
+
+    ImGui::TextDisabled("%s", typeStr);
+
+    if (open)
+    {
+        for (GameObjectHandle childHandle : go->getChildren()) {
+            if (GameObject* child = scene.find(childHandle)) drawObjectNode(scene, child, selectedObject, actions);
+        }
+        ImGui::TreePop();
+    }
+
+    ImGui::PopID();
+}
+
 void HierarchyPanel::onImGuiRender(const std::unique_ptr<Scene>& scene, GameObject*& selectedObject)
 {
     if (!_isOpen) return;
@@ -69,62 +148,20 @@ void HierarchyPanel::onImGuiRender(const std::unique_ptr<Scene>& scene, GameObje
         ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_NoHide | ImGuiTableColumnFlags_WidthStretch);
         ImGui::TableSetupColumn("Type", ImGuiTableColumnFlags_WidthFixed, 60.0f);
         
-        // --- 遍历物体 ---
-        const auto& objects = scene->getGameObjects();
-        int idToDelete = -1;
-
-        for (int i = 0; i < objects.size(); ++i)
+        // --- 遍历物体 (从根对象开始递归绘制子树) ---
+        HierarchyActions actions;
+        for (const auto& go : scene->getGameObjects())
         {
-            auto &go = objects[i];
-            
-            ImGui::TableNextRow();
-            ImGui::TableSetColumnIndex(0);
-
-            ImGui::PushID(go->getInstanceID());
-
-            // SpanAllColumns: 依然保留，让选中高亮条横跨整个表格
-            ImGuiSelectableFlags selectable_flags = ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap;
-
-            bool isSelected = (selectedObject == go.get());
-            
-            // 垂直居中对齐
-            ImGui::AlignTextToFramePadding();
-
-            // 绘制行
-            if (ImGui::Selectable(go->name.c_str(), isSelected, selectable_flags))
-            {
-                selectedObject = go.get();
-            }
-
-            // 右键菜单
-            if (ImGui::BeginPopupContextItem())
-            {
-                selectedObject = go.get();
-                if (ImGui::MenuItem("Delete")) {
-                    idToDelete = i;
-                }
-                ImGui::Separator();
-                ImGui::MenuItem("Duplicate (TODO)", nullptr, false, false);
-                ImGui::EndPopup();
-            }
-
-            // 第二列：类型
-            ImGui::TableSetColumnIndex(1);
-            ImGui::AlignTextToFramePadding(); 
-
-            const char* typeStr = "-";
-            if (go->getComponent<LightComponent>()) typeStr = "Light";
-            else if (go->getComponent<MeshComponent>()) typeStr = "Mesh";
-            else if (go->getComponent<ReflectionProbeComponent>()) typeStr = "Probe";
-
-            ImGui::TextDisabled("%s", typeStr);
-
-            ImGui::PopID();
+            if (!scene->getParent(go.get())) drawObjectNode(*scene, go.get(), selectedObject, actions);
         }
 
-        if (idToDelete != -1) {
-            scene->markForDestruction(objects[idToDelete].get());
-            if (selectedObject == objects[idToDelete].get()) selectedObject = nullptr;
+        // 树遍历结束后再修改层级，避免遍历中改动子对象列表
+        if (actions.reparentChild) {
+            scene->setParent(actions.reparentChild, actions.reparentTarget);
+        }
+        if (actions.toDelete) {
+            scene->markForDestruction(actions.toDelete);
+            if (selectedObject == actions.toDelete) selectedObject = nullptr;
         }
 
         ImGui::EndTable();
@@ -132,6 +169,16 @@ void HierarchyPanel::onImGuiRender(const std::unique_ptr<Scene>& scene, GameObje
     
     ImGui::PopStyleVar(); // Pop CellPadding
 
+    // 拖到列表空白处：变回根对象
+    if (ImGui::BeginDragDropTargetCustom(ImGui::GetCurrentWindow()->InnerRect, ImGui::GetID("HierarchyRootDrop")))
+    {
+        if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload(kHierarchyPayload)) {
+            GameObjectHandle handle = *static_cast<const GameObjectHandle*>(payload->Data);
+            if (GameObject* dragged = scene->find(handle)) scene->setParent(dragged, nullptr);
+        }
+        ImGui::EndDragDropTarget();
+    }
+
     // =========================================================
     // 3. 空白处交互
     // =========================================================
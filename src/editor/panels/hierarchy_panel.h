@@ -12,4 +12,15 @@ public:
 
     // 覆盖基类接口 (虽然主要用上面的带参版本)
     void onImGuiRender() override {} 
+
+private:
+    // 绘制过程中收集的操作，整棵树画完后再执行
+    struct HierarchyActions {
+        GameObject* toDelete = nullptr;
+        GameObject* reparentChild = nullptr;
+        GameObject* reparentTarget = nullptr; // 为空时变回根对象
+    };
+
+    // 绘制一个物体所在的行，展开时递归绘制它的子对象
+    void drawObjectNode(Scene& scene, GameObject* go, GameObject*& selectedObject, HierarchyActions& actions);
 };
\ No newline at end of file
@@ -77,7 +77,7 @@ void InspectorPanel::drawComponents(GameObject* obj)
 
     // 3. Components Loop
     Component *compToRemove = nullptr;
-    for (auto &comp : obj->components)
+    for (Component *comp : obj->getComponents())
     {
         ImGui::PushID(comp->getInstanceID());
 
@@ -92,11 +92,11 @@ void InspectorPanel::drawComponents(GameObject* obj)
         {
             ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.6f, 0.2f, 0.2f, 1.0f));
             if (ImGui::Button("Remove Component", ImVec2(-1, 0))) 
-                compToRemove = comp.get();
+                compToRemove = comp;
             ImGui::PopStyleColor();
 
             ImGui::Dummy(ImVec2(0, 5));
-            drawComponentUI(comp.get()); // 调用具体绘制
+            drawComponentUI(comp); // 调用具体绘制
             ImGui::Dummy(ImVec2(0, 10));
         }
         ImGui::PopID();
@@ -340,6 +340,48 @@ void InspectorPanel::drawComponentUI(Component *comp)
             }
         }
 
+        // CPU 端数据的驻留策略 (只对来自文件的模型有意义，程序生成的网格始终保留完整数据)
+        if (mesh->model && mesh->model->getGeometry()->source.isReloadable())
+        {
+            const auto& geometry = mesh->model->getGeometry();
+            const char* residencyNames[] = { "Full", "Picking Proxy", "Quantized Proxy", "GPU Only" };
+            int residency = (int)geometry->residency;
+            if (ImGui::Combo("CPU Data", &residency, residencyNames, IM_ARRAYSIZE(residencyNames))) {
+                ResourceManager::Get().setMeshResidency(*mesh->model, (MeshResidency)residency);
+            }
+            if (ImGui::IsItemHovered()) {
+                glm::vec3 error = geometry->proxy.step * 0.5f;
+                ImGui::SetTooltip("%zu vertices, %.2f MB resident on CPU\nQuantization error: %.4f / %.4f / %.4f\nShared by every object using this mesh.",
+                    geometry->vertexCount, geometry->getCpuByteSize() / (1024.0 * 1024.0),
+                    error.x, error.y, error.z);
+            }
+
+            // 显存中的顶点格式与量化误差
+            const PackedVertexData& packed = geometry->packed;
+            ImGui::TextDisabled("Vertex: %s, %zu B", VertexPacking::getFormatName(packed.format), VertexPacking::getStride(packed.format));
+            if (ImGui::IsItemHovered() && packed.format != VertexFormat::Standard) {
+                ImGui::SetTooltip("Max quantization error\nPosition: %.5f\nNormal: %.3f deg\nTangent: %.3f deg\nUV: %.5f",
+                    packed.maxPositionError, packed.maxNormalError, packed.maxTangentError, packed.maxTexCoordError);
+            }
+        }
+
+        // LOD 链与主相机当前选中的级别
+        if (mesh->model && mesh->model->getLodCount() > 1)
+        {
+            int lodCount = mesh->model->getLodCount();
+            int lod = mesh->getLodLevel();
+            ImGui::TextDisabled("LOD: %d / %d, %zu tris%s", lod, lodCount - 1, mesh->model->getLodFaceCount(lod),
+                                mesh->lodCulled ? " (culled)" : "");
+            if (ImGui::IsItemHovered()) {
+                ImGui::BeginTooltip();
+                for (int i = 0; i < lodCount; ++i) {
+                    ImGui::Text("LOD %d: %zu tris, error %.5f, %zu clusters", i, mesh->model->getLodFaceCount(i),
+                                mesh->model->getLodError(i), mesh->model->getClusterCount(i));
+                }
+                ImGui::EndTooltip();
+            }
+        }
+
         // 3. 执行重建逻辑
         if (needRebuild)
         {
@@ -446,7 +488,7 @@ void InspectorPanel::drawComponentUI(Component *comp)
 
             drawResourceSlot("Albedo Map", albedoName, albedoPath, "ASSET_TEXTURE",
                 [&](const std::string& path) {
-                    auto tex = ResourceManager::Get().getTexture(path);
+                    auto tex = ResourceManager::Get().getTextureAsync(path, TexturePlaceholder::Albedo, true);
                     if (tex) mesh->diffuseMap = tex;
                 },
                 [&]() { mesh->diffuseMap = nullptr; }
@@ -556,7 +598,7 @@ void InspectorPanel::drawComponentUI(Component *comp)
 
             drawResourceSlot("Normal Map", normName, normPath, "ASSET_TEXTURE",
                 [&](const std::string& path) {
-                    auto tex = ResourceManager::Get().getTexture(path);
+                    auto tex = ResourceManager::Get().getTextureAsync(path, TexturePlaceholder::Normal);
                     if (tex) mesh->normalMap = tex;
                 },
                 [&]() { mesh->normalMap = nullptr; }
@@ -584,7 +626,7 @@ void InspectorPanel::drawComponentUI(Component *comp)
 
             drawResourceSlot("ORM Map", ormName, ormPath, "ASSET_TEXTURE",
                 [&](const std::string& path) {
-                    auto tex = ResourceManager::Get().getTexture(path);
+                    auto tex = ResourceManager::Get().getTextureAsync(path, TexturePlaceholder::ORM);
                     if (tex) mesh->ormMap = tex;
                 },
                 [&]() { mesh->ormMap = nullptr; }
@@ -610,7 +652,7 @@ void InspectorPanel::drawComponentUI(Component *comp)
             std::string metalPath = mesh->metallicMap ? mesh->metallicMap->getUri() : "";
             std::string metalName = std::filesystem::path(metalPath).filename().string();
             drawResourceSlot("Metallic Map", metalName, metalPath, "ASSET_TEXTURE",
-                [&](const std::string& path) { mesh->metallicMap = ResourceManager::Get().getTexture(path); },
+                [&](const std::string& path) { mesh->metallicMap = ResourceManager::Get().getTextureAsync(path, TexturePlaceholder::Black); },
                 [&]() { mesh->metallicMap = nullptr; }
             );
             // 如果有贴图，显示黄色警告；如果没有，显示灰色提示
@@ -622,7 +664,7 @@ void InspectorPanel::drawComponentUI(Component *comp)
             std::string roughPath = mesh->roughnessMap ? mesh->roughnessMap->getUri() : "";
             std::string roughName = std::filesystem::path(roughPath).filename().string();
             drawResourceSlot("Roughness Map", roughName, roughPath, "ASSET_TEXTURE",
-                [&](const std::string& path) { mesh->roughnessMap = ResourceManager::Get().getTexture(path); },
+                [&](const std::string& path) { mesh->roughnessMap = ResourceManager::Get().getTextureAsync(path, TexturePlaceholder::White); },
                 [&]() { mesh->roughnessMap = nullptr; }
             );
             if (mesh->roughnessMap) {
@@ -633,7 +675,7 @@ void InspectorPanel::drawComponentUI(Component *comp)
             std::string aoPath = mesh->aoMap ? mesh->aoMap->getUri() : "";
             std::string aoName = std::filesystem::path(aoPath).filename().string();
             drawResourceSlot("AO Map", aoName, aoPath, "ASSET_TEXTURE",
-                [&](const std::string& path) { mesh->aoMap = ResourceManager::Get().getTexture(path); },
+                [&](const std::string& path) { mesh->aoMap = ResourceManager::Get().getTextureAsync(path, TexturePlaceholder::White); },
                 [&]() { mesh->aoMap = nullptr; }
             );
             if (mesh->aoMap) {
@@ -647,7 +689,7 @@ void InspectorPanel::drawComponentUI(Component *comp)
 
             drawResourceSlot("Emissive Map", emissiveName, emissivePath, "ASSET_TEXTURE",
                 [&](const std::string& path) {
-                    auto tex = ResourceManager::Get().getTexture(path);
+                    auto tex = ResourceManager::Get().getTextureAsync(path, TexturePlaceholder::Black, true);
                     if (tex) {
                         mesh->emissiveMap = tex;
                         // [体验优化] 如果用户拖入了贴图且颜色为纯黑，自动设为纯白，否则看不见贴图
@@ -672,7 +714,7 @@ void InspectorPanel::drawComponentUI(Component *comp)
 
             drawResourceSlot("Opacity Map", opacityName, opacityPath, "ASSET_TEXTURE",
                 [&](const std::string& path) {
-                    auto tex = ResourceManager::Get().getTexture(path);
+                    auto tex = ResourceManager::Get().getTextureAsync(path, TexturePlaceholder::White);
                     if (tex) mesh->opacityMap = tex;
                 },
                 [&]() { mesh->opacityMap = nullptr; }
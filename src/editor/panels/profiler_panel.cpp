@@ -0,0 +1,293 @@
+#include "profiler_panel.h"
+#include <imgui.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 同名作用域每帧颜色一致 (按名字的哈希取色相)
+ImU32 scopeColor(const char* name)
+{
+    uint32_t hash = 2166136261u;
+    for (const char* c = name; *c; ++c) hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+    float hue = (hash % 360) / 360.0f;
+    return ImColor::HSV(hue, 0.45f, 0.75f);
+}
+
+float frameMsGetter(void* data, int idx)
+{
+    const Profiler* profiler = static_cast<const Profiler*>(data);
+    size_t count = profiler->getHistoryCount();
+    return static_cast<float>(profiler->getHistoryFrame(count - 1 - idx).getMs());
+}
+
+} // namespace
+
+ProfilerPanel::ProfilerPanel() : Panel("Profiler") {}
+
+void ProfilerPanel::onImGuiRender()
+{
+    if (!_isOpen) return;
+
+    if (!ImGui::Begin(_title.c_str(), &_isOpen)) {
+        ImGui::End();
+        return;
+    }
+
+    Profiler& profiler = Profiler::Get();
+
+    // =========================================================
+    // 1. 工具栏
+    // =========================================================
+    bool enabled = profiler.isEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled)) profiler.setEnabled(enabled);
+    ImGui::SameLine();
+    bool frozen = profiler.isFrozen();
+    if (ImGui::Checkbox("Freeze", &frozen)) {
+        profiler.setFrozen(frozen);
+        _selectedAge = 0;
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Stop updating the history so a single frame can be inspected.\nClicking a bar in the graph also freezes.");
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(160.0f);
+    ImGui::SliderFloat("Zoom", &_zoom, 1.0f, 64.0f, "%.1fx", ImGuiSliderFlags_Logarithmic);
+
+    drawCaptureControls();
+
+    if (profiler.getHistoryCount() == 0) {
+        ImGui::TextDisabled("No frames recorded yet.");
+        ImGui::End();
+        return;
+    }
+
+    // =========================================================
+    // 2. 帧耗时历史 (点击选中一帧并冻结)
+    // =========================================================
+    drawFrameHistory();
+
+    size_t age = profiler.isFrozen() ? _selectedAge : pickDisplayedFrame();
+    age = std::min(age, profiler.getHistoryCount() - 1);
+    const ProfileFrame& frame = profiler.getHistoryFrame(age);
+
+    ImGui::Text("Frame %llu: %.2f ms CPU", static_cast<unsigned long long>(frame.index), frame.getMs());
+    ImGui::SameLine();
+    if (frame.gpuResolved) ImGui::Text("| %.2f ms GPU", frame.getGpuMs());
+    else ImGui::TextDisabled("| GPU pending");
+
+    // =========================================================
+    // 3. 时间线 (逐线程火焰图 + GPU)
+    // =========================================================
+    drawTimeline(frame);
+
+    // =========================================================
+    // 4. 各 pass 的 CPU / GPU 耗时
+    // =========================================================
+    drawPassTable(frame);
+
+    ImGui::End();
+}
+
+size_t ProfilerPanel::pickDisplayedFrame() const
+{
+    const Profiler& profiler = Profiler::Get();
+    // GPU 结果晚两三帧才取回
+    size_t limit = std::min<size_t>(profiler.getHistoryCount(), 4);
+    for (size_t age = 0; age < limit; ++age) {
+        if (profiler.getHistoryFrame(age).gpuResolved) return age;
+    }
+    return 0;
+}
+
+void ProfilerPanel::drawCaptureControls()
+{
+    Profiler& profiler = Profiler::Get();
+
+    if (ImGui::Button("Dump Trace (F9)")) profiler.requestDump();
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Write the captured frames (CPU scopes of all threads, GPU passes,\nasset loads and counters) to <project>/captures/.");
+    }
+
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(110.0f);
+    int format = static_cast<int>(profiler.getCaptureFormat());
+    const char* formats[] = { "Chrome JSON", "Perfetto" };
+    if (ImGui::Combo("##TraceFormat", &format, formats, 2)) profiler.setCaptureFormat(static_cast<TraceFormat>(format));
+
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(110.0f);
+    float seconds = profiler.getCaptureSeconds();
+    if (ImGui::DragFloat("Seconds", &seconds, 0.5f, 1.0f, 120.0f, "%.0f s")) profiler.setCaptureSeconds(seconds);
+
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(110.0f);
+    float threshold = profiler.getHitchThresholdMs();
+    if (ImGui::DragFloat("Hitch", &threshold, 0.5f, 0.0f, 1000.0f, threshold > 0.0f ? "> %.1f ms" : "Off")) {
+        profiler.setHitchThresholdMs(std::max(threshold, 0.0f));
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Dump a trace automatically when a frame takes longer than this.");
+    }
+
+    ImGui::TextDisabled("%zu frames captured", profiler.getCaptureFrameCount());
+    if (!profiler.getLastDumpPath().empty()) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("| last: %s", profiler.getLastDumpPath().c_str());
+    }
+}
+
+void ProfilerPanel::drawFrameHistory()
+{
+    Profiler& profiler = Profiler::Get();
+    int count = static_cast<int>(profiler.getHistoryCount());
+
+    float maxMs = 0.0f;
+    for (int i = 0; i < count; ++i) maxMs = std::max(maxMs, frameMsGetter(&profiler, i));
+
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "max %.2f ms", maxMs);
+    ImGui::PlotHistogram("##FrameHistory", frameMsGetter, &profiler, count, 0, overlay,
+                         0.0f, std::max(maxMs * 1.1f, 1.0f), ImVec2(-1.0f, 60.0f));
+
+    if (ImGui::IsItemClicked()) {
+        // 柱子从左 (最旧) 到右 (最新) 排列
+        ImVec2 min = ImGui::GetItemRectMin();
+        ImVec2 max = ImGui::GetItemRectMax();
+        float padding = ImGui::GetStyle().FramePadding.x;
+        float t = (ImGui::GetIO().MousePos.x - min.x - padding) / std::max(1.0f, max.x - min.x - 2.0f * padding);
+        int idx = std::clamp(static_cast<int>(t * count), 0, count - 1);
+        _selectedAge = static_cast<size_t>(count - 1 - idx);
+        profiler.setFrozen(true);
+    }
+}
+
+void ProfilerPanel::drawTimeline(const ProfileFrame& frame)
+{
+    Profiler& profiler = Profiler::Get();
+
+    // 时间范围：帧区间，加上跨过帧起点的作用域和晚于帧末的 GPU pass
+    uint64_t tMin = frame.startNs;
+    uint64_t tMax = frame.endNs;
+    for (const ProfileEvent& e : frame.cpuEvents) tMin = std::min(tMin, e.startNs);
+    for (const ProfileEvent& e : frame.gpuEvents) {
+        tMin = std::min(tMin, e.startNs);
+        tMax = std::max(tMax, e.endNs);
+    }
+    double span = static_cast<double>(std::max<uint64_t>(tMax - tMin, 1));
+
+    // 泳道：每个线程一条 (行数为最大嵌套深度 + 1)，最后是 GPU
+    struct Lane {
+        uint16_t thread;
+        int rows;
+        size_t begin, end; // 在 cpuEvents 中的区间
+    };
+    std::vector<Lane> lanes;
+    for (size_t i = 0; i < frame.cpuEvents.size(); ++i) {
+        const ProfileEvent& e = frame.cpuEvents[i];
+        if (lanes.empty() || lanes.back().thread != e.threadIndex) lanes.push_back({ e.threadIndex, 1, i, i });
+        lanes.back().rows = std::max(lanes.back().rows, e.depth + 1);
+        lanes.back().end = i + 1;
+    }
+
+    float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+    float headerHeight = ImGui::GetTextLineHeight() + 2.0f;
+    float contentHeight = headerHeight + rowHeight; // GPU
+    for (const Lane& lane : lanes) contentHeight += headerHeight + lane.rows * rowHeight;
+
+    const ImGuiStyle& style = ImGui::GetStyle();
+    float childHeight = contentHeight + style.ScrollbarSize + style.WindowPadding.y * 2.0f;
+    if (!ImGui::BeginChild("##Timeline", ImVec2(0.0f, childHeight), ImGuiChildFlags_Borders,
+                           ImGuiWindowFlags_HorizontalScrollbar)) {
+        ImGui::EndChild();
+        return;
+    }
+
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    float canvasWidth = std::max(1.0f, ImGui::GetContentRegionAvail().x) * _zoom;
+    ImGui::Dummy(ImVec2(canvasWidth, contentHeight));
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ImVec2 mouse = ImGui::GetIO().MousePos;
+    bool hovered = ImGui::IsWindowHovered();
+    float labelX = ImGui::GetWindowPos().x + style.WindowPadding.x; // 泳道名不随横向滚动
+    ImU32 textColor = ImGui::GetColorU32(ImGuiCol_Text);
+    ImU32 headerColor = ImGui::GetColorU32(ImGuiCol_TextDisabled);
+
+    auto drawEvent = [&](const ProfileEvent& e, float y) {
+        float x0 = origin.x + static_cast<float>((e.startNs - tMin) / span) * canvasWidth;
+        float x1 = origin.x + static_cast<float>((e.endNs - tMin) / span) * canvasWidth;
+        x1 = std::max(x1, x0 + 1.0f);
+        ImVec2 a(x0, y), b(x1, y + rowHeight - 1.0f);
+
+        drawList->AddRectFilled(a, b, scopeColor(e.name));
+        if (x1 - x0 > 8.0f) {
+            ImVec4 clip(x0 + 2.0f, y, x1 - 2.0f, y + rowHeight);
+            drawList->AddText(nullptr, 0.0f, ImVec2(x0 + 3.0f, y + 2.0f), IM_COL32(20, 20, 20, 255), e.name, nullptr, 0.0f, &clip);
+        }
+        if (hovered && mouse.x >= a.x && mouse.x < b.x && mouse.y >= a.y && mouse.y < b.y) {
+            ImGui::SetTooltip("%s\n%.3f ms\n+%.3f ms from frame start", e.name, e.getMs(),
+                              (static_cast<double>(e.startNs) - static_cast<double>(frame.startNs)) / 1e6);
+        }
+    };
+
+    float y = origin.y;
+    for (const Lane& lane : lanes) {
+        std::string name = profiler.getThreadName(lane.thread);
+        drawList->AddText(ImVec2(labelX, y), headerColor, name.c_str());
+        y += headerHeight;
+        for (size_t i = lane.begin; i < lane.end; ++i) {
+            const ProfileEvent& e = frame.cpuEvents[i];
+            drawEvent(e, y + e.depth * rowHeight);
+        }
+        y += lane.rows * rowHeight;
+    }
+
+    drawList->AddText(ImVec2(labelX, y), headerColor, frame.gpuResolved ? "GPU" : "GPU (pending)");
+    y += headerHeight;
+    for (const ProfileEvent& e : frame.gpuEvents) drawEvent(e, y);
+
+    // 帧边界
+    float frameX0 = origin.x + static_cast<float>((frame.startNs - tMin) / span) * canvasWidth;
+    float frameX1 = origin.x + static_cast<float>((frame.endNs - tMin) / span) * canvasWidth;
+    drawList->AddLine(ImVec2(frameX0, origin.y), ImVec2(frameX0, origin.y + contentHeight), textColor);
+    drawList->AddLine(ImVec2(frameX1, origin.y), ImVec2(frameX1, origin.y + contentHeight), textColor);
+
+    ImGui::EndChild();
+}
+
+void ProfilerPanel::drawPassTable(const ProfileFrame& frame)
+{
+    if (frame.gpuEvents.empty()) {
+        ImGui::TextDisabled("No GPU passes recorded for this frame.");
+        return;
+    }
+
+    if (!ImGui::BeginTable("##Passes", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) return;
+
+    ImGui::TableSetupColumn("Pass");
+    ImGui::TableSetupColumn("CPU (ms)");
+    ImGui::TableSetupColumn("GPU (ms)");
+    ImGui::TableHeadersRow();
+
+    for (const ProfileEvent& gpu : frame.gpuEvents) {
+        // 同名的 CPU 作用域 (PassProfileScope 同时记录两者)
+        double cpuMs = 0.0;
+        for (const ProfileEvent& cpu : frame.cpuEvents) {
+            if (cpu.name == gpu.name || std::strcmp(cpu.name, gpu.name) == 0) cpuMs += cpu.getMs();
+        }
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(gpu.name);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", cpuMs);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", gpu.getMs());
+    }
+
+    ImGui::EndTable();
+}
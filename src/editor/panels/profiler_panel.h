@@ -0,0 +1,22 @@
+#pragma once
+#include "panel.h"
+#include "engine/utils/profiler.h"
+
+// 帧分析器面板：帧耗时历史、逐线程的作用域时间线 (火焰图) 与各 pass 的 CPU / GPU 耗时
+class ProfilerPanel : public Panel {
+public:
+    ProfilerPanel();
+    void onImGuiRender() override;
+
+private:
+    size_t _selectedAge = 0; // 冻结时查看的帧 (0 为最近一帧)
+    float _zoom = 1.0f;      // 时间线横向放大倍数
+
+    // 未冻结时显示最近一个已经取回 GPU 结果的帧
+    size_t pickDisplayedFrame() const;
+
+    void drawCaptureControls();
+    void drawFrameHistory();
+    void drawTimeline(const ProfileFrame& frame);
+    void drawPassTable(const ProfileFrame& frame);
+};
@@ -23,7 +23,7 @@ void ProjectPanel::onImGuiRender()
             ResourceManager::Get().refreshProjectDirectory();
         }
         if (ImGui::IsItemHovered()) {
-            ImGui::SetTooltip("Reload file list from disk (F5)");
+            ImGui::SetTooltip("Rescan changed folders (F5)");
         }
 
         ImGui::SameLine();
@@ -42,6 +42,112 @@ void ProjectPanel::onImGuiRender()
             }
         }
 
+        // 纹理流式加载开关与统计 (关闭后走旧的同步加载路径，便于对比卡顿)
+        auto& rm = ResourceManager::Get();
+        bool streaming = rm.isTextureStreamingEnabled();
+        if (ImGui::Checkbox("Async Textures", &streaming)) {
+            rm.setTextureStreamingEnabled(streaming);
+            rm.getTextureStreamer().resetPeak();
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Decode textures on worker threads and upload them\nthrough a PBO ring within a per-frame byte budget.");
+        }
+        ImGui::SameLine();
+        bool compress = rm.isTextureCompressionEnabled();
+        if (ImGui::Checkbox("BC Compress", &compress)) {
+            rm.setTextureCompressionEnabled(compress);
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Block-compress newly loaded textures (BC1/BC3/BC4).\nCooked results are cached under .cache/textures.");
+        }
+        ImGui::SameLine();
+        bool packOrm = rm.isOrmPackingEnabled();
+        if (ImGui::Checkbox("Pack ORM", &packOrm)) {
+            rm.setOrmPackingEnabled(packOrm);
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Pack separate AO / Roughness / Metallic maps into one ORM texture\n(1 bind + 1 fetch instead of 3).");
+        }
+        ImGui::SameLine();
+        bool dedup = rm.isContentDedupEnabled();
+        if (ImGui::Checkbox("Dedup", &dedup)) {
+            rm.setContentDedupEnabled(dedup);
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Share one GPU copy between byte-identical meshes / textures\n(matched by a content hash of the decoded data).");
+        }
+        ImGui::SameLine();
+        if (streaming) {
+            auto stats = rm.getTextureStreamer().getStats();
+            ImGui::TextDisabled("Pending: %zu (%.1f MB) | Upload: %.2f ms (peak %.2f ms)",
+                stats.pendingJobs, stats.pendingBytes / (1024.0 * 1024.0),
+                stats.uploadMsThisFrame, stats.maxUploadMs);
+        } else {
+            ImGui::TextDisabled("Last sync load: %.2f ms", rm.getLastSyncTextureLoadMs());
+        }
+        ImGui::SameLine();
+        ImGui::TextDisabled("| Watch: %s", rm.getWatcher().getBackendName());
+
+        // 内容去重节省的显存
+        const auto& dedupStats = rm.getDedupStats();
+        ImGui::SameLine();
+        ImGui::TextDisabled("| Dedup saved: %.1f MB",
+            (dedupStats.textureBytesSaved + dedupStats.meshBytesSaved) / (1024.0 * 1024.0));
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Textures: %zu loaded, %zu on GPU, %.1f MB saved\nMeshes: %zu loaded, %zu on GPU, %.1f MB saved",
+                dedupStats.textureCount, dedupStats.textureStorageCount, dedupStats.textureBytesSaved / (1024.0 * 1024.0),
+                dedupStats.meshCount, dedupStats.meshStorageCount, dedupStats.meshBytesSaved / (1024.0 * 1024.0));
+        }
+
+        // 资源缓存的内存占用与预算 (超出时按 LRU 淘汰未被引用的条目)
+        const auto& mem = rm.getMemoryStats();
+        ImGui::SameLine();
+        ImGui::TextDisabled("| CPU %.0f/%.0f MB  GPU %.0f/%.0f MB",
+            mem.cpuBytes / (1024.0 * 1024.0), mem.cpuBudget / (1024.0 * 1024.0),
+            mem.gpuBytes / (1024.0 * 1024.0), mem.gpuBudget / (1024.0 * 1024.0));
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("%zu cache entries, %zu evicted so far (%.1f MB freed)",
+                mem.entryCount, mem.evictedCount, mem.evictedBytes / (1024.0 * 1024.0));
+        }
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Budget")) {
+            ImGui::OpenPopup("MemoryBudget");
+        }
+        if (ImGui::BeginPopup("MemoryBudget")) {
+            int cpuMB = (int)(mem.cpuBudget / (1024 * 1024));
+            int gpuMB = (int)(mem.gpuBudget / (1024 * 1024));
+            ImGui::SetNextItemWidth(120.0f);
+            bool changed = ImGui::DragInt("CPU (MB)", &cpuMB, 16.0f, 64, 65536);
+            ImGui::SetNextItemWidth(120.0f);
+            changed |= ImGui::DragInt("GPU (MB)", &gpuMB, 16.0f, 64, 65536);
+            if (changed) {
+                rm.setMemoryBudget((size_t)cpuMB * 1024 * 1024, (size_t)gpuMB * 1024 * 1024);
+            }
+
+            // 新加载的模型在上传后保留多少 CPU 数据 (单个模型可在 Inspector 中修改)
+            const char* residencyNames[] = { "Full", "Picking Proxy", "Quantized Proxy", "GPU Only" };
+            int residency = (int)rm.getDefaultMeshResidency();
+            ImGui::SetNextItemWidth(120.0f);
+            if (ImGui::Combo("Mesh CPU Data", &residency, residencyNames, IM_ARRAYSIZE(residencyNames))) {
+                rm.setDefaultMeshResidency((MeshResidency)residency);
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Applies to meshes loaded from now on.\nProxies keep only positions + indices for picking;\nGPU Only picks by bounding box. Export re-reads .cache/meshes.");
+            }
+
+            // 新加载的模型在显存中的顶点格式
+            const char* formatNames[] = { "Standard (48 B)", "Compact (24 B)", "Quantized (20 B)" };
+            int format = (int)rm.getVertexFormat();
+            ImGui::SetNextItemWidth(120.0f);
+            if (ImGui::Combo("Vertex Format", &format, formatNames, IM_ARRAYSIZE(formatNames))) {
+                rm.setVertexFormat((VertexFormat)format);
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Applies to meshes loaded from now on.\nOctahedral normals / tangents and half-float UVs;\nQuantized also stores positions as 16 bit within the bounds.");
+            }
+            ImGui::EndPopup();
+        }
+
         ImGui::Separator();
     }
 
@@ -52,7 +158,8 @@ void ProjectPanel::onImGuiRender()
     // 给内容区域留出一点边距
     ImGui::Dummy(ImVec2(0, 5));
 
-    const auto& files = ResourceManager::Get().getFileList();
+    // 类型、文件名与显示标签都已在资源索引中算好，这里不做任何字符串处理
+    const auto& records = ResourceManager::Get().getAssetDatabase().getRecords();
     
     float padding = 10.0f;
     float thumbnailSize = 80.0f;
@@ -66,61 +173,70 @@ void ProjectPanel::onImGuiRender()
     // 使用 ID 避免冲突
     if (ImGui::BeginTable("AssetGrid", columnCount))
     {
-        for (const auto& file : files)
+        // 只绘制可见的行 (大项目里有成千上万个资源)
+        int rowCount = ((int)records.size() + columnCount - 1) / columnCount;
+        ImGuiListClipper clipper;
+        clipper.Begin(rowCount);
+        while (clipper.Step())
         {
-            std::string filename = file.first;
-            std::string relativePath = file.second;
-
-            std::string ext = std::filesystem::path(filename).extension().string();
-            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+            {
+                ImGui::TableNextRow();
+                for (int col = 0; col < columnCount; ++col)
+                {
+                    size_t index = (size_t)row * columnCount + col;
+                    if (index >= records.size()) break;
+                    const AssetRecord& record = records[index];
+
+                    const std::string& filename = record.filename;
+                    const std::string& relativePath = record.path;
+
+                    bool isModel = (record.type == AssetType::Model);
+                    bool isTexture = (record.type == AssetType::Texture);
+
+                    ImGui::TableSetColumnIndex(col);
+                    ImGui::PushID(relativePath.c_str());
+
+                    // 绘制大图标按钮 (暂时用 Button 模拟，后续可以换成真正的图标纹理)
+                    // 区分颜色以简单识别类型
+                    if (isModel) ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.3f, 0.2f, 0.5f, 1.0f)); // 紫色代表模型
+                    else if (isTexture) ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.2f, 0.4f, 0.2f, 1.0f)); // 绿色代表图片
+                    else ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.3f, 0.3f, 0.3f, 1.0f)); // 灰色其他
+
+                    // 按钮
+                    ImGui::Button(isModel ? "MODEL" : (isTexture ? "TEX" : "FILE"), ImVec2(thumbnailSize, thumbnailSize));
             
-            bool isModel = (ext == ".obj" || ext == ".gltf" || ext == ".glb");
-            bool isTexture = (ext == ".png" || ext == ".jpg" || ext == ".jpeg" ||
-                              ext == ".bmp" || ext == ".tga" || ext == ".hdr");
-
-            ImGui::TableNextColumn();
-            ImGui::PushID(relativePath.c_str());
-
-            // 绘制大图标按钮 (暂时用 Button 模拟，后续可以换成真正的图标纹理)
-            // 区分颜色以简单识别类型
-            if (isModel) ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.3f, 0.2f, 0.5f, 1.0f)); // 紫色代表模型
-            else if (isTexture) ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.2f, 0.4f, 0.2f, 1.0f)); // 绿色代表图片
-            else ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.3f, 0.3f, 0.3f, 1.0f)); // 灰色其他
-
-            // 按钮
-            ImGui::Button(isModel ? "MODEL" : (isTexture ? "TEX" : "FILE"), ImVec2(thumbnailSize, thumbnailSize));
+                    ImGui::PopStyleColor();
+
+                    // 拖拽源 (Drag Source)
+                    if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceAllowNullID))
+                    {
+                        if (isModel) {
+                            ImGui::SetDragDropPayload("ASSET_OBJ", relativePath.c_str(), relativePath.size() + 1);
+                            ImGui::Text("Model: %s", filename.c_str());
+                        }
+                        else if (isTexture) {
+                            ImGui::SetDragDropPayload("ASSET_TEXTURE", relativePath.c_str(), relativePath.size() + 1);
+                            ImGui::Text("Texture: %s", filename.c_str());
+                        }
+                        ImGui::EndDragDropSource();
+                    }
+
+                    const std::string& label = record.label;
+
+                    // 居中文件名
+                    float textWidth = ImGui::CalcTextSize(label.c_str()).x;
+                    float offset = (thumbnailSize - textWidth) * 0.5f;
+                    if (offset > 0) ImGui::SetCursorPosX(ImGui::GetCursorPosX() + offset);
             
-            ImGui::PopStyleColor();
+                    ImGui::Text("%s", label.c_str());
+                    if (ImGui::IsItemHovered() && label != filename) {
+                        ImGui::SetTooltip("%s", filename.c_str());
+                    }
 
-            // 拖拽源 (Drag Source)
-            if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceAllowNullID))
-            {
-                if (isModel) {
-                    ImGui::SetDragDropPayload("ASSET_OBJ", relativePath.c_str(), relativePath.size() + 1);
-                    ImGui::Text("Model: %s", filename.c_str());
+                    ImGui::PopID();
                 }
-                else if (isTexture) {
-                    ImGui::SetDragDropPayload("ASSET_TEXTURE", relativePath.c_str(), relativePath.size() + 1);
-                    ImGui::Text("Texture: %s", filename.c_str());
-                }
-                ImGui::EndDragDropSource();
-            }
-
-            // 文件名截断显示 (防止太长破坏布局)
-            std::string label = filename;
-            if (label.length() > 12) label = label.substr(0, 9) + "...";
-            
-            // 居中文件名
-            float textWidth = ImGui::CalcTextSize(label.c_str()).x;
-            float offset = (thumbnailSize - textWidth) * 0.5f;
-            if (offset > 0) ImGui::SetCursorPosX(ImGui::GetCursorPosX() + offset);
-            
-            ImGui::Text("%s", label.c_str());
-            if (ImGui::IsItemHovered() && label != filename) {
-                ImGui::SetTooltip("%s", filename.c_str());
             }
-
-            ImGui::PopID();
         }
         ImGui::EndTable();
     }
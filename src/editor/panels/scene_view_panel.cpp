@@ -1,5 +1,9 @@
 #include "scene_view_panel.h"
+#include "engine/render_thread.h"
+#include "engine/utils/allocation_tracker.h"
 #include <imgui.h>
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include <limits> // for std::numeric_limits
 
@@ -15,9 +19,13 @@ SceneViewPanel::SceneViewPanel() : Panel("3D Viewport")
 
 SceneViewPanel::~SceneViewPanel()
 {
-    if (_fbo.id) glDeleteFramebuffers(1, &_fbo.id);
-    if (_fbo.texture) glDeleteTextures(1, &_fbo.texture);
-    if (_fbo.rbo) glDeleteRenderbuffers(1, &_fbo.rbo);
+    // FBO 只属于窗口上下文
+    FrameBuffer fbo = _fbo;
+    RenderThread::Get().runOnRenderContext([fbo]() {
+        if (fbo.id) glDeleteFramebuffers(1, &fbo.id);
+        if (fbo.texture) glDeleteTextures(1, &fbo.texture);
+        if (fbo.rbo) glDeleteRenderbuffers(1, &fbo.rbo);
+    });
 }
 
 void SceneViewPanel::initFBO(int width, int height)
@@ -49,15 +57,42 @@ void SceneViewPanel::initFBO(int width, int height)
 void SceneViewPanel::resizeFBO(int width, int height)
 {
     if (_fbo.width == width && _fbo.height == height) return;
-    
-    glDeleteFramebuffers(1, &_fbo.id);
-    glDeleteTextures(1, &_fbo.texture);
-    glDeleteRenderbuffers(1, &_fbo.rbo);
-    initFBO(width, height);
+
+    // 原地重新分配存储，纹理名保持不变 (这一帧已经记录的 ImGui 绘制命令引用的就是它)
+    _fbo.width = width;
+    _fbo.height = height;
+
+    glBindTexture(GL_TEXTURE_2D, _fbo.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, _fbo.rbo);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+}
+
+bool SceneViewPanel::prepareTarget(Renderer* renderer, RenderSnapshot& snapshot)
+{
+    _stats = renderer->getFrameStats();
+    if (!_isVisible || _fbo.id == 0) return false;
+
+    if (_targetWidth != _fbo.width || _targetHeight != _fbo.height)
+    {
+        resizeFBO(_targetWidth, _targetHeight);
+        renderer->onResize(_targetWidth, _targetHeight);
+        _cameraController->onResize(_targetWidth, _targetHeight);
+    }
+
+    snapshot.targetFBO = _fbo.id;
+    snapshot.width = _targetWidth;
+    snapshot.height = _targetHeight;
+    snapshot.contentScale = _contentScale;
+    return true;
 }
-// [修改后的签名]
-void SceneViewPanel::onImGuiRender(Scene* scene, Renderer* renderer, GameObject*& selectedObject, float contentScale)
+
+void SceneViewPanel::onImGuiRender(float contentScale)
 {
+    _isVisible = false;
     if (!_isOpen) return;
 
     ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0.0f, 0.0f)); 
@@ -72,27 +107,13 @@ void SceneViewPanel::onImGuiRender(Scene* scene, Renderer* renderer, GameObject*
     if (viewportPanelSize.x <= 0) viewportPanelSize.x = 1;
     if (viewportPanelSize.y <= 0) viewportPanelSize.y = 1;
 
-    int rawWidth = (int)(viewportPanelSize.x * contentScale);
-    int rawHeight = (int)(viewportPanelSize.y * contentScale);
+    // 2. 记录渲染目标大小，FBO 在帧边界上调整 (prepareTarget)
+    _targetWidth = std::max(1, (int)(viewportPanelSize.x * contentScale));
+    _targetHeight = std::max(1, (int)(viewportPanelSize.y * contentScale));
+    _contentScale = contentScale;
+    _isVisible = true;
 
-    // 2. Resize FBO
-    if (rawWidth != _fbo.width || rawHeight != _fbo.height)
-    {
-        resizeFBO(rawWidth, rawHeight);
-        renderer->onResize(rawWidth, rawHeight);
-        _cameraController->onResize(rawWidth, rawHeight);
-    }
-
-    // 3. 执行渲染 (Render to FBO)
-    // 注意：这里我们直接调用 renderer，不再需要 SceneRoaming 中转
-    if (_fbo.id != 0) {
-        renderer->render(*scene, 
-                         _cameraController->getActiveCamera(), 
-                         _fbo.id, rawWidth, rawHeight, 
-                         contentScale, selectedObject);
-    }
-
-    // 4. 绘制 Image
+    // 3. 绘制 Image (这一帧的场景由渲染线程在绘制 UI 之前画进 FBO)
     ImGui::Image((ImTextureID)(intptr_t)_fbo.texture, viewportPanelSize, ImVec2(0, 1), ImVec2(1, 0));
 
     // 记录视口位置 (用于射线检测和 Gizmo)
@@ -105,6 +126,35 @@ void SceneViewPanel::onImGuiRender(Scene* scene, Renderer* renderer, GameObject*
         glm::vec2(_viewportSize.x, _viewportSize.y)
     );
 
+    // 6. 渲染统计 (左上角)
+    const RenderFrameStats& stats = _stats;
+    char statsText[320];
+    snprintf(statsText, sizeof(statsText),
+             "Draws: %d | Tris: %zu | LOD draws: %d | Size culled: %d | Clusters: %d/%d | Tex binds: %d | Tex fetches/px: %d | Packed ORM: %d",
+             stats.drawCalls, stats.triangles, stats.lodDraws, stats.lodCulledObjects,
+             stats.clustersDrawn, stats.clustersDrawn + stats.clustersCulled,
+             stats.materialTextureBinds, stats.materialTextureFetches, stats.packedOrmDraws);
+    ImGui::GetWindowDrawList()->AddText(ImVec2(_viewportPos.x + 8.0f, _viewportPos.y + 8.0f),
+                                        IM_COL32(220, 220, 220, 200), statsText);
+
+    // 帧耗时 (当前模式；两种模式的对比见 Render 菜单)
+    bool threaded = RenderThread::Get().isRunning();
+    RenderThreadTimings timings = RenderThread::Get().getTimings(threaded);
+    snprintf(statsText, sizeof(statsText),
+             "%s | %.1f FPS | Latency: %.1f ms | UI: %.1f ms | Render: %.1f ms | Sync wait: %.1f ms",
+             threaded ? "Render thread" : "Single thread", timings.fps, timings.latencyMs,
+             timings.uiMs, timings.renderMs, timings.waitMs);
+    ImGui::GetWindowDrawList()->AddText(ImVec2(_viewportPos.x + 8.0f, _viewportPos.y + 8.0f + ImGui::GetTextLineHeightWithSpacing()),
+                                        IM_COL32(220, 220, 220, 200), statsText);
+
+    // 每帧临时内存 (堆分配次数只有调试构建统计，稳定状态下应为 0)
+    int written = snprintf(statsText, sizeof(statsText), "Frame arena: %.1f KB", stats.frameArenaBytes / 1024.0f);
+    if (AllocationTracker::isEnabled() && written > 0) {
+        snprintf(statsText + written, sizeof(statsText) - written, " | Heap allocs/frame: %zu", stats.heapAllocations);
+    }
+    ImGui::GetWindowDrawList()->AddText(ImVec2(_viewportPos.x + 8.0f, _viewportPos.y + 8.0f + 2.0f * ImGui::GetTextLineHeightWithSpacing()),
+                                        stats.heapAllocations > 0 ? IM_COL32(255, 180, 80, 220) : IM_COL32(220, 220, 220, 200), statsText);
+
     ImGui::End();
     ImGui::PopStyleVar();
 }
@@ -203,7 +253,7 @@ void SceneViewPanel::handleMousePick(Scene* scene, GameObject*& selectedObject)
             // --- 以下数学逻辑完全保持不变 ---
 
             // 1. 计算 Model Matrix
-            glm::mat4 modelMatrix = go->transform.getLocalMatrix();
+            glm::mat4 modelMatrix = go->getWorldMatrix();
             modelMatrix = modelMatrix * meshComp->model->transform.getLocalMatrix();
 
             // 2. 将射线转到局部空间
@@ -227,11 +277,9 @@ void SceneViewPanel::handleMousePick(Scene* scene, GameObject*& selectedObject)
                 // ==================================================
                 // Phase 2: 精测 (Narrow Phase) - Mesh
                 // ==================================================
+                // 模型只保留了拾取代理 (或什么都没保留) 时，raycast 会相应地退化
                 float tMesh = 0.0f;
-                const auto& verts = meshComp->model->getVertices();
-                const auto& indices = meshComp->model->getIndices();
-
-                if (PhysicsUtils::intersectRayMesh(localRay, verts, indices, tMesh))
+                if (meshComp->model->raycast(localRay, tMesh))
                 {
                     // [关键] tMesh 是局部空间的距离。
                     // 为了在不同缩放的物体之间正确排序，我们需要把它转换回世界空间距离。
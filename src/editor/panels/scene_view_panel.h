@@ -4,6 +4,7 @@
 #include <glad/gl.h>
 #include "editor/editor_camera.h"
 #include "engine/renderer.h"
+#include "engine/render_snapshot.h"
 #include "engine/scene.h"
 
 class SceneViewPanel : public Panel {
@@ -11,9 +12,12 @@ public:
     SceneViewPanel();
     ~SceneViewPanel();
 
-    // 核心绘制函数
-    // 需要传入 Scene 和 Renderer，因为面板只负责"显示"，不负责"拥有"数据
-    void onImGuiRender(Scene* scene, Renderer* renderer, GameObject*& selectedObject, float contentScale);
+    // 核心绘制函数：记录视口大小并显示 FBO 中的画面 (场景由渲染线程画进 FBO，见 prepareTarget)
+    void onImGuiRender(float contentScale);
+
+    // [帧边界] 按 UI 记录的视口大小调整 FBO，把渲染目标写进快照，并取回上一帧的渲染统计
+    // 视口这一帧不可见时返回 false (不需要渲染场景)
+    bool prepareTarget(Renderer* renderer, RenderSnapshot& snapshot);
 
     // 2. [关键修复] 必须覆盖基类的纯虚函数，否则此类为抽象类
     // 给一个空实现即可，因为我们不会通过 Panel* 多态指针来调用这个函数
@@ -38,6 +42,15 @@ private:
         int height = 0;
     } _fbo;
 
+    // UI 这一帧需要的渲染目标大小 (像素)
+    int _targetWidth = 0;
+    int _targetHeight = 0;
+    float _contentScale = 1.0f;
+    bool _isVisible = false;
+
+    // 帧边界上从渲染器拷贝的统计 (渲染线程随时在改写渲染器里的那份)
+    RenderFrameStats _stats;
+
     // 视口状态
     ImVec2 _viewportPos = {0, 0};
     ImVec2 _viewportSize = {0, 0};
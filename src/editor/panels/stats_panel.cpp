@@ -0,0 +1,192 @@
+#include "stats_panel.h"
+#include <imgui.h>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+// 三角形等大数按 K / M 显示
+void formatCount(char* buffer, size_t size, uint64_t value)
+{
+    if (value >= 10000000) snprintf(buffer, size, "%.1fM", value / 1e6);
+    else if (value >= 10000) snprintf(buffer, size, "%.1fK", value / 1e3);
+    else snprintf(buffer, size, "%llu", static_cast<unsigned long long>(value));
+}
+
+void countCell(uint64_t value)
+{
+    char text[32];
+    formatCount(text, sizeof(text), value);
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(text);
+}
+
+float maxOf(const float* values, int count)
+{
+    float result = 0.0f;
+    for (int i = 0; i < count; ++i) result = std::max(result, values[i]);
+    return result;
+}
+
+} // namespace
+
+StatsPanel::StatsPanel() : Panel("Render Stats") {}
+
+void StatsPanel::update(const RenderFrameStats& stats)
+{
+    _stats = stats;
+    _hasStats = true;
+
+    int slot = (_historyOffset + _historyCount) % kHistorySize;
+    if (_historyCount == kHistorySize) _historyOffset = (_historyOffset + 1) % kHistorySize;
+    else _historyCount++;
+    _drawCallHistory[slot] = static_cast<float>(stats.gl.drawCalls);
+    _triangleHistory[slot] = static_cast<float>(stats.gl.triangles / 1000.0);
+}
+
+void StatsPanel::onImGuiRender(const FrameRateIndicator& frameTimes)
+{
+    if (!_isOpen) return;
+
+    if (!ImGui::Begin(_title.c_str(), &_isOpen)) {
+        ImGui::End();
+        return;
+    }
+
+    // =========================================================
+    // 1. 帧耗时 (分位数 + 曲线)
+    // =========================================================
+    drawFrameTimes(frameTimes);
+
+    if (!_hasStats) {
+        ImGui::TextDisabled("No frames rendered yet.");
+        ImGui::End();
+        return;
+    }
+
+    // =========================================================
+    // 2. 计数曲线
+    // =========================================================
+    drawCounterGraphs();
+
+    // =========================================================
+    // 3. 各 pass 的 GL 调用
+    // =========================================================
+    if (ImGui::CollapsingHeader("Passes", ImGuiTreeNodeFlags_DefaultOpen)) drawPassTable();
+
+    // =========================================================
+    // 4. 各视图的剔除、阴影投射者与反射重绘
+    // =========================================================
+    if (ImGui::CollapsingHeader("Views", ImGuiTreeNodeFlags_DefaultOpen)) drawViews();
+
+    ImGui::End();
+}
+
+void StatsPanel::drawFrameTimes(const FrameRateIndicator& frameTimes)
+{
+    FrameTimeStats stats = frameTimes.computeStats();
+    if (stats.count == 0) {
+        ImGui::TextDisabled("No frame times yet.");
+        return;
+    }
+
+    ImGui::Text("%.1f FPS | avg %.2f ms", stats.getAverageFrameRate(), stats.averageMs);
+    ImGui::Text("p50 %.2f | p95 %.2f | p99 %.2f | max %.2f ms", stats.p50Ms, stats.p95Ms, stats.p99Ms, stats.maxMs);
+
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "last %d frames (ms)", stats.count);
+    float scaleMax = std::max(stats.p99Ms * 1.5f, 1.0f);
+    ImGui::PlotLines("##FrameTimes", frameTimes.getDataPtr(), frameTimes.getSize(), frameTimes.getOffset(),
+                     overlay, 0.0f, scaleMax, ImVec2(-1.0f, 60.0f));
+}
+
+void StatsPanel::drawCounterGraphs()
+{
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "draw calls: %llu", static_cast<unsigned long long>(_stats.gl.drawCalls));
+    ImGui::PlotLines("##DrawCalls", _drawCallHistory, _historyCount, _historyOffset, overlay,
+                     0.0f, std::max(maxOf(_drawCallHistory, _historyCount) * 1.1f, 1.0f), ImVec2(-1.0f, 40.0f));
+
+    char triangles[32];
+    formatCount(triangles, sizeof(triangles), _stats.gl.triangles);
+    snprintf(overlay, sizeof(overlay), "triangles: %s", triangles);
+    ImGui::PlotLines("##Triangles", _triangleHistory, _historyCount, _historyOffset, overlay,
+                     0.0f, std::max(maxOf(_triangleHistory, _historyCount) * 1.1f, 1.0f), ImVec2(-1.0f, 40.0f));
+}
+
+void StatsPanel::drawPassTable()
+{
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit |
+                            ImGuiTableFlags_ScrollX;
+    if (!ImGui::BeginTable("##PassCounters", 10, flags)) return;
+
+    ImGui::TableSetupColumn("Pass");
+    ImGui::TableSetupColumn("Draws");
+    ImGui::TableSetupColumn("Tris");
+    ImGui::TableSetupColumn("Inst");
+    ImGui::TableSetupColumn("Prog");
+    ImGui::TableSetupColumn("Tex");
+    ImGui::TableSetupColumn("VAO");
+    ImGui::TableSetupColumn("Uniforms");
+    ImGui::TableSetupColumn("Visible");
+    ImGui::TableSetupColumn("Culled");
+    ImGui::TableHeadersRow();
+
+    RenderPassStats total;
+    total.gl = _stats.gl;
+    for (int i = 0; i < kRenderPassCount; ++i) {
+        const RenderPassStats& pass = _stats.passes[i];
+        total.objectsVisible += pass.objectsVisible;
+        total.objectsCulled += pass.objectsCulled;
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(getRenderPassName(static_cast<RenderPass>(i)));
+        countCell(pass.gl.drawCalls);
+        countCell(pass.gl.triangles);
+        countCell(pass.gl.instances);
+        countCell(pass.gl.programBinds);
+        countCell(pass.gl.textureBinds);
+        countCell(pass.gl.vaoBinds);
+        countCell(pass.gl.uniformUploads);
+        countCell(pass.objectsVisible);
+        countCell(pass.objectsCulled);
+    }
+
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted("Total");
+    countCell(total.gl.drawCalls);
+    countCell(total.gl.triangles);
+    countCell(total.gl.instances);
+    countCell(total.gl.programBinds);
+    countCell(total.gl.textureBinds);
+    countCell(total.gl.vaoBinds);
+    countCell(total.gl.uniformUploads);
+    countCell(total.objectsVisible);
+    countCell(total.objectsCulled);
+
+    ImGui::EndTable();
+}
+
+void StatsPanel::drawViews()
+{
+    ImGui::Text("Main view:   %d visible, %d culled", _stats.mainView.visible, _stats.mainView.culled);
+    ImGui::Text("Mirrors:     %d visible, %d culled (%d re-rendered)",
+                _stats.mirrorViews.visible, _stats.mirrorViews.culled, _stats.mirrorRenders);
+    ImGui::Text("Probe faces: %d visible, %d culled (%d probes, %d faces re-rendered)",
+                _stats.probeViews.visible, _stats.probeViews.culled, _stats.probeRenders, _stats.probeFaceRenders);
+
+    if (_stats.shadowCascadeCount > 0) {
+        ImGui::TextUnformatted("Shadow casters per cascade:");
+        for (int i = 0; i < _stats.shadowCascadeCount; ++i) {
+            ImGui::SameLine();
+            ImGui::Text("%d", _stats.shadowCasters[i]);
+        }
+    }
+
+    ImGui::Text("Clusters: %d drawn, %d culled | Size culled: %d | LOD draws: %d",
+                _stats.clustersDrawn, _stats.clustersCulled, _stats.lodCulledObjects, _stats.lodDraws);
+    ImGui::Text("Frame arena: %.1f KB | Render heap allocations: %zu",
+                _stats.frameArenaBytes / 1024.0, _stats.heapAllocations);
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "panel.h"
+#include "base/frame_rate_indicator.h"
+#include "engine/renderer.h"
+
+// 渲染统计面板：帧耗时分位数与曲线，各 pass 的 draw / 三角形 / 绑定 / uniform 计数，各视图的剔除结果
+class StatsPanel : public Panel {
+public:
+    StatsPanel();
+
+    // [帧边界] 取最近一帧的渲染统计 (此时渲染线程没有在写)
+    void update(const RenderFrameStats& stats);
+
+    void onImGuiRender(const FrameRateIndicator& frameTimes);
+
+    // 基类接口 (需要帧耗时，使用上面的重载)
+    void onImGuiRender() override {}
+
+private:
+    static constexpr int kHistorySize = 240;
+
+    RenderFrameStats _stats;
+    bool _hasStats = false;
+
+    // 计数曲线 (环形缓冲区，_historyOffset 处为最旧的一帧)
+    float _drawCallHistory[kHistorySize] = {};
+    float _triangleHistory[kHistorySize] = {}; // 千个三角形
+    int _historyCount = 0;
+    int _historyOffset = 0;
+
+    void drawFrameTimes(const FrameRateIndicator& frameTimes);
+    void drawCounterGraphs();
+    void drawPassTable();
+    void drawViews();
+};
@@ -21,11 +21,54 @@ struct HDRData {
 // 2. 模型相关数据
 // ==========================================
 
+// 一级简化后的 LOD：索引位于 MeshLodChain::indices 的 [indexOffset, indexOffset + indexCount)
+struct MeshLod {
+    uint32_t indexOffset = 0;
+    uint32_t indexCount = 0;
+    float error = 0.0f; // 相对 LOD 0 的几何误差 (模型局部空间的距离)
+};
+
+// LOD 链 (不含 LOD 0，即原始索引)，所有级别共用同一份顶点
+struct MeshLodChain {
+    std::vector<uint32_t> indices;
+    std::vector<MeshLod> levels;
+
+    bool empty() const { return levels.empty(); }
+};
+
+// 网格簇 (meshlet)：某一级 LOD 中连续的一段三角形，带包围球与法线锥，用于逐簇剔除
+struct MeshCluster {
+    uint32_t indexOffset = 0;   // 相对所在级别索引的起始位置
+    uint32_t indexCount = 0;
+    glm::vec3 center{ 0.0f };   // 包围球 (模型局部空间)
+    float radius = 0.0f;
+    glm::vec3 coneAxis{ 0.0f }; // 法线锥：所有三角形的法线都在以 coneAxis 为轴的圆锥内
+    float coneCutoff = 1.0f;    // sin(锥的半角)；1 表示法线过于分散，不做背面剔除
+};
+
+// 各级 LOD 的簇：第 l 级 (0 为原始网格) 的簇为 clusters[levelOffsets[l], levelOffsets[l + 1])
+// 三角形太少的级别不划分，区间为空
+struct MeshClusterSet {
+    std::vector<MeshCluster> clusters;
+    std::vector<uint32_t> levelOffsets;
+
+    bool empty() const { return clusters.empty(); }
+};
+
 // 单个网格的原始数据 (Loader -> ResourceManager)
 struct MeshData {
     std::vector<Vertex> vertices;
     std::vector<uint32_t> indices;
     bool hasUVs = false;
+    MeshLodChain lods;
+    MeshClusterSet clusters;
+};
+
+// 导入场景中的一个层级节点 (glTF node)，id 在同一文件内唯一
+struct SceneNodeData {
+    int id = -1;
+    std::string name;
+    glm::mat4 localTransform = glm::mat4(1.0f); // 相对父节点
 };
 
 // 场景中的子网格定义 (含名称)
@@ -34,4 +77,9 @@ struct SubMesh {
     std::vector<Vertex> vertices;
     std::vector<uint32_t> indices;
     bool hasUVs = false;
+    MeshLodChain lods;
+    MeshClusterSet clusters;
+
+    // 从根到所属节点的节点链 (同一节点的多个 primitive 共用)；OBJ 没有节点层级，为空
+    std::vector<SceneNodeData> nodePath;
 };
\ No newline at end of file
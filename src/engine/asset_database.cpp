@@ -0,0 +1,452 @@
+#include "asset_database.h"
+#include "engine/texture_cooker.h"
+#include "engine/utils/asset_key.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char kMagic[4] = { 'Y', 'A', 'D', 'B' };
+constexpr uint32_t kVersion = 1;
+
+// 在线程池中并行执行 fn(0..count-1)，阻塞直到全部完成
+template <typename Fn>
+void parallelFor(ThreadPool& workers, size_t count, Fn fn)
+{
+    if (count == 0) return;
+    if (count == 1) { fn(0); return; }
+
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t remaining = count;
+
+    for (size_t i = 0; i < count; ++i) {
+        workers.enqueue([&, i]() {
+            fn(i);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--remaining == 0) done.notify_one();
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&]() { return remaining == 0; });
+}
+
+std::string parentDir(const std::string& path)
+{
+    size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? "" : path.substr(0, slash + 1);
+}
+
+// 文件名与面板标签只依赖路径，加载索引时直接重建
+void fillDisplayFields(AssetRecord& record)
+{
+    size_t slash = record.path.find_last_of('/');
+    record.filename = (slash == std::string::npos) ? record.path : record.path.substr(slash + 1);
+
+    // 文件名截断显示 (防止太长破坏布局)
+    record.label = record.filename;
+    if (record.label.length() > 12) record.label = record.label.substr(0, 9) + "...";
+}
+
+template <typename T>
+void writePod(std::ofstream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readPod(std::ifstream& in, T& value)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+void writeString(std::ofstream& out, const std::string& s)
+{
+    writePod(out, static_cast<uint32_t>(s.size()));
+    out.write(s.data(), s.size());
+}
+
+bool readString(std::ifstream& in, std::string& s)
+{
+    uint32_t len = 0;
+    if (!readPod(in, len) || len > 4096) return false;
+    s.resize(len);
+    return static_cast<bool>(in.read(&s[0], len));
+}
+
+} // namespace
+
+// ==========================================
+// 打开 / 关闭
+// ==========================================
+
+void AssetDatabase::open(const std::string& rootDir, ThreadPool& workers)
+{
+    close();
+    _root = rootDir;
+    if (_root.empty()) return;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if (load()) {
+        size_t before = _records.size();
+        refresh(workers);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        std::cout << "[AssetDatabase] Loaded index: " << _records.size() << " assets (" << before << " cached), "
+                  << _dirMtimes.size() << " dirs in " << ms << " ms" << std::endl;
+    }
+    else {
+        // 首次打开：并行全量扫描
+        scanTrees({ "" }, workers);
+        _dirty = true;
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        std::cout << "[AssetDatabase] Initial scan: " << _records.size() << " assets, "
+                  << _dirMtimes.size() << " dirs in " << ms << " ms" << std::endl;
+    }
+
+    saveIfDirty(true);
+}
+
+void AssetDatabase::close()
+{
+    saveIfDirty(true);
+    _records.clear();
+    _dirMtimes.clear();
+    _root.clear();
+    _dirty = false;
+}
+
+void AssetDatabase::refresh(ThreadPool& workers)
+{
+    if (_root.empty()) return;
+
+    // 1. 并行检查所有已知目录的修改时间 (目录内有增删/重命名时会变化)
+    std::vector<std::string> dirs;
+    dirs.reserve(_dirMtimes.size());
+    for (const auto& kv : _dirMtimes) dirs.push_back(kv.first);
+
+    std::vector<int64_t> mtimes(dirs.size(), 0);
+    std::vector<char> exists(dirs.size(), 0);
+    const size_t chunk = 256;
+    parallelFor(workers, (dirs.size() + chunk - 1) / chunk, [&](size_t c) {
+        for (size_t i = c * chunk; i < std::min(dirs.size(), (c + 1) * chunk); ++i) {
+            std::error_code ec;
+            auto t = fs::last_write_time(_root + dirs[i], ec);
+            if (!ec && fs::is_directory(_root + dirs[i], ec)) {
+                exists[i] = 1;
+                mtimes[i] = static_cast<int64_t>(t.time_since_epoch().count());
+            }
+        }
+    });
+
+    std::vector<std::string> changed;
+    for (size_t i = 0; i < dirs.size(); ++i) {
+        auto it = _dirMtimes.find(dirs[i]);
+        if (it == _dirMtimes.end()) continue;   // 父目录已被移除
+        if (!exists[i]) removeTree(dirs[i]);
+        else if (mtimes[i] != it->second) changed.push_back(dirs[i]);
+    }
+
+    // 2. 只重新扫描变化过的目录 (新出现的子目录会被递归扫描)
+    if (!changed.empty()) {
+        scanTrees(changed, workers);
+        _dirty = true;
+    }
+}
+
+// ==========================================
+// 增量更新
+// ==========================================
+
+void AssetDatabase::applyChange(const AssetWatcher::Change& change, ThreadPool& workers)
+{
+    if (_root.empty() || change.path.empty()) return;
+
+    // 目录：整棵子树扫描或移除
+    if (change.path.back() == '/') {
+        if (change.kind == AssetWatcher::ChangeKind::Removed) removeTree(change.path);
+        else scanTrees({ change.path }, workers);
+        _dirty = true;
+        return;
+    }
+
+    // 记录父目录最新的修改时间，下次打开项目时不必重新扫描它
+    std::string dir = parentDir(change.path);
+    std::error_code ec;
+    auto dirTime = fs::last_write_time(_root + dir, ec);
+    if (!ec && _dirMtimes.count(dir)) {
+        _dirMtimes[dir] = static_cast<int64_t>(dirTime.time_since_epoch().count());
+        _dirty = true;
+    }
+
+    AssetType type;
+    if (!classify(change.path, type)) return;
+
+    auto it = std::lower_bound(_records.begin(), _records.end(), change.path,
+        [](const AssetRecord& r, const std::string& p) { return r.path < p; });
+    bool found = (it != _records.end() && it->path == change.path);
+
+    fs::path full = _root + change.path;
+    bool present = change.kind != AssetWatcher::ChangeKind::Removed && fs::is_regular_file(full, ec);
+
+    if (!present) {
+        if (found) _records.erase(it);
+        _dirty = true;
+        return;
+    }
+
+    AssetRecord record;
+    record.path = change.path;
+    record.type = type;
+    record.mtime = static_cast<int64_t>(fs::last_write_time(full, ec).time_since_epoch().count());
+    record.size = static_cast<uint64_t>(fs::file_size(full, ec));
+    makeRecord(record);
+
+    if (found) *it = std::move(record);
+    else _records.insert(it, std::move(record));
+    _dirty = true;
+}
+
+const AssetRecord* AssetDatabase::find(const std::string& path) const
+{
+    auto it = std::lower_bound(_records.begin(), _records.end(), path,
+        [](const AssetRecord& r, const std::string& p) { return r.path < p; });
+    return (it != _records.end() && it->path == path) ? &*it : nullptr;
+}
+
+bool AssetDatabase::classify(const std::string& filename, AssetType& type)
+{
+    size_t dot = filename.find_last_of('.');
+    if (dot == std::string::npos) return false;
+
+    std::string ext = filename.substr(dot);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+    if (ext == ".obj") {
+        type = AssetType::Model;
+        return true;
+    }
+    if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp" || ext == ".tga" || ext == ".hdr") {
+        type = AssetType::Texture;
+        return true;
+    }
+    return false;
+}
+
+// ==========================================
+// 扫描
+// ==========================================
+
+AssetDatabase::DirScan AssetDatabase::scanOne(const std::string& relativeDir) const
+{
+    DirScan scan;
+    scan.dir = relativeDir;
+
+    std::error_code ec;
+    std::string dir = _root + relativeDir;
+    auto dirTime = fs::last_write_time(dir, ec);
+    if (ec || !fs::is_directory(dir, ec)) return scan;
+
+    scan.exists = true;
+    scan.mtime = static_cast<int64_t>(dirTime.time_since_epoch().count());
+
+    for (const auto& entry : fs::directory_iterator(dir, ec))
+    {
+        std::string name = entry.path().filename().string();
+        if (name.empty() || name[0] == '.') continue;   // .cache / .git 等
+
+        if (entry.is_directory(ec)) {
+            scan.subdirs.push_back(relativeDir + name + "/");
+            continue;
+        }
+
+        AssetType type;
+        if (!entry.is_regular_file(ec) || !classify(name, type)) continue;
+
+        AssetRecord record;
+        record.path = relativeDir + name;
+        record.type = type;
+        record.mtime = static_cast<int64_t>(entry.last_write_time(ec).time_since_epoch().count());
+        record.size = static_cast<uint64_t>(entry.file_size(ec));
+        makeRecord(record);
+        scan.files.push_back(std::move(record));
+    }
+    return scan;
+}
+
+void AssetDatabase::scanTrees(std::vector<std::string> frontier, ThreadPool& workers)
+{
+    // 逐层推进：同一层的目录互不依赖，可以并行扫描
+    while (!frontier.empty())
+    {
+        std::vector<DirScan> results(frontier.size());
+        parallelFor(workers, frontier.size(), [&](size_t i) { results[i] = scanOne(frontier[i]); });
+
+        // 已经在索引中的目录：先一次性移除它们 (不含子目录) 的旧记录
+        std::unordered_set<std::string> rescanned;
+        for (const auto& scan : results) {
+            if (scan.exists && _dirMtimes.count(scan.dir)) rescanned.insert(scan.dir);
+        }
+        if (!rescanned.empty()) {
+            _records.erase(std::remove_if(_records.begin(), _records.end(), [&](const AssetRecord& r) {
+                return rescanned.count(parentDir(r.path)) > 0;
+            }), _records.end());
+        }
+
+        std::vector<std::string> next;
+        for (auto& scan : results)
+        {
+            if (!scan.exists) {
+                removeTree(scan.dir);
+                continue;
+            }
+
+            _dirMtimes[scan.dir] = scan.mtime;
+            for (auto& file : scan.files) _records.push_back(std::move(file));
+
+            for (auto& sub : scan.subdirs) {
+                // 已知的子目录由 refresh 自己检查修改时间，这里只展开新目录
+                if (!_dirMtimes.count(sub)) next.push_back(sub);
+            }
+        }
+        frontier.swap(next);
+    }
+    sortRecords();
+}
+
+void AssetDatabase::removeTree(const std::string& relativeDir)
+{
+    auto underDir = [&](const std::string& path) {
+        return path.compare(0, relativeDir.size(), relativeDir) == 0;
+    };
+
+    _records.erase(std::remove_if(_records.begin(), _records.end(),
+        [&](const AssetRecord& r) { return underDir(r.path); }), _records.end());
+
+    for (auto it = _dirMtimes.begin(); it != _dirMtimes.end();) {
+        if (underDir(it->first)) it = _dirMtimes.erase(it);
+        else ++it;
+    }
+    _dirty = true;
+}
+
+void AssetDatabase::makeRecord(AssetRecord& record) const
+{
+    fillDisplayFields(record);
+
+    AssetSignature signature;
+    signature.lastWriteTime = fs::file_time_type(fs::file_time_type::duration(record.mtime));
+    signature.fileSize = record.size;
+    signature.isValid = true;
+    record.cookedKey = TextureCooker::sourceHash(record.path, { signature });
+    record.thumbnailKey = AssetKey::make(record.path).with("thumbnail").with(std::to_string(record.cookedKey)).hash;
+}
+
+void AssetDatabase::sortRecords()
+{
+    std::sort(_records.begin(), _records.end(),
+        [](const AssetRecord& a, const AssetRecord& b) { return a.path < b.path; });
+}
+
+// ==========================================
+// 持久化
+// ==========================================
+
+std::string AssetDatabase::getDbPath() const
+{
+    return _root + ".cache/asset_db.bin";
+}
+
+void AssetDatabase::saveIfDirty(bool force)
+{
+    if (!_dirty || _root.empty()) return;
+
+    auto now = std::chrono::steady_clock::now();
+    if (!force && now - _lastSave < std::chrono::seconds(2)) return;
+
+    if (save()) {
+        _dirty = false;
+        _lastSave = now;
+    }
+}
+
+bool AssetDatabase::load()
+{
+    std::ifstream in(getDbPath(), std::ios::binary);
+    if (!in) return false;
+
+    char magic[4];
+    uint32_t version = 0, dirCount = 0, recordCount = 0;
+    if (!in.read(magic, 4) || std::memcmp(magic, kMagic, 4) != 0) return false;
+    if (!readPod(in, version) || version != kVersion) return false;
+
+    if (!readPod(in, dirCount)) return false;
+    for (uint32_t i = 0; i < dirCount; ++i) {
+        std::string dir;
+        int64_t mtime = 0;
+        if (!readString(in, dir) || !readPod(in, mtime)) { _dirMtimes.clear(); return false; }
+        _dirMtimes[dir] = mtime;
+    }
+
+    if (!readPod(in, recordCount)) { _dirMtimes.clear(); return false; }
+    _records.resize(recordCount);
+    for (auto& record : _records) {
+        uint8_t type = 0;
+        if (!readString(in, record.path) || !readPod(in, type) || !readPod(in, record.mtime) ||
+            !readPod(in, record.size) || !readPod(in, record.cookedKey) || !readPod(in, record.thumbnailKey)) {
+            _records.clear();
+            _dirMtimes.clear();
+            return false;
+        }
+        record.type = static_cast<AssetType>(type);
+        fillDisplayFields(record);   // 只重建字符串字段，不访问文件系统
+    }
+    return true;
+}
+
+bool AssetDatabase::save() const
+{
+    std::error_code ec;
+    fs::create_directories(_root + ".cache", ec);
+
+    // 先写临时文件再重命名，避免崩溃时留下半个索引
+    std::string path = getDbPath();
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+
+        out.write(kMagic, 4);
+        writePod(out, kVersion);
+
+        writePod(out, static_cast<uint32_t>(_dirMtimes.size()));
+        for (const auto& kv : _dirMtimes) {
+            writeString(out, kv.first);
+            writePod(out, kv.second);
+        }
+
+        writePod(out, static_cast<uint32_t>(_records.size()));
+        for (const auto& record : _records) {
+            writeString(out, record.path);
+            writePod(out, static_cast<uint8_t>(record.type));
+            writePod(out, record.mtime);
+            writePod(out, record.size);
+            writePod(out, record.cookedKey);
+            writePod(out, record.thumbnailKey);
+        }
+        if (!out) return false;
+    }
+
+    fs::rename(tmpPath, path, ec);
+    return !ec;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/utils/asset_watcher.h"
+#include "engine/utils/thread_pool.h"
+
+enum class AssetType : uint8_t
+{
+    Model,
+    Texture
+};
+
+// 资源索引中的一条记录
+// 面板绘制需要的字段 (文件名、类型、截断后的标签) 都在入库时算好，绘制时不再做字符串处理
+struct AssetRecord
+{
+    std::string path;           // 相对项目根目录，'/' 分隔
+    std::string filename;
+    std::string label;          // 面板中显示的 (可能被截断的) 文件名
+    AssetType type = AssetType::Texture;
+
+    // 源文件签名
+    int64_t mtime = 0;
+    uint64_t size = 0;
+
+    uint64_t cookedKey = 0;     // 源数据指纹 (与 TextureCooker::sourceHash 一致)，烘焙缓存由它派生
+    uint64_t thumbnailKey = 0;  // 缩略图缓存 key
+};
+
+// 持久化的项目资源索引
+// 保存在 <projectRoot>/.cache/asset_db.bin。
+// - 首次打开项目 (没有索引) 时，按目录层级在线程池中并行扫描整棵目录树
+// - 之后打开只检查各目录的修改时间，仅重新扫描有增删的目录
+// - 运行期间由 AssetWatcher 的变化事件增量更新，不再全量遍历
+// 只在主线程访问。
+class AssetDatabase
+{
+public:
+    // 打开项目 (rootDir 以 '/' 结尾)
+    void open(const std::string& rootDir, ThreadPool& workers);
+
+    // 保存并清空
+    void close();
+
+    // 手动刷新：只重新扫描修改时间变化过的目录
+    void refresh(ThreadPool& workers);
+
+    // 应用一条文件变化 (目录变化会扫描/移除整个子树)
+    void applyChange(const AssetWatcher::Change& change, ThreadPool& workers);
+
+    // 有改动时写回磁盘 (带节流，频繁变化时最多每 2 秒写一次)
+    void saveIfDirty(bool force = false);
+
+    // 按 path 排序
+    const std::vector<AssetRecord>& getRecords() const { return _records; }
+    const AssetRecord* find(const std::string& path) const;
+
+    // 按扩展名判断资源类型，不是可识别的资源返回 false
+    static bool classify(const std::string& filename, AssetType& type);
+
+private:
+    std::string _root;
+    std::vector<AssetRecord> _records;
+    std::unordered_map<std::string, int64_t> _dirMtimes;   // 相对目录 ("" 为根目录，其余以 '/' 结尾) -> 修改时间
+
+    bool _dirty = false;
+    std::chrono::steady_clock::time_point _lastSave;
+
+    // 单个目录 (不递归) 的扫描结果
+    struct DirScan
+    {
+        std::string dir;
+        bool exists = false;
+        int64_t mtime = 0;
+        std::vector<AssetRecord> files;
+        std::vector<std::string> subdirs;
+    };
+
+    std::string getDbPath() const;
+    bool load();
+    bool save() const;
+
+    DirScan scanOne(const std::string& relativeDir) const;
+
+    // 从 dirs 开始逐层并行扫描整个子树，结果合并进索引
+    void scanTrees(std::vector<std::string> dirs, ThreadPool& workers);
+
+    // 删除目录及其整个子树的记录
+    void removeTree(const std::string& relativeDir);
+
+    void makeRecord(AssetRecord& record) const;
+    void sortRecords();
+};
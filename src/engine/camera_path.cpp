@@ -0,0 +1,95 @@
+#include "camera_path.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+void CameraPath::addKey(float time, const Transform& transform)
+{
+    CameraKey key;
+    key.time = _keys.empty() ? time : std::max(time, _keys.back().time);
+    key.position = transform.position;
+    key.rotation = transform.rotation;
+    _keys.push_back(key);
+}
+
+void CameraPath::sample(float time, Transform& out) const
+{
+    if (_keys.empty()) return;
+
+    if (time <= _keys.front().time) {
+        out.position = _keys.front().position;
+        out.setRotation(_keys.front().rotation);
+        return;
+    }
+    if (time >= _keys.back().time) {
+        out.position = _keys.back().position;
+        out.setRotation(_keys.back().rotation);
+        return;
+    }
+
+    // 第一个时间大于 time 的关键帧与它的前一个
+    auto next = std::upper_bound(_keys.begin(), _keys.end(), time,
+                                 [](float t, const CameraKey& key) { return t < key.time; });
+    const CameraKey& b = *next;
+    const CameraKey& a = *(next - 1);
+    float span = b.time - a.time;
+    float t = span > 0.0f ? (time - a.time) / span : 0.0f;
+
+    out.position = glm::mix(a.position, b.position, t);
+    out.setRotation(glm::slerp(a.rotation, b.rotation, t));
+}
+
+bool CameraPath::load(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[CameraPath] Failed to open: " << path << std::endl;
+        return false;
+    }
+
+    _keys.clear();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue;
+
+        std::istringstream stream(line);
+        CameraKey key;
+        glm::quat& q = key.rotation;
+        if (!(stream >> key.time >> key.position.x >> key.position.y >> key.position.z >> q.w >> q.x >> q.y >> q.z)) {
+            std::cerr << "[CameraPath] Malformed key at " << path << ":" << lineNumber << std::endl;
+            _keys.clear();
+            return false;
+        }
+        q = glm::normalize(q);
+        if (!_keys.empty()) key.time = std::max(key.time, _keys.back().time);
+        _keys.push_back(key);
+    }
+
+    if (_keys.empty()) {
+        std::cerr << "[CameraPath] No keys in: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool CameraPath::save(const std::string& path) const
+{
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[CameraPath] Failed to write: " << path << std::endl;
+        return false;
+    }
+
+    file << "# time px py pz qw qx qy qz\n";
+    for (const CameraKey& key : _keys) {
+        const glm::quat& q = key.rotation;
+        file << key.time << ' ' << key.position.x << ' ' << key.position.y << ' ' << key.position.z << ' '
+             << q.w << ' ' << q.x << ' ' << q.y << ' ' << q.z << '\n';
+    }
+    return static_cast<bool>(file);
+}
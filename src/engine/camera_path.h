@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "base/transform.h"
+
+// 相机路径上的一个关键帧 (time 为秒)
+struct CameraKey {
+    float time = 0.0f;
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+};
+
+// ==========================================
+// 相机路径 (录制与回放)
+// ==========================================
+// 编辑器中按 F8 录制视口相机 (每帧一个关键帧)，基准测试按时间插值回放。
+// 文件为文本，每行一个关键帧：time px py pz qw qx qy qz，'#' 开头的行为注释。
+class CameraPath
+{
+public:
+    void clear() { _keys.clear(); }
+    bool empty() const { return _keys.empty(); }
+    size_t getKeyCount() const { return _keys.size(); }
+    float getDuration() const { return _keys.empty() ? 0.0f : _keys.back().time; }
+
+    // 追加关键帧 (时间须不小于上一个)
+    void addKey(float time, const Transform& transform);
+
+    // 按时间插值 (位置线性，旋转球面插值)，超出范围时取两端
+    void sample(float time, Transform& out) const;
+
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+private:
+    std::vector<CameraKey> _keys;
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class Component;
+
+// ==========================================
+// 按类型集中存放的组件池
+// ==========================================
+// 同一类组件分块 (每块 kChunkSize 个) 连续分配，释放的槽位放回空闲表复用，
+// 不再是每个组件一次堆分配；另有一份按创建顺序排列的紧凑指针数组，
+// 渲染时按类型直接遍历 (见 Scene::view)，不用扫描每个物体的组件列表。
+// 只在主线程使用。
+template <typename T>
+class ComponentPool
+{
+public:
+    static constexpr size_t kChunkSize = 64;
+
+    static ComponentPool& Get()
+    {
+        static ComponentPool pool;
+        return pool;
+    }
+
+    template <typename... Args>
+    T* create(Args&&... args)
+    {
+        void* memory = allocate();
+        T* comp = new (memory) T(std::forward<Args>(args)...);
+        comp->_poolIndex = _items.size();
+        comp->_release = [](Component* c) { ComponentPool<T>::Get().destroy(static_cast<T*>(c)); };
+        _items.push_back(comp);
+        return comp;
+    }
+
+    void destroy(T* comp)
+    {
+        // 留下空位而不是立即前移，保持创建顺序 (光源等按顺序分配阴影层)；
+        // 空位超过一半时整体压缩一次，批量删除仍是均摊 O(1)
+        _items[comp->_poolIndex] = nullptr;
+        if (++_holes * 2 > _items.size()) compact();
+
+        comp->~T();
+        _freeSlots.push_back(comp);
+    }
+
+    // 所有组件 (按创建顺序，包含还未加入场景的物体上的组件)；已删除的位置为空指针
+    const std::vector<T*>& items() const { return _items; }
+
+    size_t getChunkCount() const { return _chunks.size(); }
+
+private:
+    using Slot = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    ComponentPool() = default;
+    ComponentPool(const ComponentPool&) = delete;
+    ComponentPool& operator=(const ComponentPool&) = delete;
+
+    void* allocate()
+    {
+        if (_freeSlots.empty()) {
+            _chunks.push_back(std::make_unique<Slot[]>(kChunkSize));
+            Slot* chunk = _chunks.back().get();
+            // 倒序放入，先分配块内靠前的槽位
+            for (size_t i = kChunkSize; i > 0; --i) _freeSlots.push_back(&chunk[i - 1]);
+        }
+        void* slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        return slot;
+    }
+
+    void compact()
+    {
+        size_t write = 0;
+        for (T* item : _items) {
+            if (!item) continue;
+            item->_poolIndex = write;
+            _items[write++] = item;
+        }
+        _items.resize(write);
+        _holes = 0;
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> _chunks;
+    std::vector<void*> _freeSlots;
+    std::vector<T*> _items;
+    size_t _holes = 0;
+};
@@ -1,4 +1,7 @@
 #include "geometry_factory.h"
+#include "mesh_simplifier.h"
+#include "mesh_clusters.h"
+#include "engine/utils/job_system.h"
 #include <cmath>
 
 // 辅助函数：添加四边形面 (由两个三角形组成)
@@ -206,7 +209,7 @@ std::shared_ptr<Model> GeometryFactory::createFrustum(float topRadius, float bot
 
     computeTangents(vertices, indices);
 
-    return std::make_unique<Model>(vertices, indices);
+    return makeModel(vertices, indices);
 }
 
 std::shared_ptr<Model> GeometryFactory::createCube(float size)
@@ -254,7 +257,7 @@ std::shared_ptr<Model> GeometryFactory::createCube(float size)
 
     computeTangents(vertices, indices);
 
-    return std::make_unique<Model>(vertices, indices);
+    return makeModel(vertices, indices);
 }
 
 std::shared_ptr<Model> GeometryFactory::createPlane(float width, float depth)
@@ -274,7 +277,7 @@ std::shared_ptr<Model> GeometryFactory::createPlane(float width, float depth)
 
     computeTangents(vertices, indices);
 
-    return std::make_unique<Model>(vertices, indices);
+    return makeModel(vertices, indices);
 }
 
 std::shared_ptr<Model> GeometryFactory::createSphere(float radius, int stacks, int slices, bool useFlatShade)
@@ -327,7 +330,7 @@ std::shared_ptr<Model> GeometryFactory::createSphere(float radius, int stacks, i
 
     computeTangents(vertices, indices);
 
-    return std::make_unique<Model>(vertices, indices);
+    return makeModel(vertices, indices);
 }
 
 std::shared_ptr<Model> GeometryFactory::createCylinder(float radius, float height, int slices, bool useFlatShade)
@@ -354,17 +357,11 @@ std::shared_ptr<Model> GeometryFactory::createPyramidFrustum(float topRadius, fl
 
 void GeometryFactory::computeTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
 {
-    // 1. 初始化所有切线为 0
-    for (auto& v : vertices) {
-        v.tangent = glm::vec4(0.0f);
-    }
-
-    // 2. 遍历所有三角形，累加切线
-    for (size_t i = 0; i < indices.size(); i += 3)
-    {
-        Vertex& v0 = vertices[indices[i]];
-        Vertex& v1 = vertices[indices[i+1]];
-        Vertex& v2 = vertices[indices[i+2]];
+    // 单个三角形的切线 (未归一化，按面积加权)
+    auto triangleTangent = [&](size_t i) {
+        const Vertex& v0 = vertices[indices[i]];
+        const Vertex& v1 = vertices[indices[i+1]];
+        const Vertex& v2 = vertices[indices[i+2]];
 
         glm::vec3 edge1 = v1.position - v0.position;
         glm::vec3 edge2 = v2.position - v0.position;
@@ -378,23 +375,74 @@ void GeometryFactory::computeTangents(std::vector<Vertex>& vertices, const std::
         tangent.x = f * (deltaUV2.y * edge1.x - deltaUV1.y * edge2.x);
         tangent.y = f * (deltaUV2.y * edge1.y - deltaUV1.y * edge2.y);
         tangent.z = f * (deltaUV2.y * edge1.z - deltaUV1.y * edge2.z);
+        return tangent;
+    };
+
+    // 正交化并设置 w
+    auto orthogonalize = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            Vertex& v = vertices[i];
+            glm::vec3 t = glm::vec3(v.tangent);
+            glm::vec3 n = v.normal;
+
+            // Gram-Schmidt 正交化
+            t = glm::normalize(t - n * glm::dot(n, t));
+
+            // 对于工厂生成的标准几何体，没有镜像 UV，手性 w 设为 1.0
+            v.tangent = glm::vec4(t, 1.0f);
+        }
+    };
+
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount < kParallelTangentTriangles)
+    {
+        // 1. 初始化所有切线为 0
+        for (auto& v : vertices) {
+            v.tangent = glm::vec4(0.0f);
+        }
+
+        // 2. 遍历所有三角形，累加切线 (平滑切线)
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            glm::vec4 tangent(triangleTangent(i), 0.0f);
+            vertices[indices[i]].tangent += tangent;
+            vertices[indices[i+1]].tangent += tangent;
+            vertices[indices[i+2]].tangent += tangent;
+        }
 
-        // 累加到三个顶点上 (平滑切线)
-        v0.tangent += glm::vec4(tangent, 0.0f);
-        v1.tangent += glm::vec4(tangent, 0.0f);
-        v2.tangent += glm::vec4(tangent, 0.0f);
+        // 3. 正交化
+        orthogonalize(0, vertices.size());
+        return;
     }
 
-    // 3. 正交化并设置 w
-    for (auto& v : vertices)
+    // 大网格：三角形切线与正交化并行；累加会写同一个顶点，仍按三角形顺序串行 (保证结果与串行一致)
+    JobSystem& jobs = JobSystem::Get();
+    std::vector<glm::vec3> triangleTangents(triangleCount);
+    jobs.parallelFor(0, triangleCount, 8192, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) triangleTangents[t] = triangleTangent(t * 3);
+    });
+
+    for (auto& v : vertices) {
+        v.tangent = glm::vec4(0.0f);
+    }
+    for (size_t t = 0; t < triangleCount; ++t)
     {
-        glm::vec3 t = glm::vec3(v.tangent);
-        glm::vec3 n = v.normal;
-        
-        // Gram-Schmidt 正交化
-        t = glm::normalize(t - n * glm::dot(n, t));
-        
-        // 对于工厂生成的标准几何体，没有镜像 UV，手性 w 设为 1.0
-        v.tangent = glm::vec4(t, 1.0f);
+        glm::vec4 tangent(triangleTangents[t], 0.0f);
+        vertices[indices[t * 3]].tangent += tangent;
+        vertices[indices[t * 3 + 1]].tangent += tangent;
+        vertices[indices[t * 3 + 2]].tangent += tangent;
     }
-}
\ No newline at end of file
+
+    jobs.parallelFor(0, vertices.size(), 16384, orthogonalize);
+}
+
+std::shared_ptr<Model> GeometryFactory::makeModel(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+    MeshLodChain lods = MeshSimplifier::buildLodChain(vertices, indices);
+    MeshClusterSet clusters = MeshClusters::buildForMesh(vertices, indices, lods);
+    auto model = std::make_shared<Model>(std::move(vertices), std::move(indices));
+    model->setLods(std::move(lods));
+    model->setClusters(std::move(clusters));
+    return model;
+}
@@ -41,8 +41,13 @@ public:
     static std::shared_ptr<Model> createPyramidFrustum(float topRadius, float bottomRadius, float height, int sides = 4, bool useFlatShade = false);
 
     // 通用切线计算函数 (修改 vertices 数组的内容)
+    // 三角形数达到 kParallelTangentTriangles 时用 JobSystem 并行，结果与串行完全一致
+    static constexpr size_t kParallelTangentTriangles = 32768;
     static void computeTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
     
 private:
+    // 生成 LOD 链后创建 Model (三角形太少或全是硬边时没有 LOD)
+    static std::shared_ptr<Model> makeModel(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
     static void convertToFlat(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
 };
\ No newline at end of file
@@ -1,20 +1,26 @@
 #include "gltf_loader.h"
 #include "geometry_factory.h"
+#include "mesh_optimizer.h"
+#include "mesh_simplifier.h"
+#include "mesh_clusters.h"
+#include "utils/profiler.h"
 #include <iostream>
 #include <filesystem>
 
 // 定义宏以实现 tinygltf
-// 注意：如果你项目中其他地方已经定义了 STB_IMAGE_IMPLEMENTATION，
-// 可能需要在这里定义 TINYGLTF_NO_STB_IMAGE 并手动包含 stb_image.h
+// stb 的实现统一由 external/stb (libstb) 提供，这里不再重复定义 STB_IMAGE_IMPLEMENTATION。
+// 否则 tinygltf 自带的旧版 stb_image.h 会与 libstb 产生重复符号，
+// 并且旧版缺少后台解码线程需要的 stbi_set_flip_vertically_on_load_thread。
 #define TINYGLTF_IMPLEMENTATION
-#define STB_IMAGE_IMPLEMENTATION 
-#define STB_IMAGE_WRITE_IMPLEMENTATION 
-// #define TINYGLTF_NO_STB_IMAGE // 如果发生链接冲突，取消注释此行
-// #define TINYGLTF_NO_STB_IMAGE_WRITE // 我们只读取，不需要写入功能
+#define TINYGLTF_NO_INCLUDE_STB_IMAGE
+#define TINYGLTF_NO_INCLUDE_STB_IMAGE_WRITE
 
+#include <stb_image.h>
+#include <stb_image_write.h>
 #include <tiny_gltf.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/ext.hpp>
 
 // 辅助函数：从 Accessor 和 BufferView 获取数据指针
 // T 是我们期望的数据类型 (如 float, uint16_t 等)
@@ -179,7 +185,40 @@ void processPrimitive(const tinygltf::Model& model, const tinygltf::Primitive& p
 }
 
 // 递归遍历节点
-void processNode(const tinygltf::Model& model, const tinygltf::Node& node, std::vector<SubMesh>& outMeshes) {
+// 节点相对父节点的变换：matrix 优先，否则按 T * R * S 组合
+glm::mat4 getNodeTransform(const tinygltf::Node& node) {
+    if (node.matrix.size() == 16) {
+        glm::mat4 m(1.0f);
+        for (int i = 0; i < 16; ++i) m[i / 4][i % 4] = static_cast<float>(node.matrix[i]); // 列主序
+        return m;
+    }
+
+    glm::mat4 m(1.0f);
+    if (node.translation.size() == 3) {
+        m = glm::translate(m, glm::vec3(node.translation[0], node.translation[1], node.translation[2]));
+    }
+    if (node.rotation.size() == 4) {
+        // glTF 的四元数顺序为 (x, y, z, w)
+        glm::quat q(static_cast<float>(node.rotation[3]), static_cast<float>(node.rotation[0]),
+                    static_cast<float>(node.rotation[1]), static_cast<float>(node.rotation[2]));
+        m = m * glm::mat4_cast(q);
+    }
+    if (node.scale.size() == 3) {
+        m = glm::scale(m, glm::vec3(node.scale[0], node.scale[1], node.scale[2]));
+    }
+    return m;
+}
+
+// path 为从根到当前节点的节点链，每个 primitive 都带上一份，实例化时据此重建层级
+void processNode(const tinygltf::Model& model, int nodeIdx, std::vector<SceneNodeData>& path, std::vector<SubMesh>& outMeshes) {
+    const tinygltf::Node& node = model.nodes[nodeIdx];
+
+    SceneNodeData data;
+    data.id = nodeIdx;
+    data.name = node.name.empty() ? "Node_" + std::to_string(nodeIdx) : node.name;
+    data.localTransform = getNodeTransform(node);
+    path.push_back(data);
+
     // 1. 如果节点包含网格，处理它
     if (node.mesh >= 0) {
         const tinygltf::Mesh& mesh = model.meshes[node.mesh];
@@ -192,17 +231,23 @@ void processNode(const tinygltf::Model& model, const tinygltf::Node& node, std::
             
             subName += "_" + std::to_string(i); // 区分 primitive
 
+            size_t before = outMeshes.size();
             processPrimitive(model, mesh.primitives[i], subName, outMeshes);
+            if (outMeshes.size() > before) outMeshes.back().nodePath = path;
         }
     }
 
     // 2. 递归处理子节点
     for (int childIdx : node.children) {
-        processNode(model, model.nodes[childIdx], outMeshes);
+        processNode(model, childIdx, path, outMeshes);
     }
+
+    path.pop_back();
 }
 
 std::vector<SubMesh> GLTFLoader::loadScene(const std::string& filepath) {
+    AssetLoadScope scope("GLTFLoader::loadScene (" + filepath + ")");
+
     tinygltf::Model model;
     tinygltf::TinyGLTF loader;
     std::string err;
@@ -237,12 +282,25 @@ std::vector<SubMesh> GLTFLoader::loadScene(const std::string& filepath) {
     // 2. 遍历 Scene
     const tinygltf::Scene& scene = model.scenes[model.defaultScene > -1 ? model.defaultScene : 0];
     
-    // 遍历根节点
+    // 遍历根节点 (保留节点层级与变换，由 Scene 实例化时重建父子关系)
+    std::vector<SceneNodeData> path;
     for (int nodeIdx : scene.nodes) {
-        processNode(model, model.nodes[nodeIdx], meshes);
+        processNode(model, nodeIdx, path, meshes);
     }
 
-    std::cout << "[GLTF Loader] Loaded " << meshes.size() << " submeshes from " << filepath << std::endl;
+    // 为 GPU 重排三角形与顶点 (结果随网格缓存保存，之后加载不再重复)
+    MeshOptimizer::Result optimized = MeshOptimizer::optimizeScene(meshes);
+
+    // 在最终的顶点顺序上生成 LOD 链 (LOD 索引引用同一份顶点)
+    MeshSimplifier::buildSceneLods(meshes);
+
+    // 大网格划分成簇用于逐簇剔除 (重排各级 LOD 的索引，须在 LOD 之后)
+    MeshClusters::buildScene(meshes);
+
+    std::cout << "[GLTF Loader] Loaded " << meshes.size() << " submeshes from " << filepath
+              << "\n  Vertex Cache: " << MeshOptimizer::describe(optimized)
+              << "\n  LODs: " << MeshSimplifier::describe(meshes)
+              << "\n  Clusters: " << MeshClusters::describe(meshes) << std::endl;
 
     return meshes;
 }
\ No newline at end of file
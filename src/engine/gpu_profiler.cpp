@@ -0,0 +1,89 @@
+#include "gpu_profiler.h"
+
+#include <algorithm>
+
+GpuProfiler& GpuProfiler::Get()
+{
+    static GpuProfiler profiler;
+    return profiler;
+}
+
+void GpuProfiler::beginFrame()
+{
+    // 一帧结束时不应还有查询在进行 (scope 都是 RAII 的)，保险起见关掉
+    if (_inScope) endScope();
+
+    _current = (_current + 1) % kFrameSlots;
+    FrameSlot& slot = _slots[_current];
+    if (slot.count > 0) resolve(slot);
+
+    Profiler& profiler = Profiler::Get();
+    slot.frameIndex = profiler.getFrameIndex();
+    slot.count = 0;
+    _frameActive = profiler.isEnabled();
+}
+
+bool GpuProfiler::beginScope(const char* name)
+{
+    if (!_frameActive || _inScope) return false;
+
+    FrameSlot& slot = _slots[_current];
+    if (slot.count == slot.scopes.size()) {
+        Scope scope;
+        glGenQueries(1, &scope.query);
+        slot.scopes.push_back(scope);
+    }
+
+    Scope& scope = slot.scopes[slot.count];
+    scope.name = name;
+    scope.submitNs = Profiler::Get().now();
+    glBeginQuery(GL_TIME_ELAPSED, scope.query);
+    _inScope = true;
+    return true;
+}
+
+void GpuProfiler::endScope()
+{
+    if (!_inScope) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    _inScope = false;
+    _slots[_current].count++;
+}
+
+void GpuProfiler::resolve(FrameSlot& slot)
+{
+    // 查询按提交顺序完成，最后一个可用时整组都可用
+    GLuint available = 0;
+    glGetQueryObjectuiv(slot.scopes[slot.count - 1].query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return;
+
+    _resolved.clear();
+    uint64_t cursor = 0;
+    for (size_t i = 0; i < slot.count; ++i) {
+        const Scope& scope = slot.scopes[i];
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(scope.query, GL_QUERY_RESULT, &elapsed);
+
+        ProfileEvent event;
+        event.name = scope.name;
+        event.startNs = std::max(scope.submitNs, cursor);
+        event.endNs = event.startNs + elapsed;
+        event.threadIndex = Profiler::kGpuThread;
+        event.depth = 0;
+        event.category = ProfileCategory::Gpu;
+        _resolved.push_back(event);
+        cursor = event.endNs;
+    }
+    Profiler::Get().submitGpuEvents(slot.frameIndex, _resolved.data(), _resolved.size());
+}
+
+void GpuProfiler::release()
+{
+    if (_inScope) endScope();
+    for (FrameSlot& slot : _slots) {
+        for (const Scope& scope : slot.scopes) glDeleteQueries(1, &scope.query);
+        slot.scopes.clear();
+        slot.count = 0;
+    }
+    _frameActive = false;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <cstdint>
+#include <vector>
+
+#include "engine/utils/profiler.h"
+
+// ==========================================
+// GPU pass 计时 (GL_TIME_ELAPSED 查询)
+// ==========================================
+// 每个 pass 用一个计时查询包起来。查询按帧分成两组轮换：第 N 帧的结果在第 N+2 帧开始时读取，
+// 此时通常早已完成，读取不会让 CPU 等 GPU；仍未完成的一组直接丢弃 (这一帧没有 GPU 数据)。
+// GL_TIME_ELAPSED 不能嵌套，已经有查询在进行时新的 scope 被忽略。
+// 取回的结果交给 Profiler：每个 pass 从它在 CPU 上提交的时刻起、接在上一个 pass 之后排在 GPU 时间线上
+// (只有时长是测量值)。所有函数都只能在持有窗口上下文的线程上调用。
+class GpuProfiler
+{
+public:
+    static GpuProfiler& Get();
+
+    // 一帧的渲染开始：读取两帧前的结果并复用那一组查询
+    void beginFrame();
+
+    // 开始 / 结束一个 pass；begin 返回 false (未启用或已有查询在进行) 时不要调用 end
+    bool beginScope(const char* name);
+    void endScope();
+
+    // 删除所有查询 (窗口上下文销毁之前)
+    void release();
+
+private:
+    GpuProfiler() = default;
+
+    static constexpr int kFrameSlots = 2;
+
+    struct Scope {
+        const char* name = nullptr;
+        GLuint query = 0;
+        uint64_t submitNs = 0; // CPU 上开始这个 pass 的时刻
+    };
+
+    // 一帧使用的查询；scopes 只增不减，count 之后的查询留给以后的帧
+    struct FrameSlot {
+        uint64_t frameIndex = 0;
+        std::vector<Scope> scopes;
+        size_t count = 0;
+    };
+
+    FrameSlot _slots[kFrameSlots];
+    int _current = 0;
+    bool _frameActive = false;
+    bool _inScope = false;
+
+    std::vector<ProfileEvent> _resolved; // 读取结果用的临时数组 (复用)
+
+    void resolve(FrameSlot& slot);
+};
+
+// 记录一个 pass 的 GPU 时间
+class GpuProfileScope
+{
+public:
+    explicit GpuProfileScope(const char* name) : _active(GpuProfiler::Get().beginScope(name)) {}
+    ~GpuProfileScope() { if (_active) GpuProfiler::Get().endScope(); }
+
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+    bool _active;
+};
+
+// 同时记录一个 pass 的 CPU 与 GPU 时间，例如 PassProfileScope pass("Shadow CSM");
+class PassProfileScope
+{
+public:
+    explicit PassProfileScope(const char* name) : _cpu(name), _gpu(name) {}
+
+private:
+    ProfileScope _cpu;
+    GpuProfileScope _gpu;
+};
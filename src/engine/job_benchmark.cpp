@@ -0,0 +1,162 @@
+#include "job_benchmark.h"
+#include "geometry_factory.h"
+#include "mesh_optimizer.h"
+#include "mesh_simplifier.h"
+#include "scene.h"
+#include "base/frustum.h"
+#include "engine/utils/job_system.h"
+#include "engine/utils/profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <glm/ext.hpp>
+
+namespace {
+
+// 规则网格 (带 UV 与法线)，用作切线与子网格后处理的输入
+void makeGrid(int size, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+    vertices.clear();
+    indices.clear();
+    vertices.reserve(static_cast<size_t>(size + 1) * (size + 1));
+    for (int y = 0; y <= size; ++y) {
+        for (int x = 0; x <= size; ++x) {
+            float u = static_cast<float>(x) / size;
+            float v = static_cast<float>(y) / size;
+            glm::vec3 p(u * 10.0f, 0.3f * std::sin(u * 20.0f) * std::cos(v * 20.0f), v * 10.0f);
+            vertices.emplace_back(p, glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(u, v));
+        }
+    }
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            uint32_t i0 = y * (size + 1) + x;
+            uint32_t i1 = i0 + 1;
+            uint32_t i2 = i0 + size + 1;
+            uint32_t i3 = i2 + 1;
+            indices.insert(indices.end(), { i0, i2, i1, i1, i2, i3 });
+        }
+    }
+}
+
+// 多次运行取最短时间 (ms)，prepare 不计时
+double measure(int repeats, const std::function<void()>& prepare, const std::function<void()>& work)
+{
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r) {
+        prepare();
+        auto start = std::chrono::steady_clock::now();
+        work();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+struct Workload {
+    std::string name;
+    std::function<double()> run;
+    double baseline = 0.0;
+};
+
+} // namespace
+
+void JobBenchmark::run()
+{
+    // 没有帧边界收集记录，关掉作用域计时，只测任务系统本身
+    Profiler::Get().setEnabled(false);
+
+    JobSystem& jobs = JobSystem::Get();
+    size_t maxThreads = jobs.getThreadCount() + 1; // 工作线程 + 调用线程
+
+    std::cout << "[JobBenchmark] Hardware threads: " << std::thread::hardware_concurrency()
+              << ", job workers: " << jobs.getThreadCount() << std::endl;
+
+    // 1. 大网格切线 (约 200 万三角形)
+    std::vector<Vertex> gridVertices;
+    std::vector<uint32_t> gridIndices;
+    makeGrid(1024, gridVertices, gridIndices);
+
+    // 2. 视锥剔除：20 万个随机分布的包围盒
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coord(-200.0f, 200.0f);
+    std::vector<glm::mat4> cullMatrices(200000);
+    for (auto& m : cullMatrices) m = glm::translate(glm::mat4(1.0f), glm::vec3(coord(rng), coord(rng) * 0.1f, coord(rng)));
+    BoundingBox unitBox;
+    unitBox.min = glm::vec3(-0.5f);
+    unitBox.max = glm::vec3(0.5f);
+    glm::mat4 viewProj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f) *
+                         glm::lookAt(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Frustum frustum = Frustum::createFromMatrix(viewProj);
+    std::vector<uint8_t> visible(cullMatrices.size());
+
+    // 3. 层级变换：一个根对象下 1000 个分组，每组 200 个子对象
+    Scene scene;
+    GameObject* root = scene.addGameObject(std::make_unique<GameObject>("Root"));
+    for (int g = 0; g < 1000; ++g) {
+        GameObject* group = scene.addGameObject(std::make_unique<GameObject>("Group"));
+        group->transform.position = glm::vec3(static_cast<float>(g), 0.0f, 0.0f);
+        scene.setParent(group, root, false);
+        for (int c = 0; c < 200; ++c) {
+            GameObject* child = scene.addGameObject(std::make_unique<GameObject>("Child"));
+            child->transform.position = glm::vec3(0.0f, static_cast<float>(c), 0.0f);
+            scene.setParent(child, group, false);
+        }
+    }
+    scene.updateWorldTransforms();
+
+    // 4. 子网格后处理：16 个子网格的顶点缓存优化 + LOD 链
+    std::vector<SubMesh> sourceMeshes(16);
+    for (auto& sub : sourceMeshes) makeGrid(64, sub.vertices, sub.indices);
+    std::vector<SubMesh> meshes;
+
+    std::vector<Workload> workloads;
+    workloads.push_back({ "Tangents (2M tris)", [&]() {
+        return measure(3, []() {}, [&]() { GeometryFactory::computeTangents(gridVertices, gridIndices); });
+    } });
+    workloads.push_back({ "Frustum cull (200k)", [&]() {
+        return measure(5, []() {}, [&]() {
+            jobs.parallelFor(0, cullMatrices.size(), 1024, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) visible[i] = frustum.intersect(unitBox, cullMatrices[i]) ? 1 : 0;
+            });
+        });
+    } });
+    workloads.push_back({ "Transforms (200k)", [&]() {
+        return measure(5, [&]() { root->transform.position.y += 1.0f; }, [&]() { scene.updateWorldTransforms(); });
+    } });
+    workloads.push_back({ "Mesh post-process (16)", [&]() {
+        return measure(2, [&]() { meshes = sourceMeshes; }, [&]() {
+            MeshOptimizer::optimizeScene(meshes);
+            MeshSimplifier::buildSceneLods(meshes);
+        });
+    } });
+
+    std::vector<size_t> threadCounts;
+    for (size_t t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    size_t previousActive = jobs.getActiveThreadCount();
+    for (size_t threads : threadCounts)
+    {
+        jobs.setActiveThreadCount(threads - 1);
+        size_t stolenBefore = jobs.getStolenCount();
+
+        std::cout << "[JobBenchmark] " << threads << " thread(s):" << std::endl;
+        for (auto& w : workloads) {
+            double ms = w.run();
+            if (threads == 1) w.baseline = ms;
+            char line[160];
+            snprintf(line, sizeof(line), "    %-24s %9.2f ms  x%.2f", w.name.c_str(), ms, w.baseline / std::max(ms, 1e-6));
+            std::cout << line << std::endl;
+        }
+        std::cout << "    (stolen jobs: " << jobs.getStolenCount() - stolenBefore << ")" << std::endl;
+    }
+    jobs.setActiveThreadCount(previousActive);
+}
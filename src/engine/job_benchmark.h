@@ -0,0 +1,11 @@
+#pragma once
+
+// JobSystem 扩展性测试 (命令行 --job-benchmark 启动，不创建窗口)
+// 用 1, 2, 4 ... 个线程 (含调用线程) 跑引擎中已经并行化的几种负载：
+// 大网格切线生成、主视图视锥剔除、层级世界变换传播、导入时的子网格后处理，
+// 打印每种负载的耗时与相对单线程的加速比
+class JobBenchmark
+{
+public:
+    static void run();
+};
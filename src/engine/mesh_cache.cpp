@@ -0,0 +1,159 @@
+#include "mesh_cache.h"
+#include "engine/utils/content_hash.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+constexpr char kMagic[4] = { 'Y', 'M', 'S', 'H' };
+constexpr uint32_t kVersion = 5;   // 2: 导入时经过 MeshOptimizer 重排，3: 附带 LOD 链，4: 附带网格簇，5: 附带节点层级
+
+// 单个子网格的上限，防止损坏的文件导致巨量分配
+constexpr uint64_t kMaxElements = 1ull << 28;
+
+template <typename T>
+bool readVector(std::ifstream& in, std::vector<T>& out)
+{
+    uint64_t count = 0;
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!in || count > kMaxElements) return false;
+    out.resize(static_cast<size_t>(count));
+    in.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(count * sizeof(T)));
+    return static_cast<bool>(in);
+}
+
+template <typename T>
+void writeVector(std::ofstream& out, const std::vector<T>& values)
+{
+    uint64_t count = values.size();
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+} // namespace
+
+std::string MeshCache::getCachePath(const std::string& projectRoot, const std::string& sourceId,
+                                    const AssetSignature& signature)
+{
+    if (projectRoot.empty() || !signature.isValid) return "";
+
+    ContentHash h;
+    h.update(sourceId.data(), sourceId.size());
+    int64_t mtime = static_cast<int64_t>(signature.lastWriteTime.time_since_epoch().count());
+    uint64_t size = static_cast<uint64_t>(signature.fileSize);
+    h.update(&mtime, sizeof(mtime));
+    h.update(&size, sizeof(size));
+    // 顶点布局变化时旧缓存自然失效
+    uint32_t layout[2] = { kVersion, static_cast<uint32_t>(sizeof(Vertex)) };
+    h.update(layout, sizeof(layout));
+
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.ymesh", static_cast<unsigned long long>(h.digest()));
+    return projectRoot + ".cache/meshes/" + name;
+}
+
+bool MeshCache::loadFromDisk(const std::string& cachePath, std::vector<SubMesh>& out)
+{
+    if (cachePath.empty()) return false;
+
+    std::ifstream in(cachePath, std::ios::binary);
+    if (!in) return false;
+
+    char magic[4];
+    uint32_t version = 0, count = 0;
+    in.read(magic, 4);
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!in || std::memcmp(magic, kMagic, 4) != 0 || version != kVersion || count > 65536) return false;
+
+    std::vector<SubMesh> subMeshes(count);
+    for (auto& sub : subMeshes) {
+        uint32_t nameLength = 0;
+        uint8_t hasUVs = 0;
+        in.read(reinterpret_cast<char*>(&nameLength), sizeof(nameLength));
+        if (!in || nameLength > 4096) return false;
+        sub.name.resize(nameLength);
+        in.read(sub.name.data(), nameLength);
+        in.read(reinterpret_cast<char*>(&hasUVs), sizeof(hasUVs));
+        sub.hasUVs = hasUVs != 0;
+        if (!readVector(in, sub.vertices) || !readVector(in, sub.indices)) return false;
+        if (!readVector(in, sub.lods.indices) || !readVector(in, sub.lods.levels)) return false;
+        if (!readVector(in, sub.clusters.clusters) || !readVector(in, sub.clusters.levelOffsets)) return false;
+
+        uint32_t depth = 0;
+        in.read(reinterpret_cast<char*>(&depth), sizeof(depth));
+        if (!in || depth > 1024) return false;
+        sub.nodePath.resize(depth);
+        for (auto& node : sub.nodePath) {
+            int32_t id = 0;
+            in.read(reinterpret_cast<char*>(&id), sizeof(id));
+            in.read(reinterpret_cast<char*>(&nameLength), sizeof(nameLength));
+            if (!in || nameLength > 4096) return false;
+            node.id = id;
+            node.name.resize(nameLength);
+            in.read(node.name.data(), nameLength);
+            in.read(reinterpret_cast<char*>(&node.localTransform), sizeof(node.localTransform));
+        }
+        if (!in) return false;
+    }
+
+    out = std::move(subMeshes);
+    return true;
+}
+
+bool MeshCache::saveToDisk(const std::string& cachePath, const std::vector<SubMesh>& subMeshes)
+{
+    if (cachePath.empty() || subMeshes.empty()) return false;
+
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::create_directories(fs::path(cachePath).parent_path(), ec);
+
+    // 先写临时文件再改名，避免其他线程/进程读到写了一半的缓存
+    std::string tmpPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+
+        uint32_t count = static_cast<uint32_t>(subMeshes.size());
+        out.write(kMagic, 4);
+        out.write(reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+        for (const auto& sub : subMeshes) {
+            uint32_t nameLength = static_cast<uint32_t>(sub.name.size());
+            uint8_t hasUVs = sub.hasUVs ? 1 : 0;
+            out.write(reinterpret_cast<const char*>(&nameLength), sizeof(nameLength));
+            out.write(sub.name.data(), nameLength);
+            out.write(reinterpret_cast<const char*>(&hasUVs), sizeof(hasUVs));
+            writeVector(out, sub.vertices);
+            writeVector(out, sub.indices);
+            writeVector(out, sub.lods.indices);
+            writeVector(out, sub.lods.levels);
+            writeVector(out, sub.clusters.clusters);
+            writeVector(out, sub.clusters.levelOffsets);
+
+            uint32_t depth = static_cast<uint32_t>(sub.nodePath.size());
+            out.write(reinterpret_cast<const char*>(&depth), sizeof(depth));
+            for (const auto& node : sub.nodePath) {
+                int32_t id = node.id;
+                uint32_t nodeNameLength = static_cast<uint32_t>(node.name.size());
+                out.write(reinterpret_cast<const char*>(&id), sizeof(id));
+                out.write(reinterpret_cast<const char*>(&nodeNameLength), sizeof(nodeNameLength));
+                out.write(node.name.data(), nodeNameLength);
+                out.write(reinterpret_cast<const char*>(&node.localTransform), sizeof(node.localTransform));
+            }
+        }
+        if (!out) return false;
+    }
+
+    fs::rename(tmpPath, cachePath, ec);
+    if (ec) {
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "engine/asset_data.h"
+#include "engine/utils/asset_signature.h"
+
+// 解析好的网格缓存
+// OBJ / glTF 的解析以及法线、切线生成都比较慢，这里把结果 (可以直接构建 Model 的顶点/索引数组)
+// 存到 <projectRoot>/.cache/meshes/<hash>.ymesh。
+// hash 由 (sourceId, 源文件签名) 决定，sourceId 应包含影响解析结果的加载参数。
+// 资源被 LRU 淘汰之后再次获取时直接读这份缓存，跳过解析。
+// 所有函数都可以在工作线程调用。
+class MeshCache
+{
+public:
+    // 项目根目录为空或签名无效时返回空串 (不使用缓存)
+    static std::string getCachePath(const std::string& projectRoot, const std::string& sourceId,
+                                    const AssetSignature& signature);
+
+    static bool loadFromDisk(const std::string& cachePath, std::vector<SubMesh>& out);
+    static bool saveToDisk(const std::string& cachePath, const std::vector<SubMesh>& subMeshes);
+};
@@ -0,0 +1,180 @@
+#include "mesh_clusters.h"
+#include "engine/utils/job_system.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <sstream>
+
+std::vector<MeshCluster> MeshClusters::build(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+    std::vector<MeshCluster> clusters;
+    const size_t triangleCount = indices.size() / 3;
+    if (indices.size() % 3 != 0 || triangleCount < kMinTriangles) return clusters;
+    for (uint32_t index : indices) {
+        if (index >= vertices.size()) return clusters;
+    }
+
+    // 三角形质心与单位法线
+    std::vector<glm::vec3> centroids(triangleCount);
+    std::vector<glm::vec3> normals(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const glm::vec3& p0 = vertices[indices[t * 3 + 0]].position;
+        const glm::vec3& p1 = vertices[indices[t * 3 + 1]].position;
+        const glm::vec3& p2 = vertices[indices[t * 3 + 2]].position;
+        centroids[t] = (p0 + p1 + p2) / 3.0f;
+        glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+        float len = glm::length(n);
+        normals[t] = len > 0.0f ? n / len : glm::vec3(0.0f);
+    }
+
+    // 顶点 -> 三角形邻接表 (CSR)
+    std::vector<uint32_t> offsets(vertices.size() + 1, 0);
+    for (uint32_t index : indices) offsets[index + 1]++;
+    for (size_t v = 0; v < vertices.size(); ++v) offsets[v + 1] += offsets[v];
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); ++i) adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+
+    // 贪心生长：按原有顺序取第一个未分配的三角形作为种子，
+    // 沿共享顶点向外扩展，总是先取离种子最近的三角形，簇尽量紧凑 (包围球小、法线集中)
+    using Candidate = std::pair<float, uint32_t>;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> frontier;
+    std::vector<uint8_t> assigned(triangleCount, 0);
+    std::vector<uint32_t> order;
+    order.reserve(triangleCount);
+    std::vector<uint32_t> members;
+
+    size_t seed = 0;
+    while (true) {
+        while (seed < triangleCount && assigned[seed]) ++seed;
+        if (seed == triangleCount) break;
+
+        const glm::vec3 seedCenter = centroids[seed];
+        frontier = decltype(frontier)();
+        frontier.push({ 0.0f, static_cast<uint32_t>(seed) });
+        members.clear();
+
+        while (!frontier.empty() && members.size() < kTrianglesPerCluster) {
+            uint32_t t = frontier.top().second;
+            frontier.pop();
+            if (assigned[t]) continue;
+            assigned[t] = 1;
+            members.push_back(t);
+
+            for (int k = 0; k < 3; ++k) {
+                uint32_t v = indices[t * 3 + k];
+                for (uint32_t a = offsets[v]; a < offsets[v + 1]; ++a) {
+                    uint32_t n = adjacency[a];
+                    if (assigned[n]) continue;
+                    glm::vec3 d = centroids[n] - seedCenter;
+                    frontier.push({ glm::dot(d, d), n });
+                }
+            }
+        }
+
+        // 簇内保持原来的相对顺序 (Tipsify 的顶点缓存局部性)
+        std::sort(members.begin(), members.end());
+
+        MeshCluster cluster;
+        cluster.indexOffset = static_cast<uint32_t>(order.size() * 3);
+        cluster.indexCount = static_cast<uint32_t>(members.size() * 3);
+
+        // 包围球：包围盒中心 + 最远顶点
+        glm::vec3 boxMin(std::numeric_limits<float>::max());
+        glm::vec3 boxMax(-std::numeric_limits<float>::max());
+        glm::vec3 normalSum(0.0f);
+        for (uint32_t t : members) {
+            for (int k = 0; k < 3; ++k) {
+                const glm::vec3& p = vertices[indices[t * 3 + k]].position;
+                boxMin = glm::min(boxMin, p);
+                boxMax = glm::max(boxMax, p);
+            }
+            normalSum += normals[t];
+        }
+        cluster.center = 0.5f * (boxMin + boxMax);
+        float radius2 = 0.0f;
+        for (uint32_t t : members) {
+            for (int k = 0; k < 3; ++k) {
+                glm::vec3 d = vertices[indices[t * 3 + k]].position - cluster.center;
+                radius2 = std::max(radius2, glm::dot(d, d));
+            }
+        }
+        cluster.radius = std::sqrt(radius2);
+
+        // 法线锥：轴取法线平均方向，半角由与轴夹角最大的法线决定；超过 90 度时无法剔除
+        float axisLength = glm::length(normalSum);
+        if (axisLength > 1e-6f) {
+            cluster.coneAxis = normalSum / axisLength;
+            float minDot = 1.0f;
+            for (uint32_t t : members) {
+                if (normals[t] == glm::vec3(0.0f)) continue;
+                minDot = std::min(minDot, glm::dot(normals[t], cluster.coneAxis));
+            }
+            cluster.coneCutoff = minDot > 0.0f ? std::sqrt(std::max(0.0f, 1.0f - minDot * minDot)) : 1.0f;
+        }
+
+        clusters.push_back(cluster);
+        order.insert(order.end(), members.begin(), members.end());
+    }
+
+    std::vector<uint32_t> reordered(indices.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        uint32_t t = order[i];
+        reordered[i * 3 + 0] = indices[t * 3 + 0];
+        reordered[i * 3 + 1] = indices[t * 3 + 1];
+        reordered[i * 3 + 2] = indices[t * 3 + 2];
+    }
+    indices.swap(reordered);
+    return clusters;
+}
+
+MeshClusterSet MeshClusters::buildForMesh(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, MeshLodChain& lods)
+{
+    MeshClusterSet set;
+    set.levelOffsets.push_back(0);
+
+    std::vector<MeshCluster> clusters = build(vertices, indices);
+    set.clusters.insert(set.clusters.end(), clusters.begin(), clusters.end());
+    set.levelOffsets.push_back(static_cast<uint32_t>(set.clusters.size()));
+
+    for (const MeshLod& level : lods.levels) {
+        auto begin = lods.indices.begin() + level.indexOffset;
+        std::vector<uint32_t> levelIndices(begin, begin + level.indexCount);
+        clusters = build(vertices, levelIndices);
+        std::copy(levelIndices.begin(), levelIndices.end(), begin);
+
+        set.clusters.insert(set.clusters.end(), clusters.begin(), clusters.end());
+        set.levelOffsets.push_back(static_cast<uint32_t>(set.clusters.size()));
+    }
+
+    if (set.clusters.empty()) return MeshClusterSet();
+    return set;
+}
+
+void MeshClusters::buildScene(std::vector<SubMesh>& meshes)
+{
+    JobSystem::Get().parallelFor(0, meshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) meshes[i].clusters = buildForMesh(meshes[i].vertices, meshes[i].indices, meshes[i].lods);
+    });
+}
+
+std::string MeshClusters::describe(const std::vector<SubMesh>& meshes)
+{
+    size_t clustered = 0, baseClusters = 0, totalClusters = 0;
+    for (const auto& mesh : meshes) {
+        if (mesh.clusters.empty()) continue;
+        clustered++;
+        baseClusters += mesh.clusters.levelOffsets[1];
+        totalClusters += mesh.clusters.clusters.size();
+    }
+
+    std::ostringstream ss;
+    ss << clustered << "/" << meshes.size() << " meshes, " << baseClusters << " clusters at LOD 0 ("
+       << totalClusters << " with LODs)";
+    return ss.str();
+}
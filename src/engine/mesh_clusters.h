@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/frustum.h"
+#include "base/gl_utility.h"
+#include "base/vertex.h"
+#include "engine/asset_data.h"
+
+// 单个视图的逐簇剔除参数 (世界空间)
+struct ClusterCullView
+{
+    const Frustum* frustum = nullptr;
+
+    // 法线锥背面剔除：需要知道视点，且物体按 GL_BACK 剔除时才成立 (镜像视图、双面材质、背面深度 pass 关闭)
+    bool coneCulling = false;
+    bool orthographic = false;
+    glm::vec3 eye{ 0.0f };          // 透视：视点位置
+    glm::vec3 direction{ 0.0f };    // 正交：视线方向
+};
+
+// 剔除后留下的索引区间 (相邻的簇合并成一段)，直接交给 glMultiDrawElements
+struct ClusterDrawList
+{
+    std::vector<GLsizei> counts;
+    std::vector<const void*> offsets;
+    size_t indexCount = 0;
+
+    int visibleClusters = 0;
+    int frustumCulled = 0;
+    int coneCulled = 0;
+
+    void clear()
+    {
+        counts.clear();
+        offsets.clear();
+        indexCount = 0;
+        visibleClusters = frustumCulled = coneCulled = 0;
+    }
+};
+
+// 大网格的簇 (meshlet) 划分
+// 一个 Model 只有一次 draw，视锥剔除要么整个剔掉、要么整个画；扫描模型等超大网格只露出一角时也会全部绘制。
+// 划分成约 128 个三角形一簇之后可以逐簇做视锥与法线锥剔除，只提交可见的索引区间。
+// 纯 CPU 计算，在工作线程中由 OBJLoader / GLTFLoader::loadScene 与 GeometryFactory 调用
+class MeshClusters
+{
+public:
+    static constexpr uint32_t kTrianglesPerCluster = 128;
+    // 三角形数低于它的网格 (以及 LOD 级别) 不划分，整个绘制更便宜
+    static constexpr size_t kMinTriangles = 8192;
+
+    // 把 indices 划分成簇并原地重排 (每簇连续存放，簇内保持原有的三角形顺序以保留顶点缓存优化)
+    static std::vector<MeshCluster> build(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+    // 对 LOD 0 与每一级 LOD 分别划分 (重排 indices 与 lods.indices)
+    static MeshClusterSet buildForMesh(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, MeshLodChain& lods);
+
+    // 按子网格并行执行 buildForMesh
+    static void buildScene(std::vector<SubMesh>& meshes);
+
+    // 用于导入统计的一行汇总
+    static std::string describe(const std::vector<SubMesh>& meshes);
+};
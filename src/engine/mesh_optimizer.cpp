@@ -0,0 +1,274 @@
+#include "mesh_optimizer.h"
+#include "engine/utils/job_system.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+MeshOptimizer::CacheStats MeshOptimizer::analyze(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize)
+{
+    CacheStats stats;
+    stats.triangles = indices.size() / 3;
+
+    // FIFO 缓存：记录每个顶点进入缓存的时间戳，超过 cacheSize 个新顶点之后视为已被挤出
+    std::vector<uint32_t> timestamps(vertexCount, 0);
+    std::vector<uint8_t> referenced(vertexCount, 0);
+    uint32_t time = static_cast<uint32_t>(cacheSize) + 1;
+
+    for (uint32_t index : indices) {
+        if (index >= vertexCount) continue;
+        if (time - timestamps[index] > static_cast<uint32_t>(cacheSize)) {
+            timestamps[index] = time++;
+            stats.misses++;
+        }
+        if (!referenced[index]) {
+            referenced[index] = 1;
+            stats.vertices++;
+        }
+    }
+    return stats;
+}
+
+std::vector<uint32_t> MeshOptimizer::tipsify(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize,
+                                             std::vector<uint32_t>& clusterStarts)
+{
+    size_t triangleCount = indices.size() / 3;
+
+    // 顶点 -> 三角形邻接表 (CSR 形式)
+    std::vector<uint32_t> liveCount(vertexCount, 0);
+    for (uint32_t index : indices) liveCount[index]++;
+
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] = offsets[v] + liveCount[v];
+
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) adjacency[cursor[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<uint32_t> deadEnd;      // 最近用过的顶点，找不到候选时从这里回溯
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> order;
+    order.reserve(triangleCount);
+
+    uint32_t time = static_cast<uint32_t>(cacheSize) + 1;
+    size_t scanCursor = 0;
+
+    // 找不到缓存内的候选时：先回溯 dead-end 栈，再顺序扫描
+    auto skipDeadEnd = [&]() -> int64_t {
+        while (!deadEnd.empty()) {
+            uint32_t v = deadEnd.back();
+            deadEnd.pop_back();
+            if (liveCount[v] > 0) return v;
+        }
+        while (scanCursor < vertexCount) {
+            if (liveCount[scanCursor] > 0) return static_cast<int64_t>(scanCursor);
+            ++scanCursor;
+        }
+        return -1;
+    };
+
+    int64_t fanning = skipDeadEnd();
+    while (fanning >= 0) {
+        clusterStarts.push_back(static_cast<uint32_t>(order.size()));
+
+        // 沿着 fanning 顶点一直走，直到遇到 dead-end
+        while (fanning >= 0) {
+            candidates.clear();
+            uint32_t f = static_cast<uint32_t>(fanning);
+            for (uint32_t a = offsets[f]; a < offsets[f + 1]; ++a) {
+                uint32_t t = adjacency[a];
+                if (emitted[t]) continue;
+                emitted[t] = 1;
+                order.push_back(t);
+                for (int k = 0; k < 3; ++k) {
+                    uint32_t v = indices[t * 3 + k];
+                    deadEnd.push_back(v);
+                    candidates.push_back(v);
+                    liveCount[v]--;
+                    if (time - cacheTime[v] > static_cast<uint32_t>(cacheSize)) cacheTime[v] = time++;
+                }
+            }
+
+            // 选下一个 fanning 顶点：仍有未输出的三角形、并且处理完之后还留在缓存里的顶点中，最早进入缓存的那个
+            int64_t best = -1;
+            int64_t bestPriority = -1;
+            for (uint32_t v : candidates) {
+                if (liveCount[v] == 0) continue;
+                int64_t priority = 0;
+                int64_t age = static_cast<int64_t>(time) - cacheTime[v];
+                if (age + 2 * static_cast<int64_t>(liveCount[v]) <= cacheSize) priority = age;
+                if (priority > bestPriority) {
+                    bestPriority = priority;
+                    best = v;
+                }
+            }
+            fanning = best;
+        }
+
+        // dead-end：开始一个新的簇
+        fanning = skipDeadEnd();
+    }
+    return order;
+}
+
+std::vector<uint32_t> MeshOptimizer::sortClusters(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                                  const std::vector<uint32_t>& order, const std::vector<uint32_t>& clusterStarts)
+{
+    // 网格中心 (按面积加权)
+    glm::vec3 meshCenter(0.0f);
+    float meshArea = 0.0f;
+
+    struct Cluster {
+        uint32_t begin, end;
+        glm::vec3 center{ 0.0f };
+        glm::vec3 normal{ 0.0f };   // 面积加权法线之和
+        float area = 0.0f;
+        float key = 0.0f;
+    };
+    std::vector<Cluster> clusters(clusterStarts.size());
+
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        Cluster& cluster = clusters[c];
+        cluster.begin = clusterStarts[c];
+        cluster.end = (c + 1 < clusterStarts.size()) ? clusterStarts[c + 1] : static_cast<uint32_t>(order.size());
+
+        for (uint32_t i = cluster.begin; i < cluster.end; ++i) {
+            uint32_t t = order[i];
+            const glm::vec3& p0 = vertices[indices[t * 3 + 0]].position;
+            const glm::vec3& p1 = vertices[indices[t * 3 + 1]].position;
+            const glm::vec3& p2 = vertices[indices[t * 3 + 2]].position;
+            glm::vec3 n = glm::cross(p1 - p0, p2 - p0);   // 长度为面积的两倍
+            float area = glm::length(n);
+            glm::vec3 centroid = (p0 + p1 + p2) / 3.0f;
+
+            cluster.center += centroid * area;
+            cluster.normal += n;
+            cluster.area += area;
+        }
+
+        meshCenter += cluster.center;
+        meshArea += cluster.area;
+        if (cluster.area > 0.0f) cluster.center /= cluster.area;
+    }
+    if (meshArea > 0.0f) meshCenter /= meshArea;
+
+    // 朝外的簇更可能挡住其他簇，先画 (Sander et al. 的线性排序)
+    for (Cluster& cluster : clusters) {
+        float len = glm::length(cluster.normal);
+        glm::vec3 n = len > 0.0f ? cluster.normal / len : glm::vec3(0.0f);
+        cluster.key = glm::dot(cluster.center - meshCenter, n);
+    }
+    std::stable_sort(clusters.begin(), clusters.end(),
+        [](const Cluster& a, const Cluster& b) { return a.key > b.key; });
+
+    std::vector<uint32_t> sorted;
+    sorted.reserve(order.size());
+    for (const Cluster& cluster : clusters) {
+        sorted.insert(sorted.end(), order.begin() + cluster.begin, order.begin() + cluster.end);
+    }
+    return sorted;
+}
+
+void MeshOptimizer::reorderVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+    constexpr uint32_t kUnassigned = ~0u;
+    std::vector<uint32_t> remap(vertices.size(), kUnassigned);
+    std::vector<Vertex> reordered;
+    reordered.reserve(vertices.size());
+
+    for (uint32_t& index : indices) {
+        if (remap[index] == kUnassigned) {
+            remap[index] = static_cast<uint32_t>(reordered.size());
+            reordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices.swap(reordered);
+}
+
+void MeshOptimizer::applyTriangleOrder(std::vector<uint32_t>& indices, const std::vector<uint32_t>& order)
+{
+    std::vector<uint32_t> reordered(indices.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        uint32_t t = order[i];
+        reordered[i * 3 + 0] = indices[t * 3 + 0];
+        reordered[i * 3 + 1] = indices[t * 3 + 1];
+        reordered[i * 3 + 2] = indices[t * 3 + 2];
+    }
+    indices.swap(reordered);
+}
+
+MeshOptimizer::CacheStats MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize)
+{
+    bool valid = !indices.empty() && indices.size() % 3 == 0
+        && *std::max_element(indices.begin(), indices.end()) < vertexCount;
+    if (valid) {
+        std::vector<uint32_t> clusterStarts;
+        applyTriangleOrder(indices, tipsify(indices, vertexCount, cacheSize, clusterStarts));
+    }
+    return analyze(indices, vertexCount, cacheSize);
+}
+
+MeshOptimizer::Result MeshOptimizer::optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, int cacheSize)
+{
+    Result result;
+    result.cacheSize = cacheSize;
+    result.before = analyze(indices, vertices.size(), cacheSize);
+
+    bool valid = !indices.empty() && indices.size() % 3 == 0
+        && *std::max_element(indices.begin(), indices.end()) < vertices.size();
+    if (!valid) {
+        result.after = result.before;
+        return result;
+    }
+
+    // 1. 顶点缓存 + 簇划分
+    std::vector<uint32_t> clusterStarts;
+    std::vector<uint32_t> order = tipsify(indices, vertices.size(), cacheSize, clusterStarts);
+
+    // 2. 过度绘制：簇之间重新排序 (簇内部保持 Tipsify 的顺序，缓存效率基本不变)
+    order = sortClusters(vertices, indices, order, clusterStarts);
+    result.clusters = clusterStarts.size();
+
+    applyTriangleOrder(indices, order);
+
+    // 3. 顶点读取顺序
+    reorderVertexFetch(vertices, indices);
+
+    result.after = analyze(indices, vertices.size(), cacheSize);
+    return result;
+}
+
+MeshOptimizer::Result MeshOptimizer::optimizeScene(std::vector<SubMesh>& meshes, int cacheSize)
+{
+    // 子网格之间互不相关，并行优化后再汇总
+    std::vector<Result> results(meshes.size());
+    JobSystem::Get().parallelFor(0, meshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) results[i] = optimize(meshes[i].vertices, meshes[i].indices, cacheSize);
+    });
+
+    Result total;
+    total.cacheSize = cacheSize;
+    for (const Result& r : results) {
+        total.before += r.before;
+        total.after += r.after;
+        total.clusters += r.clusters;
+    }
+    return total;
+}
+
+std::string MeshOptimizer::describe(const Result& result)
+{
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3)
+       << "ACMR " << result.before.getACMR() << " -> " << result.after.getACMR()
+       << ", ATVR " << result.before.getATVR() << " -> " << result.after.getATVR()
+       << " (cache " << result.cacheSize << ", " << result.clusters << " clusters)";
+    return ss.str();
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/vertex.h"
+#include "engine/asset_data.h"
+
+// 导入后的网格优化 (在工作线程中由 OBJLoader / GLTFLoader::loadScene 调用，结果随网格缓存一起保存)
+// 1. 顶点缓存：Tipsify (Sander et al. 2007) 重排三角形，提高 post-transform cache 命中率
+// 2. 过度绘制：按 Tipsify 的 dead-end 位置切分成簇，朝外的簇先画
+// 3. 顶点读取：按第一次被引用的顺序重新排列顶点 (顺带去掉未被引用的顶点)
+class MeshOptimizer
+{
+public:
+    // 顶点缓存统计 (FIFO 模型)
+    // ACMR = 缓存未命中数 / 三角形数 (理想值接近 0.5)
+    // ATVR = 缓存未命中数 / 顶点数   (理想值 1.0)
+    struct CacheStats
+    {
+        size_t triangles = 0;
+        size_t vertices = 0;
+        size_t misses = 0;
+
+        float getACMR() const { return triangles ? static_cast<float>(misses) / triangles : 0.0f; }
+        float getATVR() const { return vertices ? static_cast<float>(misses) / vertices : 0.0f; }
+
+        CacheStats& operator+=(const CacheStats& rhs)
+        {
+            triangles += rhs.triangles;
+            vertices += rhs.vertices;
+            misses += rhs.misses;
+            return *this;
+        }
+    };
+
+    struct Result
+    {
+        CacheStats before;
+        CacheStats after;
+        size_t clusters = 0;
+        int cacheSize = 0;
+    };
+
+    // 模拟的缓存大小 (与常见 GPU 的有效容量相当)
+    static constexpr int kCacheSize = 16;
+
+    // 原地优化，返回优化前后的统计；索引数不是 3 的倍数时不做任何修改
+    static Result optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, int cacheSize = kCacheSize);
+
+    // 对整个场景的每个子网格执行 optimize (按子网格并行)，返回汇总统计
+    static Result optimizeScene(std::vector<SubMesh>& meshes, int cacheSize = kCacheSize);
+
+    // 只重排三角形 (Tipsify)，顶点顺序不变；用于共用顶点缓冲的 LOD 索引
+    static CacheStats optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize = kCacheSize);
+
+    static CacheStats analyze(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize = kCacheSize);
+
+    // 用于导入统计的一行汇总
+    static std::string describe(const Result& result);
+
+private:
+    // Tipsify：返回重排后的三角形序号，clusterStarts 记录每个簇的起始位置 (按输出顺序)
+    static std::vector<uint32_t> tipsify(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize,
+                                         std::vector<uint32_t>& clusterStarts);
+
+    // 按朝外程度对簇排序，输出新的三角形顺序
+    static std::vector<uint32_t> sortClusters(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                              const std::vector<uint32_t>& order, const std::vector<uint32_t>& clusterStarts);
+
+    // 按 order (三角形序号) 重排索引
+    static void applyTriangleOrder(std::vector<uint32_t>& indices, const std::vector<uint32_t>& order);
+
+    // 按第一次引用的顺序重新排列顶点
+    static void reorderVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+};
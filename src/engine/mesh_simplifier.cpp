@@ -0,0 +1,317 @@
+#include "mesh_simplifier.h"
+#include "mesh_optimizer.h"
+#include "engine/utils/job_system.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+// 二次误差：若干平面 (n·p + d = 0) 的 w * (n·p + d)^2 之和，按对称矩阵存储
+// weight 累计面积权重，evaluate / weight 即为到这些平面的加权平均距离平方
+struct Quadric
+{
+    double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+    double b0 = 0, b1 = 0, b2 = 0;
+    double c = 0;
+    double weight = 0;
+
+    void addPlane(const glm::dvec3& n, double d, double w)
+    {
+        a00 += w * n.x * n.x; a01 += w * n.x * n.y; a02 += w * n.x * n.z;
+        a11 += w * n.y * n.y; a12 += w * n.y * n.z; a22 += w * n.z * n.z;
+        b0 += w * n.x * d; b1 += w * n.y * d; b2 += w * n.z * d;
+        c += w * d * d;
+        weight += w;
+    }
+
+    Quadric& operator+=(const Quadric& q)
+    {
+        a00 += q.a00; a01 += q.a01; a02 += q.a02;
+        a11 += q.a11; a12 += q.a12; a22 += q.a22;
+        b0 += q.b0; b1 += q.b1; b2 += q.b2;
+        c += q.c;
+        weight += q.weight;
+        return *this;
+    }
+
+    double evaluate(const glm::vec3& p) const
+    {
+        double x = p.x, y = p.y, z = p.z;
+        double r = a00 * x * x + a11 * y * y + a22 * z * z
+                 + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+                 + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+        return r > 0.0 ? r : 0.0;
+    }
+};
+
+// 把 u、v 两个顶点的误差合并后在 p 处求值，返回距离
+float collapseError(const Quadric& qu, const Quadric& qv, const glm::vec3& p)
+{
+    Quadric q = qu;
+    q += qv;
+    return q.weight > 0.0 ? static_cast<float>(std::sqrt(q.evaluate(p) / q.weight)) : 0.0f;
+}
+
+} // namespace
+
+std::vector<uint32_t> MeshSimplifier::simplify(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                               size_t targetIndexCount, float& outError)
+{
+    outError = 0.0f;
+    const size_t vertexCount = vertices.size();
+    std::vector<uint32_t> result = indices;
+    if (result.size() % 3 != 0 || result.size() <= targetIndexCount) return result;
+    for (uint32_t index : result) {
+        if (index >= vertexCount) return result;
+    }
+
+    // 1. 位置相同的顶点合并为一个拓扑顶点 (canonical)
+    std::vector<uint32_t> canonical(vertexCount);
+    std::vector<glm::vec3> positions;
+    {
+        std::vector<uint32_t> order(vertexCount);
+        for (size_t i = 0; i < vertexCount; ++i) order[i] = static_cast<uint32_t>(i);
+        auto less = [&](uint32_t a, uint32_t b) {
+            const glm::vec3& pa = vertices[a].position;
+            const glm::vec3& pb = vertices[b].position;
+            if (pa.x != pb.x) return pa.x < pb.x;
+            if (pa.y != pb.y) return pa.y < pb.y;
+            return pa.z < pb.z;
+        };
+        std::sort(order.begin(), order.end(), less);
+        for (size_t i = 0; i < vertexCount; ++i) {
+            if (i == 0 || less(order[i - 1], order[i])) positions.push_back(vertices[order[i]].position);
+            canonical[order[i]] = static_cast<uint32_t>(positions.size() - 1);
+        }
+    }
+    const size_t pointCount = positions.size();
+
+    // 2. 锁定接缝 (同一位置被多个不同属性的顶点引用) 与开放边界 / 非流形边上的顶点
+    std::vector<uint8_t> locked(pointCount, 0);
+    std::vector<uint32_t> wedgeOf(pointCount, ~0u);
+    for (uint32_t index : result) {
+        uint32_t p = canonical[index];
+        if (wedgeOf[p] == ~0u) wedgeOf[p] = index;
+        else if (wedgeOf[p] != index) locked[p] = 1;
+    }
+    {
+        std::vector<uint64_t> edges;
+        edges.reserve(result.size());
+        for (size_t t = 0; t < result.size(); t += 3) {
+            for (int k = 0; k < 3; ++k) {
+                uint32_t a = canonical[result[t + k]];
+                uint32_t b = canonical[result[t + (k + 1) % 3]];
+                if (a == b) continue;
+                edges.push_back((static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        for (size_t i = 0; i < edges.size();) {
+            size_t j = i;
+            while (j < edges.size() && edges[j] == edges[i]) ++j;
+            if (j - i != 2) {
+                locked[edges[i] >> 32] = 1;
+                locked[edges[i] & 0xffffffffu] = 1;
+            }
+            i = j;
+        }
+    }
+
+    // 3. 每个拓扑顶点的误差 = 相邻三角形平面的面积加权和
+    std::vector<Quadric> quadrics(pointCount);
+    for (size_t t = 0; t < result.size(); t += 3) {
+        glm::dvec3 p0(positions[canonical[result[t + 0]]]);
+        glm::dvec3 p1(positions[canonical[result[t + 1]]]);
+        glm::dvec3 p2(positions[canonical[result[t + 2]]]);
+        glm::dvec3 n = glm::cross(p1 - p0, p2 - p0);
+        double len = glm::length(n);
+        if (len <= 0.0) continue;
+        n /= len;
+        double area = 0.5 * len;
+        double d = -glm::dot(n, p0);
+        for (int k = 0; k < 3; ++k) quadrics[canonical[result[t + k]]].addPlane(n, d, area);
+    }
+
+    // 4. 分轮贪心折叠：每轮为每个可移除的顶点选代价最小的邻居，按代价排序后依次执行，
+    // 同一轮内被改动过的顶点不再参与，轮末统一去掉退化三角形
+    struct Collapse
+    {
+        uint32_t from;      // 被移除的拓扑顶点
+        uint32_t to;
+        uint32_t toWedge;   // 折叠后使用的顶点 (属性取自 v 一侧)
+        float error;
+    };
+
+    std::vector<uint32_t> wedgeRemap(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) wedgeRemap[i] = static_cast<uint32_t>(i);
+
+    std::vector<uint32_t> offsets(pointCount + 1);
+    std::vector<uint32_t> adjacency;
+    std::vector<uint8_t> touched(pointCount);
+    std::vector<Collapse> collapses;
+    std::vector<std::pair<uint32_t, uint32_t>> neighbors;   // (拓扑顶点, 该边上使用的顶点)；不一致时记为 ~0u
+
+    const size_t targetTriangles = targetIndexCount / 3;
+    while (result.size() / 3 > targetTriangles) {
+        const size_t triangleCount = result.size() / 3;
+
+        // 拓扑顶点 -> 三角形邻接表 (CSR)
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (uint32_t index : result) offsets[canonical[index] + 1]++;
+        for (size_t p = 0; p < pointCount; ++p) offsets[p + 1] += offsets[p];
+        adjacency.resize(result.size());
+        {
+            std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < result.size(); ++i) adjacency[cursor[canonical[result[i]]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        collapses.clear();
+        for (uint32_t u = 0; u < pointCount; ++u) {
+            if (locked[u] || offsets[u] == offsets[u + 1]) continue;
+
+            neighbors.clear();
+            for (uint32_t a = offsets[u]; a < offsets[u + 1]; ++a) {
+                const uint32_t* tri = &result[adjacency[a] * 3];
+                for (int k = 0; k < 3; ++k) {
+                    uint32_t x = canonical[tri[k]];
+                    if (x == u) continue;
+                    auto it = std::find_if(neighbors.begin(), neighbors.end(),
+                                           [x](const std::pair<uint32_t, uint32_t>& n) { return n.first == x; });
+                    if (it == neighbors.end()) neighbors.emplace_back(x, tri[k]);
+                    else if (it->second != tri[k]) it->second = ~0u;
+                }
+            }
+
+            Collapse best{ u, 0, ~0u, 0.0f };
+            for (const auto& [x, wedge] : neighbors) {
+                if (wedge == ~0u) continue;
+                float error = collapseError(quadrics[u], quadrics[x], positions[x]);
+                if (best.toWedge == ~0u || error < best.error) best = Collapse{ u, x, wedge, error };
+            }
+            if (best.toWedge != ~0u) collapses.push_back(best);
+        }
+
+        std::sort(collapses.begin(), collapses.end(),
+                  [](const Collapse& a, const Collapse& b) { return a.error < b.error; });
+
+        std::fill(touched.begin(), touched.end(), 0);
+        const size_t needed = triangleCount - targetTriangles;
+        size_t removed = 0;
+        size_t applied = 0;
+
+        auto resolve = [&](uint32_t index) { return positions[canonical[wedgeRemap[index]]]; };
+
+        for (const Collapse& c : collapses) {
+            if (removed >= needed) break;
+            if (touched[c.from] || touched[c.to]) continue;
+
+            // 折叠后不能有三角形翻面 (法线反向或退化成线)
+            bool flips = false;
+            size_t shared = 0;
+            const glm::vec3& target = positions[c.to];
+            for (uint32_t a = offsets[c.from]; a < offsets[c.from + 1] && !flips; ++a) {
+                const uint32_t* tri = &result[adjacency[a] * 3];
+                glm::vec3 p[3];
+                bool hasTarget = false;
+                int corner = 0;
+                for (int k = 0; k < 3; ++k) {
+                    p[k] = resolve(tri[k]);
+                    uint32_t x = canonical[wedgeRemap[tri[k]]];
+                    if (x == c.to) hasTarget = true;
+                    if (canonical[tri[k]] == c.from) corner = k;
+                }
+                if (hasTarget) {
+                    shared++;
+                    continue;
+                }
+                glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                p[corner] = target;
+                glm::vec3 after = glm::cross(p[1] - p[0], p[2] - p[0]);
+                if (glm::dot(before, after) <= 0.0f) flips = true;
+            }
+            if (flips) continue;
+
+            wedgeRemap[wedgeOf[c.from]] = c.toWedge;
+            quadrics[c.to] += quadrics[c.from];
+            touched[c.from] = 1;
+            touched[c.to] = 1;
+            removed += shared;
+            applied++;
+            outError = std::max(outError, c.error);
+        }
+        if (applied == 0) break;
+
+        // 轮末：应用重映射并去掉退化三角形
+        size_t write = 0;
+        for (size_t t = 0; t < result.size(); t += 3) {
+            uint32_t i0 = wedgeRemap[result[t + 0]];
+            uint32_t i1 = wedgeRemap[result[t + 1]];
+            uint32_t i2 = wedgeRemap[result[t + 2]];
+            uint32_t c0 = canonical[i0], c1 = canonical[i1], c2 = canonical[i2];
+            if (c0 == c1 || c1 == c2 || c0 == c2) continue;
+            result[write++] = i0;
+            result[write++] = i1;
+            result[write++] = i2;
+        }
+        result.resize(write);
+    }
+    return result;
+}
+
+MeshLodChain MeshSimplifier::buildLodChain(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+{
+    MeshLodChain chain;
+    if (indices.size() % 3 != 0) return chain;
+
+    // 每级的误差是从 LOD 0 起逐级累加的上界
+    std::vector<uint32_t> current = indices;
+    float error = 0.0f;
+    for (int level = 0; level < kMaxLods; ++level) {
+        size_t targetTriangles = current.size() / 6;
+        if (targetTriangles < kMinTriangles) break;
+
+        float stepError = 0.0f;
+        std::vector<uint32_t> next = simplify(vertices, current, targetTriangles * 3, stepError);
+        if (next.empty() || next.size() * 10 > current.size() * 9) break;
+        error += stepError;
+
+        MeshOptimizer::optimizeVertexCache(next, vertices.size());
+
+        MeshLod lod;
+        lod.indexOffset = static_cast<uint32_t>(chain.indices.size());
+        lod.indexCount = static_cast<uint32_t>(next.size());
+        lod.error = error;
+        chain.levels.push_back(lod);
+        chain.indices.insert(chain.indices.end(), next.begin(), next.end());
+        current = std::move(next);
+    }
+    return chain;
+}
+
+void MeshSimplifier::buildSceneLods(std::vector<SubMesh>& meshes)
+{
+    JobSystem::Get().parallelFor(0, meshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) meshes[i].lods = buildLodChain(meshes[i].vertices, meshes[i].indices);
+    });
+}
+
+std::string MeshSimplifier::describe(const std::vector<SubMesh>& meshes)
+{
+    size_t withLods = 0, levels = 0, baseIndices = 0, lodIndices = 0;
+    for (const auto& mesh : meshes) {
+        baseIndices += mesh.indices.size();
+        lodIndices += mesh.lods.indices.size();
+        levels += mesh.lods.levels.size();
+        if (!mesh.lods.empty()) withLods++;
+    }
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1)
+       << withLods << "/" << meshes.size() << " meshes, "
+       << (withLods ? static_cast<float>(levels) / withLods : 0.0f) << " levels avg, index memory +"
+       << (baseIndices ? 100.0f * lodIndices / baseIndices : 0.0f) << "%";
+    return ss.str();
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/vertex.h"
+#include "engine/asset_data.h"
+
+// 网格简化 (Garland & Heckbert 的二次误差度量，QEM)，用于生成 LOD 链
+// 只做半边折叠：顶点 u 并入已有的顶点 v，不产生新顶点，所有 LOD 共用原始顶点缓冲，只需要额外的索引。
+// - 位置相同、属性不同的顶点 (UV / 法线接缝) 视为同一个拓扑顶点，接缝上的顶点与开放边界上的顶点不会被移除
+// - 误差按面积加权平均，单位是模型局部空间的距离
+// 纯 CPU 计算，在工作线程中由 OBJLoader / GLTFLoader::loadScene 与 GeometryFactory 调用
+class MeshSimplifier
+{
+public:
+    // 链中最多几级 (不含 LOD 0)，每级目标三角形数减半
+    static constexpr int kMaxLods = 5;
+    // 三角形数低于它时不再继续生成
+    static constexpr size_t kMinTriangles = 64;
+
+    // 把 indices 简化到不超过 targetIndexCount 个索引 (锁定的顶点可能让结果达不到目标)
+    // outError 为这一步引入的最大几何误差
+    static std::vector<uint32_t> simplify(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                          size_t targetIndexCount, float& outError);
+
+    // 从 LOD 0 逐级简化，每级再做一次顶点缓存优化；某一级减少不到 10% 时停止
+    static MeshLodChain buildLodChain(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+
+    // 对场景的每个子网格生成 LOD 链 (按子网格并行)
+    static void buildSceneLods(std::vector<SubMesh>& meshes);
+
+    // 用于导入统计的一行汇总
+    static std::string describe(const std::vector<SubMesh>& meshes);
+};
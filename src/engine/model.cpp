@@ -1,157 +1,520 @@
 #include "model.h"
 #include "obj_loader.h"
+#include "engine/utils/content_hash.h"
+#include "engine/physics_utils.h"
+#include "engine/mesh_clusters.h"
+#include "engine/render_thread.h"
+#include "base/glsl_program.h"
 
 #include <algorithm>
 #include <iostream>
 #include <limits>
 
+MeshGeometry::~MeshGeometry()
+{
+    if (!vao && !depthVao && !boxVao) return;
+
+    // VAO 不在上下文之间共享：最后一个引用在 UI 线程 (或加载线程) 上释放时，推迟到帧边界删除
+    GLuint buffers[] = { boxEbo, boxVbo, depthVbo, ebo, vbo };
+    GLuint vertexArrays[] = { boxVao, depthVao, vao };
+    RenderThread::Get().runOnRenderContext([buffers, vertexArrays]() {
+        for (GLuint buffer : buffers) {
+            if (buffer) glDeleteBuffers(1, &buffer);
+        }
+        for (GLuint vertexArray : vertexArrays) {
+            if (vertexArray) glDeleteVertexArrays(1, &vertexArray);
+        }
+    });
+}
+
+uint64_t MeshGeometry::hashContent(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+{
+    ContentHash h;
+    h.update(vertices);
+    h.update(indices);
+    return h.digest();
+}
+
+void MeshGeometry::applyResidency()
+{
+    // 上传之前 GL 还需要完整数据
+    if (!isUploaded || residency == MeshResidency::Full) return;
+
+    bool hasFull = hasFullCpuData() && vertexCount > 0;
+
+    switch (residency) {
+    case MeshResidency::PickingProxy:
+        if (proxy.positions.empty() && hasFull) {
+            proxy.clear();
+            proxy.positions.reserve(vertices.size());
+            for (const auto& v : vertices) proxy.positions.push_back(v.position);
+            proxy.indices = std::move(indices);
+        }
+        break;
+
+    case MeshResidency::QuantizedProxy:
+        if (proxy.quantized.empty() && (hasFull || !proxy.positions.empty())) {
+            std::vector<glm::vec3> positions = std::move(proxy.positions);
+            std::vector<uint32_t> proxyIndices = std::move(proxy.indices);
+            if (hasFull) {
+                positions.clear();
+                positions.reserve(vertices.size());
+                for (const auto& v : vertices) positions.push_back(v.position);
+                proxyIndices = std::move(indices);
+            }
+
+            // 包围盒由顶点算出，所有位置都落在其中；最大误差为半个量化步长
+            proxy.clear();
+            proxy.origin = boundingBox.min;
+            proxy.step = (boundingBox.max - boundingBox.min) / 65535.0f;
+            glm::vec3 invStep(0.0f);
+            for (int a = 0; a < 3; ++a) {
+                if (proxy.step[a] > 0.0f) invStep[a] = 1.0f / proxy.step[a];
+            }
+            proxy.quantized.reserve(positions.size());
+            for (const auto& p : positions) {
+                glm::vec3 q = glm::clamp(glm::round((p - proxy.origin) * invStep), glm::vec3(0.0f), glm::vec3(65535.0f));
+                proxy.quantized.push_back(glm::u16vec3(q));
+            }
+            proxy.indices = std::move(proxyIndices);
+        }
+        break;
+
+    case MeshResidency::GpuOnly:
+        proxy.clear();
+        break;
+
+    default:
+        break;
+    }
+
+    // 拾取代理建好 (或不需要) 之后才释放完整数据；swap 确保容量也一并归还
+    std::vector<Vertex>().swap(vertices);
+    std::vector<uint32_t>().swap(indices);
+}
+
+void MeshGeometry::packVertices(VertexFormat format)
+{
+    if (isUploaded) return;
+    packed = VertexPacking::pack(vertices, format, boundingBox);
+}
+
+void MeshGeometry::restoreCpuData(std::vector<Vertex>&& v, std::vector<uint32_t>&& i)
+{
+    vertices = std::move(v);
+    indices = std::move(i);
+    proxy.clear();
+}
+
 Model::Model(const std::string &filepath, bool useFlatShade)
-    : _isUploaded(false)
+    : _geometry(std::make_shared<MeshGeometry>())
 {
     // 1. 调用 OBJLoader 获取数据
     // 这里利用了 C++ 的返回值优化 (RVO)，不会产生不必要的深拷贝
     MeshData data = OBJLoader::load(filepath, useFlatShade);
 
-    // 2. 将数据移动到 Model 的成员变量中
-    _vertices = std::move(data.vertices);
-    _indices = std::move(data.indices);
-    _hasUVs = data.hasUVs;
+    // 2. 将数据移动到几何数据中
+    _geometry->vertices = std::move(data.vertices);
+    _geometry->indices = std::move(data.indices);
+    _geometry->hasUVs = data.hasUVs;
+    _geometry->lods = std::move(data.lods);
+    _geometry->clusters = std::move(data.clusters);
 
     // 3. 后续初始化流程保持不变
-    computeBoundingBox();
+    onDataAssigned();
 }
 
 Model::Model(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices)
-    : _vertices(vertices), _indices(indices), _isUploaded(false)
+    : _geometry(std::make_shared<MeshGeometry>())
 {
-    _hasUVs = true;
-    computeBoundingBox();
+    _geometry->vertices = vertices;
+    _geometry->indices = indices;
+    _geometry->hasUVs = true;
+    onDataAssigned();
 }
 
-Model::Model(Model &&rhs) noexcept
-    : _vertices(std::move(rhs._vertices)), _indices(std::move(rhs._indices)),
-      _boundingBox(std::move(rhs._boundingBox)), _vao(rhs._vao), _vbo(rhs._vbo), _ebo(rhs._ebo),
-      _boxVao(rhs._boxVao), _boxVbo(rhs._boxVbo), _boxEbo(rhs._boxEbo)
+Model::Model(std::vector<Vertex> &&vertices, std::vector<uint32_t> &&indices)
+    : _geometry(std::make_shared<MeshGeometry>())
 {
-    rhs._vao = 0;
-    rhs._vbo = 0;
-    rhs._ebo = 0;
+    _geometry->vertices = std::move(vertices);
+    _geometry->indices = std::move(indices);
+    _geometry->hasUVs = true;
+    onDataAssigned();
+}
 
-    rhs._boxVao = 0;
-    rhs._boxVbo = 0;
-    rhs._boxEbo = 0;
+Model::Model(std::shared_ptr<MeshGeometry> geometry)
+    : _geometry(std::move(geometry))
+{
 }
 
-Model::~Model()
+Model::Model(Model &&rhs) noexcept
+    : transform(rhs.transform), _geometry(std::move(rhs._geometry))
 {
-    cleanup();
+    // 被移走的对象保持可用 (空网格)
+    rhs._geometry = std::make_shared<MeshGeometry>();
 }
 
+Model::~Model() = default;
+
 BoundingBox Model::getBoundingBox() const
 {
-    return _boundingBox;
+    return _geometry->boundingBox;
+}
+
+void Model::swapGeometry(Model& other)
+{
+    // 新数据沿用原来的驻留策略 (未上传时会在上传后生效)
+    MeshResidency residency = _geometry->residency;
+    std::swap(_geometry, other._geometry);
+    if (_geometry->residency != residency) {
+        _geometry->residency = residency;
+        _geometry->applyResidency();
+    }
+}
+
+bool Model::raycast(const Ray& localRay, float& outT) const
+{
+    const MeshGeometry& g = *_geometry;
+
+    if (!g.indices.empty() && g.hasFullCpuData()) {
+        return PhysicsUtils::intersectRayMesh(localRay, g.vertices, g.indices, outT);
+    }
+
+    const PickingProxy& proxy = g.proxy;
+    if (!proxy.positions.empty()) {
+        return PhysicsUtils::intersectRayTriangles(localRay, proxy.indices,
+            [&](uint32_t i) -> const glm::vec3& { return proxy.positions[i]; }, outT);
+    }
+    if (!proxy.quantized.empty()) {
+        return PhysicsUtils::intersectRayTriangles(localRay, proxy.indices,
+            [&](uint32_t i) { return proxy.origin + glm::vec3(proxy.quantized[i]) * proxy.step; }, outT);
+    }
+
+    // 没有任何 CPU 数据：退化为包围盒
+    return PhysicsUtils::intersectRayAABB(localRay, g.boundingBox, outT);
+}
+
+void Model::setLods(MeshLodChain&& lods)
+{
+    if (_geometry->isUploaded) return;
+
+    // 区间必须首尾相接、索引不越界 (损坏的缓存等情况下整条链丢弃，只画 LOD 0)
+    size_t expected = 0;
+    for (const MeshLod& level : lods.levels) {
+        if (level.indexOffset != expected) break;
+        expected += level.indexCount;
+    }
+    bool valid = expected == lods.indices.size();
+    for (size_t i = 0; valid && i < lods.indices.size(); ++i) valid = lods.indices[i] < _geometry->vertexCount;
+    if (!valid) {
+        std::cerr << "[Model] Invalid LOD chain, ignored" << std::endl;
+        lods = MeshLodChain();
+    }
+    _geometry->lods = std::move(lods);
+}
+
+float Model::getLodError(int lod) const
+{
+    const auto& levels = _geometry->lods.levels;
+    if (lod <= 0 || levels.empty()) return 0.0f;
+    return levels[std::min(lod, static_cast<int>(levels.size())) - 1].error;
+}
+
+size_t Model::getLodFaceCount(int lod) const
+{
+    const auto& levels = _geometry->lods.levels;
+    if (lod <= 0 || levels.empty()) return _geometry->indexCount / 3;
+    return levels[std::min(lod, static_cast<int>(levels.size())) - 1].indexCount / 3;
+}
+
+void Model::setClusters(MeshClusterSet&& clusters)
+{
+    if (_geometry->isUploaded) return;
+
+    // 每一级 LOD 一段 (可以为空)，簇的索引区间不能超出所在级别
+    const auto& offsets = clusters.levelOffsets;
+    const auto& levels = _geometry->lods.levels;
+    bool valid = clusters.empty()
+        || (offsets.size() == levels.size() + 2 && offsets.front() == 0 && offsets.back() == clusters.clusters.size());
+    for (size_t l = 0; valid && !clusters.empty() && l + 1 < offsets.size(); ++l) {
+        valid = offsets[l] <= offsets[l + 1];
+        size_t levelCount = l == 0 ? _geometry->indexCount : levels[l - 1].indexCount;
+        for (uint32_t c = offsets[l]; valid && c < offsets[l + 1]; ++c) {
+            const MeshCluster& cluster = clusters.clusters[c];
+            valid = static_cast<size_t>(cluster.indexOffset) + cluster.indexCount <= levelCount;
+        }
+    }
+    if (!valid) {
+        std::cerr << "[Model] Invalid cluster set, ignored" << std::endl;
+        clusters = MeshClusterSet();
+    }
+    _geometry->clusters = std::move(clusters);
+}
+
+size_t Model::getClusterCount(int lod) const
+{
+    const MeshClusterSet& set = _geometry->clusters;
+    if (set.empty()) return 0;
+    int level = std::clamp(lod, 0, static_cast<int>(_geometry->lods.levels.size()));
+    return set.levelOffsets[level + 1] - set.levelOffsets[level];
+}
+
+bool Model::cullClusters(int lod, const glm::mat4& modelMatrix, const ClusterCullView& view, ClusterDrawList& out) const
+{
+    out.clear();
+    const MeshClusterSet& set = _geometry->clusters;
+    if (set.empty()) return false;
+
+    const auto& levels = _geometry->lods.levels;
+    int level = std::clamp(lod, 0, static_cast<int>(levels.size()));
+    uint32_t begin = set.levelOffsets[level];
+    uint32_t end = set.levelOffsets[level + 1];
+    if (begin == end) return false;
+
+    // 这一级在 ebo 中的起点 (布局见 drawElements)
+    size_t base = level == 0 ? 0 : _geometry->indexCount + levels[level - 1].indexOffset;
+
+    // 包围球半径按最大轴向缩放放大，保证非均匀缩放下仍然保守
+    glm::mat3 linear(modelMatrix);
+    float scale = std::max(glm::length(linear[0]), std::max(glm::length(linear[1]), glm::length(linear[2])));
+
+    // 法线锥测试在模型局部空间进行；镜像变换 (行列式为负) 会翻转环绕方向，直接跳过
+    bool coneCulling = view.coneCulling && glm::determinant(linear) > 0.0f;
+    glm::vec3 eyeLocal(0.0f), directionLocal(0.0f);
+    if (coneCulling) {
+        glm::mat4 inverse = glm::inverse(modelMatrix);
+        if (view.orthographic) directionLocal = glm::normalize(glm::mat3(inverse) * view.direction);
+        else eyeLocal = glm::vec3(inverse * glm::vec4(view.eye, 1.0f));
+    }
+
+    size_t lastEnd = 0;
+    for (uint32_t c = begin; c < end; ++c) {
+        const MeshCluster& cluster = set.clusters[c];
+
+        if (view.frustum) {
+            glm::vec3 center = glm::vec3(modelMatrix * glm::vec4(cluster.center, 1.0f));
+            if (!view.frustum->intersectSphere(center, cluster.radius * scale)) {
+                out.frustumCulled++;
+                continue;
+            }
+        }
+
+        // 视线与锥轴的夹角小于 90° - 半角时，簇内所有三角形都背对视点
+        if (coneCulling && cluster.coneCutoff < 1.0f) {
+            bool backFacing;
+            if (view.orthographic) {
+                backFacing = glm::dot(directionLocal, cluster.coneAxis) >= cluster.coneCutoff;
+            } else {
+                glm::vec3 toCenter = cluster.center - eyeLocal;
+                backFacing = glm::dot(toCenter, cluster.coneAxis)
+                    >= cluster.coneCutoff * glm::length(toCenter) + cluster.radius;
+            }
+            if (backFacing) {
+                out.coneCulled++;
+                continue;
+            }
+        }
+
+        size_t first = base + cluster.indexOffset;
+        if (!out.counts.empty() && first == lastEnd) {
+            out.counts.back() += static_cast<GLsizei>(cluster.indexCount);
+        } else {
+            out.counts.push_back(static_cast<GLsizei>(cluster.indexCount));
+            out.offsets.push_back(reinterpret_cast<const void*>(first * sizeof(uint32_t)));
+        }
+        lastEnd = first + cluster.indexCount;
+        out.indexCount += cluster.indexCount;
+        out.visibleClusters++;
+    }
+    return true;
+}
+
+void Model::drawClusters(const ClusterDrawList& list, bool depthOnly)
+{
+    if (!_geometry->isUploaded) {
+        initGL();
+    }
+
+    GLuint vao = depthOnly ? _geometry->depthVao : _geometry->vao;
+    if (vao == 0 || list.counts.empty()) return;
+
+    glBindVertexArray(vao);
+    glMultiDrawElements(GL_TRIANGLES, list.counts.data(), GL_UNSIGNED_INT, list.offsets.data(),
+                        static_cast<GLsizei>(list.counts.size()));
+    glBindVertexArray(0);
+}
+
+void Model::setVertexDecodeUniforms(const GLSLProgram& shader) const
+{
+    const PackedVertexData& packed = _geometry->packed;
+    const GLSLProgram::VertexDecodeLocations& locations = shader.getVertexDecodeLocations();
+
+    if (locations.packedVertex != -1) glUniform1i(locations.packedVertex, packed.format != VertexFormat::Standard);
+    if (locations.positionScale != -1) {
+        glUniform3f(locations.positionScale, packed.positionScale.x, packed.positionScale.y, packed.positionScale.z);
+    }
+    if (locations.positionOffset != -1) {
+        glUniform3f(locations.positionOffset, packed.positionOffset.x, packed.positionOffset.y, packed.positionOffset.z);
+    }
 }
 
 void Model::initGL()
 {
-    if (_isUploaded) return; // 防止重复初始化
+    if (_geometry->isUploaded) return; // 防止重复初始化 (共享的几何数据只上传一次)
 
     // 确保此时有 OpenGL 上下文 (如果没有，glGetError 或 glGen* 会报错/崩溃，但此时通常都在渲染循环里了)
     initGLResources();
+    initDepthGLResources();
     initBoxGLResources();
 
-    _isUploaded = true;
+    _geometry->isUploaded = true;
+    std::vector<uint8_t>().swap(_geometry->packed.bytes);
+    std::vector<uint32_t>().swap(_geometry->lods.indices);
+
+    // 数据已经在显存里，按策略释放 CPU 端的副本
+    _geometry->applyResidency();
 }
 
-void Model::draw()
+void Model::draw(int lod)
 {
-    if (!_isUploaded) {
+    if (!_geometry->isUploaded) {
         // const_cast 是一种妥协，或者将 initGL 声明为 const 并把内部变量设为 mutable
         // 这里最优雅的方式是将 _isUploaded 设为 mutable (已在 .h 中完成)
         const_cast<Model*>(this)->initGL();
     }
 
-    if (_vao == 0) return; // 如果初始化失败，防止崩溃
+    if (_geometry->vao == 0) return; // 如果初始化失败，防止崩溃
 
-    glBindVertexArray(_vao);
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(_indices.size()), GL_UNSIGNED_INT, 0);
+    drawElements(_geometry->vao, lod);
+}
+
+void Model::drawDepth(int lod)
+{
+    if (!_geometry->isUploaded) {
+        initGL();
+    }
+
+    if (_geometry->depthVao == 0) return;
+
+    drawElements(_geometry->depthVao, lod);
+}
+
+void Model::drawElements(GLuint vao, int lod) const
+{
+    // ebo 布局：[LOD 0][LOD 1][LOD 2]...
+    size_t first = 0;
+    size_t count = _geometry->indexCount;
+    const auto& levels = _geometry->lods.levels;
+    if (lod > 0 && !levels.empty()) {
+        const MeshLod& level = levels[std::min(lod, static_cast<int>(levels.size())) - 1];
+        first = _geometry->indexCount + level.indexOffset;
+        count = level.indexCount;
+    }
+
+    glBindVertexArray(vao);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(count), GL_UNSIGNED_INT,
+                   reinterpret_cast<const void*>(first * sizeof(uint32_t)));
     glBindVertexArray(0);
 }
 
 void Model::drawBoundingBox()
 {
-    if (!_isUploaded) {
+    if (!_geometry->isUploaded) {
          const_cast<Model*>(this)->initGL();
     }
 
-    if (_boxVao == 0) return;
+    if (_geometry->boxVao == 0) return;
     
-    glBindVertexArray(_boxVao);
+    glBindVertexArray(_geometry->boxVao);
     glDrawElements(GL_LINES, 24, GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
 }
 
 GLuint Model::getVao() const
 {
-    return _vao;
+    return _geometry->vao;
 }
 
 GLuint Model::getBoundingBoxVao() const
 {
-    return _boxVao;
+    return _geometry->boxVao;
 }
 
 size_t Model::getVertexCount() const
 {
-    return _vertices.size();
+    return _geometry->vertexCount;
 }
 
 size_t Model::getFaceCount() const
 {
-    return _indices.size() / 3;
+    return _geometry->indexCount / 3;
 }
 
 void Model::initGLResources()
 {
     // create a vertex array object
-    glGenVertexArrays(1, &_vao);
+    glGenVertexArrays(1, &_geometry->vao);
     // create a vertex buffer object
-    glGenBuffers(1, &_vbo);
+    glGenBuffers(1, &_geometry->vbo);
     // create a element array buffer
-    glGenBuffers(1, &_ebo);
+    glGenBuffers(1, &_geometry->ebo);
+
+    glBindVertexArray(_geometry->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, _geometry->vbo);
+
+    // 有压缩数据时上传压缩格式，否则直接上传 Vertex 数组
+    const PackedVertexData &packed = _geometry->packed;
+    VertexFormat format = packed.bytes.empty() ? VertexFormat::Standard : packed.format;
+    if (format != VertexFormat::Standard) {
+        glBufferData(GL_ARRAY_BUFFER, packed.bytes.size(), packed.bytes.data(), GL_STATIC_DRAW);
+    } else {
+        _geometry->packed = PackedVertexData();
+        glBufferData(
+            GL_ARRAY_BUFFER, sizeof(Vertex) * _geometry->vertices.size(), _geometry->vertices.data(), GL_STATIC_DRAW);
+    }
 
-    glBindVertexArray(_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-    glBufferData(
-        GL_ARRAY_BUFFER, sizeof(Vertex) * _vertices.size(), _vertices.data(), GL_STATIC_DRAW);
+    // LOD 0 之后紧跟各级 LOD 的索引
+    const std::vector<uint32_t> &lodIndices = _geometry->lods.indices;
+    size_t baseBytes = _geometry->indices.size() * sizeof(uint32_t);
+    size_t lodBytes = lodIndices.size() * sizeof(uint32_t);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _geometry->ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, baseBytes + lodBytes, nullptr, GL_STATIC_DRAW);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, baseBytes, _geometry->indices.data());
+    if (lodBytes > 0) glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, baseBytes, lodBytes, lodIndices.data());
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
-    glBufferData(
-        GL_ELEMENT_ARRAY_BUFFER, _indices.size() * sizeof(uint32_t), _indices.data(),
-        GL_STATIC_DRAW);
+    // location 0: position, 1: normal, 2: texCoord, 3: tangent (各格式的具体布局见 vertex_packing.h)
+    VertexPacking::setupAttributes(format);
 
-    // specify layout, size of a vertex, data type, normalize, sizeof vertex array, offset of the
-    // attribute
-    // location 0: position
-    glVertexAttribPointer(
-        0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, position));
-    glEnableVertexAttribArray(0);
-    // location 1: normal
-    glVertexAttribPointer(
-        1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, normal));
-    glEnableVertexAttribArray(1);
-    // location 2: texCoord
-    glVertexAttribPointer(
-        2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, texCoord));
-    glEnableVertexAttribArray(2);
-    // location 3: tangent
-    glVertexAttribPointer(
-        3, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, tangent));
-    glEnableVertexAttribArray(3);
+    glBindVertexArray(0);
+}
+
+void Model::initDepthGLResources()
+{
+    // 位置与主顶点缓冲的编码相同 (量化格式直接取 unorm16)，解码参数通用
+    VertexFormat format = _geometry->packed.bytes.empty() ? VertexFormat::Standard : _geometry->packed.format;
+    std::vector<uint8_t> positions = VertexPacking::extractPositions(_geometry->vertices, _geometry->packed);
+
+    glGenVertexArrays(1, &_geometry->depthVao);
+    glGenBuffers(1, &_geometry->depthVbo);
+
+    glBindVertexArray(_geometry->depthVao);
+    glBindBuffer(GL_ARRAY_BUFFER, _geometry->depthVbo);
+    glBufferData(GL_ARRAY_BUFFER, positions.size(), positions.data(), GL_STATIC_DRAW);
+
+    // 索引与主 VAO 共用同一个 ebo
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _geometry->ebo);
+    VertexPacking::setupPositionAttribute(format);
 
     glBindVertexArray(0);
 }
 
+void Model::onDataAssigned()
+{
+    _geometry->vertexCount = _geometry->vertices.size();
+    _geometry->indexCount = _geometry->indices.size();
+    computeBoundingBox();
+}
+
 void Model::computeBoundingBox()
 {
     float minX = std::numeric_limits<float>::max();
@@ -161,7 +524,8 @@ void Model::computeBoundingBox()
     float maxY = -std::numeric_limits<float>::max();
     float maxZ = -std::numeric_limits<float>::max();
 
-    for (const auto &v : _vertices)
+    BoundingBox &box = _geometry->boundingBox;
+    for (const auto &v : _geometry->vertices)
     {
         minX = std::min(v.position.x, minX);
         minY = std::min(v.position.y, minY);
@@ -171,8 +535,8 @@ void Model::computeBoundingBox()
         maxZ = std::max(v.position.z, maxZ);
     }
 
-    _boundingBox.min = glm::vec3(minX, minY, minZ);
-    _boundingBox.max = glm::vec3(maxX, maxY, maxZ);
+    box.min = glm::vec3(minX, minY, minZ);
+    box.max = glm::vec3(maxX, maxY, maxZ);
 
     // =========================================================
     // [修复] 防止零厚度导致的射线检测失败
@@ -180,50 +544,51 @@ void Model::computeBoundingBox()
     // =========================================================
     constexpr float EPSILON = 0.01f;
 
-    if ((_boundingBox.max.x - _boundingBox.min.x) < EPSILON)
+    if ((box.max.x - box.min.x) < EPSILON)
     {
-        _boundingBox.max.x += EPSILON;
-        _boundingBox.min.x -= EPSILON;
+        box.max.x += EPSILON;
+        box.min.x -= EPSILON;
     }
-    if ((_boundingBox.max.y - _boundingBox.min.y) < EPSILON)
+    if ((box.max.y - box.min.y) < EPSILON)
     {
-        _boundingBox.max.y += EPSILON;
-        _boundingBox.min.y -= EPSILON; // 向下加厚一点
+        box.max.y += EPSILON;
+        box.min.y -= EPSILON; // 向下加厚一点
     }
-    if ((_boundingBox.max.z - _boundingBox.min.z) < EPSILON)
+    if ((box.max.z - box.min.z) < EPSILON)
     {
-        _boundingBox.max.z += EPSILON;
-        _boundingBox.min.z -= EPSILON;
+        box.max.z += EPSILON;
+        box.min.z -= EPSILON;
     }
 }
 
 void Model::initBoxGLResources()
 {
+    const BoundingBox &box = _geometry->boundingBox;
     std::vector<glm::vec3> boxVertices = {
-        glm::vec3(_boundingBox.min.x, _boundingBox.min.y, _boundingBox.min.z),
-        glm::vec3(_boundingBox.max.x, _boundingBox.min.y, _boundingBox.min.z),
-        glm::vec3(_boundingBox.min.x, _boundingBox.max.y, _boundingBox.min.z),
-        glm::vec3(_boundingBox.max.x, _boundingBox.max.y, _boundingBox.min.z),
-        glm::vec3(_boundingBox.min.x, _boundingBox.min.y, _boundingBox.max.z),
-        glm::vec3(_boundingBox.max.x, _boundingBox.min.y, _boundingBox.max.z),
-        glm::vec3(_boundingBox.min.x, _boundingBox.max.y, _boundingBox.max.z),
-        glm::vec3(_boundingBox.max.x, _boundingBox.max.y, _boundingBox.max.z),
+        glm::vec3(box.min.x, box.min.y, box.min.z),
+        glm::vec3(box.max.x, box.min.y, box.min.z),
+        glm::vec3(box.min.x, box.max.y, box.min.z),
+        glm::vec3(box.max.x, box.max.y, box.min.z),
+        glm::vec3(box.min.x, box.min.y, box.max.z),
+        glm::vec3(box.max.x, box.min.y, box.max.z),
+        glm::vec3(box.min.x, box.max.y, box.max.z),
+        glm::vec3(box.max.x, box.max.y, box.max.z),
     };
 
     std::vector<uint32_t> boxIndices = {0, 1, 0, 2, 0, 4, 3, 1, 3, 2, 3, 7,
                                         5, 4, 5, 1, 5, 7, 6, 4, 6, 7, 6, 2};
 
-    glGenVertexArrays(1, &_boxVao);
-    glGenBuffers(1, &_boxVbo);
-    glGenBuffers(1, &_boxEbo);
+    glGenVertexArrays(1, &_geometry->boxVao);
+    glGenBuffers(1, &_geometry->boxVbo);
+    glGenBuffers(1, &_geometry->boxEbo);
 
-    glBindVertexArray(_boxVao);
-    glBindBuffer(GL_ARRAY_BUFFER, _boxVbo);
+    glBindVertexArray(_geometry->boxVao);
+    glBindBuffer(GL_ARRAY_BUFFER, _geometry->boxVbo);
     glBufferData(
         GL_ARRAY_BUFFER, boxVertices.size() * sizeof(glm::vec3), boxVertices.data(),
         GL_STATIC_DRAW);
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _boxEbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _geometry->boxEbo);
     glBufferData(
         GL_ELEMENT_ARRAY_BUFFER, boxIndices.size() * sizeof(uint32_t), boxIndices.data(),
         GL_STATIC_DRAW);
@@ -233,42 +598,3 @@ void Model::initBoxGLResources()
 
     glBindVertexArray(0);
 }
-
-void Model::cleanup()
-{
-    if (_boxEbo)
-    {
-        glDeleteBuffers(1, &_boxEbo);
-        _boxEbo = 0;
-    }
-
-    if (_boxVbo)
-    {
-        glDeleteBuffers(1, &_boxVbo);
-        _boxVbo = 0;
-    }
-
-    if (_boxVao)
-    {
-        glDeleteVertexArrays(1, &_boxVao);
-        _boxVao = 0;
-    }
-
-    if (_ebo != 0)
-    {
-        glDeleteBuffers(1, &_ebo);
-        _ebo = 0;
-    }
-
-    if (_vbo != 0)
-    {
-        glDeleteBuffers(1, &_vbo);
-        _vbo = 0;
-    }
-
-    if (_vao != 0)
-    {
-        glDeleteVertexArrays(1, &_vao);
-        _vao = 0;
-    }
-}
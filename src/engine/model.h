@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -7,6 +8,143 @@
 #include "base/gl_utility.h"
 #include "base/transform.h"
 #include "base/vertex.h"
+#include "engine/asset_data.h"
+#include "engine/vertex_packing.h"
+
+#include <glm/gtc/type_precision.hpp>
+
+struct Ray;
+struct ClusterCullView;
+struct ClusterDrawList;
+class GLSLProgram;
+
+// 上传到 GPU 之后 CPU 端网格数据的保留方式
+// 完整数据只用于拾取和导出 OBJ；对千万级顶点的扫描模型，它和显存里的那份一样大。
+enum class MeshResidency : uint8_t
+{
+    Full,           // 保留完整的顶点/索引数组 (默认)
+    PickingProxy,   // 只保留拾取用的位置 + 索引 (每顶点 12 字节)
+    QuantizedProxy, // 位置量化到包围盒内的 16 bit (每顶点 6 字节)
+    GpuOnly         // 全部丢弃；拾取退化为包围盒，导出时从网格缓存重新读取
+};
+
+// 拾取代理：只含三角形求交需要的数据
+struct PickingProxy
+{
+    std::vector<glm::vec3> positions;
+    std::vector<glm::u16vec3> quantized;   // p = origin + q * step
+    glm::vec3 origin{ 0.0f };
+    glm::vec3 step{ 0.0f };
+    std::vector<uint32_t> indices;
+
+    bool empty() const { return indices.empty(); }
+
+    size_t getByteSize() const
+    {
+        return positions.size() * sizeof(glm::vec3) + quantized.size() * sizeof(glm::u16vec3)
+            + indices.size() * sizeof(uint32_t);
+    }
+
+    void clear() { *this = PickingProxy(); }
+};
+
+// 几何数据的来源，GpuOnly / 代理模式下据此从网格缓存重新读取完整数据
+struct MeshSourceInfo
+{
+    std::string fullPath;       // 空表示程序生成 (GeometryFactory 等)，无法重新读取
+    std::string subMeshName;
+    bool useFlatShade = false;
+    bool fromScene = false;     // 来自 loadSceneMeshes (按子网格名取) 还是 loadMeshData
+
+    bool isReloadable() const { return !fullPath.empty(); }
+};
+
+// 网格的几何数据及其 GL 对象
+// 内容完全相同的网格 (例如不同文件里的同一个子网格) 共享同一份，
+// 每个 Model 仍然是独立的对象 (各自的 transform、热重载时各自替换)。
+// 最后一个引用它的 Model 释放时一并删除 GL 对象，所以也只能在主线程释放。
+struct MeshGeometry
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    bool hasUVs = false;
+    BoundingBox boundingBox;
+
+    // 数量单独保存：CPU 数据被释放后绘制与统计仍然需要
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+
+    // CPU 端数据的保留方式，上传之后生效 (共享这份数据的 Model 共用同一策略)
+    MeshResidency residency = MeshResidency::Full;
+    PickingProxy proxy;
+    MeshSourceInfo source;
+
+    // 显存中的顶点格式；压缩数据在工作线程打包，上传后释放字节 (解码参数与误差保留)
+    PackedVertexData packed;
+
+    // LOD 链：索引在上传时接在 LOD 0 之后写入同一个 ebo，之后释放 (levels 保留，绘制时按偏移取)
+    MeshLodChain lods;
+
+    // 网格簇 (只有大网格才有)，绘制前逐簇剔除，常驻 CPU (每簇 40 字节)
+    MeshClusterSet clusters;
+
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    GLuint ebo = 0;
+
+    // 只含位置的顶点流 (与主 VAO 共用 ebo)，深度类 pass 使用
+    GLuint depthVao = 0;
+    GLuint depthVbo = 0;
+
+    GLuint boxVao = 0;
+    GLuint boxVbo = 0;
+    GLuint boxEbo = 0;
+
+    bool isUploaded = false;
+
+    // 内容哈希 (0 表示未参与去重)
+    uint64_t contentHash = 0;
+
+    MeshGeometry() = default;
+    MeshGeometry(const MeshGeometry&) = delete;
+    MeshGeometry& operator=(const MeshGeometry&) = delete;
+    ~MeshGeometry();
+
+    // LOD 1.. 的索引总数 (上传后 lods.indices 已释放，按 levels 计算)
+    size_t getLodIndexCount() const
+    {
+        return lods.levels.empty() ? 0 : lods.levels.back().indexOffset + lods.levels.back().indexCount;
+    }
+
+    // 上传到 GPU 的字节数 (顶点 + 位置流 + 索引，含 LOD)
+    size_t getGpuByteSize() const
+    {
+        return vertexCount * (VertexPacking::getStride(packed.format) + VertexPacking::getPositionStride(packed.format))
+            + (indexCount + getLodIndexCount()) * sizeof(uint32_t);
+    }
+
+    // 当前驻留在内存中的 CPU 字节数 (完整数据 + 拾取代理 + 待上传的压缩顶点与 LOD 索引)
+    size_t getCpuByteSize() const
+    {
+        return vertices.size() * sizeof(Vertex) + indices.size() * sizeof(uint32_t) + proxy.getByteSize()
+            + packed.bytes.size() + lods.indices.size() * sizeof(uint32_t)
+            + clusters.clusters.size() * sizeof(MeshCluster);
+    }
+
+    // 按 format 生成上传用的压缩顶点 (上传之前调用，可在工作线程)
+    void packVertices(VertexFormat format);
+
+    bool hasFullCpuData() const { return vertices.size() == vertexCount && indices.size() == indexCount; }
+
+    // 按 residency 释放 CPU 数据 (需要完整数据才能构建代理；已上传后才会真正释放)
+    void applyResidency();
+
+    // 重新填回完整数据 (从网格缓存读取后)，代理随之清除
+    void restoreCpuData(std::vector<Vertex>&& v, std::vector<uint32_t>&& i);
+
+    // 对顶点与索引数据计算内容哈希 (可在任意线程调用)
+    static uint64_t hashContent(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+};
 
 class Model
 {
@@ -15,6 +153,11 @@ public:
 
     Model(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices);
 
+    Model(std::vector<Vertex> &&vertices, std::vector<uint32_t> &&indices);
+
+    // 共享一份已有的几何数据 (内容去重)
+    explicit Model(std::shared_ptr<MeshGeometry> geometry);
+
     Model(Model &&rhs) noexcept;
 
     Model(const Model &) = delete;
@@ -30,47 +173,84 @@ public:
 
     void initGL();
 
-    virtual void draw();
+    // [主线程] 与另一个模型交换几何数据和 GL 对象 (热重载时原地替换，
+    // 引用这个 Model 的组件无需改动)。旧数据随 other 一起析构。
+    // 只交换本对象持有的那份引用，与它共享几何数据的其他 Model 不受影响。
+    void swapGeometry(Model& other);
+
+    const std::shared_ptr<MeshGeometry>& getGeometry() const { return _geometry; }
+
+    // 局部空间射线与网格求交，按当前驻留的数据选择：完整数据 > 拾取代理 > 包围盒
+    bool raycast(const Ray& localRay, float& outT) const;
+
+    MeshResidency getResidency() const { return _geometry->residency; }
+
+    // [上传前] 设置 LOD 链 (导入时生成，或由 GeometryFactory 现场生成)
+    void setLods(MeshLodChain&& lods);
+
+    // LOD 级别数 (含 LOD 0)；lod 超出范围时按最粗的一级处理
+    int getLodCount() const { return 1 + static_cast<int>(_geometry->lods.levels.size()); }
+    float getLodError(int lod) const;
+    size_t getLodFaceCount(int lod) const;
+
+    // [上传前] 设置网格簇 (须在 setLods 之后，按级别校验)
+    void setClusters(MeshClusterSet&& clusters);
+
+    // 某一级 LOD 的簇数 (0 表示这一级没有划分)
+    size_t getClusterCount(int lod) const;
+
+    // 对 lod 级的簇做视锥 / 法线锥剔除，存活的索引区间写入 out (相邻区间合并)
+    // 这一级没有簇时返回 false，调用方按整个网格绘制
+    bool cullClusters(int lod, const glm::mat4& modelMatrix, const ClusterCullView& view, ClusterDrawList& out) const;
+
+    // 绘制 cullClusters 留下的区间 (depthOnly 使用只含位置的顶点流，同 drawDepth)
+    void drawClusters(const ClusterDrawList& list, bool depthOnly);
+
+    // 设置着色器中的顶点解码参数 (packedVertex / positionScale / positionOffset)，
+    // 绘制场景网格的着色器在每次 draw 之前调用；着色器里没有的 uniform 会被跳过
+    void setVertexDecodeUniforms(const GLSLProgram& shader) const;
+
+    virtual void draw(int lod = 0);
+
+    // 只读位置流的绘制 (阴影、背面深度、描边遮罩等不需要法线/UV 的 pass)，
+    // 着色器只需声明 location 0 的位置与 positionScale / positionOffset
+    void drawDepth(int lod = 0);
 
     virtual void drawBoundingBox();
 
+    // CPU 数据未驻留 (见 MeshResidency) 时为空，需要时通过 ResourceManager::loadCpuMeshData 读取
     const std::vector<uint32_t> &getIndices() const
     {
-        return _indices;
+        return _geometry->indices;
     }
     const std::vector<Vertex> &getVertices() const
     {
-        return _vertices;
+        return _geometry->vertices;
     }
     const Vertex &getVertex(int i) const
     {
-        return _vertices[i];
+        return _geometry->vertices[i];
     }
     
-    bool hasUVs() const { return _hasUVs; }
+    bool hasUVs() const { return _geometry->hasUVs; }
+
+    bool isUploaded() const { return _geometry->isUploaded; }
+
+    // 上传到 GPU 的字节数 (顶点 + 索引)，用于上传预算统计
+    // 共享的几何数据只上传一次，已上传时返回 0
+    size_t getGpuByteSize() const
+    {
+        return _geometry->isUploaded ? 0 : _geometry->getGpuByteSize();
+    }
 
 public:
     Transform transform;
 
 protected:
-    // vertices of the table represented in model's own coordinate
-    std::vector<Vertex> _vertices;
-    std::vector<uint32_t> _indices;
-    bool _hasUVs = false;
-
-    // bounding box
-    BoundingBox _boundingBox;
+    std::shared_ptr<MeshGeometry> _geometry;
 
-    // opengl objects
-    GLuint _vao = 0;
-    GLuint _vbo = 0;
-    GLuint _ebo = 0;
-
-    GLuint _boxVao = 0;
-    GLuint _boxVbo = 0;
-    GLuint _boxEbo = 0;
-
-    bool _isUploaded = false;
+    // 顶点/索引数据就绪后调用：记录数量并计算包围盒
+    void onDataAssigned();
 
     void computeBoundingBox();
 
@@ -78,5 +258,8 @@ protected:
 
     void initBoxGLResources();
 
-    void cleanup();
+    void initDepthGLResources();
+
+    // 按 LOD 在 ebo 中的区间绘制
+    void drawElements(GLuint vao, int lod) const;
 };
\ No newline at end of file
@@ -1,6 +1,10 @@
 #include "obj_loader.h"
 #include "geometry_factory.h"
 #include "utils/profiler.h"
+#include "utils/job_system.h"
+#include "mesh_optimizer.h"
+#include "mesh_simplifier.h"
+#include "mesh_clusters.h"
 #include <fstream>
 #include <iostream>
 #include <vector>
@@ -142,6 +146,8 @@ MeshData OBJLoader::load(const std::string& filepath, bool useFlatShade, const s
             data.vertices = std::move(meshes[0].vertices);
             data.indices = std::move(meshes[0].indices);
             data.hasUVs = meshes[0].hasUVs;
+            data.lods = std::move(meshes[0].lods);
+            data.clusters = std::move(meshes[0].clusters);
         } else {
             // 如果有多个 mesh，我们需要把它们合并成一个 MeshData
             // 或者现在的架构其实不需要合并，因为 ResourceManager::getModel 应该只用于简单的单体
@@ -150,6 +156,8 @@ MeshData OBJLoader::load(const std::string& filepath, bool useFlatShade, const s
              data.vertices = std::move(meshes[0].vertices);
              data.indices = std::move(meshes[0].indices);
              data.hasUVs = meshes[0].hasUVs;
+             data.lods = std::move(meshes[0].lods);
+             data.clusters = std::move(meshes[0].clusters);
         }
     } else {
         // 查找匹配的
@@ -158,6 +166,8 @@ MeshData OBJLoader::load(const std::string& filepath, bool useFlatShade, const s
                 data.vertices = std::move(m.vertices);
                 data.indices = std::move(m.indices);
                 data.hasUVs = m.hasUVs;
+                data.lods = std::move(m.lods);
+                data.clusters = std::move(m.clusters);
                 break;
             }
         }
@@ -166,7 +176,7 @@ MeshData OBJLoader::load(const std::string& filepath, bool useFlatShade, const s
 }
 
 std::vector<SubMesh> OBJLoader::loadScene(const std::string& filepath, bool useFlatShade) {
-    ScopedTimer timer("OBJLoader::loadScene (" + filepath + ")");
+    AssetLoadScope scope("OBJLoader::loadScene (" + filepath + ")");
 
     // 1. 一次性读取整个文件到 Buffer [Memory Mapped File 思想]
     std::ifstream file(filepath, std::ios::ate | std::ios::binary);
@@ -215,25 +225,13 @@ std::vector<SubMesh> OBJLoader::loadScene(const std::string& filepath, bool useF
     std::unordered_map<Vertex, uint32_t> uniqueVertices;
     uniqueVertices.reserve(estimatedVerts); // 预留 Bucket
 
+    // 每个子网格是否需要自动计算法线 (在切分时按当时是否读到过 vn 决定)
+    std::vector<uint8_t> needsNormals;
+
     auto flushCurrentMesh = [&]() {
         if (!currentMesh.indices.empty()) {
-            // 自动计算法线
-            if (!useFlatShade && global_normals.empty()) {
-                // ... (法线计算逻辑同前) ...
-                // 这里的计算量较大，如果模型自带法线则不会执行
-                for (size_t i = 0; i < currentMesh.indices.size(); i += 3) {
-                    Vertex& v0 = currentMesh.vertices[currentMesh.indices[i]];
-                    Vertex& v1 = currentMesh.vertices[currentMesh.indices[i+1]];
-                    Vertex& v2 = currentMesh.vertices[currentMesh.indices[i+2]];
-                    glm::vec3 e1 = v1.position - v0.position;
-                    glm::vec3 e2 = v2.position - v0.position;
-                    glm::vec3 n = glm::normalize(glm::cross(e1, e2));
-                    v0.normal = n; v1.normal = n; v2.normal = n;
-                }
-            }
-            // 计算切线
-            GeometryFactory::computeTangents(currentMesh.vertices, currentMesh.indices);
-            
+            // 法线与切线留到解析结束后按子网格并行计算
+            needsNormals.push_back(!useFlatShade && global_normals.empty() ? 1 : 0);
             meshes.push_back(std::move(currentMesh));
         }
         // Reset
@@ -424,10 +422,46 @@ std::vector<SubMesh> OBJLoader::loadScene(const std::string& filepath, bool useF
     // 处理最后一个 Mesh
     flushCurrentMesh();
 
+    // 后处理：各子网格互不相关，按子网格分给 JobSystem 并行 (大网格的切线计算内部还会再拆分)
+    JobSystem::Get().parallelFor(0, meshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; ++m)
+        {
+            SubMesh& mesh = meshes[m];
+
+            // 自动计算法线
+            // 这里的计算量较大，如果模型自带法线则不会执行
+            if (needsNormals[m]) {
+                for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+                    Vertex& v0 = mesh.vertices[mesh.indices[i]];
+                    Vertex& v1 = mesh.vertices[mesh.indices[i+1]];
+                    Vertex& v2 = mesh.vertices[mesh.indices[i+2]];
+                    glm::vec3 e1 = v1.position - v0.position;
+                    glm::vec3 e2 = v2.position - v0.position;
+                    glm::vec3 n = glm::normalize(glm::cross(e1, e2));
+                    v0.normal = n; v1.normal = n; v2.normal = n;
+                }
+            }
+            // 计算切线
+            GeometryFactory::computeTangents(mesh.vertices, mesh.indices);
+        }
+    });
+
+    // 为 GPU 重排三角形与顶点 (结果随网格缓存保存，之后加载不再重复)
+    MeshOptimizer::Result optimized = MeshOptimizer::optimizeScene(meshes);
+
+    // 在最终的顶点顺序上生成 LOD 链 (LOD 索引引用同一份顶点)
+    MeshSimplifier::buildSceneLods(meshes);
+
+    // 大网格划分成簇用于逐簇剔除 (重排各级 LOD 的索引，须在 LOD 之后)
+    MeshClusters::buildScene(meshes);
+
     std::cout << "Loaded Scene OBJ stats:" 
               << "\n  File Size: " << fileSize / 1024 << " KB"
               << "\n  Total SubMeshes: " << meshes.size()
               << "\n  Total Global Verts: " << global_positions.size() 
+              << "\n  Vertex Cache: " << MeshOptimizer::describe(optimized)
+              << "\n  LODs: " << MeshSimplifier::describe(meshes)
+              << "\n  Clusters: " << MeshClusters::describe(meshes)
               << std::endl;
 
     return meshes;
@@ -135,8 +135,10 @@ void OutlinePass::initShaders()
         uniform mat4 model;
         uniform mat4 view;
         uniform mat4 projection;
+        uniform vec3 positionScale = vec3(1.0);   // 量化位置的解码参数 (见 VertexPacking)
+        uniform vec3 positionOffset = vec3(0.0);
         void main() {
-            gl_Position = projection * view * model * vec4(aPos, 1.0);
+            gl_Position = projection * view * model * vec4(aPos * positionScale + positionOffset, 1.0);
         }
     )";
     const char *maskFs = R"(
@@ -275,11 +277,11 @@ void OutlinePass::render(GameObject *targetObj, Camera *camera, float contentSca
     _maskShader->setUniformMat4("projection", camera->getProjectionMatrix());
 
     // 遍历该物体的所有 Mesh 组件进行渲染
-    for (const auto &comp : targetObj->components)
+    for (Component *comp : targetObj->getComponents())
     {
         if (comp->getType() == ComponentType::MeshRenderer)
         {
-            auto mesh = static_cast<MeshComponent *>(comp.get());
+            auto mesh = static_cast<MeshComponent *>(comp);
             if (!mesh->enabled)
                 continue;
             // Gizmo 通常不画外框，跳过
@@ -287,14 +289,15 @@ void OutlinePass::render(GameObject *targetObj, Camera *camera, float contentSca
             //     continue;
 
             // 计算矩阵
-            glm::mat4 modelMatrix = targetObj->transform.getLocalMatrix();
+            glm::mat4 modelMatrix = targetObj->getWorldMatrix();
             modelMatrix = modelMatrix * mesh->model->transform.getLocalMatrix();
             _maskShader->setUniformMat4("model", modelMatrix);
+            mesh->model->setVertexDecodeUniforms(*_maskShader);
 
 			if (mesh->doubleSided) {
                 glDisable(GL_CULL_FACE); // 允许绘制背面到 Mask
             }
-            mesh->model->draw();
+            mesh->model->drawDepth(); // 遮罩只需要位置
             if (mesh->doubleSided) {
                 glEnable(GL_CULL_FACE); // 恢复背面剔除
             }
@@ -3,6 +3,7 @@
 #include <glm/glm.hpp>
 #include <algorithm>
 #include <limits>
+#include <vector>
 #include "base/vertex.h"
 #include "base/bounding_box.h" // 你的 base 里应该有这个，如果没有请看 Model 类里的定义
 
@@ -99,16 +100,27 @@ public:
                                  const std::vector<Vertex>& vertices, 
                                  const std::vector<uint32_t>& indices, 
                                  float& tMin)
+    {
+        return intersectRayTriangles(localRay, indices,
+            [&](uint32_t i) -> const glm::vec3& { return vertices[i].position; }, tMin);
+    }
+
+    // 同上，顶点位置由 fetch(index) 提供 (用于只保留位置 / 量化位置的拾取代理)
+    template <typename FetchPosition>
+    static bool intersectRayTriangles(const Ray& localRay,
+                                      const std::vector<uint32_t>& indices,
+                                      FetchPosition&& fetch,
+                                      float& tMin)
     {
         bool hit = false;
         float closestT = std::numeric_limits<float>::max();
 
         // 遍历所有三角形 (每次步进 3)
-        for (size_t i = 0; i < indices.size(); i += 3)
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
         {
-            const glm::vec3& v0 = vertices[indices[i]].position;
-            const glm::vec3& v1 = vertices[indices[i+1]].position;
-            const glm::vec3& v2 = vertices[indices[i+2]].position;
+            glm::vec3 v0 = fetch(indices[i]);
+            glm::vec3 v1 = fetch(indices[i+1]);
+            glm::vec3 v2 = fetch(indices[i+2]);
 
             float t = 0.0f;
             if (intersectRayTriangle(localRay, v0, v1, v2, t))
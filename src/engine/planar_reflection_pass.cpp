@@ -13,8 +13,8 @@ void PlanarReflectionPass::render(const Scene& scene, GameObject* mirrorObj, Cam
 
     // 2. 获取平面信息 (位置和法线)
     // 假设镜面物体的局部坐标系的 +Y 轴就是镜面的法线
-    glm::vec3 planePos = mirrorObj->transform.position;
-    glm::vec3 planeNormal = glm::normalize(mirrorObj->transform.rotation * glm::vec3(0, 1, 0));
+    glm::vec3 planePos = mirrorObj->getWorldPosition();
+    glm::vec3 planeNormal = glm::normalize(mirrorObj->getWorldRotation() * glm::vec3(0, 1, 0));
 
     // 3. 计算虚拟相机的 View 矩阵
     glm::mat4 reflectionView = computeReflectionViewMatrix(mainCamera, planePos, planeNormal);
@@ -55,12 +55,9 @@ void PlanarReflectionPass::render(const Scene& scene, GameObject* mirrorObj, Cam
     // 8. 收集渲染队列 (复用 Renderer 的逻辑)
     // 这里我们简单粗暴地收集所有物体（除了镜子自己）
     // 实际项目中可能需要做视锥剔除
-    std::vector<GameObject*> renderQueue;
-    for(const auto& go : scene.getGameObjects()) {
-        auto mesh = go->getComponent<MeshComponent>();
-        if(mesh && mesh->enabled) {
-            renderQueue.push_back(go.get());
-        }
+    FrameVector<GameObject*> renderQueue(renderer->getFrameArena());
+    for (MeshComponent& mesh : scene.view<MeshComponent>()) {
+        renderQueue.push_back(mesh.owner);
     }
 
     // 9. 调用 Renderer 绘制
@@ -1,4 +1,6 @@
 #include "point_shadow_pass.h"
+#include <array>
+#include <cstdio>
 #include <iostream>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -66,8 +68,10 @@ void PointShadowPass::initShader()
         #version 330 core
         layout (location = 0) in vec3 aPos;
         uniform mat4 model;
+        uniform vec3 positionScale = vec3(1.0);   // 量化位置的解码参数 (见 VertexPacking)
+        uniform vec3 positionOffset = vec3(0.0);
         void main() {
-            gl_Position = model * vec4(aPos, 1.0);
+            gl_Position = model * vec4(aPos * positionScale + positionOffset, 1.0);
         }
     )";
 
@@ -120,7 +124,7 @@ void PointShadowPass::initShader()
     _shader->link();
 }
 
-void PointShadowPass::render(const Scene& scene, const std::vector<PointShadowInfo>& lightInfos)
+void PointShadowPass::render(const Scene& scene, const FrameVector<PointShadowInfo>& lightInfos, int lodBias)
 {
     _shader->use();
     
@@ -140,37 +144,41 @@ void PointShadowPass::render(const Scene& scene, const std::vector<PointShadowIn
         // 投影矩阵：90度 FOV，宽高比 1.0
         glm::mat4 shadowProj = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, info.farPlane);
         
-        std::vector<glm::mat4> shadowTransforms;
-        shadowTransforms.push_back(shadowProj * glm::lookAt(info.position, info.position + glm::vec3( 1.0,  0.0,  0.0), glm::vec3(0.0, -1.0,  0.0)));
-        shadowTransforms.push_back(shadowProj * glm::lookAt(info.position, info.position + glm::vec3(-1.0,  0.0,  0.0), glm::vec3(0.0, -1.0,  0.0)));
-        shadowTransforms.push_back(shadowProj * glm::lookAt(info.position, info.position + glm::vec3( 0.0,  1.0,  0.0), glm::vec3(0.0,  0.0,  1.0)));
-        shadowTransforms.push_back(shadowProj * glm::lookAt(info.position, info.position + glm::vec3( 0.0, -1.0,  0.0), glm::vec3(0.0,  0.0, -1.0)));
-        shadowTransforms.push_back(shadowProj * glm::lookAt(info.position, info.position + glm::vec3( 0.0,  0.0,  1.0), glm::vec3(0.0, -1.0,  0.0)));
-        shadowTransforms.push_back(shadowProj * glm::lookAt(info.position, info.position + glm::vec3( 0.0,  0.0, -1.0), glm::vec3(0.0, -1.0,  0.0)));
-
-        // 传递给 Shader
+        std::array<glm::mat4, 6> shadowTransforms = {
+            shadowProj * glm::lookAt(info.position, info.position + glm::vec3( 1.0,  0.0,  0.0), glm::vec3(0.0, -1.0,  0.0)),
+            shadowProj * glm::lookAt(info.position, info.position + glm::vec3(-1.0,  0.0,  0.0), glm::vec3(0.0, -1.0,  0.0)),
+            shadowProj * glm::lookAt(info.position, info.position + glm::vec3( 0.0,  1.0,  0.0), glm::vec3(0.0,  0.0,  1.0)),
+            shadowProj * glm::lookAt(info.position, info.position + glm::vec3( 0.0, -1.0,  0.0), glm::vec3(0.0,  0.0, -1.0)),
+            shadowProj * glm::lookAt(info.position, info.position + glm::vec3( 0.0,  0.0,  1.0), glm::vec3(0.0, -1.0,  0.0)),
+            shadowProj * glm::lookAt(info.position, info.position + glm::vec3( 0.0,  0.0, -1.0), glm::vec3(0.0, -1.0,  0.0)),
+        };
+
+        // 传递给 Shader (名字写进栈上的缓冲区，不拼接 std::string)
+        char uniformName[32];
         for (int i = 0; i < 6; ++i) {
-            _shader->setUniformMat4("shadowMatrices[" + std::to_string(i) + "]", shadowTransforms[i]);
+            snprintf(uniformName, sizeof(uniformName), "shadowMatrices[%d]", i);
+            _shader->setUniformMat4(uniformName, shadowTransforms[i]);
         }
         _shader->setUniformFloat("farPlane", info.farPlane);
         _shader->setUniformVec3("lightPos", info.position);
 
         // 3. 绘制场景
         // 注意：这里我们简单地画所有物体。为了性能，可以做视锥剔除（但对于全向光源，剔除比较复杂）。
-        for (const auto& go : scene.getGameObjects()) {
-            auto meshComp = go->getComponent<MeshComponent>();
-            if (!meshComp || !meshComp->enabled) continue;
+        for (MeshComponent& mesh : scene.view<MeshComponent>()) {
+            MeshComponent* meshComp = &mesh;
+            GameObject* go = mesh.owner;
             if (meshComp->isGizmo) continue; // Gizmo 不投射阴影
 
             // 这里不需要剔除背面，为了让阴影更准确（尤其是封闭物体），
             // 有时甚至可以剔除正面(GL_FRONT)来修复彼得潘现象，视具体效果而定。
             // 这里暂且不做特殊 Cull Face 设置，沿用默认或外部设置。
             
-            glm::mat4 model = go->transform.getLocalMatrix();
+            glm::mat4 model = go->getWorldMatrix();
             if (meshComp->model) {
                 model = model * meshComp->model->transform.getLocalMatrix();
                 _shader->setUniformMat4("model", model);
-                meshComp->model->draw();
+                meshComp->model->setVertexDecodeUniforms(*_shader);
+                meshComp->model->drawDepth(meshComp->getLodLevel(lodBias));
             }
         }
     }
@@ -7,6 +7,7 @@
 
 #include "base/glsl_program.h"
 #include "scene.h"
+#include "engine/utils/frame_arena.h"
 
 // 用于传递单个点光源的渲染信息
 struct PointShadowInfo {
@@ -24,7 +25,8 @@ public:
     ~PointShadowPass();
 
     // 核心渲染函数
-    void render(const Scene& scene, const std::vector<PointShadowInfo>& lightInfos);
+    // lodBias: 在主视图选出的 LOD 上再粗几级
+    void render(const Scene& scene, const FrameVector<PointShadowInfo>& lightInfos, int lodBias = 0);
 
     // 获取某个槽位的 Cubemap ID
     GLuint getShadowMap(int index) const;
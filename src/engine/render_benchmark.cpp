@@ -0,0 +1,831 @@
+#include "render_benchmark.h"
+#include "camera_path.h"
+#include "geometry_factory.h"
+#include "gpu_profiler.h"
+#include "renderer.h"
+#include "render_snapshot.h"
+#include "resource_manager.h"
+#include "scene.h"
+#include "base/frame_rate_indicator.h"
+#include "base/gl_counters.h"
+#include "engine/utils/profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <glad/gl.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include <glm/ext.hpp>
+#include <json.hpp>
+
+// 没有窗口系统时直接创建 surfaceless EGL 上下文 (只用到头文件，libEGL 运行时加载)
+#if defined(__linux__) && __has_include(<EGL/egl.h>)
+#define BENCHMARK_HAS_EGL 1
+#define EGL_NO_X11
+#define MESA_EGL_NO_X11_HEADERS
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <dlfcn.h>
+#endif
+
+using Json = nlohmann::ordered_json;
+
+namespace {
+
+// 测量结束后再跑几帧，让最后几帧的 GPU 查询结果取回
+constexpr int kFlushFrames = 3;
+// Profiler 捕获环最多保存的帧数 (测量的帧必须都留在捕获环里)
+constexpr int kMaxBenchmarkFrames = 20000 - 64;
+
+// 时间的变化小于这个值 (毫秒) 时不算回归 (计时精度与噪声)
+constexpr double kMinRegressionMs = 0.05;
+
+void printUsage()
+{
+    std::cout << "Usage: --benchmark [--scene <obj/gltf>] [--camera <camera path>] [--frames N] [--warmup N]\n"
+                 "                   [--width W] [--height H] [--output <json>] [--baseline <json>]\n"
+                 "                   [--threshold <fraction>] [--trace <json>]" << std::endl;
+}
+
+// 离屏渲染目标 (同 SceneViewPanel 的 FBO：RGBA8 颜色纹理 + 24 位深度)
+struct OffscreenTarget {
+    GLuint fbo = 0;
+    GLuint texture = 0;
+    GLuint depth = 0;
+
+    bool create(int width, int height)
+    {
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+
+        glGenRenderbuffers(1, &depth);
+        glBindRenderbuffer(GL_RENDERBUFFER, depth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth);
+
+        bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        return complete;
+    }
+
+    void release()
+    {
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (texture) glDeleteTextures(1, &texture);
+        if (depth) glDeleteRenderbuffers(1, &depth);
+        fbo = texture = depth = 0;
+    }
+};
+
+// 内置测试场景：地面、12x12 个混合图元 (含透明物体)、投射阴影的平行光与点光源、一个反射探针和一面镜子，
+// 覆盖 renderScene 中所有的 pass
+void buildDefaultScene(Scene& scene)
+{
+    scene.createDefaultScene();
+
+    auto floor = std::make_unique<GameObject>("Floor");
+    MeshComponent* floorMesh = floor->addComponent<MeshComponent>(GeometryFactory::createPlane(80.0f, 80.0f));
+    floorMesh->shapeType = MeshShapeType::Plane;
+    floorMesh->material.albedo = glm::vec3(0.6f);
+    scene.addGameObject(std::move(floor));
+
+    std::shared_ptr<Model> shapes[3] = {
+        GeometryFactory::createCube(), GeometryFactory::createSphere(), GeometryFactory::createCylinder()
+    };
+    const MeshShapeType shapeTypes[3] = { MeshShapeType::Cube, MeshShapeType::Sphere, MeshShapeType::Cylinder };
+    constexpr int kGrid = 12;
+    constexpr float kSpacing = 3.0f;
+    for (int z = 0; z < kGrid; ++z) {
+        for (int x = 0; x < kGrid; ++x) {
+            int index = z * kGrid + x;
+            auto go = std::make_unique<GameObject>("Shape");
+            MeshComponent* mesh = go->addComponent<MeshComponent>(shapes[index % 3]);
+            mesh->shapeType = shapeTypes[index % 3];
+            mesh->material.albedo = glm::vec3(0.3f + 0.05f * (x % 8), 0.4f, 0.3f + 0.05f * (z % 8));
+            mesh->material.roughness = 0.2f + 0.05f * (index % 12);
+            mesh->material.metallic = (index % 5 == 0) ? 1.0f : 0.0f;
+            if (index % 7 == 0) mesh->material.transparency = 0.5f;
+            go->transform.position = glm::vec3((x - kGrid / 2) * kSpacing, 0.5f, (z - kGrid / 2) * kSpacing);
+            scene.addGameObject(std::move(go));
+        }
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        GameObject* light = scene.createPointLight();
+        float angle = glm::half_pi<float>() * i;
+        light->transform.position = glm::vec3(std::cos(angle) * 10.0f, 4.0f, std::sin(angle) * 10.0f);
+        LightComponent* lightComp = light->getComponent<LightComponent>();
+        lightComp->range = 15.0f;
+        lightComp->castShadows = true;
+    }
+
+    auto probe = std::make_unique<GameObject>("Reflection Probe");
+    probe->addComponent<ReflectionProbeComponent>()->resolution = 256;
+    probe->transform.position = glm::vec3(0.0f, 2.0f, 0.0f);
+    scene.addGameObject(std::move(probe));
+
+    auto mirror = std::make_unique<GameObject>("Mirror");
+    MeshComponent* mirrorMesh = mirror->addComponent<MeshComponent>(GeometryFactory::createPlane(8.0f, 8.0f));
+    mirrorMesh->shapeType = MeshShapeType::Plane;
+    mirror->addComponent<PlanarReflectionComponent>()->resolution = 512;
+    mirror->transform.position = glm::vec3(0.0f, 0.01f, -kGrid * kSpacing * 0.5f - 6.0f);
+    scene.addGameObject(std::move(mirror));
+}
+
+// 场景中网格的包围球 (按物体位置近似)，环绕路径用
+void computeSceneBounds(Scene& scene, glm::vec3& center, float& radius)
+{
+    scene.updateWorldTransforms();
+
+    glm::vec3 minPos(1e30f), maxPos(-1e30f);
+    size_t count = 0;
+    for (MeshComponent& mesh : scene.view<MeshComponent>()) {
+        if (mesh.isGizmo || !mesh.model) continue;
+        glm::vec3 p = mesh.owner->getWorldPosition();
+        minPos = glm::min(minPos, p);
+        maxPos = glm::max(maxPos, p);
+        count++;
+    }
+    if (count == 0) {
+        center = glm::vec3(0.0f);
+        radius = 10.0f;
+        return;
+    }
+    center = 0.5f * (minPos + maxPos);
+    radius = std::max(0.5f * glm::length(maxPos - minPos), 5.0f);
+}
+
+// 一组数值的统计 (复用 FrameRateIndicator 的分位数)
+Json percentilesJson(const FrameRateIndicator& values)
+{
+    FrameTimeStats stats = values.computeStats();
+    Json json;
+    json["avgMs"] = stats.averageMs;
+    json["p50Ms"] = stats.p50Ms;
+    json["p95Ms"] = stats.p95Ms;
+    json["p99Ms"] = stats.p99Ms;
+    json["maxMs"] = stats.maxMs;
+    json["samples"] = stats.count;
+    return json;
+}
+
+Json countersJson(const GLCallCounters& total, double frames)
+{
+    Json json;
+    json["drawCalls"] = total.drawCalls / frames;
+    json["triangles"] = total.triangles / frames;
+    json["instances"] = total.instances / frames;
+    json["programBinds"] = total.programBinds / frames;
+    json["textureBinds"] = total.textureBinds / frames;
+    json["vaoBinds"] = total.vaoBinds / frames;
+    json["uniformUploads"] = total.uniformUploads / frames;
+    return json;
+}
+
+// 与基线比较的一项
+struct Regression {
+    std::string metric;
+    double baseline = 0.0;
+    double current = 0.0;
+};
+
+// 逐项比较 current 与 baseline 中同名的数值；timeField 为真时忽略小于 kMinRegressionMs 的变化
+void compareValue(const std::string& metric, const Json& current, const Json& baseline, bool timeField,
+                  float threshold, std::vector<Regression>& regressions)
+{
+    if (!current.is_number() || !baseline.is_number()) return;
+    double now = current.get<double>();
+    double before = baseline.get<double>();
+    double limit = before * (1.0 + threshold);
+    if (timeField) limit = std::max(limit, before + kMinRegressionMs);
+    else limit = std::max(limit, before + 0.5); // 计数按帧平均，允许半次的抖动
+    if (now > limit) regressions.push_back({ metric, before, now });
+}
+
+void compareObject(const std::string& prefix, const Json& current, const Json& baseline, bool timeFields,
+                   float threshold, std::vector<Regression>& regressions)
+{
+    if (!current.is_object() || !baseline.is_object()) return;
+    for (auto it = current.begin(); it != current.end(); ++it) {
+        if (it.key() == "samples" || !baseline.contains(it.key())) continue;
+        compareValue(prefix + it.key(), it.value(), baseline[it.key()], timeFields, threshold, regressions);
+    }
+}
+
+std::vector<Regression> compareWithBaseline(const Json& result, const Json& baseline, float threshold)
+{
+    std::vector<Regression> regressions;
+    const char* timeSections[] = { "frameTime", "renderCpu", "gpu" };
+    for (const char* section : timeSections) {
+        if (result.contains(section) && baseline.contains(section)) {
+            compareObject(std::string(section) + ".", result[section], baseline[section], true, threshold, regressions);
+        }
+    }
+
+    if (result.contains("passes") && baseline.contains("passes")) {
+        const Json& basePasses = baseline["passes"];
+        for (auto it = result["passes"].begin(); it != result["passes"].end(); ++it) {
+            if (!basePasses.contains(it.key())) continue;
+            const Json& pass = it.value();
+            const Json& basePass = basePasses[it.key()];
+            std::string prefix = "passes." + it.key() + ".";
+            for (const char* field : { "cpuMs", "gpuMs" }) {
+                if (pass.contains(field) && basePass.contains(field)) {
+                    compareValue(prefix + field, pass[field], basePass[field], true, threshold, regressions);
+                }
+            }
+            if (pass.contains("counters") && basePass.contains("counters")) {
+                compareObject(prefix, pass["counters"], basePass["counters"], false, threshold, regressions);
+            }
+        }
+    }
+
+    if (result.contains("counters") && baseline.contains("counters")) {
+        compareObject("counters.", result["counters"], baseline["counters"], false, threshold, regressions);
+    }
+    return regressions;
+}
+
+bool parseInt(const char* text, int& out)
+{
+    char* end = nullptr;
+    long value = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || value <= 0) return false;
+    out = static_cast<int>(value);
+    return true;
+}
+
+} // namespace
+
+bool RenderBenchmark::parseArguments(int argc, char* argv[], RenderBenchmarkOptions& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--benchmark") continue;
+
+        if (i + 1 >= argc) {
+            std::cerr << "[Benchmark] Missing value for " << arg << std::endl;
+            printUsage();
+            return false;
+        }
+        const char* value = argv[++i];
+
+        bool ok = true;
+        if (arg == "--scene") options.scenePath = value;
+        else if (arg == "--camera") options.cameraPath = value;
+        else if (arg == "--output") options.outputPath = value;
+        else if (arg == "--baseline") options.baselinePath = value;
+        else if (arg == "--trace") options.tracePath = value;
+        else if (arg == "--frames") ok = parseInt(value, options.frames);
+        else if (arg == "--warmup") ok = parseInt(value, options.warmupFrames) || std::strcmp(value, "0") == 0;
+        else if (arg == "--width") ok = parseInt(value, options.width);
+        else if (arg == "--height") ok = parseInt(value, options.height);
+        else if (arg == "--threshold") {
+            options.regressionThreshold = std::strtof(value, nullptr);
+            ok = options.regressionThreshold > 0.0f;
+        }
+        else {
+            std::cerr << "[Benchmark] Unknown option: " << arg << std::endl;
+            printUsage();
+            return false;
+        }
+
+        if (!ok) {
+            std::cerr << "[Benchmark] Invalid value for " << arg << ": " << value << std::endl;
+            printUsage();
+            return false;
+        }
+    }
+
+    if (options.frames + options.warmupFrames > kMaxBenchmarkFrames) {
+        std::cerr << "[Benchmark] At most " << kMaxBenchmarkFrames << " frames (including warm-up) are supported"
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+#ifdef BENCHMARK_HAS_EGL
+namespace {
+
+// 不依赖任何窗口系统的 EGL 上下文 (Mesa 的 EGL_MESA_platform_surfaceless，llvmpipe 也支持)
+// 基准只渲染到离屏 FBO，不需要默认帧缓冲，所以也不创建 pbuffer
+class SurfacelessEglContext
+{
+public:
+    SurfacelessEglContext() = default;
+    ~SurfacelessEglContext() { destroy(); }
+
+    SurfacelessEglContext(const SurfacelessEglContext&) = delete;
+    SurfacelessEglContext& operator=(const SurfacelessEglContext&) = delete;
+
+    // 创建 3.3 core 上下文并设为当前
+    bool create()
+    {
+        // 与 GLFW 一样在运行时加载 libEGL，没有它的机器上也能正常启动
+        _lib = dlopen("libEGL.so.1", RTLD_LAZY | RTLD_LOCAL);
+        if (!_lib) return fail("libEGL.so.1 not found");
+
+        s_getProcAddress = load<PFNEGLGETPROCADDRESSPROC>("eglGetProcAddress");
+        auto queryString = load<PFNEGLQUERYSTRINGPROC>("eglQueryString");
+        auto initialize = load<PFNEGLINITIALIZEPROC>("eglInitialize");
+        auto chooseConfig = load<PFNEGLCHOOSECONFIGPROC>("eglChooseConfig");
+        auto bindAPI = load<PFNEGLBINDAPIPROC>("eglBindAPI");
+        auto createContext = load<PFNEGLCREATECONTEXTPROC>("eglCreateContext");
+        auto makeCurrent = load<PFNEGLMAKECURRENTPROC>("eglMakeCurrent");
+        _destroyContext = load<PFNEGLDESTROYCONTEXTPROC>("eglDestroyContext");
+        _terminate = load<PFNEGLTERMINATEPROC>("eglTerminate");
+        if (!s_getProcAddress || !queryString || !initialize || !chooseConfig || !bindAPI || !createContext
+            || !makeCurrent || !_destroyContext || !_terminate) {
+            return fail("libEGL is missing core entry points");
+        }
+
+        const char* clientExtensions = queryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        if (!clientExtensions || !std::strstr(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+            return fail("EGL_MESA_platform_surfaceless not supported");
+        }
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            s_getProcAddress("eglGetPlatformDisplayEXT"));
+        if (!getPlatformDisplay) return fail("eglGetPlatformDisplayEXT not found");
+
+        _display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        EGLint major = 0, minor = 0;
+        if (_display == EGL_NO_DISPLAY || !initialize(_display, &major, &minor)) {
+            _display = EGL_NO_DISPLAY;
+            return fail("eglInitialize failed");
+        }
+
+        const EGLint configAttribs[] = {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_NONE
+        };
+        EGLConfig config = nullptr;
+        EGLint configCount = 0;
+        if (!chooseConfig(_display, configAttribs, &config, 1, &configCount) || configCount == 0) {
+            return fail("no OpenGL-capable EGLConfig");
+        }
+
+        if (!bindAPI(EGL_OPENGL_API)) return fail("eglBindAPI(EGL_OPENGL_API) failed");
+        const EGLint contextAttribs[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 3,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+        _context = createContext(_display, config, EGL_NO_CONTEXT, contextAttribs);
+        if (_context == EGL_NO_CONTEXT) return fail("eglCreateContext failed");
+
+        if (!makeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, _context)) return fail("eglMakeCurrent failed");
+
+        std::cout << "[Benchmark] Using a surfaceless EGL " << major << "." << minor << " context" << std::endl;
+        return true;
+    }
+
+    void destroy()
+    {
+        if (_context != EGL_NO_CONTEXT) {
+            auto makeCurrent = load<PFNEGLMAKECURRENTPROC>("eglMakeCurrent");
+            if (makeCurrent) makeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            _destroyContext(_display, _context);
+            _context = EGL_NO_CONTEXT;
+        }
+        if (_display != EGL_NO_DISPLAY) {
+            _terminate(_display);
+            _display = EGL_NO_DISPLAY;
+        }
+        if (_lib) {
+            dlclose(_lib);
+            _lib = nullptr;
+        }
+        s_getProcAddress = nullptr;
+    }
+
+    // 给 glad 用的加载函数 (Mesa 的 eglGetProcAddress 也返回核心 GL 函数)
+    static GLADapiproc getProcAddress(const char* name)
+    {
+        return s_getProcAddress ? reinterpret_cast<GLADapiproc>(s_getProcAddress(name)) : nullptr;
+    }
+
+private:
+    void* _lib = nullptr;
+    EGLDisplay _display = EGL_NO_DISPLAY;
+    EGLContext _context = EGL_NO_CONTEXT;
+    PFNEGLDESTROYCONTEXTPROC _destroyContext = nullptr;
+    PFNEGLTERMINATEPROC _terminate = nullptr;
+
+    static inline PFNEGLGETPROCADDRESSPROC s_getProcAddress = nullptr;
+
+    template <typename Proc>
+    Proc load(const char* name) const
+    {
+        return _lib ? reinterpret_cast<Proc>(dlsym(_lib, name)) : nullptr;
+    }
+
+    bool fail(const char* reason)
+    {
+        std::cerr << "[Benchmark] Surfaceless EGL: " << reason << std::endl;
+        destroy();
+        return false;
+    }
+};
+
+} // namespace
+#endif
+
+int RenderBenchmark::run(const RenderBenchmarkOptions& options)
+{
+    glfwSetErrorCallback([](int, const char* description) {
+        std::cerr << "[Benchmark] GLFW: " << description << std::endl;
+    });
+
+    auto setWindowHints = []() {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    };
+
+    // 1. 不可见窗口 (有显示器或 Xvfb 时)
+    GLFWwindow* window = nullptr;
+    if (glfwInit() == GLFW_TRUE) {
+        setWindowHints();
+        window = glfwCreateWindow(options.width, options.height, "Benchmark", nullptr, nullptr);
+        if (!window) glfwTerminate();
+    }
+
+    // 2. 没有显示器：无窗口平台 + EGL (驱动接受空的原生窗口时可用)
+    if (!window) {
+        std::cout << "[Benchmark] No window system available, trying an EGL context" << std::endl;
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+        if (glfwInit() == GLFW_TRUE) {
+            setWindowHints();
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+            window = glfwCreateWindow(options.width, options.height, "Benchmark", nullptr, nullptr);
+            if (!window) glfwTerminate();
+        }
+    }
+
+    // 3. Mesa 的 EGL 不给空窗口创建 surface (没有带 EGL_WINDOW_BIT 的配置)：
+    //    绕过 GLFW，直接创建 surfaceless 上下文，基准只渲染到离屏 FBO
+#ifdef BENCHMARK_HAS_EGL
+    if (!window) {
+        std::cout << "[Benchmark] Trying a surfaceless EGL context" << std::endl;
+        SurfacelessEglContext egl;
+        if (egl.create()) {
+            if (!gladLoadGL(SurfacelessEglContext::getProcAddress)) {
+                std::cerr << "[Benchmark] glad initialization OpenGL failure" << std::endl;
+                return 2;
+            }
+            GLCounters::install();
+            return runInCurrentContext(options);
+        }
+    }
+#endif
+
+    // 4. 最后尝试 OSMesa (纯软件渲染)
+    if (!window) {
+        std::cout << "[Benchmark] Trying an OSMesa context" << std::endl;
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+        if (glfwInit() == GLFW_TRUE) {
+            setWindowHints();
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+            window = glfwCreateWindow(options.width, options.height, "Benchmark", nullptr, nullptr);
+        }
+    }
+
+    if (!window) {
+        std::cerr << "[Benchmark] Failed to create an OpenGL 3.3 context" << std::endl;
+        glfwTerminate();
+        return 2;
+    }
+
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+    if (!gladLoadGL(glfwGetProcAddress)) {
+        std::cerr << "[Benchmark] glad initialization OpenGL failure" << std::endl;
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return 2;
+    }
+    GLCounters::install();
+
+    int code = runInCurrentContext(options);
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return code;
+}
+
+int RenderBenchmark::runInCurrentContext(const RenderBenchmarkOptions& options)
+{
+    const char* glVersion = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    const char* glRenderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    std::cout << "[Benchmark] OpenGL " << glVersion << " | " << glRenderer << std::endl;
+
+    Profiler& profiler = Profiler::Get();
+    profiler.setThreadName("Main");
+    profiler.setEnabled(true);
+    profiler.setHitchThresholdMs(0.0f);
+    profiler.setCaptureSeconds(1e9f); // 测量的帧都留在捕获环里 (帧数另有上限)
+
+    if (ResourceManager::Get().getProjectRoot().empty()) {
+        ResourceManager::Get().setProjectRoot(std::filesystem::current_path().string() + "/");
+    }
+
+    int exitCode = 0;
+    {
+        // =========================================================
+        // 1. 场景、相机与渲染目标
+        // =========================================================
+        Renderer renderer;
+        renderer.init();
+        renderer.onResize(options.width, options.height);
+
+        OffscreenTarget target;
+        if (!target.create(options.width, options.height)) {
+            std::cerr << "[Benchmark] Offscreen framebuffer is not complete" << std::endl;
+            return 2;
+        }
+
+        Scene scene;
+        if (options.scenePath.empty()) {
+            buildDefaultScene(scene);
+        } else {
+            scene.createDefaultScene();
+            scene.importScene(options.scenePath);
+        }
+
+        CameraPath path;
+        if (!options.cameraPath.empty() && !path.load(options.cameraPath)) {
+            target.release();
+            return 2;
+        }
+
+        glm::vec3 center;
+        float radius = 0.0f;
+        computeSceneBounds(scene, center, radius);
+
+        PerspectiveCamera camera(glm::radians(50.0f), static_cast<float>(options.width) / options.height, 0.1f, 1000.0f);
+        RenderSnapshot snapshot;
+
+        // =========================================================
+        // 2. 逐帧渲染 (预热 + 测量 + 取回 GPU 结果)
+        // =========================================================
+        const int totalFrames = options.warmupFrames + options.frames + kFlushFrames;
+        FrameRateIndicator frameTimes(options.frames);
+        uint64_t firstMeasured = 0;
+        uint64_t lastMeasured = 0;
+
+        RenderFrameStats statsTotal;
+        double mainVisible = 0.0, mainCulled = 0.0, mirrorVisible = 0.0, probeVisible = 0.0;
+        double shadowCasters[RenderFrameStats::kMaxShadowCascades] = {};
+        int shadowCascadeCount = 0;
+        double probeRenders = 0.0, mirrorRenders = 0.0, heapAllocations = 0.0, arenaKB = 0.0;
+
+        std::cout << "[Benchmark] " << options.warmupFrames << " warm-up + " << options.frames << " frames at "
+                  << options.width << "x" << options.height << std::endl;
+
+        for (int i = 0; i < totalFrames; ++i)
+        {
+            auto frameStart = std::chrono::steady_clock::now();
+            bool measured = i >= options.warmupFrames && i < options.warmupFrames + options.frames;
+
+            // 帧边界 (同编辑器的 prepareFrame)
+            profiler.endFrame();
+            if (i == options.warmupFrames) firstMeasured = profiler.getFrameIndex();
+            if (measured) lastMeasured = profiler.getFrameIndex();
+            {
+                ProfileScope scope("Frame Boundary");
+                scene.applyRenderFeedback(snapshot.scene);
+                snapshot.clear();
+                ResourceManager::Get().update();
+
+                // 相机：测量区间内按帧均匀走完整条路径 (与实际帧率无关，每次运行看到的画面相同)
+                int step = std::clamp(i - options.warmupFrames, 0, options.frames - 1);
+                float t = options.frames > 1 ? static_cast<float>(step) / (options.frames - 1) : 0.0f;
+                if (!path.empty()) {
+                    path.sample(t * path.getDuration(), camera.transform);
+                } else {
+                    float angle = t * glm::two_pi<float>();
+                    camera.transform.position = center + glm::vec3(std::cos(angle) * radius * 1.2f,
+                                                                   radius * 0.35f + 2.0f,
+                                                                   std::sin(angle) * radius * 1.2f);
+                    camera.transform.lookAt(center);
+                }
+
+                scene.updateImports();
+                scene.updateWorldTransforms();
+                renderer.prepareScene(scene);
+                snapshot.capture(scene, camera, nullptr);
+                snapshot.targetFBO = target.fbo;
+                snapshot.width = options.width;
+                snapshot.height = options.height;
+            }
+
+            GpuProfiler::Get().beginFrame();
+            {
+                ProfileScope scope("Draw Frame");
+                renderer.render(snapshot.scene, snapshot.getCamera(), snapshot.targetFBO,
+                                snapshot.width, snapshot.height, 1.0f, nullptr);
+            }
+            {
+                // 不 swap：等 GPU 画完，帧耗时包含 GPU 时间，也不会有帧在队列里堆积
+                ProfileScope scope("GPU Wait");
+                glFinish();
+            }
+
+            if (!measured) continue;
+
+            float frameMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+            frameTimes.push(frameMs);
+
+            const RenderFrameStats& stats = renderer.getFrameStats();
+            statsTotal.gl += stats.gl;
+            for (int p = 0; p < kRenderPassCount; ++p) {
+                statsTotal.passes[p].gl += stats.passes[p].gl;
+                statsTotal.passes[p].objectsVisible += stats.passes[p].objectsVisible;
+                statsTotal.passes[p].objectsCulled += stats.passes[p].objectsCulled;
+            }
+            mainVisible += stats.mainView.visible;
+            mainCulled += stats.mainView.culled;
+            mirrorVisible += stats.mirrorViews.visible;
+            probeVisible += stats.probeViews.visible;
+            shadowCascadeCount = stats.shadowCascadeCount;
+            for (int c = 0; c < stats.shadowCascadeCount; ++c) shadowCasters[c] += stats.shadowCasters[c];
+            probeRenders += stats.probeRenders;
+            mirrorRenders += stats.mirrorRenders;
+            heapAllocations += static_cast<double>(stats.heapAllocations);
+            arenaKB += stats.frameArenaBytes / 1024.0;
+        }
+        profiler.endFrame();
+
+        // =========================================================
+        // 3. 从捕获环中取各 pass 的 CPU / GPU 耗时
+        // =========================================================
+        FrameRateIndicator renderCpu(options.frames);
+        FrameRateIndicator gpuTotal(options.frames);
+        double passCpuMs[kRenderPassCount] = {};
+        double passGpuMs[kRenderPassCount] = {};
+        int gpuFrames = 0;
+
+        for (size_t age = 0; age < profiler.getHistoryCount(); ++age) {
+            const ProfileFrame& frame = profiler.getHistoryFrame(age);
+            if (frame.index < firstMeasured || frame.index > lastMeasured) continue;
+
+            double renderMs = 0.0;
+            for (const ProfileEvent& event : frame.cpuEvents) {
+                if (std::strcmp(event.name, "Render Scene") == 0) renderMs += event.getMs();
+                for (int p = 0; p < kRenderPassCount; ++p) {
+                    if (std::strcmp(event.name, getRenderPassName(static_cast<RenderPass>(p))) == 0) passCpuMs[p] += event.getMs();
+                }
+            }
+            renderCpu.push(static_cast<float>(renderMs));
+
+            if (!frame.gpuResolved) continue;
+            gpuFrames++;
+            gpuTotal.push(static_cast<float>(frame.getGpuMs()));
+            for (const ProfileEvent& event : frame.gpuEvents) {
+                for (int p = 0; p < kRenderPassCount; ++p) {
+                    if (std::strcmp(event.name, getRenderPassName(static_cast<RenderPass>(p))) == 0) passGpuMs[p] += event.getMs();
+                }
+            }
+        }
+
+        // =========================================================
+        // 4. 结果
+        // =========================================================
+        const double frames = options.frames;
+        Json result;
+        Json& info = result["benchmark"];
+        info["scene"] = options.scenePath.empty() ? "builtin" : options.scenePath;
+        info["cameraPath"] = options.cameraPath.empty() ? "orbit" : options.cameraPath;
+        info["frames"] = options.frames;
+        info["warmupFrames"] = options.warmupFrames;
+        info["width"] = options.width;
+        info["height"] = options.height;
+        info["glVersion"] = glVersion;
+        info["glRenderer"] = glRenderer;
+
+        result["frameTime"] = percentilesJson(frameTimes);
+        result["frameTime"]["fps"] = frameTimes.computeStats().getAverageFrameRate();
+        result["renderCpu"] = percentilesJson(renderCpu);
+        result["gpu"] = percentilesJson(gpuTotal);
+
+        Json& passes = result["passes"];
+        for (int p = 0; p < kRenderPassCount; ++p) {
+            const RenderPassStats& pass = statsTotal.passes[p];
+            Json& entry = passes[getRenderPassName(static_cast<RenderPass>(p))];
+            entry["cpuMs"] = passCpuMs[p] / frames;
+            entry["gpuMs"] = gpuFrames > 0 ? passGpuMs[p] / gpuFrames : 0.0;
+            entry["counters"] = countersJson(pass.gl, frames);
+            entry["counters"]["objectsVisible"] = pass.objectsVisible / frames;
+            entry["counters"]["objectsCulled"] = pass.objectsCulled / frames;
+        }
+
+        Json& counters = result["counters"];
+        counters = countersJson(statsTotal.gl, frames);
+        counters["mainViewVisible"] = mainVisible / frames;
+        counters["mainViewCulled"] = mainCulled / frames;
+        counters["mirrorVisible"] = mirrorVisible / frames;
+        counters["probeFaceVisible"] = probeVisible / frames;
+        counters["probeRenders"] = probeRenders / frames;
+        counters["mirrorRenders"] = mirrorRenders / frames;
+        counters["frameArenaKB"] = arenaKB / frames;
+        counters["heapAllocations"] = heapAllocations / frames;
+        Json cascades = Json::array();
+        for (int c = 0; c < shadowCascadeCount; ++c) cascades.push_back(shadowCasters[c] / frames);
+        result["shadowCastersPerCascade"] = cascades;
+
+        FrameTimeStats summary = frameTimes.computeStats();
+        char line[200];
+        snprintf(line, sizeof(line), "[Benchmark] Frame time: avg %.2f | p50 %.2f | p95 %.2f | p99 %.2f ms (%.1f FPS)",
+                 summary.averageMs, summary.p50Ms, summary.p95Ms, summary.p99Ms, summary.getAverageFrameRate());
+        std::cout << line << std::endl;
+        snprintf(line, sizeof(line), "[Benchmark] Draw calls %.1f | triangles %.0f per frame",
+                 statsTotal.gl.drawCalls / frames, statsTotal.gl.triangles / frames);
+        std::cout << line << std::endl;
+
+        // 与基线比较
+        if (!options.baselinePath.empty()) {
+            std::ifstream baselineFile(options.baselinePath);
+            Json baseline = Json::parse(baselineFile, nullptr, false);
+            if (!baselineFile.is_open() || baseline.is_discarded()) {
+                std::cerr << "[Benchmark] Failed to read baseline: " << options.baselinePath << std::endl;
+                exitCode = 2;
+            } else {
+                if (baseline.contains("benchmark")) {
+                    const Json& before = baseline["benchmark"];
+                    for (const char* key : { "scene", "cameraPath", "frames", "width", "height", "glRenderer" }) {
+                        if (before.contains(key) && before[key] != info[key]) {
+                            std::cout << "[Benchmark] Warning: baseline was recorded with a different " << key << std::endl;
+                        }
+                    }
+                }
+
+                std::vector<Regression> regressions = compareWithBaseline(result, baseline, options.regressionThreshold);
+                Json& comparison = result["comparison"];
+                comparison["baseline"] = options.baselinePath;
+                comparison["threshold"] = options.regressionThreshold;
+                comparison["regressions"] = Json::array();
+                for (const Regression& r : regressions) {
+                    Json entry;
+                    entry["metric"] = r.metric;
+                    entry["baseline"] = r.baseline;
+                    entry["current"] = r.current;
+                    entry["change"] = r.baseline != 0.0 ? (r.current - r.baseline) / r.baseline : 0.0;
+                    comparison["regressions"].push_back(entry);
+
+                    snprintf(line, sizeof(line), "[Benchmark] REGRESSION %s: %.3f -> %.3f",
+                             r.metric.c_str(), r.baseline, r.current);
+                    std::cout << line << std::endl;
+                }
+                std::cout << "[Benchmark] " << regressions.size() << " regression(s) against " << options.baselinePath
+                          << std::endl;
+                if (!regressions.empty()) exitCode = 1;
+            }
+        }
+
+        std::ofstream output(options.outputPath);
+        if (output.is_open()) {
+            output << result.dump(2) << std::endl;
+            std::cout << "[Benchmark] Results written to " << options.outputPath << std::endl;
+        } else {
+            std::cerr << "[Benchmark] Failed to write: " << options.outputPath << std::endl;
+            exitCode = 2;
+        }
+
+        if (!options.tracePath.empty() && profiler.dumpCapture(options.tracePath, TraceFormat::ChromeJson)) {
+            std::cout << "[Benchmark] Trace written to " << options.tracePath << std::endl;
+        }
+
+        // GL 资源在上下文销毁前释放
+        snapshot.clear();
+        scene.clear();
+        target.release();
+    }
+
+    GpuProfiler::Get().release();
+    ResourceManager::Get().shutdown();
+    return exitCode;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+
+// 渲染基准测试的参数 (命令行 --benchmark 之后的选项)
+struct RenderBenchmarkOptions {
+    std::string scenePath;          // --scene：导入的场景 (OBJ / glTF)；为空时生成内置的测试场景
+    std::string cameraPath;         // --camera：录制的相机路径 (见 CameraPath)；为空时绕场景中心环绕一周
+    std::string outputPath = "benchmark.json"; // --output
+    std::string baselinePath;       // --baseline：与之比较的旧结果；为空时不比较
+    std::string tracePath;          // --trace：同时导出这次运行的 Chrome trace
+    int frames = 600;               // --frames：计入结果的帧数
+    int warmupFrames = 60;          // --warmup：先跑的帧 (上传、着色器编译、LOD 稳定)
+    int width = 1280;               // --width / --height：渲染目标大小
+    int height = 720;
+    float regressionThreshold = 0.10f; // --threshold：比基线慢 (或计数多) 这个比例视为回归
+};
+
+// ==========================================
+// 渲染基准测试 (命令行 --benchmark 启动)
+// ==========================================
+// 创建不可见的窗口 (没有显示器时改用无窗口平台 + OSMesa，可在 Mesa llvmpipe 上运行)，关闭垂直同步，
+// 加载场景后沿相机路径渲染固定帧数到离屏 FBO。每帧结束时等待 GPU 完成，帧耗时包含 GPU 时间。
+// 结果写成 JSON：帧耗时分位数、各 pass 的 CPU / GPU 耗时、GL 调用与剔除计数 (见 RenderFrameStats)；
+// 给出基线时逐项比较，超过阈值的项目作为回归列出。
+class RenderBenchmark
+{
+public:
+    // 解析 argv 中的选项 (忽略 --benchmark 本身)；出错时打印用法并返回 false
+    static bool parseArguments(int argc, char* argv[], RenderBenchmarkOptions& options);
+
+    // 创建上下文并运行；返回进程退出码：0 正常，1 有回归，2 出错
+    static int run(const RenderBenchmarkOptions& options);
+
+    // 在调用线程当前的 GL 上下文中运行 (glad 已加载)，返回值同 run
+    static int runInCurrentContext(const RenderBenchmarkOptions& options);
+};
@@ -0,0 +1,23 @@
+#include "render_snapshot.h"
+
+template <typename T>
+void RenderSnapshot::copyCamera(const T& camera)
+{
+    // 类型相同时原地赋值，不用每帧重新分配
+    if (T* existing = dynamic_cast<T*>(_camera.get())) *existing = camera;
+    else _camera = std::make_unique<T>(camera);
+}
+
+void RenderSnapshot::capture(const Scene& source, const Camera& camera, const GameObject* selectedObject)
+{
+    selected = source.captureRenderState(scene, selectedObject);
+
+    if (auto* perspective = dynamic_cast<const PerspectiveCamera*>(&camera)) copyCamera(*perspective);
+    else if (auto* orthographic = dynamic_cast<const OrthographicCamera*>(&camera)) copyCamera(*orthographic);
+}
+
+void RenderSnapshot::clear()
+{
+    scene.clear();
+    selected = nullptr;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <glad/gl.h>
+#include "base/camera.h"
+#include "scene.h"
+
+// ==========================================
+// 渲染快照
+// ==========================================
+// 一帧渲染需要的全部场景状态：对象的世界矩阵、网格 / 材质 / 光源 / 探针参数、环境设置与相机。
+// 在帧边界由 UI 线程的场景拷贝而来 (见 Scene::captureRenderState)，之后只交给渲染线程使用，
+// UI 线程接下来对场景的修改不会影响正在渲染的这一帧。
+// 模型、贴图等资源通过 shared_ptr 共享，快照存在期间它们不会被释放。
+class RenderSnapshot
+{
+public:
+    Scene scene;
+    GameObject* selected = nullptr; // 选中对象在快照中的拷贝 (描边用)
+
+    // 渲染目标
+    GLuint targetFBO = 0;
+    int width = 0;
+    int height = 0;
+    float contentScale = 1.0f;
+
+    // [帧边界] 拷贝场景与相机
+    void capture(const Scene& source, const Camera& camera, const GameObject* selectedObject);
+
+    // 释放场景拷贝 (模型等最后一个引用可能在这里释放，应在渲染上下文中调用)
+    void clear();
+
+    Camera* getCamera() const { return _camera.get(); }
+
+private:
+    std::unique_ptr<Camera> _camera;
+
+    template <typename T>
+    void copyCamera(const T& camera);
+};
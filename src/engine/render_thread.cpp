@@ -0,0 +1,237 @@
+#include "render_thread.h"
+#include "engine/utils/profiler.h"
+
+#include <future>
+#include <iostream>
+
+#include <glad/gl.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+namespace {
+
+// 滑动平均的权重 (约等于最近 20 帧)
+constexpr float kSmoothing = 0.05f;
+
+float toMs(std::chrono::high_resolution_clock::duration d)
+{
+    return std::chrono::duration<float, std::milli>(d).count();
+}
+
+// 第一个样本直接采用，之后按权重逼近
+void smooth(float& value, float sample, uint64_t frames)
+{
+    value = (frames == 0 || value == 0.0f) ? sample : value + (sample - value) * kSmoothing;
+}
+
+} // namespace
+
+RenderThread& RenderThread::Get()
+{
+    static RenderThread instance;
+    return instance;
+}
+
+RenderThread::~RenderThread()
+{
+    // 正常情况下 shutdown 已经在 glfwTerminate 之前调用过
+    if (_thread.joinable()) {
+        push(nullptr);
+        _thread.join();
+    }
+}
+
+void RenderThread::init(GLFWwindow* window)
+{
+    _window = window;
+    _frameStart = Clock::now();
+
+    // 1x1 的隐藏窗口，只为了拿到一个与主窗口共享对象的上下文
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    _uiContext = glfwCreateWindow(1, 1, "UI Context", nullptr, window);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+
+    if (!_uiContext) {
+        std::cerr << "[RenderThread] Failed to create shared context, rendering stays on the main thread" << std::endl;
+    }
+}
+
+void RenderThread::shutdown()
+{
+    stop();
+    runPendingCommands();
+
+    if (_uiContext) {
+        glfwDestroyWindow(_uiContext);
+        _uiContext = nullptr;
+    }
+    _window = nullptr;
+}
+
+void RenderThread::start()
+{
+    if (_running || !_uiContext) return;
+
+    // 主线程上已经发出的命令全部完成后再交出上下文
+    glFinish();
+    glfwMakeContextCurrent(_uiContext);
+
+    _running = true;
+    _thread = std::thread([this]() { threadLoop(); });
+    std::cout << "[RenderThread] Started" << std::endl;
+}
+
+void RenderThread::stop()
+{
+    if (!_running) return;
+
+    push(nullptr);
+    _thread.join();
+    _running = false;
+
+    glfwMakeContextCurrent(_window);
+    std::cout << "[RenderThread] Stopped, rendering on the main thread" << std::endl;
+}
+
+bool RenderThread::isRenderContextCurrent() const
+{
+    return !_window || glfwGetCurrentContext() == _window;
+}
+
+void RenderThread::runOnRenderContext(std::function<void()> fn)
+{
+    if (isRenderContextCurrent()) {
+        fn();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_commandMutex);
+    _commands.push_back(std::move(fn));
+}
+
+void RenderThread::runPendingCommands()
+{
+    std::vector<std::function<void()>> commands;
+    {
+        std::lock_guard<std::mutex> lock(_commandMutex);
+        commands.swap(_commands);
+    }
+    for (auto& command : commands) command();
+}
+
+void RenderThread::push(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_taskMutex);
+        _tasks.push_back(std::move(task));
+    }
+    _taskCv.notify_one();
+}
+
+void RenderThread::threadLoop()
+{
+    glfwMakeContextCurrent(_window);
+    Profiler::Get().setThreadName("Render");
+
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_taskMutex);
+            _taskCv.wait(lock, [this]() { return !_tasks.empty(); });
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        if (!task) break;
+        task();
+    }
+
+    // 退出前把投递给窗口上下文的操作做完，再交还上下文
+    runPendingCommands();
+    glFinish();
+    glfwMakeContextCurrent(nullptr);
+}
+
+void RenderThread::beginFrame()
+{
+    _frameStart = Clock::now();
+}
+
+void RenderThread::sync(const std::function<void()>& boundary)
+{
+    Clock::time_point syncStart = Clock::now();
+    float uiMs = toMs(syncStart - _frameStart);
+
+    if (!_running) {
+        runPendingCommands();
+        boundary();
+        recordBoundary(false, uiMs, 0.0f, toMs(Clock::now() - syncStart));
+        return;
+    }
+
+    // UI 上下文中的命令 (新建纹理、删除等) 先提交，渲染上下文等它们完成后再使用这些对象
+    GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+
+    Clock::time_point boundaryStart;
+    std::promise<void> done;
+    push([&]() {
+        boundaryStart = Clock::now();
+        glWaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSync(fence);
+        runPendingCommands();
+        boundary();
+        done.set_value();
+    });
+    done.get_future().wait();
+
+    Clock::time_point boundaryEnd = Clock::now();
+    recordBoundary(true, uiMs, toMs(boundaryStart - syncStart), toMs(boundaryEnd - boundaryStart));
+}
+
+void RenderThread::submit(std::function<void()> frame)
+{
+    bool threaded = _running;
+    Clock::time_point frameStart = _frameStart;
+
+    auto job = [this, frame = std::move(frame), threaded, frameStart]() {
+        Clock::time_point renderStart = Clock::now();
+        frame();
+        Clock::time_point renderEnd = Clock::now();
+        recordFrame(threaded, toMs(renderEnd - renderStart), toMs(renderEnd - frameStart), renderEnd);
+    };
+
+    if (threaded) push(std::move(job));
+    else job();
+}
+
+void RenderThread::recordBoundary(bool threaded, float uiMs, float waitMs, float boundaryMs)
+{
+    std::lock_guard<std::mutex> lock(_timingMutex);
+    RenderThreadTimings& t = _timings[threaded ? 1 : 0];
+    smooth(t.uiMs, uiMs, t.frames);
+    smooth(t.waitMs, waitMs, t.frames);
+    smooth(t.boundaryMs, boundaryMs, t.frames);
+}
+
+void RenderThread::recordFrame(bool threaded, float renderMs, float latencyMs, Clock::time_point presentTime)
+{
+    std::lock_guard<std::mutex> lock(_timingMutex);
+    RenderThreadTimings& t = _timings[threaded ? 1 : 0];
+    smooth(t.renderMs, renderMs, t.frames);
+    smooth(t.latencyMs, latencyMs, t.frames);
+
+    // 切换模式后的第一帧没有同模式的上一帧可比
+    if (_hasLastPresent && _lastPresentThreaded == threaded) {
+        float intervalMs = toMs(presentTime - _lastPresent);
+        if (intervalMs > 0.0f) smooth(t.fps, 1000.0f / intervalMs, t.frames);
+    }
+    _lastPresent = presentTime;
+    _lastPresentThreaded = threaded;
+    _hasLastPresent = true;
+    t.frames++;
+}
+
+RenderThreadTimings RenderThread::getTimings(bool threaded) const
+{
+    std::lock_guard<std::mutex> lock(_timingMutex);
+    return _timings[threaded ? 1 : 0];
+}
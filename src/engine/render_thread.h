@@ -0,0 +1,105 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct GLFWwindow;
+
+// 一种模式 (单线程 / 渲染线程) 下的帧耗时 (指数滑动平均，毫秒)
+struct RenderThreadTimings {
+    float uiMs = 0.0f;       // UI 线程：帧开始到帧边界 (输入、面板、ImGui 布局)
+    float waitMs = 0.0f;     // 帧边界上 UI 线程等待渲染线程画完上一帧的时间
+    float boundaryMs = 0.0f; // 帧边界本身 (资源更新、层级、快照拷贝)，期间两个线程都停住
+    float renderMs = 0.0f;   // 渲染一帧 (场景 + UI + swap)
+    float latencyMs = 0.0f;  // 延迟：UI 帧开始到这一帧 swap 完成
+    float fps = 0.0f;        // 吞吐：相邻两次 swap 的间隔
+    uint64_t frames = 0;
+};
+
+// ==========================================
+// 渲染线程
+// ==========================================
+// 启动后窗口的 GL 上下文只在渲染线程上使用；UI 线程改用一个与它共享对象的隐藏上下文，
+// 仍可以创建 / 删除纹理、缓冲这类共享对象，但 VAO、FBO 等容器对象和渲染器内部状态
+// 只属于窗口上下文，这类操作通过 runOnRenderContext 投递。
+//
+// 每帧的流程 (两种模式走同一套代码)：
+//   UI 线程:   beginFrame -> 输入 / 面板 -> sync(帧边界) -> submit(这一帧) -> 下一帧 ...
+//   渲染线程:                 等上一帧画完 -> 执行帧边界 ->  渲染并 swap (与 UI 的下一帧并行)
+// 帧边界期间 UI 线程阻塞，是两边交换数据 (写回渲染结果、拷贝场景快照) 的唯一时机。
+// 未启动时所有操作都在调用线程上直接执行，与原来的单线程渲染一致。
+class RenderThread
+{
+public:
+    static RenderThread& Get();
+
+    // [主线程] 记录窗口 (此时窗口上下文在主线程上)，并创建 UI 线程使用的共享上下文
+    void init(GLFWwindow* window);
+
+    // [主线程] 停止渲染线程并销毁共享上下文 (在 glfwTerminate 之前调用)
+    void shutdown();
+
+    // [主线程] 把窗口上下文交给渲染线程 / 收回 (stop 会等排队的帧全部画完)
+    void start();
+    void stop();
+    bool isRunning() const { return _running; }
+
+    // 当前线程是否持有窗口上下文 (还没有 init 时视为持有)
+    bool isRenderContextCurrent() const;
+
+    // 需要窗口上下文的操作：在持有它的线程上立即执行，否则排到下一个帧边界执行
+    void runOnRenderContext(std::function<void()> fn);
+
+    // [UI 线程] 一帧开始 (计时起点)
+    void beginFrame();
+
+    // [UI 线程] 帧边界：等渲染线程画完上一帧，在窗口上下文中执行排队的操作和 boundary，返回时 boundary 已完成
+    void sync(const std::function<void()>& boundary);
+
+    // [UI 线程] 提交这一帧的渲染 (由 frame 负责 swap)；渲染线程上异步执行，未启动时直接执行
+    void submit(std::function<void()> frame);
+
+    RenderThreadTimings getTimings(bool threaded) const;
+
+private:
+    using Clock = std::chrono::high_resolution_clock;
+
+    RenderThread() = default;
+    ~RenderThread();
+
+    GLFWwindow* _window = nullptr;
+    GLFWwindow* _uiContext = nullptr;
+
+    std::thread _thread;
+    bool _running = false;
+
+    // 渲染线程的任务队列 (帧边界与帧)，空任务表示退出
+    std::mutex _taskMutex;
+    std::condition_variable _taskCv;
+    std::deque<std::function<void()>> _tasks;
+
+    // 等待窗口上下文的操作
+    std::mutex _commandMutex;
+    std::vector<std::function<void()>> _commands;
+
+    Clock::time_point _frameStart;
+
+    mutable std::mutex _timingMutex;
+    RenderThreadTimings _timings[2];
+    Clock::time_point _lastPresent;
+    bool _lastPresentThreaded = false;
+    bool _hasLastPresent = false;
+
+    void threadLoop();
+    void push(std::function<void()> task);
+    void runPendingCommands();
+
+    void recordBoundary(bool threaded, float uiMs, float waitMs, float boundaryMs);
+    void recordFrame(bool threaded, float renderMs, float latencyMs, Clock::time_point presentTime);
+};
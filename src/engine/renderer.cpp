@@ -1,9 +1,31 @@
 #include "renderer.h"
 #include "resource_manager.h"
 #include "asset_data.h"
+#include "engine/utils/job_system.h"
+#include "engine/utils/allocation_tracker.h"
+#include "engine/utils/content_hash.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdio>
 #include <iostream>
 #include <glm/gtc/type_ptr.hpp>
 
+namespace {
+// 主视图并行剔除时每个任务处理的物体数 (物体更少时直接在主线程完成)
+constexpr size_t kCullChunkSize = 256;
+
+// 场景不变多少帧之后要求 render() 没有堆分配 (数组容量、驱动的着色器变体等在此之前稳定下来)
+constexpr int kAllocationWarmupFrames = 30;
+
+// 数组成员的 uniform 名，如 "pointLights[2].range"，写进调用方的缓冲区
+const char* arrayUniformName(char (&buffer)[64], const char* array, int index, const char* member)
+{
+    snprintf(buffer, sizeof(buffer), "%s[%d].%s", array, index, member);
+    return buffer;
+}
+}
+
 Renderer::Renderer() {
     // 构造函数可以留空，把初始化放在 init() 里更安全
 }
@@ -44,8 +66,26 @@ void Renderer::init() {
         uniform mat4 view;
         uniform mat4 projection;
 
+        // 压缩顶点格式的解码参数 (见 VertexPacking)
+        uniform bool packedVertex = false;
+        uniform vec3 positionScale = vec3(1.0);
+        uniform vec3 positionOffset = vec3(0.0);
+
+        vec3 octDecode(vec2 e) {
+            vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+            float t = max(-n.z, 0.0);
+            n.x += n.x >= 0.0 ? -t : t;
+            n.y += n.y >= 0.0 ? -t : t;
+            return normalize(n);
+        }
+
         void main() {
-            vec4 worldPos = model * vec4(aPosition, 1.0);
+            // 0. 解码顶点属性 (标准格式时原样使用)
+            vec3 position = aPosition * positionScale + positionOffset;
+            vec3 normal = packedVertex ? octDecode(aNormal.xy) : aNormal;
+            vec4 tangent = packedVertex ? vec4(octDecode(aTangent.xy), aTangent.z < 0.0 ? -1.0 : 1.0) : aTangent;
+
+            vec4 worldPos = model * vec4(position, 1.0);
             FragPos = vec3(worldPos);
             
             // 1. 计算 Normal Matrix (法线矩阵)
@@ -53,11 +93,11 @@ void Renderer::init() {
             mat3 normalMatrix = mat3(transpose(inverse(model)));
 
             // 2. 计算世界空间法线 (N)
-            vec3 N = normalize(normalMatrix * aNormal);
+            vec3 N = normalize(normalMatrix * normal);
             Normal = N; // 将计算好的法线传给 FS (虽然 FS 可能有了 TBN 会重算，但保留它是个好习惯)
             
             // 3. 计算世界空间切线 (T)
-            vec3 T = normalize(normalMatrix * aTangent.xyz);
+            vec3 T = normalize(normalMatrix * tangent.xyz);
             
             // 4. Gram-Schmidt 正交化
             // 这一步非常关键！它剔除 T 中包含的 N 分量，确保 T 绝对垂直于 N。
@@ -66,13 +106,13 @@ void Renderer::init() {
             
             // 5. 计算副切线 (Bitangent, B)
             // 利用叉乘生成第三个轴
-            vec3 B = cross(N, T) * aTangent.w;
+            vec3 B = cross(N, T) * tangent.w;
             
             // 6. 构建 TBN 矩阵
             TBN = mat3(T, B, N);
 
             TexCoord = aTexCoord;
-            LocalPos = aPosition;
+            LocalPos = position;
             
             gl_Position = projection * view * worldPos;
             
@@ -111,6 +151,7 @@ void Renderer::init() {
         // 基础纹理
         uniform sampler2D diffuseMap; 
         uniform bool hasDiffuseMap;
+        uniform bool diffuseIsSRGB;   // sRGB 格式的纹理由硬件线性化，不需要手动 pow
 
         // 纹理变换
         uniform bool useTriplanar;
@@ -141,6 +182,7 @@ void Renderer::init() {
         // 自发光贴图
         uniform sampler2D emissiveMap;
         uniform bool hasEmissiveMap;
+        uniform bool emissiveIsSRGB;
         uniform vec3 emissiveColor;
         uniform float emissiveStrength;
 
@@ -435,7 +477,7 @@ void Renderer::init() {
                     texColor = texture(diffuseMap, TexCoord);
                 }
                 // sRGB 矫正
-                texColor.rgb = pow(texColor.rgb, vec3(2.2)); 
+                if (!diffuseIsSRGB) texColor.rgb = pow(texColor.rgb, vec3(2.2));
                 albedoColor = texColor.rgb * material.albedo;
             }
 
@@ -733,7 +775,7 @@ void Renderer::init() {
                 }
                 
                 // 自发光贴图是颜色信息，通常是 sRGB 的，需要转到 Linear 空间
-                emTex = pow(emTex, vec3(2.2));
+                if (!emissiveIsSRGB) emTex = pow(emTex, vec3(2.2));
                 
                 emission *= emTex;
             }
@@ -1401,6 +1443,30 @@ void Renderer::init() {
     _gridShader->attachFragmentShader(gridFs);
     _gridShader->link();
 
+    // =============================================================
+    // 1.5 只写深度的 Shader (背面深度 pass)：只读位置流，没有片元计算
+    // =============================================================
+    const char* depthOnlyVs = R"(
+        #version 330 core
+        layout (location = 0) in vec3 aPos;
+        uniform mat4 model;
+        uniform mat4 viewProjection;
+        uniform vec3 positionScale = vec3(1.0);   // 量化位置的解码参数 (见 VertexPacking)
+        uniform vec3 positionOffset = vec3(0.0);
+        void main() {
+            gl_Position = viewProjection * model * vec4(aPos * positionScale + positionOffset, 1.0);
+        }
+    )";
+    const char* depthOnlyFs = R"(
+        #version 330 core
+        void main() {}
+    )";
+
+    _depthOnlyShader.reset(new GLSLProgram);
+    _depthOnlyShader->attachVertexShader(depthOnlyVs);
+    _depthOnlyShader->attachFragmentShader(depthOnlyFs);
+    _depthOnlyShader->link();
+
     // =============================================================
     // 2. 程序化天空盒 Shader (Unity 默认风格)
     // =============================================================
@@ -1620,24 +1686,146 @@ void Renderer::render(const Scene& scene, Camera* camera,
                       float contentScale,
                       GameObject* selectedObj)
 {
+    ProfileScope scope("Render Scene");
+    _frameStats = RenderFrameStats();
+    _currentPass = RenderPass::Other;
+    AllocationScope allocations;
+    GLCounterScope glCounters;
+
+    renderScene(scene, camera, targetFBO, width, height, contentScale, selectedObj);
+
+    // pass 之外的调用 (网格线、状态设置等) 记在 Other 上
+    _frameStats.gl = glCounters.getCounters();
+    GLCallCounters passTotal;
+    for (int i = 0; i < kRenderPassCount; ++i) {
+        if (i != static_cast<int>(RenderPass::Other)) passTotal += _frameStats.passes[i].gl;
+    }
+    _frameStats.passes[static_cast<int>(RenderPass::Other)].gl = _frameStats.gl - passTotal;
+
+    // 帧末回收这一帧的临时数组 (它们在 renderScene 返回时已经销毁)
+    _frameStats.frameArenaBytes = _frameArena.getUsedBytes();
+    _frameArena.reset();
+
+    _frameStats.heapAllocations = allocations.getAllocations();
+    checkSteadyStateAllocations(scene, camera, width, height, selectedObj);
+
+    Profiler& profiler = Profiler::Get();
+    profiler.setCounter("Frame Arena KB", _frameStats.frameArenaBytes / 1024.0);
+    profiler.setCounter("Render Heap Allocations", static_cast<double>(_frameStats.heapAllocations));
+    profiler.setCounter("Draw Calls", static_cast<double>(_frameStats.gl.drawCalls));
+    profiler.setCounter("Triangles", static_cast<double>(_frameStats.gl.triangles));
+}
+
+const char* getRenderPassName(RenderPass pass)
+{
+    static const char* const kNames[kRenderPassCount] = {
+        "Reflection Probes", "Planar Reflections", "Shadow CSM", "Point Shadows", "Backface",
+        "Opaque", "Skybox", "Grab", "Transparent", "Outline", "Other"
+    };
+    int index = static_cast<int>(pass);
+    return (index >= 0 && index < kRenderPassCount) ? kNames[index] : "Unknown";
+}
+
+Renderer::RenderPassScope::RenderPassScope(Renderer& renderer, RenderPass pass)
+    : _renderer(renderer), _previous(renderer._currentPass), _profile(getRenderPassName(pass))
+{
+    _renderer._currentPass = pass;
+}
+
+Renderer::RenderPassScope::~RenderPassScope()
+{
+    _renderer.currentPassStats().gl += _counters.getCounters();
+    _renderer._currentPass = _previous;
+}
+
+ViewCullStats* Renderer::currentViewStats()
+{
+    switch (_currentPass) {
+    case RenderPass::ReflectionProbes: return &_frameStats.probeViews;
+    case RenderPass::PlanarReflections: return &_frameStats.mirrorViews;
+    case RenderPass::Opaque:
+    case RenderPass::Transparent: return &_frameStats.mainView;
+    default: return nullptr;
+    }
+}
+
+void Renderer::checkSteadyStateAllocations(const Scene& scene, Camera* camera, int width, int height,
+                                           const GameObject* selectedObj)
+{
+    if (!AllocationTracker::isEnabled()) return;
+
+    // 影响这一帧分配情况的输入：物体用的模型与 LOD、光源、探针、视口、相机与渲染设置
+    ContentHash hash;
+    for (const MeshComponent& mesh : scene.view<MeshComponent>()) {
+        const Model* model = mesh.model.get();
+        hash.update(&model, sizeof(model));
+        hash.update(&mesh.lodLevel, sizeof(mesh.lodLevel));
+        hash.update(&mesh.lodCulled, sizeof(mesh.lodCulled));
+    }
+    for (const LightComponent& light : scene.view<LightComponent>()) {
+        hash.update(&light.type, sizeof(light.type));
+        hash.update(&light.castShadows, sizeof(light.castShadows));
+    }
+    size_t probes = 0, planars = 0;
+    for (const ReflectionProbeComponent& probe : scene.view<ReflectionProbeComponent>(false)) { (void)probe; probes++; }
+    for (const PlanarReflectionComponent& planar : scene.view<PlanarReflectionComponent>()) { (void)planar; planars++; }
+    int selectedId = selectedObj ? selectedObj->getInstanceID() : 0;
+    glm::mat4 viewProjection = camera->getProjectionMatrix() * camera->getViewMatrix();
+    hash.update(&probes, sizeof(probes));
+    hash.update(&planars, sizeof(planars));
+    hash.update(&width, sizeof(width));
+    hash.update(&height, sizeof(height));
+    hash.update(&selectedId, sizeof(selectedId));
+    hash.update(&viewProjection, sizeof(viewProjection));
+    int lodBiases[2] = { _lodSettings.enabled ? _lodSettings.shadowLodBias : 0,
+                         _lodSettings.enabled ? _lodSettings.probeLodBias : 0 };
+    bool clusterFlags[3] = { _clusterSettings.enabled, _clusterSettings.coneCulling, _clusterSettings.shadows };
+    hash.update(lodBiases, sizeof(lodBiases));
+    hash.update(clusterFlags, sizeof(clusterFlags));
+
+    uint64_t signature = hash.digest();
+    _steadyFrames = (signature == _frameSignature) ? _steadyFrames + 1 : 0;
+    _frameSignature = signature;
+
+    if (_steadyFrames >= kAllocationWarmupFrames && _frameStats.heapAllocations > 0) {
+        std::cerr << "[Renderer] " << _frameStats.heapAllocations
+                  << " heap allocations in a steady-state frame" << std::endl;
+        assert(_frameStats.heapAllocations == 0 && "render() must not allocate once the scene is static");
+    }
+}
+
+void Renderer::renderScene(const Scene& scene, Camera* camera,
+                           GLuint targetFBO, int width, int height,
+                           float contentScale,
+                           GameObject* selectedObj)
+{
+    // Pass -2: 按主相机选择 LOD (阴影、探针在此基础上加粗)
+    {
+        ProfileScope scope("LOD Select");
+        updateMeshLods(scene, camera, height);
+    }
+    int shadowLodBias = _lodSettings.enabled ? _lodSettings.shadowLodBias : 0;
+
     // Pass -1: 烘焙反射探针
-    updateReflectionProbes(scene);
+    {
+        RenderPassScope pass(*this, RenderPass::ReflectionProbes);
+        updateReflectionProbes(scene);
+    }
 
     // ===============================================
     // Pass -0.5: 平面反射渲染 (Planar Reflection)
     // ===============================================
     // 遍历场景，找到所有带 PlanarReflectionComponent 的物体
     // 必须在主场景渲染之前完成，因为主场景需要采样这些纹理
-    for (const auto& go : scene.getGameObjects())
+    // 简单的视锥剔除优化：如果镜子不在相机视野内，就不需要渲染它的反射图
+    // 这里暂时略过，直接渲染所有启用的镜子
     {
-        // 简单的视锥剔除优化：如果镜子不在相机视野内，就不需要渲染它的反射图
-        // 这里暂时略过，直接渲染所有启用的镜子
-        if (auto planar = go->getComponent<PlanarReflectionComponent>())
+        RenderPassScope pass(*this, RenderPass::PlanarReflections);
+        for (PlanarReflectionComponent& planar : scene.view<PlanarReflectionComponent>())
         {
-            if (planar->enabled) {
-                // 传入主相机，计算它的镜像
-                _planarReflectionPass->render(scene, go.get(), camera, this);
-            }
+            // 传入主相机，计算它的镜像
+            _planarReflectionPass->render(scene, planar.owner, camera, this);
+            _frameStats.mirrorRenders++;
         }
     }
 
@@ -1645,117 +1833,156 @@ void Renderer::render(const Scene& scene, Camera* camera,
     // 1. 收集光源 & 准备阴影数据
     // ===============================================
     
-    // 1. 收集并分类光源
-    std::vector<LightComponent*> dirLights;
-    std::vector<LightComponent*> pointLights;
-    std::vector<LightComponent*> spotLights;
+    // 1. 收集并分类光源 (连同各自的阴影索引)
+    FrameLights lights(_frameArena);
     
     // 用于传递给 ShadowPass 的纯数据
-    std::vector<ShadowCasterInfo> csmCasters; // 平行光
-    std::vector<PointShadowInfo> pointShadowInfos; // 点光源
-    
-    // 记录光源组件对应的纹理层级索引 (LightComponent* -> LayerIndex)
-    std::unordered_map<LightComponent*, int> lightToShadowIndex;
+    FrameVector<ShadowCasterInfo> csmCasters(_frameArena); // 平行光
+    FrameVector<PointShadowInfo> pointShadowInfos(_frameArena); // 点光源
 
     int csmLayersPerLight = _shadowPass->getCascadeCount(); // 通常是 5 (4级联 + 1)
     
     // 遍历场景收集光源
-    for (const auto& go : scene.getGameObjects()) {
-        auto light = go->getComponent<LightComponent>();
-        if (light && light->enabled) {
-            if (light->type == LightType::Directional) {
-                dirLights.push_back(light);
+    for (LightComponent& lightComp : scene.view<LightComponent>()) {
+        LightComponent* light = &lightComp;
+        GameObject* go = light->owner;
+        if (light->type == LightType::Directional) {
+            lights.directional.push_back(light);
+            
+            // 判断是否投射阴影 (且未超过最大限制，假设 ShadowPass 支持 4 个)
+            // 注意：这里 4 必须与 ShadowMapPass 构造时的 maxLights 一致
+            if (light->castShadows && csmCasters.size() < 4) {
+                ShadowCasterInfo info;
+                // 计算光的方向 (物体的前方是 -Z，应用旋转)
+                info.direction = go->getWorldRotation() * glm::vec3(0, 0, -1);
+                info.shadowNormalBias = light->shadowNormalBias;
+                info.cullFaceMode = light->shadowCullFace;
                 
-                // 判断是否投射阴影 (且未超过最大限制，假设 ShadowPass 支持 4 个)
-                // 注意：这里 4 必须与 ShadowMapPass 构造时的 maxLights 一致
-                if (light->castShadows && csmCasters.size() < 4) {
-                    ShadowCasterInfo info;
-                    // 计算光的方向 (物体的前方是 -Z，应用旋转)
-                    info.direction = go->transform.rotation * glm::vec3(0, 0, -1);
-                    info.shadowNormalBias = light->shadowNormalBias;
-                    info.cullFaceMode = light->shadowCullFace;
-                    
-                    csmCasters.push_back(info);
-                    
-                    // 计算该光源在 TextureArray 中的起始层级
-                    // 第 0 个光源用 0~4 层，第 1 个用 5~9 层...
-                    int baseLayer = (int)(csmCasters.size() - 1) * csmLayersPerLight;
-                    lightToShadowIndex[light] = baseLayer;
-                } else {
-                    lightToShadowIndex[light] = -1; // 不投射阴影
-                }
-            }
-            else if (light->type == LightType::Point) {
-                pointLights.push_back(light);
-
-                // 检查是否开启阴影且未超限 (PointShadowPass 最大支持 4 个)
-                if (light->castShadows && pointShadowInfos.size() < _pointShadowPass->getMaxLights()) {
-                    PointShadowInfo info;
-                    info.position = go->transform.position;
-                    info.farPlane = light->range;
-                    info.lightIndex = (int)pointShadowInfos.size(); // 0, 1, 2, 3...
-
-                    pointShadowInfos.push_back(info);
-                    lightToShadowIndex[light] = info.lightIndex;
-                } else {
-                    lightToShadowIndex[light] = -1;
-                }
+                csmCasters.push_back(info);
+                
+                // 计算该光源在 TextureArray 中的起始层级
+                // 第 0 个光源用 0~4 层，第 1 个用 5~9 层...
+                int baseLayer = (int)(csmCasters.size() - 1) * csmLayersPerLight;
+                lights.directionalShadowIndices.push_back(baseLayer);
+            } else {
+                lights.directionalShadowIndices.push_back(-1); // 不投射阴影
             }
-            else if (light->type == LightType::Spot) {
-                spotLights.push_back(light);
+        }
+        else if (light->type == LightType::Point) {
+            lights.point.push_back(light);
+
+            // 检查是否开启阴影且未超限 (PointShadowPass 最大支持 4 个)
+            if (light->castShadows && pointShadowInfos.size() < _pointShadowPass->getMaxLights()) {
+                PointShadowInfo info;
+                info.position = go->getWorldPosition();
+                info.farPlane = light->range;
+                info.lightIndex = (int)pointShadowInfos.size(); // 0, 1, 2, 3...
+
+                pointShadowInfos.push_back(info);
+                lights.pointShadowIndices.push_back(info.lightIndex);
+            } else {
+                lights.pointShadowIndices.push_back(-1);
             }
         }
+        else if (light->type == LightType::Spot) {
+            lights.spot.push_back(light);
+        }
     }
 
     // ===============================================
     // 2. 执行 Shadow Passes
     // ===============================================
     // 渲染平行光 (CSM)
-    _shadowPass->render(scene, csmCasters, camera);
+    {
+        RenderPassScope pass(*this, RenderPass::ShadowCSM);
+        _shadowPass->render(scene, csmCasters, camera, shadowLodBias,
+                            _clusterSettings.enabled && _clusterSettings.shadows, _clusterSettings.coneCulling);
+
+        const std::vector<int>& cascadeCasters = _shadowPass->getCascadeCasterCounts();
+        _frameStats.shadowCascadeCount = std::min((int)cascadeCasters.size(), RenderFrameStats::kMaxShadowCascades);
+        for (int i = 0; i < _frameStats.shadowCascadeCount; ++i) {
+            _frameStats.shadowCasters[i] = cascadeCasters[i];
+            currentPassStats().objectsVisible += cascadeCasters[i];
+        }
+        currentPassStats().objectsCulled += _shadowPass->getCulledCasterCount();
+    }
     
     // 渲染点光源 (Omnidirectional)
-    _pointShadowPass->render(scene, pointShadowInfos);
+    {
+        RenderPassScope pass(*this, RenderPass::PointShadows);
+        _pointShadowPass->render(scene, pointShadowInfos, shadowLodBias);
+    }
 
     // ===============================================
     // 3. 准备渲染队列 (Sorting & Culling)
     // ===============================================
-    std::vector<GameObject*> opaqueQueue;
-    std::vector<GameObject*> transparentQueue;
+    FrameVector<GameObject*> opaqueQueue(_frameArena);
+    FrameVector<GameObject*> transparentQueue(_frameArena);
     glm::vec3 camPos = camera->transform.position;
+    Frustum mainCamFrustum = camera->getFrustum();
 
-    for (const auto& go : scene.getGameObjects()) {
-        auto mesh = go->getComponent<MeshComponent>();
-        if (!mesh || !mesh->enabled) continue;
+    {
+        ProfileScope scope("Cull & Sort");
+
+        // 主视图的视锥剔除与分桶在 JobSystem 上并行：每个物体的结果写进自己的槽位，
+        // 之后按原顺序串行收集，队列顺序与串行构建时一致
+        enum : uint8_t { CullOut = 0, OpaqueBucket = 1, TransparentBucket = 2 };
+        FrameVector<MeshComponent*> candidates(_frameArena);
+        for (MeshComponent& mesh : scene.view<MeshComponent>()) candidates.push_back(&mesh);
+
+        FrameVector<uint8_t> buckets(candidates.size(), CullOut, _frameArena);
+        FrameVector<float> distances(candidates.size(), 0.0f, _frameArena);
+        JobSystem::Get().parallelFor(0, candidates.size(), kCullChunkSize, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const MeshComponent* mesh = candidates[i];
+                const GameObject* go = mesh->owner;
+
+                if (mesh->model) {
+                    glm::mat4 modelMatrix = go->getWorldMatrix() * mesh->model->transform.getLocalMatrix();
+                    if (!mainCamFrustum.intersect(mesh->model->getBoundingBox(), modelMatrix)) {
+                        buckets[i] = CullOut;
+                        continue;
+                    }
+                }
 
-        // 根据透明度参数分桶
-        if (mesh->material.transparency > 0.001f || (mesh->opacityMap != nullptr)) {
-            transparentQueue.push_back(go.get());
-        } else {
-            opaqueQueue.push_back(go.get());
-        }
+                // 根据透明度参数分桶
+                bool transparent = mesh->material.transparency > 0.001f || (mesh->opacityMap != nullptr);
+                buckets[i] = transparent ? TransparentBucket : OpaqueBucket;
+                distances[i] = glm::distance(go->getWorldPosition(), camPos);
+            }
+        });
+
+        FrameVector<size_t> transparentOrder(_frameArena);
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (buckets[i] == OpaqueBucket) opaqueQueue.push_back(candidates[i]->owner);
+            else if (buckets[i] == TransparentBucket) transparentOrder.push_back(i);
+            else _frameStats.mainView.culled++; // 画出的与尺寸剔除的在 Opaque / Transparent 中统计
+        }
+
+        // 对透明队列进行排序：从远到近 (Back-to-Front)
+        // 这样才能保证透过前面的玻璃能看到后面的玻璃
+        // 距离相同时按原顺序 (与 stable_sort 结果一致，但 std::sort 不需要临时缓冲区)
+        std::sort(transparentOrder.begin(), transparentOrder.end(),
+            [&distances](size_t a, size_t b) {
+                if (distances[a] != distances[b]) return distances[a] > distances[b]; // 距离大的排前面
+                return a < b;
+            });
+        transparentQueue.reserve(transparentOrder.size());
+        for (size_t i : transparentOrder) transparentQueue.push_back(candidates[i]->owner);
     }
 
-    // 对透明队列进行排序：从远到近 (Back-to-Front)
-    // 这样才能保证透过前面的玻璃能看到后面的玻璃
-    std::sort(transparentQueue.begin(), transparentQueue.end(), 
-        [&camPos](GameObject* a, GameObject* b) {
-            float distA = glm::distance(a->transform.position, camPos);
-            float distB = glm::distance(b->transform.position, camPos);
-            return distA > distB; // 距离大的排前面
-        });
-    
-    Frustum mainCamFrustum = camera->getFrustum();
+    ClusterCullView mainClusterView = makeClusterView(&mainCamFrustum, camera->getViewMatrix(), camera->getProjectionMatrix());
     
-    // 必须先更新 Shader 的 View/Proj 矩阵！
-    // 否则使用的是上一帧或 Probe 最后一次渲染的矩阵，导致深度图错位
-    _mainShader->use();
-    _mainShader->setUniformMat4("view", camera->getViewMatrix());
-    _mainShader->setUniformMat4("projection", camera->getProjectionMatrix());
-
     // Backface Depth Pass
+    // 矩阵直接传入 (不再复用 Main Shader 里上一帧或 Probe 留下的 View/Proj)
     // 必须在 Grab Pass 之前绘制，因为 Grab Pass 会切换 FBO
-    glViewport(0, 0, width, height);
-    renderBackfacePass(transparentQueue, &mainCamFrustum); // 绘制透明物体的背面深度
+    {
+        RenderPassScope pass(*this, RenderPass::Backface);
+        glViewport(0, 0, width, height);
+        renderBackfacePass(transparentQueue, &mainCamFrustum,
+                           camera->getProjectionMatrix() * camera->getViewMatrix()); // 绘制透明物体的背面深度
+    }
 
     // ===============================================
     // Pass 1: 主场景渲染
@@ -1788,45 +2015,53 @@ void Renderer::render(const Scene& scene, Camera* camera,
     ReflectionProbeComponent* activeProbe = nullptr;
     GameObject* activeProbeObj = nullptr;
 
-    for (const auto& go : scene.getGameObjects()) {
-        auto probe = go->getComponent<ReflectionProbeComponent>();
-        if (probe && probe->enabled && probe->textureID != 0) {
-            activeProbe = probe;
-            activeProbeObj = go.get();
+    for (ReflectionProbeComponent& probe : scene.view<ReflectionProbeComponent>()) {
+        if (probe.textureID != 0) {
+            activeProbe = &probe;
+            activeProbeObj = probe.owner;
             break; // 暂只支持一个，找到即止
         }
     }
 
-    // A. 设置全局 Uniforms (只需一次)
-    setupShaderLighting(scene, view, proj, camPos, dirLights, pointLights, spotLights, lightToShadowIndex);
+    {
+        RenderPassScope pass(*this, RenderPass::Opaque);
+        // A. 设置全局 Uniforms (只需一次)
+        setupShaderLighting(scene, view, proj, camPos, lights);
 
-    // 补充设置相机的 Near/Far
-    float zNear = 0.1f; 
-    float zFar = 1000.0f;
+        // 补充设置相机的 Near/Far
+        float zNear = 0.1f; 
+        float zFar = 1000.0f;
     
-    // 尝试从 Camera 指针获取
-    if (auto pCam = dynamic_cast<PerspectiveCamera*>(camera)) {
-        zNear = pCam->znear;
-        zFar = pCam->zfar;
-    } else if (auto oCam = dynamic_cast<OrthographicCamera*>(camera)) {
-        zNear = oCam->znear;
-        zFar = oCam->zfar;
-    }
+        // 尝试从 Camera 指针获取
+        if (auto pCam = dynamic_cast<PerspectiveCamera*>(camera)) {
+            zNear = pCam->znear;
+            zFar = pCam->zfar;
+        } else if (auto oCam = dynamic_cast<OrthographicCamera*>(camera)) {
+            zNear = oCam->znear;
+            zFar = oCam->zfar;
+        }
     
-    _mainShader->setUniformFloat("zNear", zNear);
-    _mainShader->setUniformFloat("zFar", zFar);
+        _mainShader->setUniformFloat("zNear", zNear);
+        _mainShader->setUniformFloat("zFar", zFar);
 
-    // B. 绘制不透明物体 (Opaque)
-    // 它们会写入深度，遮挡后面的东西
-    renderObjectList(opaqueQueue, scene, nullptr, activeProbe, activeProbeObj, &mainCamFrustum);
+        // B. 绘制不透明物体 (Opaque)
+        // 它们会写入深度，遮挡后面的东西
+        // 队列已经过视锥剔除，这里不再逐物体检测 (逐簇剔除仍使用 mainClusterView 中的视锥)
+        renderObjectList(opaqueQueue, scene, nullptr, activeProbe, activeProbeObj, nullptr, true, &mainClusterView);
+    }
 
     // C. 绘制天空盒 (Skybox)
     // [优化] 放在不透明物体之后画，利用 Early-Z 减少 Overdraw
     // drawSkybox 内部已经设置了 glDepthFunc(GL_LEQUAL)，所以只会画在没被遮挡的地方
-    drawSkybox(view, proj, scene.getEnvironment());
+    {
+        RenderPassScope pass(*this, RenderPass::Skybox);
+        drawSkybox(view, proj, scene.getEnvironment());
+    }
 
     if (width > 0 && height > 0) // 防止最小化时崩溃
     {
+        RenderPassScope pass(*this, RenderPass::Grab);
+
         // 1. 抓取颜色
         glActiveTexture(GL_TEXTURE3);
         glBindTexture(GL_TEXTURE_2D, _sceneColorMap);
@@ -1861,18 +2096,23 @@ void Renderer::render(const Scene& scene, Camera* camera,
     // D. 绘制透明物体 (Transparent)
     // 此时天空和不透明物体都画好了，玻璃可以正确混合(blend)并进行后续的背景抓取(GrabPass)
     // 绑定背面深度图到 Slot 17
-    glActiveTexture(GL_TEXTURE17);
-    glBindTexture(GL_TEXTURE_2D, _sceneBackfaceDepthMap);
-    _mainShader->use();
-    _mainShader->setUniformInt("backfaceDepthMap", 17);
-    
-    renderObjectList(transparentQueue, scene, nullptr, activeProbe, activeProbeObj, &mainCamFrustum);
+    {
+        RenderPassScope pass(*this, RenderPass::Transparent);
+        glActiveTexture(GL_TEXTURE17);
+        glBindTexture(GL_TEXTURE_2D, _sceneBackfaceDepthMap);
+        _mainShader->use();
+        _mainShader->setUniformInt("backfaceDepthMap", 17);
+
+        renderObjectList(transparentQueue, scene, nullptr, activeProbe, activeProbeObj, nullptr, true, &mainClusterView);
+    }
 
     // E. 辅助渲染 (Grid / Gizmos / Outline)
     drawGrid(view, proj, camPos);
 
     // 绘制描边
     if (selectedObj) {
+        RenderPassScope pass(*this, RenderPass::Outline);
+
         // OutlinePass 需要传入宽高用于重新生成纹理
         _outlinePass->render(selectedObj, camera, contentScale, width, height);
         
@@ -2611,10 +2851,7 @@ void Renderer::drawGrid(const glm::mat4& view, const glm::mat4& proj, const glm:
 }
 
 void Renderer::setupShaderLighting(const Scene& scene, const glm::mat4& view, const glm::mat4& proj, const glm::vec3& viewPos,
-                                   const std::vector<LightComponent*>& dirLights,
-                                   const std::vector<LightComponent*>& pointLights,
-                                   const std::vector<LightComponent*>& spotLights,
-                                   const std::unordered_map<LightComponent*, int>& shadowIndices)
+                                   const FrameLights& lights)
 {
     _mainShader->use();
     _mainShader->setUniformMat4("projection", proj);
@@ -2652,7 +2889,7 @@ void Renderer::setupShaderLighting(const Scene& scene, const glm::mat4& view, co
 
     // 设置全局 Shadow Bias (取第一个灯的配置作为参考)
     float globalBias = 0.001f;
-    for(auto l : dirLights) if(l->castShadows) { globalBias = l->shadowBias; break; }
+    for(auto l : lights.directional) if(l->castShadows) { globalBias = l->shadowBias; break; }
     _mainShader->setUniformFloat("shadowBias", globalBias);
 
     // 设置 Point Shadows -> Slot 7, 8, 9, 10
@@ -2673,21 +2910,22 @@ void Renderer::setupShaderLighting(const Scene& scene, const glm::mat4& view, co
     // 2. 提交光源数据 (Lights)
     // ==================================================
     
+    // uniform 名写进栈上的缓冲区 (不拼接 std::string)
+    char name[64];
+
     // --- Directional Lights ---
     int maxDir = 4;
     int countDir = 0;
-    for (auto light : dirLights) {
+    for (auto light : lights.directional) {
         if (countDir >= maxDir) break;
-        std::string base = "dirLights[" + std::to_string(countDir) + "]";
         
-        glm::vec3 dir = light->owner->transform.rotation * glm::vec3(0, 0, -1);
-        _mainShader->setUniformVec3(base + ".direction", dir);
-        _mainShader->setUniformVec3(base + ".color", light->color);
-        _mainShader->setUniformFloat(base + ".intensity", light->intensity);
+        glm::vec3 dir = light->owner->getWorldRotation() * glm::vec3(0, 0, -1);
+        _mainShader->setUniformVec3(arrayUniformName(name, "dirLights", countDir, "direction"), dir);
+        _mainShader->setUniformVec3(arrayUniformName(name, "dirLights", countDir, "color"), light->color);
+        _mainShader->setUniformFloat(arrayUniformName(name, "dirLights", countDir, "intensity"), light->intensity);
         
-        int idx = -1;
-        if (shadowIndices.count(light)) idx = shadowIndices.at(light);
-        _mainShader->setUniformInt(base + ".shadowIndex", idx);
+        int idx = countDir < (int)lights.directionalShadowIndices.size() ? lights.directionalShadowIndices[countDir] : -1;
+        _mainShader->setUniformInt(arrayUniformName(name, "dirLights", countDir, "shadowIndex"), idx);
         
         countDir++;
     }
@@ -2696,21 +2934,19 @@ void Renderer::setupShaderLighting(const Scene& scene, const glm::mat4& view, co
     // --- Point Lights ---
     int maxPoint = 4;
     int countPoint = 0;
-    for (auto light : pointLights) {
+    for (auto light : lights.point) {
         if (countPoint >= maxPoint) break;
-        std::string base = "pointLights[" + std::to_string(countPoint) + "]";
-        _mainShader->setUniformVec3(base + ".position", light->owner->transform.position);
-        _mainShader->setUniformVec3(base + ".color", light->color);
-        _mainShader->setUniformFloat(base + ".intensity", light->intensity);
-        _mainShader->setUniformFloat(base + ".range", light->range);
-
-        int idx = -1;
-        if (shadowIndices.count(light)) idx = shadowIndices.at(light);
-        _mainShader->setUniformInt(base + ".shadowIndex", idx);
-
-        _mainShader->setUniformFloat(base + ".shadowStrength", light->shadowStrength);
-        _mainShader->setUniformFloat(base + ".shadowRadius", light->shadowRadius);
-        _mainShader->setUniformFloat(base + ".shadowBias", light->shadowBias);
+        _mainShader->setUniformVec3(arrayUniformName(name, "pointLights", countPoint, "position"), light->owner->getWorldPosition());
+        _mainShader->setUniformVec3(arrayUniformName(name, "pointLights", countPoint, "color"), light->color);
+        _mainShader->setUniformFloat(arrayUniformName(name, "pointLights", countPoint, "intensity"), light->intensity);
+        _mainShader->setUniformFloat(arrayUniformName(name, "pointLights", countPoint, "range"), light->range);
+
+        int idx = countPoint < (int)lights.pointShadowIndices.size() ? lights.pointShadowIndices[countPoint] : -1;
+        _mainShader->setUniformInt(arrayUniformName(name, "pointLights", countPoint, "shadowIndex"), idx);
+
+        _mainShader->setUniformFloat(arrayUniformName(name, "pointLights", countPoint, "shadowStrength"), light->shadowStrength);
+        _mainShader->setUniformFloat(arrayUniformName(name, "pointLights", countPoint, "shadowRadius"), light->shadowRadius);
+        _mainShader->setUniformFloat(arrayUniformName(name, "pointLights", countPoint, "shadowBias"), light->shadowBias);
         
         // 可选：更新 Gizmo 颜色
         if (auto mesh = light->owner->getComponent<MeshComponent>()) {
@@ -2723,18 +2959,17 @@ void Renderer::setupShaderLighting(const Scene& scene, const glm::mat4& view, co
     // --- Spot Lights ---
     int maxSpot = 4;
     int countSpot = 0;
-    for (auto light : spotLights) {
+    for (auto light : lights.spot) {
         if (countSpot >= maxSpot) break;
-        std::string base = "spotLights[" + std::to_string(countSpot) + "]";
-        glm::vec3 dir = light->owner->transform.rotation * glm::vec3(0, 0, -1);
+        glm::vec3 dir = light->owner->getWorldRotation() * glm::vec3(0, 0, -1);
         
-        _mainShader->setUniformVec3(base + ".position", light->owner->transform.position);
-        _mainShader->setUniformVec3(base + ".direction", dir);
-        _mainShader->setUniformVec3(base + ".color", light->color);
-        _mainShader->setUniformFloat(base + ".intensity", light->intensity);
-        _mainShader->setUniformFloat(base + ".cutOff", light->cutOff);
-        _mainShader->setUniformFloat(base + ".outerCutOff", light->outerCutOff);
-        _mainShader->setUniformFloat(base + ".range", light->range);
+        _mainShader->setUniformVec3(arrayUniformName(name, "spotLights", countSpot, "position"), light->owner->getWorldPosition());
+        _mainShader->setUniformVec3(arrayUniformName(name, "spotLights", countSpot, "direction"), dir);
+        _mainShader->setUniformVec3(arrayUniformName(name, "spotLights", countSpot, "color"), light->color);
+        _mainShader->setUniformFloat(arrayUniformName(name, "spotLights", countSpot, "intensity"), light->intensity);
+        _mainShader->setUniformFloat(arrayUniformName(name, "spotLights", countSpot, "cutOff"), light->cutOff);
+        _mainShader->setUniformFloat(arrayUniformName(name, "spotLights", countSpot, "outerCutOff"), light->outerCutOff);
+        _mainShader->setUniformFloat(arrayUniformName(name, "spotLights", countSpot, "range"), light->range);
         
         if (auto mesh = light->owner->getComponent<MeshComponent>()) {
             if (mesh->isGizmo) mesh->material.albedo = light->color;
@@ -2780,15 +3015,25 @@ void Renderer::setupShaderLighting(const Scene& scene, const glm::mat4& view, co
     }
 }
 
-void Renderer::renderObjectList(const std::vector<GameObject*>& objects, 
+void Renderer::renderObjectList(const FrameVector<GameObject*>& objects, 
                                 const Scene& scene, 
                                 const GameObject* excludeObject,
                                 const ReflectionProbeComponent* activeProbe,
                                 const GameObject* activeProbeObj,
-                                const Frustum* frustum)
+                                const Frustum* frustum,
+                                bool mainView,
+                                const ClusterCullView* clusterView)
 {
     _mainShader->use();
 
+    int lodBias = (!mainView && _lodSettings.enabled) ? _lodSettings.probeLodBias : 0;
+
+    // 没有视点信息时 (平面反射) 只做逐簇视锥剔除
+    // frustum 为空表示物体已在外面剔除过，逐簇剔除沿用 clusterView 自带的视锥
+    ClusterCullView clusterCull = clusterView ? *clusterView : ClusterCullView();
+    if (frustum) clusterCull.frustum = frustum;
+    clusterCull.coneCulling = clusterCull.coneCulling && _clusterSettings.coneCulling;
+
     // 开启混合以支持透明物体正确渲染
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -2799,8 +3044,6 @@ void Renderer::renderObjectList(const std::vector<GameObject*>& objects,
 
     _mainShader->setUniformInt("planarReflectionMap", PLANAR_REFLECTION_SLOT);
 
-    // int drawCallCount = 0;
-
     for (GameObject* go : objects) 
     {
         if (excludeObject && go == excludeObject) continue;
@@ -2815,16 +3058,27 @@ void Renderer::renderObjectList(const std::vector<GameObject*>& objects,
             const BoundingBox& localBox = meshComp->model->getBoundingBox();
             
             // 计算完整的 Model Matrix (GameObject Transform * Mesh Local Transform)
-            glm::mat4 modelMatrix = go->transform.getLocalMatrix() * meshComp->model->transform.getLocalMatrix();
+            glm::mat4 modelMatrix = go->getWorldMatrix() * meshComp->model->transform.getLocalMatrix();
 
             // 调用我们刚才确认过的 OBB 检测函数
             if (!frustum->intersect(localBox, modelMatrix)) {
+                countCulledObject();
                 continue; // 在视锥外，跳过绘制
             }
         }
 
-        // drawCallCount++;
-        
+        // 投影尺寸过小 (只在主视图剔除，探针的视点离物体可能更近)
+        if (mainView && meshComp->lodCulled) {
+            _frameStats.lodCulledObjects++;
+            countCulledObject();
+            continue;
+        }
+
+        _frameStats.drawCalls++;
+        currentPassStats().objectsVisible++;
+        if (ViewCullStats* viewStats = currentViewStats()) viewStats->visible++;
+        const int fetchesPerMap = meshComp->useTriplanar ? 3 : 1;
+
         // 双面渲染处理
         if (meshComp->doubleSided) glDisable(GL_CULL_FACE);
         else glEnable(GL_CULL_FACE);
@@ -2836,7 +3090,9 @@ void Renderer::renderObjectList(const std::vector<GameObject*>& objects,
         // Diffuse / Albedo (Slot 0)
         if (meshComp->diffuseMap) {
             meshComp->diffuseMap->bind(0);
+            _frameStats.materialTextureBinds++;
             _mainShader->setUniformBool("hasDiffuseMap", true);
+            _mainShader->setUniformBool("diffuseIsSRGB", meshComp->diffuseMap->isSRGB());
         } else {
             _mainShader->setUniformBool("hasDiffuseMap", false);
             glActiveTexture(GL_TEXTURE0); glBindTexture(GL_TEXTURE_2D, 0);
@@ -2845,6 +3101,7 @@ void Renderer::renderObjectList(const std::vector<GameObject*>& objects,
         // Normal (Slot 1)
         if (meshComp->normalMap) {
             meshComp->normalMap->bind(1);
+            _frameStats.materialTextureBinds++;
             _mainShader->setUniformBool("hasNormalMap", true);
             _mainShader->setUniformFloat("normalStrength", meshComp->normalStrength);
             _mainShader->setUniformBool("flipNormalY", meshComp->flipNormalY);
@@ -2854,8 +3111,16 @@ void Renderer::renderObjectList(const std::vector<GameObject*>& objects,
         }
 
         // ORM (Slot 4)
-        if (meshComp->ormMap) {
+        // 独立 AO/Roughness/Metallic 齐全时用自动打包的 ORM 替代 (三者优先级高于 ormMap，打包后结果一致)
+        ImageTexture2D* packedOrm = resolvePackedOrm(meshComp);
+        if (packedOrm) {
+            packedOrm->bind(4);
+            _frameStats.materialTextureBinds++;
+            _frameStats.packedOrmDraws++;
+            _mainShader->setUniformBool("hasOrmMap", true);
+        } else if (meshComp->ormMap) {
             meshComp->ormMap->bind(4);
+            _frameStats.materialTextureBinds++;
             _mainShader->setUniformBool("hasOrmMap", true);
         } else {
             _mainShader->setUniformBool("hasOrmMap", false);
@@ -2865,7 +3130,9 @@ void Renderer::renderObjectList(const std::vector<GameObject*>& objects,
         // Emissive (Slot 5)
         if (meshComp->emissiveMap) {
             meshComp->emissiveMap->bind(5);
+            _frameStats.materialTextureBinds++;
             _mainShader->setUniformBool("hasEmissiveMap", true);
+            _mainShader->setUniformBool("emissiveIsSRGB", meshComp->emissiveMap->isSRGB());
         } else {
             _mainShader->setUniformBool("hasEmissiveMap", false);
             glActiveTexture(GL_TEXTURE5); glBindTexture(GL_TEXTURE_2D, 0);
@@ -2876,6 +3143,7 @@ void Renderer::renderObjectList(const std::vector<GameObject*>& objects,
         // Opacity (Slot 6)
         if (meshComp->opacityMap) {
             meshComp->opacityMap->bind(6);
+            _frameStats.materialTextureBinds++;
             _mainShader->setUniformBool("hasOpacityMap", true);
             _mainShader->setUniformFloat("alphaCutoff", meshComp->alphaCutoff);
         } else {
@@ -2883,16 +3151,27 @@ void Renderer::renderObjectList(const std::vector<GameObject*>& objects,
             glActiveTexture(GL_TEXTURE6); glBindTexture(GL_TEXTURE_2D, 0);
         }
 
-        // Independent PBR Maps (Slot 14, 15, 16)
-        if (meshComp->aoMap) { meshComp->aoMap->bind(14); _mainShader->setUniformBool("hasAoMap", true); }
+        // Independent PBR Maps (Slot 14, 15, 16)，已被打包 ORM 替代时跳过
+        ImageTexture2D* aoMap = packedOrm ? nullptr : meshComp->aoMap.get();
+        ImageTexture2D* roughnessMap = packedOrm ? nullptr : meshComp->roughnessMap.get();
+        ImageTexture2D* metallicMap = packedOrm ? nullptr : meshComp->metallicMap.get();
+
+        if (aoMap) { aoMap->bind(14); _frameStats.materialTextureBinds++; _mainShader->setUniformBool("hasAoMap", true); }
         else { _mainShader->setUniformBool("hasAoMap", false); glActiveTexture(GL_TEXTURE14); glBindTexture(GL_TEXTURE_2D, 0); }
 
-        if (meshComp->roughnessMap) { meshComp->roughnessMap->bind(15); _mainShader->setUniformBool("hasRoughnessMap", true); }
+        if (roughnessMap) { roughnessMap->bind(15); _frameStats.materialTextureBinds++; _mainShader->setUniformBool("hasRoughnessMap", true); }
         else { _mainShader->setUniformBool("hasRoughnessMap", false); glActiveTexture(GL_TEXTURE15); glBindTexture(GL_TEXTURE_2D, 0); }
 
-        if (meshComp->metallicMap) { meshComp->metallicMap->bind(16); _mainShader->setUniformBool("hasMetallicMap", true); }
+        if (metallicMap) { metallicMap->bind(16); _frameStats.materialTextureBinds++; _mainShader->setUniformBool("hasMetallicMap", true); }
         else { _mainShader->setUniformBool("hasMetallicMap", false); glActiveTexture(GL_TEXTURE16); glBindTexture(GL_TEXTURE_2D, 0); }
 
+        // 每像素材质采样次数 (与片元着色器中的分支一一对应)
+        int sampledMaps = (meshComp->diffuseMap ? 1 : 0) + (meshComp->normalMap ? 1 : 0)
+                        + ((packedOrm || meshComp->ormMap) ? 1 : 0) + (meshComp->emissiveMap ? 1 : 0)
+                        + (meshComp->opacityMap ? 1 : 0)
+                        + (aoMap ? 1 : 0) + (roughnessMap ? 1 : 0) + (metallicMap ? 1 : 0);
+        _frameStats.materialTextureFetches += sampledMaps * fetchesPerMap;
+
         // ==================================================
         // 2. 材质与几何参数
         // ==================================================
@@ -2951,7 +3230,7 @@ void Renderer::renderObjectList(const std::vector<GameObject*>& objects,
             // 情况 A: 有局部探针 -> 绑定 Probe 纹理
             glBindTexture(GL_TEXTURE_CUBE_MAP, activeProbe->textureID);
 
-            glm::vec3 pPos = activeProbeObj->transform.position; // 使用 Probe 对象的位置
+            glm::vec3 pPos = activeProbeObj->getWorldPosition(); // 使用 Probe 对象的位置
             
             // 计算世界坐标下的 AABB (Min/Max)
             glm::vec3 bMin = pPos - activeProbe->boxSize * 0.5f;
@@ -2980,15 +3259,23 @@ void Renderer::renderObjectList(const std::vector<GameObject*>& objects,
         // ==================================================
         // 4. 绘制调用
         // ==================================================
-        glm::mat4 modelMatrix = go->transform.getLocalMatrix();
+        glm::mat4 modelMatrix = go->getWorldMatrix();
         if (meshComp->model) {
             modelMatrix = modelMatrix * meshComp->model->transform.getLocalMatrix();
             _mainShader->setUniformMat4("model", modelMatrix);
-            meshComp->model->draw();
+            meshComp->model->setVertexDecodeUniforms(*_mainShader);
+
+            int lod = meshComp->getLodLevel(lodBias);
+            if (lod > 0) _frameStats.lodDraws++;
+
+            // 双面材质关闭了背面剔除，法线锥剔除不再成立
+            ClusterCullView objectView = clusterCull;
+            objectView.coneCulling = objectView.coneCulling && !meshComp->doubleSided;
+            _frameStats.triangles += drawMeshClustered(*meshComp->model, lod, modelMatrix,
+                                                       frustum ? &objectView : nullptr, false);
         }
     }
 
-    // if (frustum) std::cout << "Draw calls: " << drawCallCount << " / " << objects.size() << std::endl;
 
     // 绘制结束后恢复 Cull Face
     glEnable(GL_CULL_FACE);
@@ -2997,7 +3284,156 @@ void Renderer::renderObjectList(const std::vector<GameObject*>& objects,
     glDisable(GL_BLEND);
 }
 
-void Renderer::renderBackfacePass(const std::vector<GameObject*>& objects, const Frustum* frustum)
+ClusterCullView Renderer::makeClusterView(const Frustum* frustum, const glm::mat4& view, const glm::mat4& proj)
+{
+    ClusterCullView clusterView;
+    clusterView.frustum = frustum;
+    clusterView.coneCulling = true;
+    clusterView.orthographic = proj[2][3] == 0.0f;
+
+    glm::mat4 cameraToWorld = glm::inverse(view);
+    clusterView.eye = glm::vec3(cameraToWorld[3]);
+    clusterView.direction = -glm::normalize(glm::vec3(cameraToWorld[2]));
+    return clusterView;
+}
+
+size_t Renderer::drawMeshClustered(Model& model, int lod, const glm::mat4& modelMatrix,
+                                   const ClusterCullView* view, bool depthOnly)
+{
+    if (_clusterSettings.enabled && view && model.cullClusters(lod, modelMatrix, *view, _clusterDrawList)) {
+        _frameStats.clusterDraws++;
+        _frameStats.clustersDrawn += _clusterDrawList.visibleClusters;
+        _frameStats.clustersCulled += _clusterDrawList.frustumCulled + _clusterDrawList.coneCulled;
+        model.drawClusters(_clusterDrawList, depthOnly);
+        return _clusterDrawList.indexCount / 3;
+    }
+
+    if (depthOnly) model.drawDepth(lod);
+    else model.draw(lod);
+    return model.getLodFaceCount(lod);
+}
+
+void Renderer::prepareScene(Scene& scene)
+{
+    bool packOrm = ResourceManager::Get().isOrmPackingEnabled();
+    for (MeshComponent& mesh : scene.view<MeshComponent>(false)) {
+        // 上传放在这里，渲染时不会再触发 initGL (它会按驻留策略释放 CPU 端数据，UI 线程的拾取还在读)
+        if (mesh.model && !mesh.model->isUploaded()) mesh.model->initGL();
+        if (packOrm) requestPackedOrm(&mesh);
+    }
+
+    for (ReflectionProbeComponent& probe : scene.view<ReflectionProbeComponent>(false)) probe.initGL();
+    for (PlanarReflectionComponent& planar : scene.view<PlanarReflectionComponent>(false)) planar.initGL();
+}
+
+void Renderer::requestPackedOrm(MeshComponent* meshComp)
+{
+    if (!meshComp->aoMap || !meshComp->roughnessMap || !meshComp->metallicMap) {
+        meshComp->packedOrmMap.reset();
+        return;
+    }
+
+    // 输入变化 (或首次使用) 时重新请求；ResourceManager 内部有缓存，同一组贴图只打包一次
+    if (meshComp->packedOrmSources[0] != meshComp->aoMap ||
+        meshComp->packedOrmSources[1] != meshComp->roughnessMap ||
+        meshComp->packedOrmSources[2] != meshComp->metallicMap)
+    {
+        meshComp->packedOrmSources[0] = meshComp->aoMap;
+        meshComp->packedOrmSources[1] = meshComp->roughnessMap;
+        meshComp->packedOrmSources[2] = meshComp->metallicMap;
+        meshComp->packedOrmMap = ResourceManager::Get().getPackedORM(
+            *meshComp->aoMap, *meshComp->roughnessMap, *meshComp->metallicMap);
+    }
+}
+
+ImageTexture2D* Renderer::resolvePackedOrm(const MeshComponent* meshComp) const
+{
+    if (!ResourceManager::Get().isOrmPackingEnabled() || !meshComp->packedOrmMap) return nullptr;
+
+    // 请求之后又换了贴图 (还没有经过 prepareScene) 时不能用旧的打包结果
+    if (meshComp->packedOrmSources[0] != meshComp->aoMap ||
+        meshComp->packedOrmSources[1] != meshComp->roughnessMap ||
+        meshComp->packedOrmSources[2] != meshComp->metallicMap)
+    {
+        return nullptr;
+    }
+
+    // 打包完成前继续使用独立贴图，不会出现占位图闪烁
+    if (meshComp->packedOrmMap->isResident()) {
+        return meshComp->packedOrmMap.get();
+    }
+    return nullptr;
+}
+
+void Renderer::updateMeshLods(const Scene& scene, Camera* camera, int viewportHeight)
+{
+    const LodSettings& settings = _lodSettings;
+    glm::mat4 view = camera->getViewMatrix();
+    glm::mat4 proj = camera->getProjectionMatrix();
+
+    // 投影矩阵的 [1][1] 在透视下是 1/tan(fovy/2)，正交下是 2/高度：
+    // 距离 d 处 (正交时与距离无关) 一个单位长度对应的像素数 = [1][1] * 0.5 * 视口高度 (/ d)
+    bool perspective = proj[2][3] != 0.0f;
+    float pixelsPerUnit = proj[1][1] * 0.5f * static_cast<float>(viewportHeight);
+
+    for (MeshComponent& mesh : scene.view<MeshComponent>(false)) {
+        MeshComponent* meshComp = &mesh;
+        GameObject* go = mesh.owner;
+        if (!meshComp->model) continue;
+
+        if (!settings.enabled || meshComp->isGizmo || viewportHeight <= 0) {
+            meshComp->lodLevel = 0;
+            meshComp->lodCulled = false;
+            continue;
+        }
+
+        // 包围球 (世界空间，非均匀缩放取最大轴)
+        glm::mat4 modelMatrix = go->getWorldMatrix() * meshComp->model->transform.getLocalMatrix();
+        const BoundingBox& box = meshComp->model->getBoundingBox();
+        float scale = std::max({ glm::length(glm::vec3(modelMatrix[0])),
+                                 glm::length(glm::vec3(modelMatrix[1])),
+                                 glm::length(glm::vec3(modelMatrix[2])) });
+        float radius = 0.5f * glm::length(box.max - box.min) * scale;
+        glm::vec3 center = glm::vec3(modelMatrix * glm::vec4(0.5f * (box.min + box.max), 1.0f));
+
+        float sizeScale = pixelsPerUnit;    // 按球心深度：判断投影尺寸
+        float errorScale = pixelsPerUnit;   // 按最近点深度：误差取保守值
+        if (perspective) {
+            float depth = -(view * glm::vec4(center, 1.0f)).z;
+            if (depth - radius <= 1e-3f) {
+                // 相机在包围球内或贴得很近：全精度
+                meshComp->lodLevel = 0;
+                meshComp->lodCulled = false;
+                continue;
+            }
+            sizeScale /= depth;
+            errorScale /= depth - radius;
+        }
+
+        // 尺寸剔除：已剔除的物体要长到阈值 / hysteresis 才恢复
+        float diameterPx = 2.0f * radius * sizeScale;
+        float cullPx = meshComp->lodCulled ? settings.cullPixels / settings.hysteresis : settings.cullPixels;
+        meshComp->lodCulled = settings.cullPixels > 0.0f && diameterPx < cullPx;
+
+        // LOD：误差随级别单调增加，分别找出误差不超过阈值 / 阈值 * hysteresis 的最粗级别
+        int lodCount = meshComp->model->getLodCount();
+        int allowed = 0;
+        int comfortable = 0;
+        for (int lod = 1; lod < lodCount; ++lod) {
+            float errorPx = meshComp->model->getLodError(lod) * scale * errorScale;
+            if (errorPx <= settings.maxErrorPixels) allowed = lod;
+            if (errorPx <= settings.maxErrorPixels * settings.hysteresis) comfortable = lod;
+        }
+
+        // 当前级别误差超标时立即换细，有足够余量时才换粗
+        int current = std::min(meshComp->lodLevel, lodCount - 1);
+        if (current > allowed) current = allowed;
+        else if (comfortable > current) current = comfortable;
+        meshComp->lodLevel = current;
+    }
+}
+
+void Renderer::renderBackfacePass(const FrameVector<GameObject*>& objects, const Frustum* frustum, const glm::mat4& viewProjection)
 {
     if (objects.empty()) return;
 
@@ -3014,8 +3450,9 @@ void Renderer::renderBackfacePass(const std::vector<GameObject*>& objects, const
     // 3. 深度测试开启
     glEnable(GL_DEPTH_TEST);
 
-    // 复用 Main Shader，因为它已经绑定了 View/Projection 矩阵
-    _mainShader->use();
+    // 只写深度，用位置流 + 空片元着色器
+    _depthOnlyShader->use();
+    _depthOnlyShader->setUniformMat4("viewProjection", viewProjection);
 
     // 简化版绘制循环
     for (GameObject* go : objects) 
@@ -3026,25 +3463,33 @@ void Renderer::renderBackfacePass(const std::vector<GameObject*>& objects, const
         // 只有开启了实体模式的物体，才需要渲染背面深度！
         // 薄壁物体不需要厚度信息，跳过
         if (!meshComp->isSolidGlass) continue;
+        if (meshComp->lodCulled) continue;
 
         // 计算矩阵
         if (frustum && meshComp->model) {
             const BoundingBox& localBox = meshComp->model->getBoundingBox();
-            glm::mat4 modelMatrix = go->transform.getLocalMatrix() * meshComp->model->transform.getLocalMatrix();
+            glm::mat4 modelMatrix = go->getWorldMatrix() * meshComp->model->transform.getLocalMatrix();
             
             if (!frustum->intersect(localBox, modelMatrix)) {
+                currentPassStats().objectsCulled++;
                 continue; // 跳过
             }
+            currentPassStats().objectsVisible++;
             
             // 如果通过检测，设置矩阵并绘制
-            _mainShader->setUniformMat4("model", modelMatrix);
-            meshComp->model->draw();
+            _depthOnlyShader->setUniformMat4("model", modelMatrix);
+            meshComp->model->setVertexDecodeUniforms(*_depthOnlyShader);
+            // 与正面使用同一级 LOD，厚度才一致；这里画的是背面，只做逐簇视锥剔除
+            ClusterCullView clusterView;
+            clusterView.frustum = frustum;
+            drawMeshClustered(*meshComp->model, meshComp->getLodLevel(), modelMatrix, &clusterView, true);
         } 
         else if (meshComp->model) // 如果没有传 frustum，回退到旧逻辑
         {
-            glm::mat4 modelMatrix = go->transform.getLocalMatrix() * meshComp->model->transform.getLocalMatrix();
-            _mainShader->setUniformMat4("model", modelMatrix);
-            meshComp->model->draw();
+            glm::mat4 modelMatrix = go->getWorldMatrix() * meshComp->model->transform.getLocalMatrix();
+            _depthOnlyShader->setUniformMat4("model", modelMatrix);
+            meshComp->model->setVertexDecodeUniforms(*_depthOnlyShader);
+            meshComp->model->drawDepth(meshComp->getLodLevel());
         }
     }
 
@@ -3061,63 +3506,59 @@ void Renderer::updateReflectionProbes(const Scene& scene)
     glGetIntegerv(GL_VIEWPORT, prevViewport);
 
     // 1. 预先收集光源 (为了简单起见，反射探针渲染时不开启阴影)
-    std::vector<LightComponent*> dirLights, pointLights, spotLights;
-    std::unordered_map<LightComponent*, int> emptyShadowIndices; // 空 map，表示无阴影
+    // 阴影索引留空，表示都没有阴影
+    FrameLights lights(_frameArena);
 
-    for (const auto& go : scene.getGameObjects()) {
-        auto light = go->getComponent<LightComponent>();
-        if (light && light->enabled) {
-            if (light->type == LightType::Directional) dirLights.push_back(light);
-            else if (light->type == LightType::Point) pointLights.push_back(light);
-            else if (light->type == LightType::Spot) spotLights.push_back(light);
-        }
+    for (LightComponent& light : scene.view<LightComponent>()) {
+        if (light.type == LightType::Directional) lights.directional.push_back(&light);
+        else if (light.type == LightType::Point) lights.point.push_back(&light);
+        else if (light.type == LightType::Spot) lights.spot.push_back(&light);
     }
 
-    std::vector<GameObject*> opaqueQueue;
-    std::vector<GameObject*> transparentQueue;
+    FrameVector<GameObject*> opaqueQueue(_frameArena);
+    FrameVector<GameObject*> transparentQueue(_frameArena);
 
     // 简单的可见性判断
-    for (const auto& go : scene.getGameObjects()) {
-        auto mesh = go->getComponent<MeshComponent>();
-        if (!mesh || !mesh->enabled) continue;
-
-        if (mesh->material.transparency > 0.001f || mesh->opacityMap) {
-            transparentQueue.push_back(go.get());
+    for (MeshComponent& mesh : scene.view<MeshComponent>()) {
+        if (mesh.material.transparency > 0.001f || mesh.opacityMap) {
+            transparentQueue.push_back(mesh.owner);
         } else {
-            opaqueQueue.push_back(go.get());
+            opaqueQueue.push_back(mesh.owner);
         }
     }
     // 注意：反射探针对于透明物体的排序通常不需要太严格（因为是低频环境图），
     // 但为了代码复用，如果有需要可以在这里加 sort。
 
     // 遍历所有物体，找带 ReflectionProbeComponent 的
-    for (const auto& go : scene.getGameObjects())
+    for (ReflectionProbeComponent& probeComp : scene.view<ReflectionProbeComponent>(false))
     {
-        auto probe = go->getComponent<ReflectionProbeComponent>();
-        if (!probe) continue;
+        ReflectionProbeComponent* probe = &probeComp;
+        GameObject* go = probe->owner;
 
         // if (!probe->isDirty) continue;
 
         // 1. 确保 GL 资源已创建
         probe->initGL();
+        _frameStats.probeRenders++;
 
         // 2. 准备烘焙参数
         glBindFramebuffer(GL_FRAMEBUFFER, probe->fboID);
         glViewport(0, 0, probe->resolution, probe->resolution);
 
-        glm::vec3 probePos = go->transform.position;
+        glm::vec3 probePos = go->getWorldPosition();
         // 投影矩阵：90度 FOV, 1:1 比例, 近裁剪面 0.1, 远裁剪面 100
         glm::mat4 shadowProj = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
 
         // 3. 朝 6 个方向渲染
         // OpenGL Cubemap 面顺序: +X, -X, +Y, -Y, +Z, -Z
-        std::vector<glm::mat4> shadowViews;
-        shadowViews.push_back(glm::lookAt(probePos, probePos + glm::vec3( 1.0f,  0.0f,  0.0f), glm::vec3(0.0f, -1.0f,  0.0f)));
-        shadowViews.push_back(glm::lookAt(probePos, probePos + glm::vec3(-1.0f,  0.0f,  0.0f), glm::vec3(0.0f, -1.0f,  0.0f)));
-        shadowViews.push_back(glm::lookAt(probePos, probePos + glm::vec3( 0.0f,  1.0f,  0.0f), glm::vec3(0.0f,  0.0f,  1.0f)));
-        shadowViews.push_back(glm::lookAt(probePos, probePos + glm::vec3( 0.0f, -1.0f,  0.0f), glm::vec3(0.0f,  0.0f, -1.0f)));
-        shadowViews.push_back(glm::lookAt(probePos, probePos + glm::vec3( 0.0f,  0.0f,  1.0f), glm::vec3(0.0f, -1.0f,  0.0f)));
-        shadowViews.push_back(glm::lookAt(probePos, probePos + glm::vec3( 0.0f,  0.0f, -1.0f), glm::vec3(0.0f, -1.0f,  0.0f)));
+        std::array<glm::mat4, 6> shadowViews = {
+            glm::lookAt(probePos, probePos + glm::vec3( 1.0f,  0.0f,  0.0f), glm::vec3(0.0f, -1.0f,  0.0f)),
+            glm::lookAt(probePos, probePos + glm::vec3(-1.0f,  0.0f,  0.0f), glm::vec3(0.0f, -1.0f,  0.0f)),
+            glm::lookAt(probePos, probePos + glm::vec3( 0.0f,  1.0f,  0.0f), glm::vec3(0.0f,  0.0f,  1.0f)),
+            glm::lookAt(probePos, probePos + glm::vec3( 0.0f, -1.0f,  0.0f), glm::vec3(0.0f,  0.0f, -1.0f)),
+            glm::lookAt(probePos, probePos + glm::vec3( 0.0f,  0.0f,  1.0f), glm::vec3(0.0f, -1.0f,  0.0f)),
+            glm::lookAt(probePos, probePos + glm::vec3( 0.0f,  0.0f, -1.0f), glm::vec3(0.0f, -1.0f,  0.0f)),
+        };
 
         for (int i = 0; i < 6; ++i)
         {
@@ -3128,22 +3569,23 @@ void Renderer::updateReflectionProbes(const Scene& scene)
             // 清屏 (注意：这里不需要 glClearColor 设置太亮，否则缝隙会明显)
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+            _frameStats.probeFaceRenders++;
             glm::mat4 faceVP = shadowProj * shadowViews[i]; // Proj * View
             Frustum faceFrustum = Frustum::createFromMatrix(faceVP);
+            ClusterCullView faceClusterView = makeClusterView(&faceFrustum, shadowViews[i], shadowProj);
 
             // A. 设置全局光照参数 (注意：View 矩阵每面都不同)
-            setupShaderLighting(scene, shadowViews[i], shadowProj, probePos, 
-                                dirLights, pointLights, spotLights, emptyShadowIndices);
+            setupShaderLighting(scene, shadowViews[i], shadowProj, probePos, lights);
 
             // B. 绘制不透明物体 (排除自己)
-            renderObjectList(opaqueQueue, scene, go.get(), nullptr, nullptr, &faceFrustum);
+            renderObjectList(opaqueQueue, scene, go, nullptr, nullptr, &faceFrustum, false, &faceClusterView);
 
             // C. 绘制天空盒 (后绘优化)
             glm::mat4 viewNoTrans = glm::mat4(glm::mat3(shadowViews[i])); 
             drawSkybox(viewNoTrans, shadowProj, scene.getEnvironment());
 
             // D. 绘制透明物体 (排除自己)
-            renderObjectList(transparentQueue, scene, go.get(), nullptr, nullptr, &faceFrustum);
+            renderObjectList(transparentQueue, scene, go, nullptr, nullptr, &faceFrustum, false, &faceClusterView);
         }
 
         // 6个面都画完了，生成 Mipmap
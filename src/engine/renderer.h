@@ -1,18 +1,22 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
-#include <unordered_map>
 #include <glad/gl.h>
 
 #include "scene.h"
 #include "base/camera.h"
 #include "base/glsl_program.h"
+#include "base/gl_counters.h"
 #include "outline_pass.h"
 #include "geometry_factory.h"
 #include "shadow_map_pass.h"
 #include "point_shadow_pass.h"
 #include "planar_reflection_pass.h"
+#include "gpu_profiler.h"
+#include "mesh_clusters.h"
+#include "engine/utils/frame_arena.h"
 
 struct IBLProfile {
     GLuint envMap = 0;       // 天空盒
@@ -22,6 +26,93 @@ struct IBLProfile {
     bool isBaked = false;     // 标记是否已经烘焙过数据
 };
 
+// render() 中的各个 pass (与分析器中的 pass 名字一致)；Other 收集 pass 之外的调用 (网格线等)
+enum class RenderPass : int {
+    ReflectionProbes,
+    PlanarReflections,
+    ShadowCSM,
+    PointShadows,
+    Backface,
+    Opaque,
+    Skybox,
+    Grab,
+    Transparent,
+    Outline,
+    Other,
+    Count
+};
+
+constexpr int kRenderPassCount = static_cast<int>(RenderPass::Count);
+const char* getRenderPassName(RenderPass pass);
+
+// 一个 pass 的统计
+struct RenderPassStats {
+    GLCallCounters gl;       // 这个 pass 提交的 GL 调用
+    int objectsVisible = 0;  // 画出的物体 (阴影 pass 为投射者，按级联 / 面重复计)
+    int objectsCulled = 0;   // 被视锥、尺寸或逐簇剔除整个跳过的物体
+};
+
+// 一个视图 (或同类视图之和) 的剔除结果
+struct ViewCullStats {
+    int visible = 0;
+    int culled = 0;
+};
+
+// 每帧渲染统计 (render() 开始时清零，包含反射、探针等所有 renderObjectList 调用)
+struct RenderFrameStats {
+    static constexpr int kMaxShadowCascades = 8;
+
+    int drawCalls = 0;
+    int materialTextureBinds = 0;   // 材质贴图绑定次数
+    int materialTextureFetches = 0; // 各 draw 每像素材质采样次数之和 (三平面映射按 3 次计)
+    int packedOrmDraws = 0;         // 用自动打包 ORM 替代了独立贴图的 draw 数
+    int lodDraws = 0;               // 使用了简化 LOD (级别 > 0) 的 draw 数
+    int lodCulledObjects = 0;       // 投影尺寸过小被剔除的物体数
+    size_t triangles = 0;           // 提交的三角形数
+    int clusterDraws = 0;           // 按网格簇提交的 draw 数
+    int clustersDrawn = 0;          // 这些 draw 中可见的簇
+    int clustersCulled = 0;         // 被视锥 / 法线锥剔除的簇
+    size_t frameArenaBytes = 0;     // 这一帧从 FrameArena 分配的临时内存
+    size_t heapAllocations = 0;     // 这一帧 render() 在渲染线程上的堆分配次数 (只有调试构建统计)
+
+    // GL 调用计数：整个 render() 与各个 pass
+    GLCallCounters gl;
+    RenderPassStats passes[kRenderPassCount];
+
+    // 各视图的剔除：主相机 (视锥 + 尺寸剔除)、平面反射 (所有镜子)、反射探针 (所有探针的 6 个面)
+    ViewCullStats mainView;
+    ViewCullStats mirrorViews;
+    ViewCullStats probeViews;
+
+    // 平行光阴影每一级级联的投射者 (所有光源之和)
+    int shadowCasters[kMaxShadowCascades] = {};
+    int shadowCascadeCount = 0;
+
+    // 这一帧重新渲染的反射探针 / 探针面 / 镜子
+    int probeRenders = 0;
+    int probeFaceRenders = 0;
+    int mirrorRenders = 0;
+
+    const RenderPassStats& getPass(RenderPass pass) const { return passes[static_cast<int>(pass)]; }
+};
+
+// 网格 LOD 选择参数 (主相机每帧选一次，结果记在 MeshComponent 上供各个 pass 使用)
+struct LodSettings {
+    bool enabled = true;
+    float maxErrorPixels = 1.0f;    // 允许的屏幕空间几何误差 (像素)
+    float hysteresis = 0.7f;        // 换到更粗的级别 (或剔除后恢复) 时须越过阈值的这个比例，避免来回跳
+    float cullPixels = 2.0f;        // 包围球投影直径小于它的物体不画 (0 = 不剔除)
+    int shadowLodBias = 1;          // 阴影 pass 比主视图粗几级
+    int probeLodBias = 2;           // 反射探针比主视图粗几级
+};
+
+// 大网格的逐簇剔除 (簇在导入时划分，见 MeshClusters)
+struct ClusterCullSettings {
+    bool enabled = true;
+    bool coneCulling = true;        // 法线锥背面剔除 (双面材质、平面反射不做)
+    bool shadows = true;            // 平行光阴影级联也逐簇剔除
+};
+
 class Renderer
 {
 public:
@@ -41,25 +132,44 @@ public:
     void updateProceduralSkybox(const SceneEnvironment& env);
 
     // 渲染指定的物体列表 (通用函数)
-    void renderObjectList(const std::vector<GameObject*>& objects, 
+    // mainView: 主视图 (含平面反射) 使用按屏幕尺寸选出的 LOD 并剔除过小的物体；
+    // 反射探针传 false，改用 probeLodBias 加粗后的级别，不做尺寸剔除
+    // clusterView: 逐簇剔除用的视点 (见 makeClusterView)；为空时只按 frustum 逐簇剔除
+    void renderObjectList(const FrameVector<GameObject*>& objects, 
                           const Scene& scene, 
                           const GameObject* excludeObject = nullptr,
                           const ReflectionProbeComponent* activeProbe = nullptr,
                           const GameObject* activeProbeObj = nullptr,
-                          const Frustum* frustum = nullptr);
+                          const Frustum* frustum = nullptr,
+                          bool mainView = true,
+                          const ClusterCullView* clusterView = nullptr);
     
     void drawSkybox(const glm::mat4& view, const glm::mat4& proj, const SceneEnvironment& env);
 
     // 核心渲染函数
     // targetFBO: 传入 0 渲染到屏幕，传入 FBO ID 渲染到纹理
     // selectedObj: 如果非空，则绘制描边 (Editor 模式用)
+    // 每帧的临时数组都来自 FrameArena，帧末统一回收；稳定状态下整个调用没有堆分配
     void render(const Scene& scene, Camera* camera, 
                 GLuint targetFBO, int width, int height,
                 float contentScale, 
                 GameObject* selectedObj = nullptr);
 
+    // [帧边界] 在场景本身 (而不是渲染快照) 上完成渲染前的准备：模型上传、打包 ORM 请求、
+    // 探针与平面反射的 GL 资源。之后拷贝出的快照直接带上这些结果，渲染时不再改写场景或调用 ResourceManager
+    void prepareScene(Scene& scene);
+
     GLSLProgram* getMainShader() const { return _mainShader.get(); }
 
+    // 这一帧的临时内存 (只在 render() 期间、渲染线程上使用)
+    FrameArena& getFrameArena() { return _frameArena; }
+
+    // 最近一帧 render() 的统计 (渲染线程写入；其他线程只在帧边界上读取)
+    const RenderFrameStats& getFrameStats() const { return _frameStats; }
+
+    LodSettings& getLodSettings() { return _lodSettings; }
+    ClusterCullSettings& getClusterCullSettings() { return _clusterSettings; }
+
     // 定义反射纹理专用的纹理槽位 (Slot 18)
     // 0-6: 基础材质, 7-10: 点光源阴影, 11-13: IBL, 14-16: ORM独立, 17: 背面深度
     static constexpr int PLANAR_REFLECTION_SLOT = 18;
@@ -68,6 +178,7 @@ private:
     // --- Shader 资源 ---
     std::unique_ptr<GLSLProgram> _mainShader;
     std::unique_ptr<GLSLProgram> _gridShader;
+    std::unique_ptr<GLSLProgram> _depthOnlyShader;   // 只读位置流的深度 pass
     std::unique_ptr<GLSLProgram> _skyboxShader;
     std::unique_ptr<GLSLProgram> _equirectangularToCubemapShader;
     std::unique_ptr<GLSLProgram> _irradianceShader;
@@ -114,15 +225,86 @@ private:
     void initSceneDepthMap(int width, int height);
     void initBackfaceDepthMap(int width, int height);
     void drawGrid(const glm::mat4& view, const glm::mat4& proj, const glm::vec3& viewPos);
+
+    // 一帧中收集到的光源 (按类型分组)
+    // xxxShadowIndices 与同组的光源一一对应 (阴影贴图层 / 槽位，-1 表示不投射阴影)，为空表示都没有阴影
+    struct FrameLights {
+        FrameVector<LightComponent*> directional;
+        FrameVector<LightComponent*> point;
+        FrameVector<LightComponent*> spot;
+        FrameVector<int> directionalShadowIndices;
+        FrameVector<int> pointShadowIndices;
+
+        explicit FrameLights(FrameArena& arena)
+            : directional(arena), point(arena), spot(arena),
+              directionalShadowIndices(arena), pointShadowIndices(arena) {}
+    };
+
     // 设置 Shader 的全局光照参数 (灯光、阴影、环境贴图)
     void setupShaderLighting(const Scene& scene, const glm::mat4& view, const glm::mat4& proj, const glm::vec3& viewPos, 
-                             const std::vector<LightComponent*>& dirLights,
-                             const std::vector<LightComponent*>& pointLights,
-                             const std::vector<LightComponent*>& spotLights,
-                             const std::unordered_map<LightComponent*, int>& shadowIndices);
+                             const FrameLights& lights);
+
+    // render() 的主体：其中的临时数组在返回前全部销毁，之后 render() 才回收 FrameArena
+    void renderScene(const Scene& scene, Camera* camera, GLuint targetFBO, int width, int height,
+                     float contentScale, GameObject* selectedObj);
+
+    FrameArena _frameArena;
+
+    // 调试构建：场景、视点与设置连续若干帧不变之后，检查这一帧没有堆分配
+    uint64_t _frameSignature = 0;
+    int _steadyFrames = 0;
+    void checkSteadyStateAllocations(const Scene& scene, Camera* camera, int width, int height,
+                                     const GameObject* selectedObj);
     
+    RenderFrameStats _frameStats;
+    RenderPass _currentPass = RenderPass::Other;
+    RenderPassStats& currentPassStats() { return _frameStats.passes[static_cast<int>(_currentPass)]; }
+    // 正在进行的 pass 对应的视图剔除统计 (主相机之外的视图)
+    ViewCullStats* currentViewStats();
+    void countCulledObject()
+    {
+        currentPassStats().objectsCulled++;
+        if (ViewCullStats* viewStats = currentViewStats()) viewStats->culled++;
+    }
+
+    // 一个 pass：CPU / GPU 计时 (同 PassProfileScope) 并把期间的 GL 调用与剔除结果记到这个 pass 上
+    class RenderPassScope
+    {
+    public:
+        RenderPassScope(Renderer& renderer, RenderPass pass);
+        ~RenderPassScope();
+
+        RenderPassScope(const RenderPassScope&) = delete;
+        RenderPassScope& operator=(const RenderPassScope&) = delete;
+
+    private:
+        Renderer& _renderer;
+        RenderPass _previous;
+        GLCounterScope _counters;
+        PassProfileScope _profile;
+    };
+
+    LodSettings _lodSettings;
+    ClusterCullSettings _clusterSettings;
+    ClusterDrawList _clusterDrawList;   // 逐簇剔除的结果，每次 draw 复用
+
+    // 由视图 / 投影矩阵构造逐簇剔除的视点 (正交投影取视线方向)
+    static ClusterCullView makeClusterView(const Frustum* frustum, const glm::mat4& view, const glm::mat4& proj);
+
+    // 有簇时只提交可见的簇，否则整个绘制；返回提交的三角形数
+    size_t drawMeshClustered(Model& model, int lod, const glm::mat4& modelMatrix,
+                             const ClusterCullView* view, bool depthOnly);
+
+    // 按主相机为每个网格选择 LOD 与尺寸剔除 (viewportHeight 为像素高度)
+    void updateMeshLods(const Scene& scene, Camera* camera, int viewportHeight);
+
+    // 三张独立贴图齐全时向 ResourceManager 请求打包 ORM (prepareScene 中调用)
+    void requestPackedOrm(MeshComponent* meshComp);
+    // 独立 AO/Roughness/Metallic 贴图齐全且打包 ORM 已驻留时返回它，否则返回空
+    ImageTexture2D* resolvePackedOrm(const MeshComponent* meshComp) const;
+
     // 渲染物体背面
-    void renderBackfacePass(const std::vector<GameObject*>& objects, const Frustum* frustum);
+    void renderBackfacePass(const FrameVector<GameObject*>& objects, const Frustum* frustum, const glm::mat4& viewProjection);
     // 更新场景中的所有反射探针
     void updateReflectionProbes(const Scene& scene);
 };
\ No newline at end of file
@@ -1,8 +1,12 @@
 #include "resource_manager.h"
 #include "obj_loader.h"
 #include "gltf_loader.h"
+#include "mesh_cache.h"
+#include "engine/utils/profiler.h"
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <unordered_set>
 #include <stb_image.h>
 
 ResourceManager& ResourceManager::Get()
@@ -11,23 +15,46 @@ ResourceManager& ResourceManager::Get()
     return instance;
 }
 
+ResourceManager::ResourceManager()
+    : _workers(std::make_unique<ThreadPool>()),
+      _streamer(std::make_unique<TextureStreamer>()),
+      _watcher(std::make_unique<AssetWatcher>()),
+      _assetDb(std::make_unique<AssetDatabase>())
+{
+    _memoryStats.cpuBudget = _cpuBudget;
+    _memoryStats.gpuBudget = _gpuBudget;
+}
+
+ResourceManager::~ResourceManager()
+{
+    // 先停掉工作线程，再析构缓存
+    _workers.reset();
+}
+
 void ResourceManager::setProjectRoot(const std::string& rootPath)
 {
     // 1. 路径清洗：强制将反斜杠转换为正斜杠
     std::string cleanPath = rootPath;
     std::replace(cleanPath.begin(), cleanPath.end(), '\\', '/');
 
-    _projectRoot = cleanPath;
-    
     // 2. 确保路径以分隔符结尾
-    if (!_projectRoot.empty() && _projectRoot.back() != '/') {
-        _projectRoot += "/";
+    if (!cleanPath.empty() && cleanPath.back() != '/') {
+        cleanPath += "/";
     }
 
+    // 3. 先排空旧项目的加载任务并清空缓存，再切换根目录
+    // (否则旧任务可能把旧文件写进新项目的缓存，或者让新请求拿到旧的 in-flight future)
     shutdown();
+    _projectRoot = cleanPath;
+
+    // 先启动监视器再打开索引，打开期间发生的变化也不会丢
+    if (_watcher->start(_projectRoot)) {
+        std::lock_guard<std::mutex> lock(_watchedRootMutex);
+        _watchedRoot = std::make_shared<const std::string>(_projectRoot);
+    }
 
-    // 初始扫描
-    refreshProjectDirectory();
+    // 读取资源索引 (首次打开项目时并行全量扫描)
+    _assetDb->open(_projectRoot, *_workers);
 }
 
 void ResourceManager::refreshProjectDirectory()
@@ -36,9 +63,9 @@ void ResourceManager::refreshProjectDirectory()
         std::cout << "[ResourceManager] Cannot refresh: Project root not set." << std::endl;
         return;
     }
-    std::cout << "[ResourceManager] Refreshing directory: " << _projectRoot << " ... ";
-    scanDirectory(_projectRoot);
-    std::cout << "Done. Found " << _fileList.size() << " assets." << std::endl;
+    _assetDb->refresh(*_workers);
+    _assetDb->saveIfDirty(true);
+    std::cout << "[ResourceManager] Refreshed: " << _assetDb->getRecords().size() << " assets." << std::endl;
 }
 
 std::string ResourceManager::getFullPath(const std::string& relativePath)
@@ -50,104 +77,85 @@ std::string ResourceManager::getFullPath(const std::string& relativePath)
     return _projectRoot + relativePath;
 }
 
-// scanDirectory 里的逻辑稍微改一下，确保存储的是“相对路径”
-void ResourceManager::scanDirectory(const std::string& rootDir)
+// ==========================================
+// 缓存查询
+// ==========================================
+
+std::shared_ptr<Model> ResourceManager::lookupModel(const AssetKey& key, const std::string& fullPath, const std::string& cleanPath)
 {
-    _fileList.clear();
-    namespace fs = std::filesystem;
-    try {
-        if (rootDir.empty() || !fs::exists(rootDir) || !fs::is_directory(rootDir)) return;
+    // 命中时顺便刷新 LRU 时间戳
+    CacheEntry<Model> entry;
+    uint64_t frame = _frameIndex;
+    if (!_modelCache.update(key, [&](CacheEntry<Model>& e) { e.lastUse = frame; entry = e; })) return nullptr;
 
-        for (const auto& entry : fs::recursive_directory_iterator(rootDir))
-        {
-            if (entry.is_regular_file())
-            {
-                std::string ext = entry.path().extension().string();
-                std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-                
-                bool isModel = (ext == ".obj");
-                bool isTexture = (ext == ".png" || ext == ".jpg" || ext == ".jpeg" ||
-                                ext == ".bmp" || ext == ".tga" || ext == ".hdr");
-
-                if (isModel || isTexture)
-                {
-                    std::string filename = entry.path().filename().string();
-                    
-                    std::string storePath;
-                    try {
-                        // 尝试计算相对路径
-                        storePath = fs::relative(entry.path(), rootDir).string();
-                    } catch (const fs::filesystem_error& e) {
-                        // 如果无法计算相对路径（比如跨盘符），则退化为存储绝对路径
-                        storePath = entry.path().string();
-                    }
-                    std::replace(storePath.begin(), storePath.end(), '\\', '/');
-                    
-                    _fileList.push_back({filename, storePath});
-                }
-            }
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "[ResourceManager] Scan failed: " << e.what() << std::endl;
+    // 由监视器负责的文件：命中即有效 (变化会通过热重载原地替换)
+    if (isWatched(entry.sourcePath)) return entry.resource;
+
+    // 命中缓存后，检查文件是否被修改
+    // 生成当前磁盘文件的签名
+    AssetSignature currentSig = AssetSignature::generate(fullPath);
+
+    // 如果签名不一致，则缓存失效
+    if (currentSig != entry.signature) {
+        std::cout << "[ResourceManager] Hot-Reload Detected: " << cleanPath << std::endl;
+        // 不需要手动 erase，下面的加载逻辑会覆盖它
+        return nullptr;
     }
+    // 签名一致，直接返回缓存
+    return entry.resource;
 }
 
-std::shared_ptr<Model> ResourceManager::getModel(const std::string& pathKey, bool useFlatShade, const std::string& subMeshName)
+std::shared_ptr<ImageTexture2D> ResourceManager::lookupTexture(const AssetKey& key, const std::string& fullPath, const std::string& cleanPath)
 {
-    std::string cleanPath = pathKey;
-    std::replace(cleanPath.begin(), cleanPath.end(), '\\', '/');
+    CacheEntry<ImageTexture2D> entry;
+    uint64_t frame = _frameIndex;
+    if (!_textureCache.update(key, [&](CacheEntry<ImageTexture2D>& e) { e.lastUse = frame; entry = e; })) return nullptr;
 
-    std::string cacheKey = cleanPath;
-    if (useFlatShade) cacheKey += ":useFlatShade";
-    if (!subMeshName.empty()) cacheKey += ":" + subMeshName;
+    if (isWatched(entry.sourcePath)) return entry.resource;
 
-    // 1. 获取绝对路径 (用于检测文件变化)
-    std::string fullPath = getFullPath(cleanPath);
-
-    // 2. 检查缓存
-    auto it = _modelCache.find(cacheKey);
-    if (it != _modelCache.end())
-    {
-        // 命中缓存后，检查文件是否被修改
-        // 生成当前磁盘文件的签名
-        AssetSignature currentSig = AssetSignature::generate(fullPath);
-
-        // 如果签名不一致，则缓存失效
-        if (currentSig != it->second.signature) {
-            std::cout << "[ResourceManager] Hot-Reload Detected: " << cleanPath << std::endl;
-            // 不需要手动 erase，下面的加载逻辑会覆盖它
-        } 
-        else {
-            // 签名一致，直接返回缓存
-            return it->second.resource;
-        }
+    AssetSignature currentSig = AssetSignature::generate(fullPath);
+    // 对比签名
+    if (currentSig != entry.signature) {
+        std::cout << "[ResourceManager] Hot-Reload Detected: " << cleanPath << std::endl;
+        // 签名不一致，继续向下执行加载逻辑（覆盖旧缓存）
+        return nullptr;
     }
+    return entry.resource;
+}
 
-    // 3. 缓存未命中，准备加载
+std::shared_ptr<Model> ResourceManager::loadModelFromDisk(const std::string& projectRoot, const AssetKey& key, const std::string& fullPath,
+                                                          bool useFlatShade, const std::string& subMeshName)
+{
+    // 缓存未命中，准备加载
     if (!std::filesystem::exists(fullPath)) {
         std::cerr << "[ResourceManager] Error: File not found: " << fullPath << std::endl;
         return nullptr; // 或者返回一个紫黑格子的 "ErrorModel"
     }
 
-    // [调试] 打印一下路径，确认拼对了吗
-    // std::cout << "Loading Model: " << fullPath << std::endl;
-
     try {
-        // 加载数据
-        MeshData data = OBJLoader::load(fullPath, useFlatShade, subMeshName);
+        // 加载数据 (优先读网格缓存)
+        MeshData data = loadMeshData(projectRoot, fullPath, useFlatShade, subMeshName);
         if (data.vertices.empty()) return nullptr;
 
-        // 创建 GPU 资源
-        std::shared_ptr<Model> newModel = std::make_shared<Model>(data.vertices, data.indices);
+        // 创建模型 (此时只有 CPU 数据，GL 资源在第一次 draw 时于主线程创建)
+        std::shared_ptr<Model> newModel = createModel(std::move(data.vertices), std::move(data.indices),
+                                                      MeshSourceInfo{ fullPath, subMeshName, useFlatShade, false },
+                                                      std::move(data.lods), std::move(data.clusters));
+        const PackedVertexData& packed = newModel->getGeometry()->packed;
+        if (packed.format != VertexFormat::Standard) {
+            std::cout << "[ResourceManager] Packed vertices: " << fullPath << " (" << VertexPacking::describe(packed) << ")" << std::endl;
+        }
 
-        // 4. 构建新的缓存条目
+        // 构建新的缓存条目
         CacheEntry<Model> entry;
         entry.resource = newModel;
         entry.sourcePath = fullPath;
         entry.signature = AssetSignature::generate(fullPath); // 记录当前版本
-        
-        // 存入 Map
-        _modelCache[cacheKey] = entry;
+        entry.useFlatShade = useFlatShade;
+        entry.subMeshName = subMeshName;
+        entry.lastUse = _frameIndex;
+
+        _modelCache.assign(key, entry);
         return newModel;
     }
     catch (std::exception& e) {
@@ -156,32 +164,188 @@ std::shared_ptr<Model> ResourceManager::getModel(const std::string& pathKey, boo
     }
 }
 
-std::shared_ptr<SceneResource> ResourceManager::getSceneResource(const std::string& pathKey, bool useFlatShade)
+// ==========================================
+// 同步接口
+// ==========================================
+
+std::shared_ptr<Model> ResourceManager::getModel(const std::string& pathKey, bool useFlatShade, const std::string& subMeshName)
 {
-    // 1. 路径标准化
-    std::string cleanPath = pathKey;
-    std::replace(cleanPath.begin(), cleanPath.end(), '\\', '/');
+    // 工作线程里不能等待 requestModel 的 future (它要排在同一个线程池里执行)，直接就地加载
+    if (_workers->isWorkerThread()) {
+        std::string cleanPath = AssetKey::normalizePath(pathKey);
+        AssetKey key = AssetKey::make(cleanPath, useFlatShade, subMeshName);
+        std::string fullPath = getFullPath(cleanPath);
+        if (auto cached = lookupModel(key, fullPath, cleanPath)) return cached;
+        // 切换根目录前工作线程已被排空 (见 shutdown)，这里读到的就是发起这个任务时的根目录
+        return loadModelFromDisk(_projectRoot, key, fullPath, useFlatShade, subMeshName);
+    }
 
-    // 2. 生成 Cache Key
-    // 场景加载只受路径和平滑模式影响，不受 subMeshName 影响
-    std::string cacheKey = cleanPath;
-    if (useFlatShade) cacheKey += ":useFlatShade";
+    // 同步接口直接复用异步请求：
+    // 如果别的线程已经在加载同一资源，这里只会等待它，而不会重复解析文件
+    return requestModel(pathKey, useFlatShade, subMeshName).get();
+}
+
+std::vector<SubMesh> ResourceManager::parseSceneFile(const std::string& fullPath, bool useFlatShade)
+{
+    std::string ext = std::filesystem::path(fullPath).extension().string();
+    // 转小写
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+    if (ext == ".obj") {
+        return OBJLoader::loadScene(fullPath, useFlatShade);
+    } 
+    else if (ext == ".gltf" || ext == ".glb") {
+        // GLTF 通常自带法线，如果需要在加载时重新计算 flat shade，可以在 loader 里加参数
+        // 目前 GLTFLoader 还没支持 useFlatShade 参数，我们暂时忽略它
+        return GLTFLoader::loadScene(fullPath);
+    }
 
-    // 3. 获取绝对路径
+    std::cerr << "[ResourceManager] Unsupported format: " << ext << std::endl;
+    return {};
+}
+
+std::string ResourceManager::makeMeshSourceId(const std::string& projectRoot, const std::string& fullPath, bool useFlatShade,
+                                              const std::string& part)
+{
+    std::string id = AssetKey::normalizePath(fullPath);
+    if (!projectRoot.empty() && id.compare(0, projectRoot.size(), projectRoot) == 0) {
+        id = id.substr(projectRoot.size());
+    }
+    return id + (useFlatShade ? "|flat|" : "|smooth|") + part;
+}
+
+std::vector<SubMesh> ResourceManager::loadSceneMeshes(const std::string& projectRoot, const std::string& fullPath, bool useFlatShade)
+{
+    AssetSignature signature = AssetSignature::generate(fullPath);
+    std::string cachePath = MeshCache::getCachePath(projectRoot, makeMeshSourceId(projectRoot, fullPath, useFlatShade, "scene"), signature);
+
+    AssetLoadScope scope("Scene meshes (" + fullPath + ")");
+    std::vector<SubMesh> subMeshes;
+    if (MeshCache::loadFromDisk(cachePath, subMeshes)) {
+        std::cout << "[ResourceManager] Mesh cache hit: " << fullPath << " (" << subMeshes.size() << " meshes)" << std::endl;
+        return subMeshes;
+    }
+
+    subMeshes = parseSceneFile(fullPath, useFlatShade);
+    if (!subMeshes.empty()) MeshCache::saveToDisk(cachePath, subMeshes);
+    return subMeshes;
+}
+
+MeshData ResourceManager::loadMeshData(const std::string& projectRoot, const std::string& fullPath, bool useFlatShade,
+                                       const std::string& subMeshName)
+{
+    AssetSignature signature = AssetSignature::generate(fullPath);
+    std::string cachePath = MeshCache::getCachePath(projectRoot, makeMeshSourceId(projectRoot, fullPath, useFlatShade, "mesh:" + subMeshName),
+                                                    signature);
+
+    MeshData data;
+    std::vector<SubMesh> cached;
+    if (MeshCache::loadFromDisk(cachePath, cached) && cached.size() == 1) {
+        data.vertices = std::move(cached[0].vertices);
+        data.indices = std::move(cached[0].indices);
+        data.hasUVs = cached[0].hasUVs;
+        data.lods = std::move(cached[0].lods);
+        data.clusters = std::move(cached[0].clusters);
+        return data;
+    }
+
+    data = OBJLoader::load(fullPath, useFlatShade, subMeshName);
+    if (!data.vertices.empty()) {
+        cached.resize(1);
+        cached[0].name = subMeshName;
+        cached[0].vertices = std::move(data.vertices);
+        cached[0].indices = std::move(data.indices);
+        cached[0].hasUVs = data.hasUVs;
+        cached[0].lods = std::move(data.lods);
+        cached[0].clusters = std::move(data.clusters);
+        MeshCache::saveToDisk(cachePath, cached);
+
+        data.vertices = std::move(cached[0].vertices);
+        data.indices = std::move(cached[0].indices);
+        data.lods = std::move(cached[0].lods);
+        data.clusters = std::move(cached[0].clusters);
+    }
+    return data;
+}
+
+std::shared_ptr<SceneResource> ResourceManager::findSceneResource(const std::string& pathKey, bool useFlatShade)
+{
+    std::string cleanPath = AssetKey::normalizePath(pathKey);
     std::string fullPath = getFullPath(cleanPath);
 
-    // 4. 检查缓存 (Dirty Check)
-    auto it = _sceneCache.find(cacheKey);
-    if (it != _sceneCache.end())
+    CacheEntry<SceneResource> cached;
+    uint64_t frame = _frameIndex;
+    if (!_sceneCache.update(AssetKey::make(cleanPath, useFlatShade),
+                            [&](CacheEntry<SceneResource>& e) { e.lastUse = frame; cached = e; })) return nullptr;
+    if (isWatched(cached.sourcePath)) return cached.resource;
+
+    if (AssetSignature::generate(fullPath) != cached.signature) {
+        std::cout << "[ResourceManager] Hot-Reload Detected (Scene): " << cleanPath << std::endl;
+        return nullptr;
+    }
+    return cached.resource;
+}
+
+void ResourceManager::injectSceneResource(const std::string& pathKey, bool useFlatShade, std::shared_ptr<SceneResource> sceneRes)
+{
+    if (!sceneRes || sceneRes->nodes.empty()) return;
+
+    std::string cleanPath = AssetKey::normalizePath(pathKey);
+    std::string fullPath = getFullPath(cleanPath);
+
+    // 场景加载只受路径和平滑模式影响，不受 subMeshName 影响
+    AssetKey cacheKey = AssetKey::make(cleanPath, useFlatShade);
+    AssetSignature fileSig = AssetSignature::generate(fullPath);
+
+    for (const auto& node : sceneRes->nodes)
     {
-        AssetSignature currentSig = AssetSignature::generate(fullPath);
-        if (currentSig != it->second.signature) {
-            std::cout << "[ResourceManager] Hot-Reload Detected (Scene): " << cleanPath << std::endl;
-            // 缓存已脏，继续执行加载逻辑
-        } 
-        else {
-            return it->second.resource;
-        }
+        // [自动缓存注入] 
+        // 将这个子模型单独注册到 _modelCache 中
+        // 这样 getModel("file.obj", ..., "SubName") 也能直接命中
+        CacheEntry<Model> subEntry;
+        subEntry.resource = node.model;
+        subEntry.sourcePath = fullPath;
+        subEntry.signature = fileSig; // 共享同一个文件的签名
+        subEntry.useFlatShade = useFlatShade;
+        subEntry.subMeshName = node.name;
+        subEntry.lastUse = _frameIndex;
+
+        _modelCache.assign(AssetKey::make(cleanPath, useFlatShade, node.name), subEntry);
+    }
+
+    // 如果场景只有一个物体，我们也注册一个“默认单体”缓存 (空 subMeshName)
+    if (sceneRes->nodes.size() == 1) {
+        CacheEntry<Model> singleEntry;
+        singleEntry.resource = sceneRes->nodes[0].model;
+        singleEntry.sourcePath = fullPath;
+        singleEntry.signature = fileSig;
+        singleEntry.useFlatShade = useFlatShade;
+        singleEntry.lastUse = _frameIndex;
+        _modelCache.assign(cacheKey, singleEntry); // cacheKey 就是不带 subName 的 key
+    }
+
+    // 存入 Scene 缓存
+    CacheEntry<SceneResource> entry;
+    entry.resource = sceneRes;
+    entry.sourcePath = fullPath;
+    entry.signature = fileSig;
+    entry.useFlatShade = useFlatShade;
+    entry.lastUse = _frameIndex;
+
+    _sceneCache.assign(cacheKey, entry);
+}
+
+std::shared_ptr<SceneResource> ResourceManager::getSceneResource(const std::string& pathKey, bool useFlatShade)
+{
+    // 1. 路径标准化
+    std::string cleanPath = AssetKey::normalizePath(pathKey);
+
+    // 2. 获取绝对路径
+    std::string fullPath = getFullPath(cleanPath);
+
+    // 3. 检查缓存 (Dirty Check)
+    if (auto cached = findSceneResource(cleanPath, useFlatShade)) {
+        return cached;
     }
 
     if (!std::filesystem::exists(fullPath)) {
@@ -190,70 +354,39 @@ std::shared_ptr<SceneResource> ResourceManager::getSceneResource(const std::stri
     }
 
     try {
-        // 这将返回 raw CPU data (vector<SubMesh>)
-        std::vector<SubMesh> subMeshes;
-        
-        std::string ext = std::filesystem::path(fullPath).extension().string();
-        // 转小写
-        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-
-        if (ext == ".obj") {
-            subMeshes = OBJLoader::loadScene(fullPath, useFlatShade);
-        } 
-        else if (ext == ".gltf" || ext == ".glb") {
-            // GLTF 通常自带法线，如果需要在加载时重新计算 flat shade，可以在 loader 里加参数
-            // 目前 GLTFLoader 还没支持 useFlatShade 参数，我们暂时忽略它
-            subMeshes = GLTFLoader::loadScene(fullPath);
-        }
-        else {
-            std::cerr << "[ResourceManager] Unsupported format: " << ext << std::endl;
-            return nullptr;
-        }
-        
+        // 这将返回 raw CPU data (vector<SubMesh>)，网格缓存命中时跳过解析
+        std::vector<SubMesh> subMeshes = loadSceneMeshes(_projectRoot, fullPath, useFlatShade);
         if (subMeshes.empty()) return nullptr;
 
         // 创建新的场景资源容器
         auto newSceneRes = std::make_shared<SceneResource>();
-        AssetSignature fileSig = AssetSignature::generate(fullPath);
 
-        // 遍历加载到的子网格，转换为 GPU Model
-        for (const auto& sub : subMeshes)
+        // 遍历加载到的子网格，转换为 Model
+        for (auto& sub : subMeshes)
         {
-            // 1. 构建 Model
-            auto model = std::make_shared<Model>(sub.vertices, sub.indices);
-            
-            // 2. 添加到 SceneResource
-            newSceneRes->nodes.push_back({ sub.name, model });
-
-            // 3. [自动缓存注入] 
-            // 将这个子模型单独注册到 _modelCache 中
-            // 这样 getModel("file.obj", ..., "SubName") 也能直接命中
-            std::string modelCacheKey = cacheKey + ":" + sub.name;
-            
-            CacheEntry<Model> subEntry;
-            subEntry.resource = model;
-            subEntry.sourcePath = fullPath;
-            subEntry.signature = fileSig; // 共享同一个文件的签名
-            
-            _modelCache[modelCacheKey] = subEntry;
+            auto model = createModel(std::move(sub.vertices), std::move(sub.indices),
+                                     MeshSourceInfo{ fullPath, sub.name, useFlatShade, true }, std::move(sub.lods),
+                                     std::move(sub.clusters));
+            newSceneRes->nodes.push_back({ sub.name, model, std::move(sub.nodePath) });
         }
 
-        // 如果场景只有一个物体，我们也注册一个“默认单体”缓存 (空 subMeshName)
-        if (subMeshes.size() == 1) {
-            CacheEntry<Model> singleEntry;
-            singleEntry.resource = newSceneRes->nodes[0].model;
-            singleEntry.sourcePath = fullPath;
-            singleEntry.signature = fileSig;
-            _modelCache[cacheKey] = singleEntry; // cacheKey 就是不带 subName 的 key
+        // 压缩顶点的误差按整个场景取最大值汇报
+        PackedVertexData worst;
+        for (const auto& node : newSceneRes->nodes) {
+            const PackedVertexData& packed = node.model->getGeometry()->packed;
+            if (packed.format == VertexFormat::Standard) continue;
+            worst.format = packed.format;
+            worst.maxPositionError = std::max(worst.maxPositionError, packed.maxPositionError);
+            worst.maxNormalError = std::max(worst.maxNormalError, packed.maxNormalError);
+            worst.maxTangentError = std::max(worst.maxTangentError, packed.maxTangentError);
+            worst.maxTexCoordError = std::max(worst.maxTexCoordError, packed.maxTexCoordError);
+        }
+        if (worst.format != VertexFormat::Standard) {
+            std::cout << "[ResourceManager] Packed vertices: " << fullPath << " (" << VertexPacking::describe(worst) << ")" << std::endl;
         }
 
-        // 5. 存入 Scene 缓存
-        CacheEntry<SceneResource> entry;
-        entry.resource = newSceneRes;
-        entry.sourcePath = fullPath;
-        entry.signature = fileSig;
-
-        _sceneCache[cacheKey] = entry;
+        // 4. 存入缓存 (场景 + 每个子模型)
+        injectSceneResource(cleanPath, useFlatShade, newSceneRes);
 
         return newSceneRes;
     }
@@ -263,45 +396,102 @@ std::shared_ptr<SceneResource> ResourceManager::getSceneResource(const std::stri
     }
 }
 
-std::shared_ptr<ImageTexture2D> ResourceManager::getTexture(const std::string& pathKey)
+AssetKey ResourceManager::makeTextureKey(const std::string& cleanPath, bool srgb)
 {
-    std::string cleanPath = pathKey;
-    std::replace(cleanPath.begin(), cleanPath.end(), '\\', '/');
+    AssetKey key = AssetKey::make(cleanPath);
+    return srgb ? key.with("srgb") : key;
+}
+
+TextureCookOptions ResourceManager::makeCookOptions(bool srgb) const
+{
+    TextureCookOptions options;
+    options.srgb = srgb;
+    options.compress = _textureCompressionEnabled;
+    return options;
+}
+
+CookedTexture ResourceManager::cookTexture(const std::string& projectRoot, const std::string& cleanPath,
+                                           const std::string& fullPath, const TextureCookOptions& options)
+{
+    AssetLoadScope scope("Texture (" + cleanPath + ")");
+    CookedTexture cooked;
+
+    // 1. 先查磁盘上的烘焙缓存 (命中时跳过解码、mip 生成和压缩)
+    AssetSignature signature = AssetSignature::generate(fullPath);
+    std::string cachePath = TextureCooker::getCachePath(projectRoot, cleanPath, signature, options);
+    if (TextureCooker::loadFromDisk(cachePath, cooked)) {
+        std::cout << "[ResourceManager] Texture cache hit: " << cleanPath
+                  << " (" << TextureCooker::formatName(cooked.internalFormat) << ")" << std::endl;
+        return cooked;
+    }
+
+    // 2. 解码 (flip 标记是线程局部的，不影响其他线程)
+    stbi_set_flip_vertically_on_load_thread(true);
+    int width = 0, height = 0, channels = 0;
+    unsigned char* pixels = stbi_load(fullPath.c_str(), &width, &height, &channels, 0);
+    if (!pixels || ImageTexture2D::formatForChannels(channels) == 0) {
+        if (pixels) stbi_image_free(pixels);
+        return cooked;
+    }
 
-    std::string cacheKey = cleanPath;
+    // 3. 烘焙并写回缓存
+    cooked = TextureCooker::cook(pixels, width, height, channels, options);
+    stbi_image_free(pixels);
+
+    if (cooked.isValid() && !cachePath.empty()) {
+        TextureCooker::saveToDisk(cachePath, cooked);
+    }
+    return cooked;
+}
+
+std::shared_ptr<ImageTexture2D> ResourceManager::getTexture(const std::string& pathKey, bool srgb)
+{
+    std::string cleanPath = AssetKey::normalizePath(pathKey);
+    AssetKey cacheKey = makeTextureKey(cleanPath, srgb);
 
     // 1. 获取绝对路径 (用于检测文件变化)
     std::string fullPath = getFullPath(cleanPath);
 
     // 2. 检查缓存
-    auto it = _textureCache.find(cacheKey);
-    if (it != _textureCache.end()) {
-        AssetSignature currentSig = AssetSignature::generate(fullPath);
-        // 对比签名
-        if (currentSig != it->second.signature) {
-            std::cout << "[ResourceManager] Hot-Reload Detected: " << cleanPath << std::endl;
-            // 签名不一致，继续向下执行加载逻辑（覆盖旧缓存）
-        } else {
-            return it->second.resource;
-        }
+    if (auto cached = lookupTexture(cacheKey, fullPath, cleanPath)) {
+        return cached;
     }
 
     // 3. 缓存未命中，准备加载
+    // 注意：纹理的异步请求要回到主线程才能兑现，所以这里不能等待 in-flight 的 future，
+    // 只能直接同步加载。异步任务完成时会发现缓存已存在并复用它。
     if (!std::filesystem::exists(fullPath)) {
         std::cerr << "[ResourceManager] Error: Texture not found: " << fullPath << std::endl;
         return nullptr;
     }
 
     try {
-        auto newTex = std::make_shared<ImageTexture2D>(fullPath);
+        auto loadStart = std::chrono::high_resolution_clock::now();
+        CookedTexture cooked = cookTexture(_projectRoot, cleanPath, fullPath, makeCookOptions(srgb));
+        if (!cooked.isValid()) {
+            std::cerr << "[ResourceManager] Failed to decode texture: " << fullPath << std::endl;
+            return nullptr;
+        }
+        auto newTex = std::make_shared<ImageTexture2D>(fullPath, static_cast<GLuint>(0));
+        if (_contentDedupEnabled) {
+            uint64_t contentHash = TextureCooker::contentHash(cooked);
+            resolveTextureStorage(std::move(cooked), contentHash, cleanPath, newTex, true, nullptr);
+        } else {
+            TextureStreamer::uploadImmediately(*newTex, cooked);
+        }
+        auto loadEnd = std::chrono::high_resolution_clock::now();
+        _lastSyncTextureLoadMs = std::chrono::duration<double, std::milli>(loadEnd - loadStart).count();
+        std::cout << "[ResourceManager] Sync texture load: " << cleanPath << " took "
+                  << _lastSyncTextureLoadMs << " ms" << std::endl;
         
         CacheEntry<ImageTexture2D> entry;
         entry.resource = newTex;
         entry.sourcePath = fullPath;
         entry.signature = AssetSignature::generate(fullPath);
+        entry.lastUse = _frameIndex;
 
         // 4. 存入缓存
-        _textureCache[cacheKey] = entry;
+        _textureCache.assign(cacheKey, entry);
         return newTex;
     }
     catch (std::exception& e) {
@@ -310,45 +500,1084 @@ std::shared_ptr<ImageTexture2D> ResourceManager::getTexture(const std::string& p
     }
 }
 
+// ==========================================
+// 异步接口
+// ==========================================
+
+ModelFuture ResourceManager::requestModel(const std::string& pathKey, bool useFlatShade, const std::string& subMeshName)
+{
+    std::string cleanPath = AssetKey::normalizePath(pathKey);
+    AssetKey key = AssetKey::make(cleanPath, useFlatShade, subMeshName);
+    std::string fullPath = getFullPath(cleanPath);
+
+    // 1. 缓存命中：直接返回一个已就绪的 future
+    // (先记下当前条目，未命中时它要么不存在、要么已过期)
+    std::shared_ptr<Model> seen;
+    CacheEntry<Model> current;
+    if (_modelCache.find(key, current)) seen = current.resource;
+    if (auto cached = lookupModel(key, fullPath, cleanPath)) {
+        std::promise<std::shared_ptr<Model>> ready;
+        ready.set_value(cached);
+        return ready.get_future().share();
+    }
+
+    // 2. 已经有人在加载同一资源：共享它的 future
+    std::lock_guard<std::mutex> lock(_inFlightMutex);
+    auto it = _inFlightModels.find(key);
+    if (it != _inFlightModels.end()) {
+        return it->second;
+    }
+
+    // 持锁后再探测一次缓存：第 1 步未命中之后，加载任务可能已经写完缓存并移除了 in-flight 条目
+    // 只做内存查表 (不 stat 文件)：条目换成了第 1 步之外的新对象，说明是刚加载好的
+    CacheEntry<Model> fresh;
+    if (_modelCache.find(key, fresh) && fresh.resource != seen) {
+        std::promise<std::shared_ptr<Model>> ready;
+        ready.set_value(fresh.resource);
+        return ready.get_future().share();
+    }
+
+    // 3. 发起新的加载任务
+    auto promise = std::make_shared<std::promise<std::shared_ptr<Model>>>();
+    ModelFuture future = promise->get_future().share();
+    _inFlightModels[key] = future;
+
+    // 根目录在投递时拷贝一份，工作线程不读 _projectRoot
+    std::string projectRoot = _projectRoot;
+    _workers->enqueue([this, promise, projectRoot, key, fullPath, useFlatShade, subMeshName]() {
+        std::shared_ptr<Model> result = loadModelFromDisk(projectRoot, key, fullPath, useFlatShade, subMeshName);
+        {
+            // 先写缓存 (loadModelFromDisk 内完成) 再在锁内移除 in-flight；
+            // 请求方持锁后会重查缓存，所以中间到来的请求要么命中缓存，要么拿到这个 future
+            std::lock_guard<std::mutex> lock(_inFlightMutex);
+            _inFlightModels.erase(key);
+        }
+        promise->set_value(result);
+    });
+
+    return future;
+}
+
+void ResourceManager::decodeAndStream(const AssetKey& key, const std::string& cleanPath, const std::string& fullPath,
+                                      const TextureCookOptions& options,
+                                      std::shared_ptr<ImageTexture2D> target, std::function<void(bool)> onDone)
+{
+    // 所有结束路径 (解码失败、上传完成或被丢弃) 都汇总到这里，并且只在主线程调用一次：
+    // 失败时移除占位条目 (允许之后重试)，再通知 runWhenResident 的等待者和调用者
+    // 这里只记录裸指针，不延长 target 的生命周期，否则上传的取消条件永远不会满足
+    const ImageTexture2D* raw = target.get();
+    auto done = [this, key, raw, onDone](bool ok) {
+        if (!ok) {
+            CacheEntry<ImageTexture2D> entry;
+            if (_textureCache.find(key, entry) && entry.resource.get() == raw) _textureCache.erase(key);
+        }
+        notifyResidency(raw, ok);
+        if (onDone) onDone(ok);
+    };
+    // 没有人等结果时 (getTextureAsync)，使用者都放手后就不再上传
+    bool cancellable = !onDone;
+
+    std::string projectRoot = _projectRoot;
+    _workers->enqueue([this, projectRoot, cleanPath, fullPath, options, target, done, cancellable]() {
+        CookedTexture cooked = cookTexture(projectRoot, cleanPath, fullPath, options);
+
+        if (!cooked.isValid()) {
+            std::cerr << "[ResourceManager] Failed to decode texture: " << fullPath << std::endl;
+            // 持有 target 直到通知完成，保证 done 里的裸指针比较有效
+            postToMainThread([target, done]() { done(false); });
+            return;
+        }
+
+        if (_contentDedupEnabled) {
+            // 内容哈希在工作线程算好，主线程只做一次查表
+            uint64_t contentHash = TextureCooker::contentHash(cooked);
+            auto payload = std::make_shared<CookedTexture>(std::move(cooked));
+            postToMainThread([this, payload, contentHash, cleanPath, target, done]() {
+                resolveTextureStorage(std::move(*payload), contentHash, cleanPath, target, false, done);
+            });
+            return;
+        }
+
+        // 交给 streamer，在主线程按预算分帧上传 (被取消时 done(false) 会移除缓存里的占位条目)
+        TextureCancelPolicy cancel;
+        if (cancellable) {
+            cancel.watched = target;
+            cancel.ownerRefs = 2; // _textureCache 条目 + 上传任务
+        }
+        streamTexture(target, std::move(cooked), done, std::move(cancel));
+    });
+}
+
+void ResourceManager::resolveTextureStorage(CookedTexture&& cooked, uint64_t contentHash, const std::string& cleanPath,
+                                            std::shared_ptr<ImageTexture2D> target, bool sync, std::function<void(bool)> onDone)
+{
+    std::weak_ptr<ImageTexture2D> existing;
+    std::shared_ptr<ImageTexture2D> storage;
+    if (_textureContent.find(contentHash, existing)) storage = existing.lock();
+
+    // 1. 已有内容相同的存储：直接共享，不再上传
+    // (同步路径等不了仍在上传中的存储，退回到下面重新上传一份)
+    if (storage && (storage->isResident() || !sync)) {
+        std::cout << "[ResourceManager] Dedup: " << cleanPath << " shares texture storage ("
+                  << cooked.totalBytes() / 1024 << " KB saved)" << std::endl;
+
+        // 存储还在上传中时 target 继续显示自己的占位图，驻留后再切换过去
+        std::weak_ptr<ImageTexture2D> weakStorage = storage;
+        runWhenResident(storage, [target, weakStorage, onDone](bool ok) {
+            auto shared = weakStorage.lock();
+            if (ok && shared) target->shareStorage(shared);
+            if (onDone) onDone(ok && shared);
+        });
+        return;
+    }
+
+    // 2. 新内容：上传到一张独立的存储纹理，target 只引用它
+    // 这样 target 热重载换掉引用时，其他共享者看到的内容不受影响
+    storage = std::make_shared<ImageTexture2D>(target->getUri(), static_cast<GLuint>(0));
+    _textureContent.assign(contentHash, storage);
+
+    if (sync) {
+        TextureStreamer::uploadImmediately(*storage, cooked);
+        target->shareStorage(storage);
+        if (onDone) onDone(true);
+        return;
+    }
+
+    // 存储纹理只由上传任务持有 (_textureContent 里是弱引用)，不设取消条件，
+    // 否则别的 target 可能已经在 runWhenResident 里等它
+    std::weak_ptr<ImageTexture2D> weakStorage = storage;
+    streamTexture(storage, std::move(cooked), [target, weakStorage, onDone](bool ok) {
+        auto shared = weakStorage.lock();
+        if (ok && shared) target->shareStorage(shared);
+        if (onDone) onDone(ok && shared);
+    });
+}
+
+void ResourceManager::streamTexture(std::shared_ptr<ImageTexture2D> target, CookedTexture&& cooked,
+                                    std::function<void(bool)> onDone, TextureCancelPolicy cancel)
+{
+    // streamer 在回调之后才释放任务持有的 target，这里的裸指针在回调期间一定有效
+    const ImageTexture2D* raw = target.get();
+    _streamer->enqueue(std::move(target), std::move(cooked), [this, raw, onDone](bool ok) {
+        notifyResidency(raw, ok);
+        if (onDone) onDone(ok);
+    }, std::move(cancel));
+}
+
+void ResourceManager::runWhenResident(std::weak_ptr<const ImageTexture2D> tex, std::function<void(bool)> fn)
+{
+    auto locked = tex.lock();
+    if (!locked) {
+        fn(false);
+        return;
+    }
+    if (locked->isResident()) {
+        fn(true);
+        return;
+    }
+    // 登记到它的上传结束通知上 (驻留或被丢弃时由 notifyResidency 调用)
+    _residencyWaiters[locked.get()].push_back(std::move(fn));
+}
+
+void ResourceManager::notifyResidency(const ImageTexture2D* tex, bool resident)
+{
+    auto it = _residencyWaiters.find(tex);
+    if (it == _residencyWaiters.end()) return;
+
+    std::vector<std::function<void(bool)>> waiters = std::move(it->second);
+    _residencyWaiters.erase(it);
+    for (auto& fn : waiters) fn(resident);
+}
+
+std::shared_ptr<ImageTexture2D> ResourceManager::getTextureAsync(const std::string& pathKey, TexturePlaceholder placeholder, bool srgb)
+{
+    if (!_textureStreamingEnabled) {
+        return getTexture(pathKey, srgb);
+    }
+
+    std::string cleanPath = AssetKey::normalizePath(pathKey);
+    AssetKey key = makeTextureKey(cleanPath, srgb);
+    std::string fullPath = getFullPath(cleanPath);
+
+    // 命中缓存 (可能是已驻留的纹理，也可能是仍在上传中的占位对象)
+    if (auto cached = lookupTexture(key, fullPath, cleanPath)) {
+        return cached;
+    }
+
+    if (!std::filesystem::exists(fullPath)) {
+        std::cerr << "[ResourceManager] Error: Texture not found: " << fullPath << std::endl;
+        return nullptr;
+    }
+
+    // 先创建空壳纹理并立即入缓存，重复请求会直接拿到同一个对象
+    auto shell = std::make_shared<ImageTexture2D>(fullPath, _streamer->getPlaceholder(placeholder));
+
+    CacheEntry<ImageTexture2D> entry;
+    entry.resource = shell;
+    entry.sourcePath = fullPath;
+    entry.signature = AssetSignature::generate(fullPath);
+    entry.lastUse = _frameIndex;
+    _textureCache.assign(key, entry);
+
+    decodeAndStream(key, cleanPath, fullPath, makeCookOptions(srgb), shell, nullptr);
+    return shell;
+}
+
+TextureFuture ResourceManager::requestTexture(const std::string& pathKey, bool srgb)
+{
+    std::string cleanPath = AssetKey::normalizePath(pathKey);
+    AssetKey key = makeTextureKey(cleanPath, srgb);
+    std::string fullPath = getFullPath(cleanPath);
+
+    CacheEntry<ImageTexture2D> cachedEntry;
+    uint64_t frame = _frameIndex;
+    bool hasCached = _textureCache.update(key, [&](CacheEntry<ImageTexture2D>& e) { e.lastUse = frame; cachedEntry = e; });
+    if (hasCached && cachedEntry.resource->isResident()
+        && (isWatched(cachedEntry.sourcePath) || cachedEntry.signature == AssetSignature::generate(fullPath))) {
+        std::promise<std::shared_ptr<ImageTexture2D>> ready;
+        ready.set_value(cachedEntry.resource);
+        return ready.get_future().share();
+    }
+
+    std::lock_guard<std::mutex> lock(_inFlightMutex);
+    auto it = _inFlightTextures.find(key);
+    if (it != _inFlightTextures.end()) {
+        return it->second;
+    }
+
+    auto promise = std::make_shared<std::promise<std::shared_ptr<ImageTexture2D>>>();
+    TextureFuture future = promise->get_future().share();
+    _inFlightTextures[key] = future;
+
+    // 空壳纹理必须在 GL 线程创建，所以先回到主线程
+    postToMainThread([this, promise, key, cleanPath, fullPath, srgb]() {
+        auto finish = [this, promise, key](std::shared_ptr<ImageTexture2D> result) {
+            {
+                std::lock_guard<std::mutex> lock(_inFlightMutex);
+                _inFlightTextures.erase(key);
+            }
+            promise->set_value(result);
+        };
+
+        // 期间可能已经有 getTextureAsync / getTexture 创建了它
+        std::shared_ptr<ImageTexture2D> shell = lookupTexture(key, fullPath, cleanPath);
+        if (shell && shell->isResident()) {
+            finish(shell);
+            return;
+        }
+
+        if (!shell) {
+            if (!std::filesystem::exists(fullPath)) {
+                std::cerr << "[ResourceManager] Error: Texture not found: " << fullPath << std::endl;
+                finish(nullptr);
+                return;
+            }
+            shell = std::make_shared<ImageTexture2D>(fullPath, _streamer->getPlaceholder(TexturePlaceholder::Albedo));
+
+            CacheEntry<ImageTexture2D> entry;
+            entry.resource = shell;
+            entry.sourcePath = fullPath;
+            entry.signature = AssetSignature::generate(fullPath);
+            entry.lastUse = _frameIndex;
+            _textureCache.assign(key, entry);
+
+            std::weak_ptr<ImageTexture2D> weak = shell;
+            decodeAndStream(key, cleanPath, fullPath, makeCookOptions(srgb), shell, [finish, weak](bool ok) {
+                finish(ok ? weak.lock() : nullptr);
+            });
+        }
+        else {
+            // 已经在上传中：挂到它的上传结束通知上 (等待期间持有它，上传不会因为没人使用而被取消)
+            runWhenResident(shell, [finish, shell](bool ok) {
+                finish(ok ? shell : nullptr);
+            });
+        }
+    });
+
+    return future;
+}
+
+// ==========================================
+// ORM 自动打包
+// ==========================================
+
+std::shared_ptr<ImageTexture2D> ResourceManager::getPackedORM(const ImageTexture2D& ao, const ImageTexture2D& roughness,
+                                                              const ImageTexture2D& metallic)
+{
+    const std::string fullPaths[3] = { ao.getUri(), roughness.getUri(), metallic.getUri() };
+
+    // 缓存 key 与磁盘缓存 id 使用相对路径，项目目录移动后依然有效
+    std::string sourceId = "orm";
+    for (const auto& path : fullPaths) {
+        std::string clean = AssetKey::normalizePath(path);
+        if (!_projectRoot.empty() && clean.compare(0, _projectRoot.size(), _projectRoot) == 0) {
+            clean = clean.substr(_projectRoot.size());
+        }
+        sourceId += "|" + clean;
+    }
+    AssetKey key = AssetKey::make(sourceId);
+
+    PackedOrmEntry cached;
+    uint64_t frame = _frameIndex;
+    bool hasCached = _packedOrmCache.update(key, [&](PackedOrmEntry& e) { e.lastUse = frame; cached = e; });
+    if (hasCached && isWatched(fullPaths[0]) && isWatched(fullPaths[1]) && isWatched(fullPaths[2])) {
+        return cached.resource;
+    }
+
+    std::vector<AssetSignature> signatures;
+    for (const auto& path : fullPaths) signatures.push_back(AssetSignature::generate(path));
+
+    if (hasCached) {
+        bool same = true;
+        for (size_t i = 0; i < signatures.size(); ++i) same = same && (signatures[i] == cached.signatures[i]);
+        if (same) return cached.resource;
+        std::cout << "[ResourceManager] Hot-Reload Detected: " << sourceId << std::endl;
+    }
+
+    for (const auto& sig : signatures) {
+        if (!sig.isValid) return nullptr;
+    }
+
+    auto shell = std::make_shared<ImageTexture2D>(sourceId, _streamer->getPlaceholder(TexturePlaceholder::ORM));
+    std::vector<std::string> sourcePaths(std::begin(fullPaths), std::end(fullPaths));
+    _packedOrmCache.assign(key, { shell, signatures, sourceId, sourcePaths, frame });
+
+    packOrmAsync(sourceId, sourcePaths, shell, nullptr);
+    return shell;
+}
+
+void ResourceManager::packOrmAsync(const std::string& sourceId, const std::vector<std::string>& sourcePaths,
+                                   std::shared_ptr<ImageTexture2D> target, std::function<void(bool)> onResident)
+{
+    std::vector<AssetSignature> signatures;
+    for (const auto& path : sourcePaths) signatures.push_back(AssetSignature::generate(path));
+
+    TextureCookOptions options = makeCookOptions(false);
+    std::string cachePath = TextureCooker::getCachePath(_projectRoot, sourceId, signatures, options);
+
+    _workers->enqueue([this, target, sourceId, sourcePaths, cachePath, options, onResident]() {
+        CookedTexture cooked;
+        if (TextureCooker::loadFromDisk(cachePath, cooked)) {
+            std::cout << "[ResourceManager] Packed ORM cache hit: " << sourceId << std::endl;
+        }
+        else {
+            // 解码三张源图，各取第一个通道 (与 shader 中 .r 的读取方式一致)
+            stbi_set_flip_vertically_on_load_thread(true);
+            ChannelSource sources[3];
+            bool ok = true;
+            for (int i = 0; i < 3; ++i) {
+                sources[i].pixels = stbi_load(sourcePaths[i].c_str(), &sources[i].width, &sources[i].height, &sources[i].channels, 0);
+                ok = ok && sources[i].pixels != nullptr;
+            }
+
+            if (ok) {
+                int width = 0, height = 0;
+                std::vector<uint8_t> packed = TextureCooker::packChannels(sources, width, height);
+                cooked = TextureCooker::cook(packed.data(), width, height, 4, options);
+                if (cooked.isValid()) TextureCooker::saveToDisk(cachePath, cooked);
+                std::cout << "[ResourceManager] Packed ORM " << width << "x" << height << ": " << sourceId << std::endl;
+            }
+            for (auto& src : sources) {
+                if (src.pixels) stbi_image_free(const_cast<unsigned char*>(src.pixels));
+            }
+        }
+
+        if (!cooked.isValid()) {
+            // 打包失败：空壳永远不会驻留，渲染器会一直退回独立贴图
+            std::cerr << "[ResourceManager] Failed to pack ORM: " << sourceId << std::endl;
+            postToMainThread([this, target, onResident]() {
+                notifyResidency(target.get(), false);
+                if (onResident) onResident(false);
+            });
+            return;
+        }
+        TextureCancelPolicy cancel;
+        if (!onResident) {
+            std::weak_ptr<ImageTexture2D> weak = target;
+            AssetKey key = AssetKey::make(sourceId);
+            cancel.watched = target;
+            cancel.ownerRefs = 2; // _packedOrmCache 条目 + 上传任务
+            cancel.onCancelled = [this, key, weak]() {
+                PackedOrmEntry entry;
+                if (_packedOrmCache.find(key, entry) && entry.resource == weak.lock()) _packedOrmCache.erase(key);
+            };
+        }
+        streamTexture(target, std::move(cooked), onResident, std::move(cancel));
+    });
+}
+
+// ==========================================
+// 热重载
+// ==========================================
+
+bool ResourceManager::isWatched(const std::string& fullPath) const
+{
+    // 工作线程也会调用 (lookupModel / lookupTexture)，只读根目录快照，不碰 _projectRoot
+    std::shared_ptr<const std::string> root;
+    {
+        std::lock_guard<std::mutex> lock(_watchedRootMutex);
+        root = _watchedRoot;
+    }
+    return root && !root->empty() && fullPath.compare(0, root->size(), *root) == 0;
+}
+
+void ResourceManager::processFileChanges()
+{
+    if (!_watcher->isRunning()) return;
+
+    if (_watcher->takeOverflow()) {
+        rescanLoadedSources();
+        _assetDb->refresh(*_workers);
+    }
+
+    for (const auto& change : _watcher->takeSettledChanges())
+    {
+        // 资源索引增量更新
+        _assetDb->applyChange(change, *_workers);
+
+        // 目录变化只影响索引
+        if (change.path.back() == '/') continue;
+
+        if (change.kind == AssetWatcher::ChangeKind::Removed) {
+            // 文件被删除：已加载的资源继续可用，不做处理
+            continue;
+        }
+        std::string fullPath = _projectRoot + change.path;
+        hotReloadTextures(change.path, fullPath);
+        hotReloadModels(change.path, fullPath);
+    }
+
+    _assetDb->saveIfDirty();
+}
+
+void ResourceManager::rescanLoadedSources()
+{
+    // 收集签名与磁盘不一致的源文件 (同一文件可能被多个条目引用，只重载一次)
+    std::unordered_set<std::string> changed;
+    auto check = [&](const std::string& sourcePath, const AssetSignature& signature) {
+        // 项目目录外的资源命中缓存时本来就会逐次校验签名
+        if (!isWatched(sourcePath) || changed.count(sourcePath) != 0) return;
+        if (AssetSignature::generate(sourcePath) != signature) {
+            changed.insert(sourcePath);
+        }
+    };
+    _textureCache.forEach([&](const AssetKey&, CacheEntry<ImageTexture2D>& e) { check(e.sourcePath, e.signature); });
+    _modelCache.forEach([&](const AssetKey&, CacheEntry<Model>& e) { check(e.sourcePath, e.signature); });
+    _sceneCache.forEach([&](const AssetKey&, CacheEntry<SceneResource>& e) { check(e.sourcePath, e.signature); });
+    _packedOrmCache.forEach([&](const AssetKey&, PackedOrmEntry& e) {
+        for (size_t i = 0; i < e.sourcePaths.size() && i < e.signatures.size(); ++i) check(e.sourcePaths[i], e.signatures[i]);
+    });
+
+    for (const std::string& fullPath : changed) {
+        std::string cleanPath = fullPath.substr(_projectRoot.size());
+        hotReloadTextures(cleanPath, fullPath);
+        hotReloadModels(cleanPath, fullPath);
+    }
+    std::cout << "[ResourceManager] Rescanned loaded assets after missed file events: "
+              << changed.size() << " changed" << std::endl;
+}
+
+void ResourceManager::hotReloadTextures(const std::string& cleanPath, const std::string& fullPath)
+{
+    // 1. 普通纹理：重新烘焙到临时纹理，驻留后与旧纹理交换内容
+    std::vector<std::pair<AssetKey, CacheEntry<ImageTexture2D>>> hits;
+    _textureCache.forEach([&](const AssetKey& key, CacheEntry<ImageTexture2D>& entry) {
+        if (entry.sourcePath == fullPath) hits.push_back({ key, entry });
+    });
+
+    for (auto& [key, entry] : hits)
+    {
+        std::shared_ptr<ImageTexture2D> old = entry.resource;
+        // 首次加载尚未完成：正在进行的解码会读到新文件，无需重复
+        if (!old->isResident()) continue;
+
+        std::cout << "[ResourceManager] Hot-Reload: " << cleanPath << std::endl;
+        bool srgb = (key == makeTextureKey(cleanPath, true));
+        auto fresh = std::make_shared<ImageTexture2D>(fullPath, static_cast<GLuint>(0));
+        AssetSignature signature = AssetSignature::generate(fullPath);
+        AssetKey cacheKey = key;
+
+        decodeAndStream(key, cleanPath, fullPath, makeCookOptions(srgb), fresh,
+            [this, cacheKey, old, fresh, signature](bool ok) {
+                if (!ok) return;
+                old->swapContents(*fresh);
+                _textureCache.update(cacheKey, [&](CacheEntry<ImageTexture2D>& e) {
+                    if (e.resource == old) e.signature = signature;
+                });
+            });
+    }
+
+    // 2. 以它为输入的打包 ORM：重新打包
+    std::vector<std::pair<AssetKey, PackedOrmEntry>> packed;
+    _packedOrmCache.forEach([&](const AssetKey& key, PackedOrmEntry& entry) {
+        if (std::find(entry.sourcePaths.begin(), entry.sourcePaths.end(), fullPath) != entry.sourcePaths.end()) {
+            packed.push_back({ key, entry });
+        }
+    });
+
+    for (auto& [key, entry] : packed)
+    {
+        std::shared_ptr<ImageTexture2D> old = entry.resource;
+        if (!old->isResident()) continue;
+
+        auto fresh = std::make_shared<ImageTexture2D>(entry.sourceId, static_cast<GLuint>(0));
+        AssetKey cacheKey = key;
+        std::vector<std::string> sourcePaths = entry.sourcePaths;
+        packOrmAsync(entry.sourceId, sourcePaths, fresh, [this, cacheKey, old, fresh, sourcePaths](bool ok) {
+            if (!ok) return;
+            old->swapContents(*fresh);
+            _packedOrmCache.update(cacheKey, [&](PackedOrmEntry& e) {
+                e.signatures.clear();
+                for (const auto& path : sourcePaths) e.signatures.push_back(AssetSignature::generate(path));
+            });
+        });
+    }
+}
+
+void ResourceManager::hotReloadModels(const std::string& cleanPath, const std::string& fullPath)
+{
+    // 1. 场景资源：整个文件重新解析一次，按子网格名原地替换
+    std::vector<std::pair<AssetKey, CacheEntry<SceneResource>>> scenes;
+    _sceneCache.forEach([&](const AssetKey& key, CacheEntry<SceneResource>& entry) {
+        if (entry.sourcePath == fullPath) scenes.push_back({ key, entry });
+    });
+
+    // 场景里的子模型也注册在 _modelCache 中，它们随场景一起替换，不单独重载
+    std::unordered_set<const Model*> handled;
+    for (const auto& [key, entry] : scenes) {
+        for (const auto& node : entry.resource->nodes) handled.insert(node.model.get());
+    }
+
+    for (auto& [key, entry] : scenes)
+    {
+        std::cout << "[ResourceManager] Hot-Reload (Scene): " << cleanPath << std::endl;
+        std::shared_ptr<SceneResource> sceneRes = entry.resource;
+        bool useFlatShade = entry.useFlatShade;
+
+        _workers->enqueue([this, sceneRes, projectRoot = _projectRoot, fullPath, useFlatShade]() {
+            AssetSignature signature = AssetSignature::generate(fullPath);
+            std::vector<SubMesh> subMeshes;
+            try {
+                subMeshes = loadSceneMeshes(projectRoot, fullPath, useFlatShade);
+            }
+            catch (std::exception& e) {
+                std::cerr << "[ResourceManager] Hot-Reload failed: " << e.what() << std::endl;
+                return;
+            }
+            if (subMeshes.empty()) return;
+
+            auto fresh = std::make_shared<std::unordered_map<std::string, std::shared_ptr<Model>>>();
+            for (auto& sub : subMeshes) {
+                (*fresh)[sub.name] = createModel(std::move(sub.vertices), std::move(sub.indices),
+                                                 MeshSourceInfo{ fullPath, sub.name, useFlatShade, true },
+                                                 std::move(sub.lods), std::move(sub.clusters));
+            }
+
+            // GL 对象的交换与释放都必须在主线程
+            postToMainThread([this, sceneRes, fullPath, signature, fresh = std::move(fresh)]() {
+                for (const auto& node : sceneRes->nodes) {
+                    auto it = fresh->find(node.name);
+                    if (it != fresh->end()) node.model->swapGeometry(*it->second);
+                }
+                _sceneCache.forEach([&](const AssetKey&, CacheEntry<SceneResource>& e) {
+                    if (e.resource == sceneRes) e.signature = signature;
+                });
+                _modelCache.forEach([&](const AssetKey&, CacheEntry<Model>& e) {
+                    if (e.sourcePath == fullPath) e.signature = signature;
+                });
+            });
+        });
+    }
+
+    // 2. 单独加载的模型
+    std::vector<std::pair<AssetKey, CacheEntry<Model>>> models;
+    _modelCache.forEach([&](const AssetKey& key, CacheEntry<Model>& entry) {
+        if (entry.sourcePath == fullPath && handled.count(entry.resource.get()) == 0) models.push_back({ key, entry });
+    });
+
+    for (auto& [key, entry] : models)
+    {
+        std::cout << "[ResourceManager] Hot-Reload: " << cleanPath << std::endl;
+        std::shared_ptr<Model> old = entry.resource;
+        bool useFlatShade = entry.useFlatShade;
+        std::string subMeshName = entry.subMeshName;
+        AssetKey cacheKey = key;
+
+        _workers->enqueue([this, old, cacheKey, projectRoot = _projectRoot, fullPath, useFlatShade, subMeshName]() {
+            AssetSignature signature = AssetSignature::generate(fullPath);
+            std::shared_ptr<Model> fresh;
+            try {
+                MeshData data = loadMeshData(projectRoot, fullPath, useFlatShade, subMeshName);
+                if (data.vertices.empty()) return;
+                fresh = createModel(std::move(data.vertices), std::move(data.indices),
+                                    MeshSourceInfo{ fullPath, subMeshName, useFlatShade, false }, std::move(data.lods),
+                                    std::move(data.clusters));
+            }
+            catch (std::exception& e) {
+                std::cerr << "[ResourceManager] Hot-Reload failed: " << e.what() << std::endl;
+                return;
+            }
+
+            postToMainThread([this, old, cacheKey, signature, fresh]() {
+                old->swapGeometry(*fresh);
+                _modelCache.update(cacheKey, [&](CacheEntry<Model>& e) {
+                    if (e.resource == old) e.signature = signature;
+                });
+            });
+        });
+    }
+}
+
+// ==========================================
+// 内容去重
+// ==========================================
+
+std::shared_ptr<Model> ResourceManager::createModel(std::vector<Vertex> vertices, std::vector<uint32_t> indices,
+                                                    const MeshSourceInfo& source, MeshLodChain lods,
+                                                    MeshClusterSet clusters)
+{
+    // 内容哈希也用于校验从网格缓存读回的数据，所以去重关闭时同样计算
+    uint64_t contentHash = MeshGeometry::hashContent(vertices, indices);
+
+    // 新建的几何数据记录来源、驻留策略 (上传之后生效) 与顶点格式
+    auto makeModel = [&]() {
+        auto model = std::make_shared<Model>(std::move(vertices), std::move(indices));
+        model->setLods(std::move(lods));
+        model->setClusters(std::move(clusters));
+        const auto& geometry = model->getGeometry();
+        geometry->contentHash = contentHash;
+        geometry->source = source;
+        if (source.isReloadable()) geometry->residency = _defaultMeshResidency;
+
+        VertexFormat format = _vertexFormat;
+        if (format != VertexFormat::Standard) geometry->packVertices(format);
+        return model;
+    };
+
+    if (!_contentDedupEnabled) return makeModel();
+
+    // 64 位哈希碰撞的概率可以忽略，这里再比较一次数量兜底
+    // (比较保存下来的数量，CPU 数据可能已经按驻留策略释放)
+    auto matches = [&](const std::shared_ptr<MeshGeometry>& geometry) {
+        return geometry && geometry->vertexCount == vertices.size() && geometry->indexCount == indices.size();
+    };
+
+    // 1. 快速路径：已有相同内容
+    std::weak_ptr<MeshGeometry> existing;
+    if (_meshContent.find(contentHash, existing)) {
+        auto geometry = existing.lock();
+        if (matches(geometry)) return std::make_shared<Model>(geometry);
+    }
+
+    // 2. 在锁外构建 (包围盒计算是 O(n) 的)，再原子地登记；
+    // 期间别的线程抢先登记了相同内容时改用它的 (新建的 Model 还没有 GL 对象，直接丢弃是安全的)
+    auto model = makeModel();
+
+    std::shared_ptr<MeshGeometry> winner;
+    _meshContent.upsert(contentHash, [&](std::weak_ptr<MeshGeometry>& slot) {
+        auto current = slot.lock();
+        if (current && current->vertexCount == model->getVertexCount()
+            && current->indexCount == model->getGeometry()->indexCount) {
+            winner = current;
+        } else {
+            slot = model->getGeometry();
+        }
+    });
+    return winner ? std::make_shared<Model>(winner) : model;
+}
+
+// ==========================================
+// CPU 端网格数据驻留
+// ==========================================
+
+bool ResourceManager::setMeshResidency(Model& model, MeshResidency residency)
+{
+    const auto& geometry = model.getGeometry();
+    if (residency != MeshResidency::Full && !geometry->source.isReloadable()) {
+        std::cerr << "[ResourceManager] Mesh has no source file, keeping full CPU data" << std::endl;
+        return false;
+    }
+
+    // 目标策略需要的数据当前不在内存里时，先从网格缓存读回完整数据
+    const PickingProxy& proxy = geometry->proxy;
+    bool needFull = false;
+    switch (residency) {
+    case MeshResidency::Full:           needFull = true; break;
+    case MeshResidency::PickingProxy:   needFull = proxy.positions.empty(); break;
+    case MeshResidency::QuantizedProxy: needFull = proxy.quantized.empty() && proxy.positions.empty(); break;
+    default: break;
+    }
+
+    if (needFull && !geometry->hasFullCpuData()) {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        if (!loadCpuMeshData(*geometry, vertices, indices)) return false;
+        geometry->restoreCpuData(std::move(vertices), std::move(indices));
+    }
+
+    geometry->residency = residency;
+    geometry->applyResidency();
+    return true;
+}
+
+bool ResourceManager::loadCpuMeshData(const MeshGeometry& geometry, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+    const MeshSourceInfo& source = geometry.source;
+    if (!source.isReloadable()) return false;
+
+    vertices.clear();
+    indices.clear();
+    try {
+        if (source.fromScene) {
+            std::vector<SubMesh> subMeshes = loadSceneMeshes(_projectRoot, source.fullPath, source.useFlatShade);
+            for (auto& sub : subMeshes) {
+                if (sub.name != source.subMeshName) continue;
+                vertices = std::move(sub.vertices);
+                indices = std::move(sub.indices);
+                break;
+            }
+        } else {
+            MeshData data = loadMeshData(_projectRoot, source.fullPath, source.useFlatShade, source.subMeshName);
+            vertices = std::move(data.vertices);
+            indices = std::move(data.indices);
+        }
+    }
+    catch (std::exception& e) {
+        std::cerr << "[ResourceManager] Failed to reload mesh data: " << e.what() << std::endl;
+        return false;
+    }
+
+    // 源文件在加载之后被修改过 (热重载尚未替换) 时，读回的内容与显存里的不同
+    if (vertices.size() != geometry.vertexCount || indices.size() != geometry.indexCount
+        || MeshGeometry::hashContent(vertices, indices) != geometry.contentHash) {
+        std::cerr << "[ResourceManager] Reloaded mesh data does not match: " << source.fullPath
+                  << " (" << source.subMeshName << ")" << std::endl;
+        vertices.clear();
+        indices.clear();
+        return false;
+    }
+    return true;
+}
+
+const ResourceManager::DedupStats& ResourceManager::getDedupStats()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - _dedupStatsTime < std::chrono::milliseconds(500)) return _dedupStats;
+    _dedupStatsTime = now;
+
+    // 失效的内容条目顺便清掉
+    _meshContent.eraseIf([](const uint64_t&, std::weak_ptr<MeshGeometry>& w) { return w.expired(); });
+    _textureContent.eraseIf([](const uint64_t&, std::weak_ptr<ImageTexture2D>& w) { return w.expired(); });
+
+    struct Usage { size_t users = 0; size_t bytes = 0; };
+    DedupStats stats;
+
+    // 纹理：每个缓存条目是一个资源，按它实际使用的存储分组
+    std::unordered_map<const void*, Usage> textures;
+    _textureCache.forEach([&](const AssetKey&, CacheEntry<ImageTexture2D>& e) {
+        const auto& storage = e.resource->getSharedStorage();
+        const ImageTexture2D* owner = storage ? storage.get() : e.resource.get();
+        Usage& u = textures[owner];
+        if (u.users++ == 0) u.bytes = owner->getGpuByteSize();
+        stats.textureCount++;
+    });
+
+    // 模型：同一个 Model 可能以多个 key 注册 (场景子网格 + 单体 key)，先按对象去重
+    std::unordered_set<const Model*> models;
+    std::unordered_map<const void*, Usage> meshes;
+    _modelCache.forEach([&](const AssetKey&, CacheEntry<Model>& e) {
+        if (!models.insert(e.resource.get()).second) return;
+        const MeshGeometry* geometry = e.resource->getGeometry().get();
+        Usage& u = meshes[geometry];
+        if (u.users++ == 0) u.bytes = geometry->getGpuByteSize();
+    });
+    stats.meshCount = models.size();
+
+    for (const auto& [owner, u] : textures) stats.textureBytesSaved += (u.users - 1) * u.bytes;
+    for (const auto& [owner, u] : meshes) stats.meshBytesSaved += (u.users - 1) * u.bytes;
+    stats.textureStorageCount = textures.size();
+    stats.meshStorageCount = meshes.size();
+
+    _dedupStats = stats;
+    return _dedupStats;
+}
+
+void ResourceManager::postToMainThread(std::function<void()> task)
+{
+    std::lock_guard<std::mutex> lock(_mainThreadMutex);
+    _mainThreadTasks.push_back(std::move(task));
+}
+
+bool ResourceManager::runMainThreadTasks()
+{
+    // 先把队列整体交换出来，执行任务时不持锁 (任务内部可能再次投递)
+    std::vector<std::function<void()>> tasks;
+    {
+        std::lock_guard<std::mutex> lock(_mainThreadMutex);
+        tasks.swap(_mainThreadTasks);
+    }
+    for (auto& task : tasks) task();
+    return !tasks.empty();
+}
+
+void ResourceManager::update()
+{
+    // 工作线程烘焙时需要知道驱动是否支持 S3TC，这里在 GL 线程查询一次
+    if (!_glCapsQueried) {
+        TextureCooker::queryGLCaps();
+        _glCapsQueried = true;
+    }
+
+    runMainThreadTasks();
+
+    // 处理监视器上报的文件变化 (已合并、去抖)
+    processFileChanges();
+
+    // 在预算内推进纹理上传
+    _streamer->pump();
+
+    // 定期统计内存并按 LRU 淘汰
+    if (++_frameIndex % 30 == 0) enforceMemoryBudget();
+}
+
+// ==========================================
+// 内存预算
+// ==========================================
+
+void ResourceManager::setMemoryBudget(size_t cpuBytes, size_t gpuBytes)
+{
+    _cpuBudget = cpuBytes;
+    _gpuBudget = gpuBytes;
+    enforceMemoryBudget();
+}
+
+void ResourceManager::enforceMemoryBudget()
+{
+    // 淘汰单位：一组 key (同一个 Model 可能注册在多个 key 下，场景连同它的子模型一起淘汰)
+    enum class Kind { Scene, Model, Texture, PackedOrm };
+    struct Candidate {
+        Kind kind = Kind::Model;
+        std::vector<AssetKey> keys;
+        uint64_t lastUse = 0;
+        size_t cpuBytes = 0;    // 淘汰后实际能释放的字节数 (与其他资源共享的存储不算)
+        size_t gpuBytes = 0;
+    };
+
+    MemoryStats stats;
+    stats.cpuBudget = _cpuBudget;
+    stats.gpuBudget = _gpuBudget;
+    stats.evictedCount = _memoryStats.evictedCount;
+    stats.evictedBytes = _memoryStats.evictedBytes;
+
+    // 共享的存储 (内容去重) 只计一次
+    std::unordered_set<const void*> counted;
+
+    // 1. 模型：统计每个 Model 被缓存自己引用了几次 (多个 key + 场景节点)，
+    // use_count 与之相等说明缓存之外已经没有人在用它
+    std::unordered_map<const Model*, long> internalRefs;
+    std::unordered_set<const Model*> inScene;
+    _sceneCache.forEach([&](const AssetKey&, CacheEntry<SceneResource>& e) {
+        for (const auto& node : e.resource->nodes) {
+            internalRefs[node.model.get()]++;
+            inScene.insert(node.model.get());
+        }
+        stats.entryCount++;
+    });
+
+    struct ModelGroup {
+        Candidate candidate;
+        long useCount = 0;
+    };
+    std::unordered_map<const Model*, ModelGroup> modelGroups;
+    _modelCache.forEach([&](const AssetKey& key, CacheEntry<Model>& e) {
+        const Model* model = e.resource.get();
+        const auto& geometry = e.resource->getGeometry();
+        e.cpuBytes = geometry->getCpuByteSize();
+        e.gpuBytes = geometry->isUploaded ? geometry->getGpuByteSize() : 0;
+        if (counted.insert(geometry.get()).second) {
+            stats.cpuBytes += e.cpuBytes;
+            stats.gpuBytes += e.gpuBytes;
+        }
+        stats.entryCount++;
+        internalRefs[model]++;
+
+        ModelGroup& group = modelGroups[model];
+        group.candidate.keys.push_back(key);
+        group.candidate.lastUse = std::max(group.candidate.lastUse, e.lastUse);
+        group.useCount = e.resource.use_count();
+        // 几何数据只被这一个 Model 持有时，淘汰才真正释放内存
+        if (geometry.use_count() == 1) {
+            group.candidate.cpuBytes = e.cpuBytes;
+            group.candidate.gpuBytes = e.gpuBytes;
+        }
+    });
+
+    auto unreferenced = [&](const Model* model) {
+        auto it = modelGroups.find(model);
+        long uses = (it != modelGroups.end()) ? it->second.useCount : 0;
+        return uses <= internalRefs[model];
+    };
+
+    std::vector<Candidate> candidates;
+
+    // 场景：自身和所有子模型都没有外部引用时，连同子模型的 key 一起淘汰
+    _sceneCache.forEach([&](const AssetKey& key, CacheEntry<SceneResource>& e) {
+        if (e.resource.use_count() != 1) return;
+        Candidate c{ Kind::Scene, { key }, e.lastUse };
+        for (const auto& node : e.resource->nodes) {
+            if (!unreferenced(node.model.get())) return;
+            auto it = modelGroups.find(node.model.get());
+            if (it == modelGroups.end()) continue;
+            const Candidate& m = it->second.candidate;
+            c.keys.insert(c.keys.end(), m.keys.begin(), m.keys.end());
+            c.lastUse = std::max(c.lastUse, m.lastUse);
+            c.cpuBytes += m.cpuBytes;
+            c.gpuBytes += m.gpuBytes;
+        }
+        candidates.push_back(std::move(c));
+    });
+
+    // 单独加载的模型 (属于某个场景的随场景淘汰)
+    for (auto& [model, group] : modelGroups) {
+        if (inScene.count(model) == 0 && unreferenced(model)) candidates.push_back(std::move(group.candidate));
+    }
+
+    // 2. 纹理：按实际使用的存储统计
+    _textureCache.forEach([&](const AssetKey& key, CacheEntry<ImageTexture2D>& e) {
+        const auto& storage = e.resource->getSharedStorage();
+        const ImageTexture2D* owner = storage ? storage.get() : e.resource.get();
+        e.cpuBytes = 0;     // 像素数据上传后就释放了，只占显存
+        e.gpuBytes = owner->getGpuByteSize();
+        if (counted.insert(owner).second) stats.gpuBytes += e.gpuBytes;
+        stats.entryCount++;
+
+        // 只被缓存持有、并且已经上传完成
+        if (e.resource.use_count() != 1 || !e.resource->isResident()) return;
+        Candidate c{ Kind::Texture, { key }, e.lastUse };
+        if (!storage || storage.use_count() == 1) c.gpuBytes = e.gpuBytes;
+        candidates.push_back(std::move(c));
+    });
+
+    _packedOrmCache.forEach([&](const AssetKey& key, PackedOrmEntry& e) {
+        e.gpuBytes = e.resource->getGpuByteSize();
+        stats.gpuBytes += e.gpuBytes;
+        stats.entryCount++;
+        if (e.resource.use_count() != 1 || !e.resource->isResident()) return;
+        candidates.push_back({ Kind::PackedOrm, { key }, e.lastUse, 0, e.gpuBytes });
+    });
+
+    // 3. 超出预算：从最久没用过的开始淘汰，直到回到预算以内
+    if (stats.cpuBytes > _cpuBudget || stats.gpuBytes > _gpuBudget)
+    {
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Candidate& a, const Candidate& b) { return a.lastUse < b.lastUse; });
+
+        // 先把资源拷出来再删条目，GL 对象在锁外 (仍在主线程) 统一释放
+        std::vector<std::shared_ptr<void>> graveyard;
+        size_t evicted = 0, freed = 0;
+
+        for (const Candidate& c : candidates)
+        {
+            bool cpuOver = stats.cpuBytes > _cpuBudget;
+            bool gpuOver = stats.gpuBytes > _gpuBudget;
+            if (!cpuOver && !gpuOver) break;
+            // 释放不了超标那一项的条目留着 (淘汰它没有意义，下次还要重新加载)
+            if (!(cpuOver && c.cpuBytes > 0) && !(gpuOver && c.gpuBytes > 0)) continue;
+
+            for (size_t i = 0; i < c.keys.size(); ++i) {
+                const AssetKey& key = c.keys[i];
+                switch (c.kind) {
+                case Kind::Scene:
+                    // keys[0] 是场景本身，其余是它的子模型 (可能与场景 key 相同，但在模型缓存里)
+                    if (i == 0) {
+                        CacheEntry<SceneResource> e;
+                        if (_sceneCache.find(key, e)) graveyard.push_back(e.resource);
+                        _sceneCache.erase(key);
+                        break;
+                    }
+                    [[fallthrough]];
+                case Kind::Model: {
+                    CacheEntry<Model> e;
+                    if (_modelCache.find(key, e)) graveyard.push_back(e.resource);
+                    _modelCache.erase(key);
+                    break;
+                }
+                case Kind::Texture: {
+                    CacheEntry<ImageTexture2D> e;
+                    if (_textureCache.find(key, e)) graveyard.push_back(e.resource);
+                    _textureCache.erase(key);
+                    break;
+                }
+                case Kind::PackedOrm: {
+                    PackedOrmEntry e;
+                    if (_packedOrmCache.find(key, e)) graveyard.push_back(e.resource);
+                    _packedOrmCache.erase(key);
+                    break;
+                }
+                }
+            }
+
+            stats.cpuBytes -= std::min(stats.cpuBytes, c.cpuBytes);
+            stats.gpuBytes -= std::min(stats.gpuBytes, c.gpuBytes);
+            stats.entryCount -= std::min(stats.entryCount, c.keys.size());
+            freed += c.cpuBytes + c.gpuBytes;
+            evicted += c.keys.size();
+        }
+        graveyard.clear();
+
+        if (evicted > 0) {
+            stats.evictedCount += evicted;
+            stats.evictedBytes += freed;
+            std::cout << "[ResourceManager] Evicted " << evicted << " cache entries (" << freed / (1024 * 1024)
+                      << " MB). CPU " << stats.cpuBytes / (1024 * 1024) << "/" << _cpuBudget / (1024 * 1024)
+                      << " MB, GPU " << stats.gpuBytes / (1024 * 1024) << "/" << _gpuBudget / (1024 * 1024) << " MB" << std::endl;
+        }
+    }
+
+    _memoryStats = stats;
+}
+
+size_t ResourceManager::getPendingRequestCount() const
+{
+    std::lock_guard<std::mutex> lock(_inFlightMutex);
+    return _inFlightModels.size() + _inFlightTextures.size();
+}
+
 void ResourceManager::injectCache(const std::string& pathKey, const std::string& subMeshName, bool useFlatShade, std::shared_ptr<Model> model)
 {
     if (!model) return;
 
     // 1. 标准化路径
-    std::string cleanPath = pathKey;
-    std::replace(cleanPath.begin(), cleanPath.end(), '\\', '/');
+    std::string cleanPath = AssetKey::normalizePath(pathKey);
 
     // 2. 生成 Cache Key
-    std::string cacheKey = cleanPath;
-    if (useFlatShade) cacheKey += ":useFlatShade";
-    if (!subMeshName.empty()) cacheKey += ":" + subMeshName;
+    AssetKey cacheKey = AssetKey::make(cleanPath, useFlatShade, subMeshName);
 
     // 构造 Entry
     CacheEntry<Model> entry;
     entry.resource = model;
     entry.sourcePath = getFullPath(cleanPath); // 尝试补全绝对路径
     entry.signature = AssetSignature::generate(entry.sourcePath); // 生成签名
+    entry.lastUse = _frameIndex;
 
     // 3. 存入缓存
-    _modelCache[cacheKey] = entry;
+    _modelCache.assign(cacheKey, entry);
     
-    std::cout << "[ResourceManager] Injected cache: " << cacheKey << std::endl;
+    std::cout << "[ResourceManager] Injected cache: " << cleanPath
+              << (useFlatShade ? " (flat)" : "")
+              << (subMeshName.empty() ? "" : " : " + subMeshName) << std::endl;
 }
 
 std::shared_ptr<Model> ResourceManager::findModel(const std::string& pathKey, bool useFlatShade, const std::string& subMeshName)
 {
-    std::string cleanPath = pathKey;
-    std::replace(cleanPath.begin(), cleanPath.end(), '\\', '/');
-
-    std::string cacheKey = cleanPath;
-    if (useFlatShade) cacheKey += ":useFlatShade";
-    if (!subMeshName.empty()) cacheKey += ":" + subMeshName;
+    std::string cleanPath = AssetKey::normalizePath(pathKey);
+    AssetKey cacheKey = AssetKey::make(cleanPath, useFlatShade, subMeshName);
 
-    auto it = _modelCache.find(cacheKey);
-    if (it != _modelCache.end()) {
-        // findModel 只是为了查询是否存在内存副本，通常不需要做 Dirty Check (性能优先)
-        // 或者是为了 Scene 逻辑复用，如果我们要严格一点，这里也可以加 check
-        return it->second.resource;
+    // findModel 只是为了查询是否存在内存副本，通常不需要做 Dirty Check (性能优先)
+    CacheEntry<Model> entry;
+    uint64_t frame = _frameIndex;
+    if (_modelCache.update(cacheKey, [&](CacheEntry<Model>& e) { e.lastUse = frame; entry = e; })) {
+        return entry.resource;
     }
     return nullptr;
 }
@@ -358,6 +1587,7 @@ HDRData ResourceManager::loadHDRRaw(const std::string& pathKey)
     std::string cleanPath = pathKey;
     std::replace(cleanPath.begin(), cleanPath.end(), '\\', '/');
     std::string fullPath = getFullPath(cleanPath);
+    AssetLoadScope scope("HDR (" + cleanPath + ")");
 
     HDRData result;
     
@@ -384,7 +1614,34 @@ void ResourceManager::freeHDRRaw(HDRData& data)
 }
 
 void ResourceManager::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(_watchedRootMutex);
+        _watchedRoot.reset();
+    }
+    _watcher->stop();
+    _assetDb->close();
+
+    // 排空旧项目的任务：工作线程任务会投递主线程任务，主线程任务又可能投递新的工作线程任务，
+    // 交替执行直到两边都没有剩余，之后不会再有旧任务写入缓存，所有 future 也都已兑现
+    do {
+        _workers->waitIdle();
+    } while (runMainThreadTasks());
+    // 未完成的上传以失败通知各自的回调；没有上传可等的等待者也在这里一并失败，不会永远挂起
+    _streamer->cancelAll();
+    auto waiters = std::move(_residencyWaiters);
+    _residencyWaiters.clear();
+    for (auto& [tex, fns] : waiters) {
+        for (auto& fn : fns) fn(false);
+    }
+
     _modelCache.clear();
     _sceneCache.clear();
     _textureCache.clear();
+    _packedOrmCache.clear();
+    _meshContent.clear();
+    _textureContent.clear();
+
+    std::lock_guard<std::mutex> lock(_inFlightMutex);
+    _inFlightModels.clear();
+    _inFlightTextures.clear();
 }
\ No newline at end of file
@@ -5,9 +5,21 @@
 #include <memory>
 #include <vector>
 #include <filesystem>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <functional>
+#include <atomic>
 #include "engine/model.h"
 #include "base/texture2d.h"
 #include "engine/utils/asset_signature.h"
+#include "engine/utils/asset_key.h"
+#include "engine/utils/sharded_map.h"
+#include "engine/utils/thread_pool.h"
+#include "engine/utils/asset_watcher.h"
+#include "engine/texture_streamer.h"
+#include "engine/texture_cooker.h"
+#include "engine/asset_database.h"
 #include "engine/asset_data.h"
 
 // 场景资源容器
@@ -16,10 +28,19 @@ struct SceneResource {
     struct Node {
         std::string name;             // 子物体名称 (如 "Chair_Leg")
         std::shared_ptr<Model> model; // 对应的 GPU 模型资源
+        std::vector<SceneNodeData> nodePath; // 所属的节点链 (实例化时重建父子层级)
     };
     std::vector<Node> nodes;
 };
 
+// 异步请求的句柄
+// 同一资源的并发请求共享同一个 future (同一份加载任务)
+using ModelFuture = std::shared_future<std::shared_ptr<Model>>;
+using TextureFuture = std::shared_future<std::shared_ptr<ImageTexture2D>>;
+
+// 线程安全说明：
+// 所有缓存都是分片加锁的，可以在任意线程查询。
+// 但凡涉及 GL 对象创建的步骤 (纹理上传) 只会在主线程的 update() 中执行。
 class ResourceManager
 {
 public:
@@ -32,7 +53,7 @@ public:
     // 获取项目根目录
     std::string getProjectRoot() const { return _projectRoot; }
 
-    // 刷新当前项目目录 (重新扫描文件)
+    // 刷新当前项目目录 (只重新扫描有增删的目录)
     void refreshProjectDirectory();
 
     // 获取完整路径 (用于加载)
@@ -46,15 +67,159 @@ public:
     // 这将加载文件中的所有物体，并自动缓存它们
     std::shared_ptr<SceneResource> getSceneResource(const std::string& pathKey, bool useFlatShade);
 
+    // 仅检查场景缓存 (带签名校验)，不触发加载
+    std::shared_ptr<SceneResource> findSceneResource(const std::string& pathKey, bool useFlatShade);
+
+    // 把外部 (例如异步导入管线) 构建好的场景资源注册进缓存
+    // 同时注入每个子模型，与 getSceneResource 的缓存行为一致
+    void injectSceneResource(const std::string& pathKey, bool useFlatShade, std::shared_ptr<SceneResource> sceneRes);
+
+    // 按扩展名分派到 OBJ / glTF 解析器，只产出 CPU 数据 (线程安全)
+    static std::vector<SubMesh> parseSceneFile(const std::string& fullPath, bool useFlatShade);
+
+    // 同上，但优先读取 projectRoot 下的网格缓存 (.cache/meshes)，未命中时解析并写回 (线程安全)
+    // 工作线程不读 _projectRoot，由投递任务的一方传入当时的根目录
+    std::vector<SubMesh> loadSceneMeshes(const std::string& projectRoot, const std::string& fullPath, bool useFlatShade);
+
     // 加载或获取已缓存的纹理
-    std::shared_ptr<ImageTexture2D> getTexture(const std::string& pathKey);
+    // srgb: 颜色贴图 (Albedo / Emissive) 传 true，以 sRGB 格式上传，由硬件在采样时线性化
+    std::shared_ptr<ImageTexture2D> getTexture(const std::string& pathKey, bool srgb = false);
+
+    // ==========================================
+    // 异步请求接口
+    // ==========================================
+
+    // 在工作线程加载模型 (Model 构造不涉及 GL，可以安全地在后台完成)
+    // 已在加载中的同一资源会直接返回正在进行的 future，不会重复加载
+    ModelFuture requestModel(const std::string& pathKey, bool useFlatShade, const std::string& subMeshName = "");
+
+    // 在工作线程解码纹理，随后在主线程通过 TextureStreamer 分帧上传，驻留后兑现 future
+    // 注意：不要在主线程上对未就绪的 TextureFuture 调用 get()，否则会死锁
+    TextureFuture requestTexture(const std::string& pathKey, bool srgb = false);
+
+    // [主线程] 立即返回一个可直接挂到 MeshComponent 上的纹理对象
+    // 数据驻留之前它会绑定 placeholder 指定的占位图
+    // 如果关闭了流式加载，则退化为同步的 getTexture (旧路径，用于对比卡顿)
+    std::shared_ptr<ImageTexture2D> getTextureAsync(const std::string& pathKey, TexturePlaceholder placeholder = TexturePlaceholder::Albedo,
+                                                    bool srgb = false);
+
+    // 流式纹理加载开关 (关闭后走旧的同步路径)
+    void setTextureStreamingEnabled(bool enabled) { _textureStreamingEnabled = enabled; }
+    bool isTextureStreamingEnabled() const { return _textureStreamingEnabled; }
+
+    TextureStreamer& getTextureStreamer() { return *_streamer; }
+
+    // CPU 块压缩开关 (BC1/BC3/BC4)，只影响之后新加载的纹理
+    void setTextureCompressionEnabled(bool enabled) { _textureCompressionEnabled = enabled; }
+    bool isTextureCompressionEnabled() const { return _textureCompressionEnabled; }
+
+    // 最近一次同步纹理加载 (解码 + 上传) 的耗时，用于和流式路径对比
+    double getLastSyncTextureLoadMs() const { return _lastSyncTextureLoadMs; }
+
+    // ==========================================
+    // ORM 自动打包
+    // ==========================================
+
+    // 材质同时使用独立的 AO / Roughness / Metallic 贴图时，在工作线程把三者打包成
+    // 一张 ORM (R=AO, G=Roughness, B=Metallic)，渲染时 1 次绑定 + 1 次采样即可。
+    // 结果按三张源图的签名缓存 (内存 + 磁盘)。
+    // 返回的纹理在打包完成前未驻留 (isResident() == false)，期间调用方应继续使用独立贴图。
+    std::shared_ptr<ImageTexture2D> getPackedORM(const ImageTexture2D& ao, const ImageTexture2D& roughness,
+                                                 const ImageTexture2D& metallic);
+
+    void setOrmPackingEnabled(bool enabled) { _ormPackingEnabled = enabled; }
+    bool isOrmPackingEnabled() const { return _ormPackingEnabled; }
+
+    // ==========================================
+    // 内容去重
+    // ==========================================
+
+    // 缓存 key 是 (路径, 选项)，不同目录下的同一张图、不同文件里的同一个子网格会各占一份显存。
+    // 开启后在工作线程对解码后的数据计算内容哈希，作为第二级 key：
+    // 内容完全相同的模型共享同一份 MeshGeometry，纹理共享同一张存储纹理。
+    // 每个资源仍然是独立的对象，热重载只替换变化的那一个。
+    struct DedupStats {
+        size_t textureCount = 0;        // 已加载的纹理 (按缓存条目计)
+        size_t textureStorageCount = 0; // 实际占用显存的份数
+        size_t textureBytesSaved = 0;
+        size_t meshCount = 0;           // 已加载的模型 (按对象计)
+        size_t meshStorageCount = 0;
+        size_t meshBytesSaved = 0;
+    };
+
+    // 统计结果最多每 0.5 秒重新计算一次
+    const DedupStats& getDedupStats();
+
+    // 只影响之后新加载的资源
+    void setContentDedupEnabled(bool enabled) { _contentDedupEnabled = enabled; }
+    bool isContentDedupEnabled() const { return _contentDedupEnabled; }
+
+    // 由解析出的网格数据创建模型，内容相同时共享已有的几何数据 (线程安全)
+    // source 记录数据来自哪个文件，CPU 数据被释放后据此从网格缓存读回
+    // lods / clusters 为导入时生成的 LOD 链与网格簇 (由顶点/索引唯一决定，共享几何数据时沿用已有的那份)
+    std::shared_ptr<Model> createModel(std::vector<Vertex> vertices, std::vector<uint32_t> indices,
+                                       const MeshSourceInfo& source = {}, MeshLodChain lods = {},
+                                       MeshClusterSet clusters = {});
+
+    // ==========================================
+    // CPU 端网格数据驻留
+    // ==========================================
+
+    // 新加载的 (来自文件的) 模型默认使用的驻留策略，程序生成的网格始终保留完整数据
+    void setDefaultMeshResidency(MeshResidency residency) { _defaultMeshResidency = residency; }
+    MeshResidency getDefaultMeshResidency() const { return _defaultMeshResidency; }
+
+    // 新加载的 (来自文件的) 模型在显存中使用的顶点格式，在工作线程打包
+    void setVertexFormat(VertexFormat format) { _vertexFormat = format; }
+    VertexFormat getVertexFormat() const { return _vertexFormat; }
+
+    // [主线程] 修改模型 (及与它共享几何数据的模型) 的驻留策略。
+    // 需要比当前更多的数据时 (例如从 GpuOnly 切回 Full) 先从网格缓存读回；失败返回 false
+    bool setMeshResidency(Model& model, MeshResidency residency);
+
+    // 从网格缓存 (或源文件) 重新读取完整的顶点/索引数据，不修改 geometry 本身。
+    // 读回的数据与显存中的不一致 (源文件已被修改) 时返回 false
+    bool loadCpuMeshData(const MeshGeometry& geometry, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+    // ==========================================
+    // 内存预算
+    // ==========================================
+
+    // 每个缓存条目记录它占用的 CPU / GPU 字节数 (共享的存储只计一次) 和最后一次被获取的帧号。
+    // 总量超出预算时，按最近最少使用的顺序淘汰"只被缓存自己引用"的条目，
+    // 场景里仍在使用的资源不会被淘汰。淘汰后再次获取时走磁盘上的烘焙缓存
+    // (.cache/textures 与 .cache/meshes)，不需要重新解析源文件。
+    struct MemoryStats {
+        size_t cpuBytes = 0;
+        size_t gpuBytes = 0;
+        size_t cpuBudget = 0;
+        size_t gpuBudget = 0;
+        size_t entryCount = 0;      // 各缓存的条目总数
+        size_t evictedCount = 0;    // 累计淘汰的条目数
+        size_t evictedBytes = 0;    // 累计释放的字节数 (CPU + GPU)
+    };
+
+    const MemoryStats& getMemoryStats() const { return _memoryStats; }
+
+    void setMemoryBudget(size_t cpuBytes, size_t gpuBytes);
 
-    // 扫描资源目录下所有的 .obj 文件 (用于 UI 显示)
-    // rootDir: 资源根目录，例如 "../../media/"
-    void scanDirectory(const std::string& rootDir);
+    // [主线程] 重新统计并在超出预算时淘汰 (update() 中每 30 帧自动执行一次)
+    void enforceMemoryBudget();
 
-    // 获取扫描到的文件列表 (文件名, 相对路径)
-    const std::vector<std::pair<std::string, std::string>>& getFileList() const { return _fileList; }
+    // 每帧在主线程 (持有 GL 上下文) 调用一次，执行后台任务投递回来的 GL 工作
+    void update();
+
+    // 当前正在进行中的异步请求数量 (用于 UI 显示)
+    size_t getPendingRequestCount() const;
+
+    // 项目目录监视器 (未设置项目根目录时不运行)
+    const AssetWatcher& getWatcher() const { return *_watcher; }
+
+    // 后台工作线程池 (供导入管线等投递 CPU 任务)
+    ThreadPool& getWorkers() { return *_workers; }
+
+    // 项目资源索引 (用于 UI 显示)，由文件变化事件增量维护
+    const AssetDatabase& getAssetDatabase() const { return *_assetDb; }
 
     // 手动将已加载的模型注入缓存
     void injectCache(const std::string& pathKey, const std::string& subMeshName, bool useFlatShade, std::shared_ptr<Model> model);
@@ -68,10 +233,12 @@ public:
     // 释放 HDR 内存
     static void freeHDRRaw(HDRData& data);
 
+    // [主线程] 排空后台加载任务，丢弃未完成的上传并清空所有缓存 (切换项目和退出时调用)
     void shutdown();
 
 private:
-    ResourceManager() = default;
+    ResourceManager();
+    ~ResourceManager();
 
     std::string _projectRoot = ""; // 默认为空
 
@@ -80,17 +247,148 @@ private:
         std::shared_ptr<T> resource;    // 实际资源
         AssetSignature signature;       // 加载时的版本指纹
         std::string sourcePath;         // 原始绝对路径 (用于重校验)
+
+        // 加载参数 (热重载时按原参数重新加载)
+        bool useFlatShade = false;
+        std::string subMeshName;
+
+        // 内存统计与 LRU
+        uint64_t lastUse = 0;           // 最后一次被获取时的帧号
+        size_t cpuBytes = 0;            // 由 enforceMemoryBudget 刷新
+        size_t gpuBytes = 0;
     };
 
-    // 模型缓存：key=相对路径, value=模型指针
-    std::unordered_map<std::string, CacheEntry<Model>> _modelCache;
+    // 模型缓存：key=AssetKey(相对路径, flat, 子网格), value=模型指针
+    ShardedMap<AssetKey, CacheEntry<Model>> _modelCache;
 
     // 场景资源缓存
-    std::unordered_map<std::string, CacheEntry<SceneResource>> _sceneCache;
+    ShardedMap<AssetKey, CacheEntry<SceneResource>> _sceneCache;
 
     // 纹理缓存
-    std::unordered_map<std::string, CacheEntry<ImageTexture2D>> _textureCache;
+    ShardedMap<AssetKey, CacheEntry<ImageTexture2D>> _textureCache;
+
+    // 正在加载中的请求 (用于去重)
+    mutable std::mutex _inFlightMutex;
+    std::unordered_map<AssetKey, ModelFuture> _inFlightModels;
+    std::unordered_map<AssetKey, TextureFuture> _inFlightTextures;
+
+    // 需要回到主线程执行的任务 (GL 上传)
+    std::mutex _mainThreadMutex;
+    std::vector<std::function<void()>> _mainThreadTasks;
+
+    // 后台工作线程
+    std::unique_ptr<ThreadPool> _workers;
+
+    // 纹理流式上传
+    std::unique_ptr<TextureStreamer> _streamer;
+    bool _textureStreamingEnabled = true;
+    double _lastSyncTextureLoadMs = 0.0;
+    bool _textureCompressionEnabled = false;
+    bool _glCapsQueried = false;
+
+    // 打包 ORM 缓存：签名来自三张源图，任意一张变化都会重新打包
+    struct PackedOrmEntry {
+        std::shared_ptr<ImageTexture2D> resource;
+        std::vector<AssetSignature> signatures;
+        std::string sourceId;
+        std::vector<std::string> sourcePaths;   // 三张源图的绝对路径
+        uint64_t lastUse = 0;
+        size_t gpuBytes = 0;
+    };
+    ShardedMap<AssetKey, PackedOrmEntry> _packedOrmCache;
+    bool _ormPackingEnabled = true;
+
+    // 内容哈希 -> 共享的存储 (弱引用，最后一个使用者释放后自然失效)
+    std::atomic<bool> _contentDedupEnabled{ true };
+    std::atomic<MeshResidency> _defaultMeshResidency{ MeshResidency::Full };
+    std::atomic<VertexFormat> _vertexFormat{ VertexFormat::Standard };
+    ShardedMap<uint64_t, std::weak_ptr<MeshGeometry>> _meshContent;
+    ShardedMap<uint64_t, std::weak_ptr<ImageTexture2D>> _textureContent;
+    DedupStats _dedupStats;
+    std::chrono::steady_clock::time_point _dedupStatsTime;
+
+    // [主线程] 把烘焙好的纹理交给 target：内容已存在时直接共享存储，否则上传一份新的存储纹理
+    // sync 为 true 时立即上传 (同步加载路径)，否则交给 streamer 分帧上传
+    void resolveTextureStorage(CookedTexture&& cooked, uint64_t contentHash, const std::string& cleanPath,
+                               std::shared_ptr<ImageTexture2D> target, bool sync, std::function<void(bool)> onDone);
+
+    // [线程安全] 把纹理交给 streamer，上传结束 (驻留或被丢弃) 时在主线程先通知等待者，再调用 onDone
+    void streamTexture(std::shared_ptr<ImageTexture2D> target, CookedTexture&& cooked,
+                       std::function<void(bool)> onDone, TextureCancelPolicy cancel = {});
+
+    // [主线程] tex 驻留后调用 fn(true)；tex 已被释放或它的上传被丢弃时调用 fn(false)
+    // 不轮询：fn 挂在 tex 的上传结束通知上 (notifyResidency)
+    void runWhenResident(std::weak_ptr<const ImageTexture2D> tex, std::function<void(bool)> fn);
+
+    // [主线程] 某张纹理的上传结束：调用并移除挂在它上面的等待者
+    void notifyResidency(const ImageTexture2D* tex, bool resident);
+
+    // 正在上传的纹理 -> 等它驻留的回调 (仅主线程访问；shutdown 时全部以 false 通知)
+    std::unordered_map<const ImageTexture2D*, std::vector<std::function<void(bool)>>> _residencyWaiters;
+
+    // 在工作线程打包 ORM 并交给 streamer，上传结束后 (主线程) 调用 onResident(是否驻留)
+    void packOrmAsync(const std::string& sourceId, const std::vector<std::string>& sourcePaths,
+                      std::shared_ptr<ImageTexture2D> target, std::function<void(bool)> onResident);
+
+    // ==========================================
+    // 热重载
+    // ==========================================
+    // 监视器运行时，项目目录内的资源命中缓存不再逐次 stat 文件，
+    // 而是由监视器上报变化后，在后台重新加载并原地替换 (使用者持有的指针保持有效)。
+    std::unique_ptr<AssetWatcher> _watcher;
+
+    // 该资源的变化是否由监视器负责 (纯字符串比较，不访问文件系统，线程安全)
+    bool isWatched(const std::string& fullPath) const;
+
+    // 监视器正在监视的根目录快照 (未运行时为空)，切换项目时整体替换
+    std::shared_ptr<const std::string> _watchedRoot;
+    mutable std::mutex _watchedRootMutex;
+
+    void processFileChanges();
+    // 监视器丢了事件 (队列溢出) 时：逐个比较已加载资源的签名，变化的按热重载处理
+    void rescanLoadedSources();
+    void hotReloadTextures(const std::string& cleanPath, const std::string& fullPath);
+    void hotReloadModels(const std::string& cleanPath, const std::string& fullPath);
+
+    // 纹理缓存 key：同一张图的 sRGB / 线性版本分开缓存
+    static AssetKey makeTextureKey(const std::string& cleanPath, bool srgb);
+    TextureCookOptions makeCookOptions(bool srgb) const;
+
+    // 读取磁盘上的烘焙缓存，未命中时解码 + 烘焙并写回缓存 (线程安全)
+    static CookedTexture cookTexture(const std::string& projectRoot, const std::string& cleanPath,
+                                     const std::string& fullPath, const TextureCookOptions& options);
+
+    // 后台解码/烘焙一张图，把结果交给 streamer (失败时从缓存移除占位条目)
+    void decodeAndStream(const AssetKey& key, const std::string& cleanPath, const std::string& fullPath,
+                         const TextureCookOptions& options,
+                         std::shared_ptr<ImageTexture2D> target, std::function<void(bool)> onDone);
+
+    // 命中缓存且签名一致时返回资源，否则返回空
+    std::shared_ptr<Model> lookupModel(const AssetKey& key, const std::string& fullPath, const std::string& cleanPath);
+    std::shared_ptr<ImageTexture2D> lookupTexture(const AssetKey& key, const std::string& fullPath, const std::string& cleanPath);
+
+    // 实际的磁盘加载 (可在任意线程执行)
+    std::shared_ptr<Model> loadModelFromDisk(const std::string& projectRoot, const AssetKey& key, const std::string& fullPath,
+                                             bool useFlatShade, const std::string& subMeshName);
+
+    // 读取单个 (子) 网格，优先使用网格缓存 (可在任意线程执行)
+    MeshData loadMeshData(const std::string& projectRoot, const std::string& fullPath, bool useFlatShade,
+                          const std::string& subMeshName);
+
+    // 网格缓存的 sourceId：项目内的文件用相对路径，项目目录移动后缓存依然有效
+    static std::string makeMeshSourceId(const std::string& projectRoot, const std::string& fullPath, bool useFlatShade,
+                                        const std::string& part);
+
+    // 帧号 (LRU 时间戳)，update() 中递增
+    std::atomic<uint64_t> _frameIndex{ 1 };
+    size_t _cpuBudget = 1024ull * 1024 * 1024;
+    size_t _gpuBudget = 1024ull * 1024 * 1024;
+    MemoryStats _memoryStats;
+
+    void postToMainThread(std::function<void()> task);
+    // [主线程] 执行已投递的主线程任务，返回是否执行了任何任务
+    bool runMainThreadTasks();
 
-    // 扫描到的文件列表
-    std::vector<std::pair<std::string, std::string>> _fileList;
+    // 持久化的资源索引
+    std::unique_ptr<AssetDatabase> _assetDb;
 };
\ No newline at end of file
@@ -1,10 +1,21 @@
 #include "scene.h"
 #include "resource_manager.h" // 如果需要加载默认图标
+#include "engine/utils/job_system.h"
 
+#include <atomic>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 
+namespace {
+
+// 一层对象数超过该值时并行计算世界矩阵，每个任务处理 kTransformChunkSize 个
+constexpr size_t kParallelTransformThreshold = 4096;
+constexpr size_t kTransformChunkSize = 1024;
+
+} // namespace
+
 GameObject* Scene::createCube()
 {
     auto go = new GameObject("Cube");
@@ -18,8 +29,7 @@ GameObject* Scene::createCube()
     meshComp->material.ao = 1.0f;
 
     // 存入容器
-    _gameObjects.push_back(std::unique_ptr<GameObject>(go));
-    return go;
+    return addGameObject(std::unique_ptr<GameObject>(go));
 }
 
 GameObject* Scene::createPointLight()
@@ -35,8 +45,7 @@ GameObject* Scene::createPointLight()
     meshComp->params.radius = 0.2f;
     meshComp->material.albedo = lightComp->color;
 
-    _gameObjects.push_back(std::unique_ptr<GameObject>(go));
-    return go;
+    return addGameObject(std::unique_ptr<GameObject>(go));
 }
 
 void Scene::createDefaultScene()
@@ -61,32 +70,342 @@ void Scene::createDefaultScene()
         }
     } catch (...) {}
 
-    _gameObjects.push_back(std::unique_ptr<GameObject>(sun));
+    addGameObject(std::unique_ptr<GameObject>(sun));
 }
 
-void Scene::markForDestruction(GameObject* go)
+GameObject* Scene::addGameObject(std::unique_ptr<GameObject> go)
+{
+    if (!go) return nullptr;
+
+    uint32_t index;
+    if (!_freeSlots.empty()) {
+        index = _freeSlots.back();
+        _freeSlots.pop_back();
+    } else {
+        if (_slots.size() > GameObjectHandle::kIndexMask) {
+            std::cerr << "[Scene] Too many objects, " << go->name << " discarded" << std::endl;
+            return nullptr;
+        }
+        index = static_cast<uint32_t>(_slots.size());
+        _slots.emplace_back();
+    }
+
+    ObjectSlot& slot = _slots[index];
+    slot.denseIndex = static_cast<uint32_t>(_gameObjects.size());
+    slot.alive = true;
+
+    go->_scene = this;
+    go->_handle = GameObjectHandle(index, slot.generation);
+    go->_pendingDestroy = false;
+    go->_parent = GameObjectHandle();
+    go->_children.clear();
+    go->_worldMatrix = go->transform.getLocalMatrix();
+    _hierarchyChanged = true;
+    _instanceIdToHandle[go->getInstanceID()] = go->_handle;
+    _gameObjects.push_back(std::move(go));
+    return _gameObjects.back().get();
+}
+
+void Scene::releaseSlot(GameObjectHandle handle)
+{
+    ObjectSlot& slot = _slots[handle.getIndex()];
+    slot.alive = false;
+    slot.generation = (slot.generation + 1) & GameObjectHandle::kGenerationMask;
+    if (slot.generation == 0) slot.generation = 1;
+    _freeSlots.push_back(handle.getIndex());
+}
+
+GameObject* Scene::find(GameObjectHandle handle) const
+{
+    uint32_t index = handle.getIndex();
+    if (handle.isNull() || index >= _slots.size()) return nullptr;
+    const ObjectSlot& slot = _slots[index];
+    if (!slot.alive || slot.generation != handle.getGeneration()) return nullptr;
+    return _gameObjects[slot.denseIndex].get();
+}
+
+GameObject* Scene::findByInstanceID(int instanceId) const
+{
+    auto it = _instanceIdToHandle.find(instanceId);
+    return it != _instanceIdToHandle.end() ? find(it->second) : nullptr;
+}
+
+void Scene::removeGameObject(GameObject* go)
+{
+    if (!contains(go)) return;
+
+    // 先删除子对象 (复制一份，子对象删除时会修改列表)
+    std::vector<GameObjectHandle> children = go->_children;
+    for (GameObjectHandle child : children) removeGameObject(find(child));
+
+    if (GameObject* parent = getParent(go)) {
+        auto& siblings = parent->_children;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), go->_handle), siblings.end());
+    }
+    _hierarchyChanged = true;
+
+    if (go->_pendingDestroy) _pendingDestroyCount--;
+    uint32_t denseIndex = _slots[go->_handle.getIndex()].denseIndex;
+    _instanceIdToHandle.erase(go->getInstanceID());
+    releaseSlot(go->_handle);
+
+    // 保持顺序：后面的对象前移一位
+    _gameObjects.erase(_gameObjects.begin() + denseIndex);
+    for (size_t i = denseIndex; i < _gameObjects.size(); ++i) {
+        _slots[_gameObjects[i]->_handle.getIndex()].denseIndex = static_cast<uint32_t>(i);
+    }
+}
+
+void Scene::clear()
+{
+    // 快照中的对象没有占用本场景的槽位
+    if (!_isSnapshot) {
+        for (const auto& go : _gameObjects) releaseSlot(go->_handle);
+    }
+    _gameObjects.clear();
+    _instanceIdToHandle.clear();
+    _pendingDestroyCount = 0;
+    _hierarchyChanged = true;
+    std::apply([](auto&... lists) { (lists.clear(), ...); }, _snapshotComponents);
+}
+
+template <typename T>
+void Scene::captureComponents(Scene& snapshot, std::vector<GameObject*>& copies) const
 {
-    // 检查是否已经在队列中，防止重复添加
-    if (std::find(_killQueue.begin(), _killQueue.end(), go) == _killQueue.end()) {
-        _killQueue.push_back(go);
+    // 按池中的创建顺序拷贝 (光源按这个顺序分配阴影层)
+    auto& list = std::get<std::vector<T*>>(snapshot._snapshotComponents);
+    for (T* comp : ComponentPool<T>::Get().items())
+    {
+        if (!comp || comp->owner->getScene() != this) continue;
+
+        uint32_t denseIndex = _slots[comp->owner->_handle.getIndex()].denseIndex;
+        GameObject*& copy = copies[denseIndex];
+        if (!copy) copy = new GameObject(*comp->owner, &snapshot);
+        list.push_back(copy->attachCopy(*comp));
     }
 }
 
+GameObject* Scene::captureRenderState(Scene& snapshot, const GameObject* selected) const
+{
+    snapshot.clear();
+    snapshot._isSnapshot = true;
+    snapshot._environment = _environment;
+
+    std::vector<GameObject*> copies(_gameObjects.size(), nullptr);
+    captureComponents<MeshComponent>(snapshot, copies);
+    captureComponents<LightComponent>(snapshot, copies);
+    captureComponents<ReflectionProbeComponent>(snapshot, copies);
+    captureComponents<PlanarReflectionComponent>(snapshot, copies);
+
+    // 保持原场景中的对象顺序
+    GameObject* selectedCopy = nullptr;
+    for (GameObject* copy : copies) {
+        if (!copy) continue;
+        if (selected && copy->_handle == selected->_handle) selectedCopy = copy;
+        snapshot._gameObjects.emplace_back(copy);
+    }
+    return selectedCopy;
+}
+
+void Scene::applyRenderFeedback(const Scene& snapshot)
+{
+    for (const MeshComponent* copy : std::get<std::vector<MeshComponent*>>(snapshot._snapshotComponents))
+    {
+        // 渲染期间被销毁 (句柄失效) 的对象直接跳过
+        GameObject* go = find(copy->owner->_handle);
+        if (!go) continue;
+
+        for (Component* comp : go->_components) {
+            if (comp->getInstanceID() != copy->getInstanceID()) continue;
+
+            // 渲染期间换了模型时，旧模型上选出的级别不再适用
+            auto* mesh = static_cast<MeshComponent*>(comp);
+            if (mesh->model == copy->model) {
+                mesh->lodLevel = copy->lodLevel;
+                mesh->lodCulled = copy->lodCulled;
+            }
+            break;
+        }
+    }
+}
+
+void Scene::markForDestruction(GameObject* go)
+{
+    // 已标记过的不重复计数；子对象随父对象一起销毁
+    if (!contains(go) || go->_pendingDestroy) return;
+    go->_pendingDestroy = true;
+    _pendingDestroyCount++;
+    for (GameObjectHandle child : go->_children) markForDestruction(find(child));
+}
+
 void Scene::destroyMarkedObjects()
 {
-    if (_killQueue.empty()) return;
+    if (_pendingDestroyCount == 0) return;
+
+    // 先断开层级：被销毁对象从存活的父对象中摘除；
+    // 标记之后才挂到被销毁对象下的子对象不跟着销毁，变回根对象
+    for (const auto& go : _gameObjects)
+    {
+        GameObject* parent = getParent(go.get());
+        if (!parent || parent->_pendingDestroy == go->_pendingDestroy) continue;
+        if (go->_pendingDestroy) {
+            auto& siblings = parent->_children;
+            siblings.erase(std::remove(siblings.begin(), siblings.end(), go->_handle), siblings.end());
+        } else {
+            go->_parent = GameObjectHandle();
+        }
+    }
+    _hierarchyChanged = true;
+
+    // 一次遍历：存活的对象前移补位，被标记的对象就地销毁
+    size_t write = 0;
+    for (size_t read = 0; read < _gameObjects.size(); ++read)
+    {
+        std::unique_ptr<GameObject>& go = _gameObjects[read];
+        if (go->_pendingDestroy) {
+            _instanceIdToHandle.erase(go->getInstanceID());
+            releaseSlot(go->_handle);
+            go.reset();
+            continue;
+        }
+        if (write != read) _gameObjects[write] = std::move(go);
+        _slots[_gameObjects[write]->_handle.getIndex()].denseIndex = static_cast<uint32_t>(write);
+        write++;
+    }
+    _gameObjects.resize(write);
+    _pendingDestroyCount = 0;
+}
+
+// ==========================================
+// 父子层级与世界变换
+// ==========================================
+bool Scene::setParent(GameObject* child, GameObject* parent, bool keepWorldTransform)
+{
+    if (!contains(child) || (parent && !contains(parent))) return false;
+    if (getParent(child) == parent) return true;
+
+    for (GameObject* p = parent; p; p = getParent(p)) {
+        if (p == child) {
+            std::cerr << "[Scene] Cannot parent " << child->name << " under its own descendant " << parent->name << std::endl;
+            return false;
+        }
+    }
+
+    if (keepWorldTransform) {
+        updateWorldTransforms();
+        glm::mat4 local = parent ? glm::inverse(parent->_worldMatrix) * child->_worldMatrix : child->_worldMatrix;
+        child->transform.setFromTRS(local);
+    }
+
+    if (GameObject* oldParent = getParent(child)) {
+        auto& siblings = oldParent->_children;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), child->_handle), siblings.end());
+    }
+    child->_parent = parent ? parent->_handle : GameObjectHandle();
+    if (parent) parent->_children.push_back(child->_handle);
+
+    _hierarchyChanged = true;
+    return true;
+}
+
+void Scene::rebuildHierarchy()
+{
+    TransformHierarchy& h = _hierarchy;
+    h.objects.clear();
+    h.parents.clear();
+    h.levelOffsets.clear();
+
+    // 第 0 层：根对象 (按 Hierarchy 显示顺序)
+    for (const auto& go : _gameObjects) {
+        if (!getParent(go.get())) {
+            h.objects.push_back(go.get());
+            h.parents.push_back(-1);
+        }
+    }
 
-    for (GameObject* go : _killQueue)
+    // 逐层展开：上一层每个对象的子对象排成下一层
+    size_t levelBegin = 0;
+    while (levelBegin < h.objects.size())
     {
-        // 执行真正的物理删除
-        _gameObjects.erase(
-            std::remove_if(_gameObjects.begin(), _gameObjects.end(),
-                [go](const std::unique_ptr<GameObject>& p) { 
-                    return p.get() == go; 
-                }),
-            _gameObjects.end());
+        size_t levelEnd = h.objects.size();
+        h.levelOffsets.push_back(static_cast<uint32_t>(levelBegin));
+        for (size_t i = levelBegin; i < levelEnd; ++i) {
+            for (GameObjectHandle childHandle : h.objects[i]->_children) {
+                if (GameObject* child = find(childHandle)) {
+                    h.objects.push_back(child);
+                    h.parents.push_back(static_cast<int32_t>(i));
+                }
+            }
+        }
+        levelBegin = levelEnd;
+    }
+    h.levelOffsets.push_back(static_cast<uint32_t>(h.objects.size()));
+
+    size_t count = h.objects.size();
+    h.positions.resize(count);
+    h.rotations.resize(count);
+    h.scales.resize(count);
+    h.worlds.resize(count);
+    h.dirty.assign(count, 0);
+
+    _transformStats.objects = count;
+    _transformStats.depth = h.levelOffsets.size() - 1;
+}
+
+size_t Scene::updateTransformRange(size_t begin, size_t end, bool force)
+{
+    TransformHierarchy& h = _hierarchy;
+    size_t updated = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+        const Transform& t = h.objects[i]->transform;
+        int32_t parent = h.parents[i];
+        bool changed = force || (parent >= 0 && h.dirty[parent]) ||
+                       t.position != h.positions[i] || t.rotation != h.rotations[i] || t.scale != h.scales[i];
+        h.dirty[i] = changed ? 1 : 0;
+        if (!changed) continue;
+
+        h.positions[i] = t.position;
+        h.rotations[i] = t.rotation;
+        h.scales[i] = t.scale;
+        h.worlds[i] = parent >= 0 ? h.worlds[parent] * t.getLocalMatrix() : t.getLocalMatrix();
+        h.objects[i]->_worldMatrix = h.worlds[i];
+        updated++;
+    }
+    return updated;
+}
+
+void Scene::updateWorldTransforms()
+{
+    bool force = _hierarchyChanged;
+    if (_hierarchyChanged) {
+        rebuildHierarchy();
+        _hierarchyChanged = false;
+    }
+
+    _transformStats.updated = 0;
+    _transformStats.parallel = false;
+
+    // 逐层计算：同一层内只读上一层的结果，可以任意拆分
+    for (size_t level = 0; level + 1 < _hierarchy.levelOffsets.size(); ++level)
+    {
+        size_t begin = _hierarchy.levelOffsets[level];
+        size_t end = _hierarchy.levelOffsets[level + 1];
+
+        if (end - begin < kParallelTransformThreshold) {
+            _transformStats.updated += updateTransformRange(begin, end, force);
+            continue;
+        }
+
+        // 并行：按块分给任务系统，主线程等待时也参与计算
+        std::atomic<size_t> updated{ 0 };
+        JobSystem::Get().parallelFor(begin, end, kTransformChunkSize, [&](size_t chunkBegin, size_t chunkEnd) {
+            updated += updateTransformRange(chunkBegin, chunkEnd, force);
+        });
+
+        _transformStats.updated += updated;
+        _transformStats.parallel = true;
     }
-    _killQueue.clear();
 }
 
 void Scene::exportToOBJ(const std::string& filename)
@@ -109,8 +428,22 @@ void Scene::exportToOBJ(const std::string& filename)
         auto meshComp = go->getComponent<MeshComponent>();
         if (!meshComp || !meshComp->enabled || !meshComp->model) continue;
 
-        const auto& vertices = meshComp->model->getVertices();
-        const auto& indices = meshComp->model->getIndices();
+        // CPU 数据已按驻留策略释放时，临时从网格缓存读回一份 (只用于本次导出)
+        std::vector<Vertex> reloadedVertices;
+        std::vector<uint32_t> reloadedIndices;
+        const std::vector<Vertex>* vertexSource = &meshComp->model->getVertices();
+        const std::vector<uint32_t>* indexSource = &meshComp->model->getIndices();
+        const auto& geometry = meshComp->model->getGeometry();
+        if (!geometry->hasFullCpuData()) {
+            if (!ResourceManager::Get().loadCpuMeshData(*geometry, reloadedVertices, reloadedIndices)) {
+                std::cerr << "Export: skipping " << go->name << " (mesh data not resident and cannot be reloaded)" << std::endl;
+                continue;
+            }
+            vertexSource = &reloadedVertices;
+            indexSource = &reloadedIndices;
+        }
+        const auto& vertices = *vertexSource;
+        const auto& indices = *indexSource;
 
         if (vertices.empty() || indices.empty()) continue;
 
@@ -118,7 +451,7 @@ void Scene::exportToOBJ(const std::string& filename)
         out << "o " << go->name << "_" << go->getInstanceID() << "\n";
 
         // 2. 计算变换矩阵
-        glm::mat4 modelMat = go->transform.getLocalMatrix();
+        glm::mat4 modelMat = go->getWorldMatrix();
         // 还要叠加上 Model 自身的变换 (如果有的话，通常 Model 自带变换是单位矩阵，但也可能不是)
         modelMat = modelMat * meshComp->model->transform.getLocalMatrix();
 
@@ -186,36 +519,98 @@ void Scene::importScene(const std::string& filepath)
 
     // 2. 构建场景图 (Scene Graph)
     // 资源管理器给了我们一组纯数据 (Node)，我们需要将其实例化为具体的 GameObject
+    SceneImportHierarchy hierarchy;
     for (const auto& node : sceneRes->nodes)
     {
-        auto go = new GameObject(node.name);
-        
-        // node.model 已经是一个初始化好的 GPU 资源指针了
-        auto meshComp = go->addComponent<MeshComponent>(node.model);
-        
-        // 设置组件元数据，以便 Inspector 面板能正确显示
-        meshComp->shapeType = MeshShapeType::CustomOBJ;
-        
-        // 记录路径
-        strncpy(meshComp->params.objPath, cleanPath.c_str(), sizeof(meshComp->params.objPath) - 1);
-        meshComp->params.objPath[sizeof(meshComp->params.objPath) - 1] = '\0';
-
-        // 记录子网格名称
-        strncpy(meshComp->params.subMeshName, node.name.c_str(), sizeof(meshComp->params.subMeshName) - 1);
-        meshComp->params.subMeshName[sizeof(meshComp->params.subMeshName) - 1] = '\0';
-
-        // 智能 UV 检测
-        if (!node.model->hasUVs()) {
-            meshComp->useTriplanar = true;
-            meshComp->triplanarScale = 0.2f;
-        } else {
-            meshComp->useTriplanar = false;
+        instantiateMeshNode(cleanPath, node, hierarchy);
+    }
+
+    std::cout << "[Scene] Instantiated " << sceneRes->nodes.size() << " objects from " << cleanPath << std::endl;
+}
+
+GameObject* Scene::instantiateMeshNode(const std::string& cleanPath, const SceneResource::Node& node, SceneImportHierarchy& hierarchy)
+{
+    // 1. 导入根对象 (以文件名命名)，整个文件的物体可以一起移动
+    GameObject* parent = find(hierarchy.root);
+    if (!parent) {
+        std::string rootName = std::filesystem::path(cleanPath).stem().string();
+        parent = addGameObject(std::make_unique<GameObject>(rootName.empty() ? "Imported Scene" : rootName));
+        if (!parent) return nullptr;
+        hierarchy.root = parent->getHandle();
+    }
+
+    // 2. 补齐节点链上还没创建的节点对象 (带 glTF 节点的局部变换)
+    for (const SceneNodeData& nodeData : node.nodePath)
+    {
+        auto it = hierarchy.nodes.find(nodeData.id);
+        GameObject* nodeObj = it != hierarchy.nodes.end() ? find(it->second) : nullptr;
+        if (!nodeObj) {
+            nodeObj = addGameObject(std::make_unique<GameObject>(nodeData.name));
+            if (!nodeObj) return nullptr;
+            nodeObj->transform.setFromTRS(nodeData.localTransform);
+            setParent(nodeObj, parent, false);
+            hierarchy.nodes[nodeData.id] = nodeObj->getHandle();
         }
+        parent = nodeObj;
+    }
+
+    const std::string& nodeName = node.name;
+    const std::shared_ptr<Model>& model = node.model;
+    auto go = new GameObject(nodeName);
+    
+    // model 已经是一个初始化好的 GPU 资源指针了
+    auto meshComp = go->addComponent<MeshComponent>(model);
+    
+    // 设置组件元数据，以便 Inspector 面板能正确显示
+    meshComp->shapeType = MeshShapeType::CustomOBJ;
+    
+    // 记录路径
+    strncpy(meshComp->params.objPath, cleanPath.c_str(), sizeof(meshComp->params.objPath) - 1);
+    meshComp->params.objPath[sizeof(meshComp->params.objPath) - 1] = '\0';
 
-        _gameObjects.push_back(std::unique_ptr<GameObject>(go));
+    // 记录子网格名称
+    strncpy(meshComp->params.subMeshName, nodeName.c_str(), sizeof(meshComp->params.subMeshName) - 1);
+    meshComp->params.subMeshName[sizeof(meshComp->params.subMeshName) - 1] = '\0';
+
+    // 智能 UV 检测
+    if (!model->hasUVs()) {
+        meshComp->useTriplanar = true;
+        meshComp->triplanarScale = 0.2f;
+    } else {
+        meshComp->useTriplanar = false;
     }
 
-    std::cout << "[Scene] Instantiated " << sceneRes->nodes.size() << " objects from " << cleanPath << std::endl;
+    GameObject* added = addGameObject(std::unique_ptr<GameObject>(go));
+    if (added) setParent(added, parent, false);
+    return added;
+}
+
+std::shared_ptr<SceneImportJob> Scene::importSceneAsync(const std::string& filepath)
+{
+    auto job = std::make_shared<SceneImportJob>(filepath, false);
+    job->start();
+    _importJobs.push_back(job);
+
+    std::cout << "[Scene] Async import started: " << job->getPath() << std::endl;
+    return job;
+}
+
+void Scene::updateImports()
+{
+    if (_importJobs.empty()) return;
+
+    // 多个任务共享同一帧预算，先来先服务
+    size_t remaining = _importUploadBudget;
+    for (auto& job : _importJobs) {
+        size_t used = job->pump(*this, remaining);
+        remaining = (used >= remaining) ? 0 : remaining - used;
+    }
+
+    // 移除已结束的任务
+    _importJobs.erase(
+        std::remove_if(_importJobs.begin(), _importJobs.end(),
+            [](const std::shared_ptr<SceneImportJob>& j) { return j->isFinished(); }),
+        _importJobs.end());
 }
 
 void Scene::importSingleMeshFromOBJ(const std::string& filepath)
@@ -264,7 +659,7 @@ void Scene::importSingleMeshFromOBJ(const std::string& filepath)
     }
 
     // 8. 加入场景列表
-    _gameObjects.push_back(std::unique_ptr<GameObject>(go));
+    addGameObject(std::unique_ptr<GameObject>(go));
 
     std::cout << "[Scene] Imported single mesh: " << name << std::endl;
 }
\ No newline at end of file
@@ -3,9 +3,54 @@
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <tuple>
+#include <unordered_map>
+#include <glm/gtc/quaternion.hpp>
 #include "scene_object.h" // 根据你的实际路径调整
 #include "scene_environment.h"
 #include "geometry_factory.h"
+#include "scene_import_job.h"
+
+// 某一类组件在一个场景中的遍历视图 (直接走 ComponentPool 的紧凑数组，按组件创建顺序)
+// 跳过不属于该场景的物体上的组件；enabledOnly 时再跳过禁用的组件
+template <typename T>
+class ComponentView
+{
+public:
+    class Iterator
+    {
+    public:
+        Iterator(T* const* it, T* const* end, const Scene* scene, bool enabledOnly)
+            : _it(it), _end(end), _scene(scene), _enabledOnly(enabledOnly) { skip(); }
+
+        T& operator*() const { return **_it; }
+        T* operator->() const { return *_it; }
+        Iterator& operator++() { ++_it; skip(); return *this; }
+        bool operator!=(const Iterator& other) const { return _it != other._it; }
+
+    private:
+        void skip()
+        {
+            while (_it != _end && (!*_it || (*_it)->owner->getScene() != _scene || (_enabledOnly && !(*_it)->enabled))) ++_it;
+        }
+
+        T* const* _it;
+        T* const* _end;
+        const Scene* _scene;
+        bool _enabledOnly;
+    };
+
+    ComponentView(const std::vector<T*>& items, const Scene* scene, bool enabledOnly)
+        : _items(items), _scene(scene), _enabledOnly(enabledOnly) {}
+
+    Iterator begin() const { return Iterator(_items.data(), _items.data() + _items.size(), _scene, _enabledOnly); }
+    Iterator end() const { return Iterator(_items.data() + _items.size(), _items.data() + _items.size(), _scene, _enabledOnly); }
+
+private:
+    const std::vector<T*>& _items;
+    const Scene* _scene;
+    bool _enabledOnly;
+};
 
 class Scene
 {
@@ -18,21 +63,63 @@ public:
     // 获取所有对象 (供 Renderer 遍历)
     const std::vector<std::unique_ptr<GameObject>>& getGameObjects() const { return _gameObjects; }
 
-    // 添加一个已经创建好的对象
-    void addGameObject(std::unique_ptr<GameObject> go) {
-        _gameObjects.push_back(std::move(go));
+    // 按类型遍历场景中的组件，例如 for (MeshComponent& mesh : scene.view<MeshComponent>())
+    // 组件的物体通过 owner 取得 (变换等)
+    // 渲染快照的组件不在 ComponentPool 中，遍历快照自己的列表
+    template <typename T>
+    ComponentView<T> view(bool enabledOnly = true) const {
+        if (_isSnapshot) return ComponentView<T>(std::get<std::vector<T*>>(_snapshotComponents), this, enabledOnly);
+        return ComponentView<T>(ComponentPool<T>::Get().items(), this, enabledOnly);
     }
 
-    // 删除指定对象
-    void removeGameObject(GameObject* go) {
-        _gameObjects.erase(
-            std::remove_if(_gameObjects.begin(), _gameObjects.end(),
-                [go](const std::unique_ptr<GameObject>& p) { return p.get() == go; }),
-            _gameObjects.end());
-    }
+    // 添加一个已经创建好的对象 (分配句柄)；槽位耗尽时丢弃并返回空
+    GameObject* addGameObject(std::unique_ptr<GameObject> go);
+
+    // 立即删除指定对象 (连同它的所有子对象)
+    void removeGameObject(GameObject* go);
+
+    // 清空场景 (所有旧句柄失效)
+    void clear();
+
+    // --- 渲染快照 ---
+
+    // 把渲染需要的状态拷贝进 snapshot (先清空它)：带组件的对象连同世界矩阵、组件参数与环境设置，
+    // 拷贝与原对象的实例 ID / 句柄相同，但不占用 snapshot 的槽位，snapshot 只用于渲染。
+    // 返回 selected 在快照中的拷贝 (它没有组件时为空)
+    GameObject* captureRenderState(Scene& snapshot, const GameObject* selected = nullptr) const;
+
+    // 把渲染器写在快照组件上的结果 (LOD 选择与尺寸剔除) 写回仍然存在的原组件
+    void applyRenderFeedback(const Scene& snapshot);
+
+    bool isSnapshot() const { return _isSnapshot; }
+
+    // 按句柄 / 实例 ID 查找 (O(1))，对象已销毁或句柄过期时返回空
+    GameObject* find(GameObjectHandle handle) const;
+    GameObject* findByInstanceID(int instanceId) const;
 
-    // 清空场景
-    void clear() { _gameObjects.clear(); }
+    bool isValid(GameObjectHandle handle) const { return find(handle) != nullptr; }
+
+    // --- 父子层级 ---
+
+    // 把 child 挂到 parent 下 (parent 为空则变回根对象)
+    // keepWorldTransform 时改写 child 的局部变换，使它在世界中的位置保持不变
+    // parent 是 child 自身或其子孙 (会形成环) 时拒绝并返回 false
+    bool setParent(GameObject* child, GameObject* parent, bool keepWorldTransform = true);
+
+    GameObject* getParent(const GameObject* go) const { return go ? find(go->_parent) : nullptr; }
+
+    // 重新计算所有对象的世界矩阵 (每帧渲染前调用一次)
+    // 层级按深度排成平铺数组 (父对象总在子对象之前)，一次线性遍历即可完成；
+    // 局部变换没变、父对象也没变的对象直接跳过，某一层对象很多时交给 JobSystem 并行计算
+    void updateWorldTransforms();
+
+    struct TransformStats {
+        size_t objects = 0;  // 层级中的对象数
+        size_t depth = 0;    // 最大深度 (层数)
+        size_t updated = 0;  // 上次更新实际重算的对象数
+        bool parallel = false;
+    };
+    const TransformStats& getTransformStats() const { return _transformStats; }
 
     SceneEnvironment& getEnvironment() { return _environment; }
     const SceneEnvironment& getEnvironment() const { return _environment; }
@@ -48,14 +135,14 @@ public:
     // 创建默认场景 (比如初始化一个太阳)
     void createDefaultScene();
 
+    // 标记为待删除 (在帧末 destroyMarkedObjects 时统一销毁)
     void markForDestruction(GameObject* go);
 
-    bool isMarkedForDestruction(GameObject* go) const {
-        if (!go) return false;
-        // 检查指针是否存在于 _killQueue 中
-        return std::find(_killQueue.begin(), _killQueue.end(), go) != _killQueue.end();
+    bool isMarkedForDestruction(const GameObject* go) const {
+        return contains(go) && go->_pendingDestroy;
     }
 
+    // 一次遍历销毁所有被标记的对象 (保持其余对象的顺序)，O(N)，与标记的数量无关
     void destroyMarkedObjects();
 
     // 导出当前场景为 OBJ
@@ -63,13 +150,77 @@ public:
 
     // 从 OBJ 导入场景（多个物体）
     void importScene(const std::string& filepath);
+
+    // 异步导入场景：解析在后台进行，物体按上传预算逐帧出现
+    std::shared_ptr<SceneImportJob> importSceneAsync(const std::string& filepath);
+
+    // [主线程] 每帧推进所有导入任务
+    void updateImports();
+
+    const std::vector<std::shared_ptr<SceneImportJob>>& getImportJobs() const { return _importJobs; }
+
+    // 每帧用于导入上传的字节预算
+    void setImportUploadBudget(size_t bytes) { _importUploadBudget = bytes; }
+    size_t getImportUploadBudget() const { return _importUploadBudget; }
+
+    // 把一个模型实例化为带 MeshComponent 的 GameObject 并加入场景
+    // 按 node.nodePath 在 hierarchy 的根对象下补齐节点对象，新物体挂在所属节点下
+    GameObject* instantiateMeshNode(const std::string& cleanPath, const SceneResource::Node& node, SceneImportHierarchy& hierarchy);
+
+    // 检查对象是否在场景中 (go 必须是存活的对象；可能已被销毁的对象请保存句柄，用 find 校验)
+    bool contains(const GameObject* go) const {
+        return go && go->_scene == this && find(go->_handle) == go;
+    }
     // 从 OBJ 导入单体
     void importSingleMeshFromOBJ(const std::string& filepath);
 
 private:
+    // 对象按加入顺序紧凑存放 (Hierarchy 的显示顺序)，句柄经槽位表映射到这里的下标
     std::vector<std::unique_ptr<GameObject>> _gameObjects;
 
+    struct ObjectSlot {
+        uint32_t denseIndex = 0;
+        uint32_t generation = 1;
+        bool alive = false;
+    };
+    std::vector<ObjectSlot> _slots;
+    std::vector<uint32_t> _freeSlots;
+    std::unordered_map<int, GameObjectHandle> _instanceIdToHandle;
+
     SceneEnvironment _environment;
 
-    std::vector<GameObject*> _killQueue;
+    size_t _pendingDestroyCount = 0;
+
+    // 槽位回收：代数加一 (跳过 0，保证有效句柄不为 0)
+    void releaseSlot(GameObjectHandle handle);
+
+    // 按深度排序的层级数组 (SoA)，层级结构变化时整体重建
+    // levelOffsets[d] ~ levelOffsets[d + 1] 是深度 d 的对象，同一层之间互不依赖
+    struct TransformHierarchy {
+        std::vector<GameObject*> objects;
+        std::vector<int32_t> parents;        // 父对象在本数组中的下标，根为 -1
+        std::vector<uint32_t> levelOffsets;  // 末尾为对象总数
+        std::vector<glm::vec3> positions;    // 上次计算时的局部 TRS，用于检测变化
+        std::vector<glm::quat> rotations;
+        std::vector<glm::vec3> scales;
+        std::vector<glm::mat4> worlds;
+        std::vector<uint8_t> dirty;          // 本次是否重算 (子对象据此得知父对象变了)
+    };
+    TransformHierarchy _hierarchy;
+    bool _hierarchyChanged = true;
+    TransformStats _transformStats;
+
+    void rebuildHierarchy();
+    size_t updateTransformRange(size_t begin, size_t end, bool force);
+
+    std::vector<std::shared_ptr<SceneImportJob>> _importJobs;
+    size_t _importUploadBudget = 32 * 1024 * 1024;
+
+    // 渲染快照：各类组件的拷贝 (按原组件的创建顺序)
+    bool _isSnapshot = false;
+    std::tuple<std::vector<MeshComponent*>, std::vector<LightComponent*>,
+               std::vector<ReflectionProbeComponent*>, std::vector<PlanarReflectionComponent*>> _snapshotComponents;
+
+    template <typename T>
+    void captureComponents(Scene& snapshot, std::vector<GameObject*>& copies) const;
 };
\ No newline at end of file
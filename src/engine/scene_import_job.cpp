@@ -0,0 +1,172 @@
+#include "scene_import_job.h"
+#include "scene.h"
+
+#include <filesystem>
+#include <iostream>
+
+SceneImportJob::SceneImportJob(const std::string& path, bool useFlatShade)
+    : _cleanPath(AssetKey::normalizePath(path)), _useFlatShade(useFlatShade)
+{
+}
+
+void SceneImportJob::start()
+{
+    // 缓存里已有完整场景：跳过解析，直接进入上传阶段
+    if (auto cached = ResourceManager::Get().findSceneResource(_cleanPath, _useFlatShade)) {
+        std::lock_guard<std::mutex> lock(_readyMutex);
+        for (const auto& node : cached->nodes) _ready.push_back(node);
+        _total = static_cast<int>(cached->nodes.size());
+        _parseFinished = true;
+        return;
+    }
+
+    // 根目录与完整路径在主线程取好，工作线程不再读 ResourceManager 的根目录
+    _projectRoot = ResourceManager::Get().getProjectRoot();
+    _fullPath = ResourceManager::Get().getFullPath(_cleanPath);
+
+    auto self = shared_from_this();
+    ResourceManager::Get().getWorkers().enqueue([self]() { self->runWorker(); });
+}
+
+void SceneImportJob::runWorker()
+{
+    const std::string& fullPath = _fullPath;
+
+    try {
+        if (!std::filesystem::exists(fullPath)) {
+            std::cerr << "[SceneImport] Error: Scene file not found: " << fullPath << std::endl;
+            _parseFailed = true;
+            _parseFinished = true;
+            return;
+        }
+
+        // 1. 解析 (OBJ/glTF 的法线与切线生成都在 loader 内部完成，网格缓存命中时直接读缓存)
+        std::vector<SubMesh> subMeshes = ResourceManager::Get().loadSceneMeshes(_projectRoot, fullPath, _useFlatShade);
+        if (_cancelRequested) { _parseFinished = true; return; }
+
+        _total = static_cast<int>(subMeshes.size());
+
+        // 2. 逐个构建 Model (包围盒在构造函数中计算)，构建一个就交给主线程一个
+        for (auto& sub : subMeshes)
+        {
+            if (_cancelRequested) break;
+
+            // 数据直接移交给 Model (内容与已加载的网格相同时共享同一份几何数据)
+            auto model = ResourceManager::Get().createModel(std::move(sub.vertices), std::move(sub.indices),
+                                                            MeshSourceInfo{ fullPath, sub.name, _useFlatShade, true },
+                                                            std::move(sub.lods), std::move(sub.clusters));
+
+            std::lock_guard<std::mutex> lock(_readyMutex);
+            _ready.push_back({ sub.name, model, std::move(sub.nodePath) });
+        }
+
+        if (subMeshes.empty()) _parseFailed = true;
+    }
+    catch (std::exception& e) {
+        std::cerr << "[SceneImport] Failed to load scene: " << e.what() << std::endl;
+        _parseFailed = true;
+    }
+
+    _parseFinished = true;
+}
+
+size_t SceneImportJob::pump(Scene& scene, size_t budgetBytes)
+{
+    if (isFinished()) return 0;
+
+    // 1. 处理取消：回滚已实例化的物体
+    if (_cancelRequested) {
+        if (GameObject* root = scene.find(_hierarchy.root)) scene.markForDestruction(root);
+        _hierarchy = SceneImportHierarchy();
+        {
+            std::lock_guard<std::mutex> lock(_readyMutex);
+            _ready.clear();
+        }
+        // 等工作线程确认退出后再标记为已取消
+        if (_parseFinished) {
+            _stage = Stage::Cancelled;
+            std::cout << "[SceneImport] Cancelled: " << _cleanPath << std::endl;
+        }
+        return 0;
+    }
+
+    // 2. 在预算内上传并实例化
+    size_t usedBytes = 0;
+    while (true)
+    {
+        SceneResource::Node node;
+        {
+            std::lock_guard<std::mutex> lock(_readyMutex);
+            if (_ready.empty()) break;
+
+            // 至少处理一个，之后超出预算就留到下一帧
+            size_t nextBytes = _ready.front().model->getGpuByteSize();
+            if (usedBytes > 0 && usedBytes + nextBytes > budgetBytes) break;
+
+            node = std::move(_ready.front());
+            _ready.pop_front();
+        }
+
+        usedBytes += node.model->getGpuByteSize();
+        node.model->initGL();
+
+        scene.instantiateMeshNode(_cleanPath, node, _hierarchy);
+        _result->nodes.push_back(node);
+        _uploaded++;
+    }
+
+    // 3. 检查是否全部完成
+    bool parseDone = _parseFinished;
+    bool queueEmpty;
+    {
+        std::lock_guard<std::mutex> lock(_readyMutex);
+        queueEmpty = _ready.empty();
+    }
+
+    if (!parseDone) {
+        _stage = Stage::Parsing;
+        return usedBytes;
+    }
+
+    if (!queueEmpty) {
+        _stage = Stage::Uploading;
+        return usedBytes;
+    }
+
+    if (_parseFailed || _result->nodes.empty()) {
+        _stage = Stage::Failed;
+        std::cout << "[SceneImport] Failed to load or empty scene: " << _cleanPath << std::endl;
+        return usedBytes;
+    }
+
+    // 全部驻留后统一写入缓存
+    ResourceManager::Get().injectSceneResource(_cleanPath, _useFlatShade, _result);
+    _stage = Stage::Done;
+    std::cout << "[SceneImport] Instantiated " << _result->nodes.size() << " objects from " << _cleanPath << std::endl;
+    return usedBytes;
+}
+
+bool SceneImportJob::isFinished() const
+{
+    Stage s = _stage;
+    return s == Stage::Done || s == Stage::Cancelled || s == Stage::Failed;
+}
+
+std::string SceneImportJob::getStageName() const
+{
+    switch (_stage.load()) {
+    case Stage::Parsing:   return "Parsing";
+    case Stage::Uploading: return "Uploading";
+    case Stage::Done:      return "Done";
+    case Stage::Cancelled: return "Cancelled";
+    case Stage::Failed:    return "Failed";
+    }
+    return "";
+}
+
+float SceneImportJob::getProgress() const
+{
+    int total = _total;
+    if (total <= 0) return 0.0f;
+    return static_cast<float>(_uploaded) / static_cast<float>(total);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/resource_manager.h"
+#include "engine/scene_object.h"
+
+class Scene;
+
+// 实例化导入场景时的层级状态：所有物体挂在一个以文件命名的根对象下 (整体移动)，
+// glTF 节点按 id 只创建一次，同一节点的多个 primitive 成为它的子对象
+struct SceneImportHierarchy
+{
+    GameObjectHandle root;
+    std::unordered_map<int, GameObjectHandle> nodes;
+};
+
+// 异步场景导入任务
+// 阶段划分：
+//   [工作线程] 解析文件 (含法线/切线生成) -> 逐个子网格构建 Model (计算包围盒)
+//   [主线程]   每帧在字节预算内 initGL 上传已完成的子网格，并实例化为 GameObject
+// 这样大文件导入期间窗口保持响应，物体会陆续出现在场景中。
+class SceneImportJob : public std::enable_shared_from_this<SceneImportJob>
+{
+public:
+    enum class Stage
+    {
+        Parsing,    // 工作线程解析中
+        Uploading,  // 解析完毕，主线程仍在上传
+        Done,
+        Cancelled,
+        Failed
+    };
+
+    SceneImportJob(const std::string& path, bool useFlatShade);
+
+    // 把解析任务投递到 ResourceManager 的工作线程
+    // 任务对象必须由 shared_ptr 持有 (工作线程会延长它的生命周期)
+    void start();
+
+    // [主线程] 每帧调用：上传不超过 budgetBytes 字节的子网格 (至少一个)，并实例化到场景
+    // 返回本次实际上传的字节数
+    size_t pump(Scene& scene, size_t budgetBytes);
+
+    // 请求取消：工作线程尽快停止，已实例化的物体会被移除
+    void cancel() { _cancelRequested = true; }
+
+    Stage getStage() const { return _stage; }
+    bool isFinished() const;
+
+    const std::string& getPath() const { return _cleanPath; }
+    std::string getStageName() const;
+
+    // 进度 [0, 1]：以已上传的子网格数为准
+    float getProgress() const;
+    int getTotalCount() const { return _total; }
+    int getUploadedCount() const { return _uploaded; }
+
+private:
+    std::string _cleanPath;
+    bool _useFlatShade = false;
+    std::string _projectRoot; // start() 时的项目根目录 (工作线程只读这份拷贝)
+    std::string _fullPath;
+
+    std::atomic<Stage> _stage{ Stage::Parsing };
+    std::atomic<bool> _cancelRequested{ false };
+    std::atomic<bool> _parseFinished{ false };
+    std::atomic<bool> _parseFailed{ false };
+    std::atomic<int> _total{ 0 };
+    int _uploaded = 0;
+
+    // 工作线程产出、主线程消费的子网格队列
+    std::mutex _readyMutex;
+    std::deque<SceneResource::Node> _ready;
+
+    // 最终写入缓存的场景资源 (主线程独占)
+    std::shared_ptr<SceneResource> _result = std::make_shared<SceneResource>();
+
+    // 本任务实例化出的层级 (取消时销毁根对象即整体回滚)
+    SceneImportHierarchy _hierarchy;
+
+    void runWorker();
+};
@@ -1,4 +1,5 @@
 #include "scene_object.h"
+#include "render_thread.h"
 #include <glad/gl.h> // 只有这里需要包含 OpenGL 头文件，净化了头文件
 #include <iostream>
 
@@ -23,6 +24,13 @@ MeshComponent::MeshComponent(std::shared_ptr<Model> m, bool gizmo)
 
 void MeshComponent::setMesh(std::shared_ptr<Model> newModel) {
     if (newModel) model = newModel;
+    lodLevel = 0;
+    lodCulled = false;
+}
+
+int MeshComponent::getLodLevel(int bias) const {
+    if (!model) return 0;
+    return std::max(0, std::min(lodLevel + bias, model->getLodCount() - 1));
 }
 
 // ==========================================
@@ -34,9 +42,16 @@ LightComponent::LightComponent(LightType t) : type(t) {}
 // ReflectionProbeComponent
 // ==========================================
 ReflectionProbeComponent::~ReflectionProbeComponent() {
-    if (textureID) glDeleteTextures(1, &textureID);
-    if (fboID) glDeleteFramebuffers(1, &fboID);
-    if (rboID) glDeleteRenderbuffers(1, &rboID);
+    if (isSnapshotCopy()) return;
+
+    // FBO 不在上下文之间共享，在 UI 线程上删除组件时推迟到帧边界
+    GLuint texture = textureID, fbo = fboID, rbo = rboID;
+    if (!texture && !fbo && !rbo) return;
+    RenderThread::Get().runOnRenderContext([texture, fbo, rbo]() {
+        if (texture) glDeleteTextures(1, &texture);
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (rbo) glDeleteRenderbuffers(1, &rbo);
+    });
 }
 
 void ReflectionProbeComponent::initGL() {
@@ -76,9 +91,15 @@ void ReflectionProbeComponent::initGL() {
 // PlanarReflectionComponent
 // ==========================================
 PlanarReflectionComponent::~PlanarReflectionComponent() {
-    if (textureID) glDeleteTextures(1, &textureID);
-    if (fboID) glDeleteFramebuffers(1, &fboID);
-    if (rboID) glDeleteRenderbuffers(1, &rboID);
+    if (isSnapshotCopy()) return;
+
+    GLuint texture = textureID, fbo = fboID, rbo = rboID;
+    if (!texture && !fbo && !rbo) return;
+    RenderThread::Get().runOnRenderContext([texture, fbo, rbo]() {
+        if (texture) glDeleteTextures(1, &texture);
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (rbo) glDeleteRenderbuffers(1, &rbo);
+    });
 }
 
 void PlanarReflectionComponent::initGL() {
@@ -117,11 +138,43 @@ void PlanarReflectionComponent::initGL() {
 // ==========================================
 GameObject::GameObject(const std::string &n) : name(n), _instanceId(IDGenerator::generate()) {}
 
+GameObject::GameObject(const GameObject &source, Scene *snapshot)
+    : name(source.name), transform(source.transform), _instanceId(source._instanceId),
+      _scene(snapshot), _handle(source._handle), _parent(source._parent), _worldMatrix(source._worldMatrix) {}
+
+GameObject::~GameObject()
+{
+    for (Component *comp : _components) comp->_release(comp);
+}
+
+glm::quat GameObject::getWorldRotation() const
+{
+    // 去掉各轴缩放后再取旋转
+    glm::mat3 m(_worldMatrix);
+    for (int i = 0; i < 3; ++i) {
+        float len = glm::length(m[i]);
+        if (len > 0.0f) m[i] /= len;
+    }
+    return glm::normalize(glm::quat_cast(m));
+}
+
 void GameObject::removeComponent(Component *comp)
 {
-    components.erase(
-        std::remove_if(components.begin(), components.end(),
-                        [comp](const std::unique_ptr<Component> &p)
-                        { return p.get() == comp; }),
-        components.end());
+    auto it = std::find(_components.begin(), _components.end(), comp);
+    if (it == _components.end()) return;
+    _components.erase(it);
+
+    // 槽位指向被删除的组件时，换成剩下的同类组件中最早添加的那个
+    size_t type = static_cast<size_t>(comp->getType());
+    if (_slots[type] == comp) {
+        _slots[type] = nullptr;
+        for (Component *other : _components) {
+            if (static_cast<size_t>(other->getType()) == type) {
+                _slots[type] = other;
+                break;
+            }
+        }
+    }
+
+    comp->_release(comp);
 }
\ No newline at end of file
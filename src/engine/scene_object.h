@@ -4,16 +4,20 @@
 #include <memory>
 #include <string>
 #include <algorithm>
+#include <array>
 #include <iostream>
 #include <atomic>
+#include <cstdint>
 
 #include "base/transform.h"
 #include "base/texture2d.h"
 #include "engine/model.h"
 #include "light_structs.h"
+#include "component_pool.h"
 
 // 前置声明
 class GameObject;
+class Scene;
 
 enum class MeshShapeType
 {
@@ -38,6 +42,8 @@ enum class ComponentType
     PlanarReflection
 };
 
+constexpr size_t kComponentTypeCount = 4;
+
 enum class LightType
 {
     Directional,
@@ -102,6 +108,18 @@ public:
 
 protected:
     int _instanceId;
+
+    // 是否是渲染快照中的拷贝 (与原组件共用 GL 资源，不负责释放)
+    bool isSnapshotCopy() const { return _snapshotCopy; }
+
+private:
+    template <typename T> friend class ComponentPool;
+    friend class GameObject;
+
+    // 在所属 ComponentPool 中的位置，以及释放回池的函数 (创建时由池填写)
+    size_t _poolIndex = 0;
+    void (*_release)(Component*) = nullptr;
+    bool _snapshotCopy = false;
 };
 
 // ==========================================
@@ -122,6 +140,11 @@ public:
     std::shared_ptr<ImageTexture2D> roughnessMap; // 独立粗糙度 (Roughness)
     std::shared_ptr<ImageTexture2D> metallicMap;  // 独立金属度 (Metallic)
 
+    // [运行时] 三张独立贴图齐全时由 ResourceManager 自动打包出的 ORM，渲染时替代它们
+    // packedOrmSources 记录打包时的输入，任意一张被替换后会重新请求
+    std::shared_ptr<ImageTexture2D> packedOrmMap;
+    std::shared_ptr<ImageTexture2D> packedOrmSources[3];
+
     std::shared_ptr<ImageTexture2D> emissiveMap; // 自发光贴图
     std::shared_ptr<ImageTexture2D> opacityMap; // 透明度贴图
     Material material;
@@ -171,11 +194,18 @@ public:
     MeshShapeType shapeType = MeshShapeType::Cube;
     MeshParams params;
 
+    // [运行时] 主相机按投影尺寸选出的 LOD 与尺寸剔除结果 (Renderer 每帧更新，切换带滞后)
+    int lodLevel = 0;
+    bool lodCulled = false;
+
     MeshComponent(std::shared_ptr<Model> m, bool gizmo = false);
 
     ComponentType getType() const override { return Type; }
 
     void setMesh(std::shared_ptr<Model> newModel);
+
+    // 在主视图的级别上再粗 bias 级 (阴影、反射探针)，不超过模型实际的级别数
+    int getLodLevel(int bias = 0) const;
 };
 
 // ==========================================
@@ -245,7 +275,7 @@ public:
     glm::vec3 boxSize = glm::vec3(10.0f, 10.0f, 10.0f);
 
     ReflectionProbeComponent() = default;
-    ~ReflectionProbeComponent(); // 析构移到 cpp (因为它包含 glDelete)
+    ~ReflectionProbeComponent(); // 析构移到 cpp (因为它包含 glDelete，交给渲染上下文执行)
 
     void initGL(); // 核心逻辑移到 cpp
     ComponentType getType() const override { return Type; }
@@ -270,7 +300,7 @@ public:
     unsigned int rboID = 0;     // 深度缓冲 (渲染时需要深度测试)
 
     PlanarReflectionComponent() = default;
-    ~PlanarReflectionComponent(); // 负责释放 GL 资源
+    ~PlanarReflectionComponent(); // 负责释放 GL 资源 (交给渲染上下文执行)
 
     void initGL(); // 初始化 FBO 和 Texture
 
@@ -280,43 +310,109 @@ public:
 // ==========================================
 // 5. 游戏对象
 // ==========================================
+
+// 场景对象句柄 (32 位)：低 20 位为 Scene 中的槽位索引，高 12 位为槽位的代数 (generation)
+// 对象销毁后槽位代数加一，旧句柄随之失效，不会像裸指针那样悬空；0 为空句柄
+struct GameObjectHandle
+{
+    static constexpr uint32_t kIndexBits = 20;
+    static constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1;
+    static constexpr uint32_t kGenerationMask = (1u << (32 - kIndexBits)) - 1;
+
+    uint32_t value = 0;
+
+    GameObjectHandle() = default;
+    GameObjectHandle(uint32_t index, uint32_t generation) : value((generation << kIndexBits) | index) {}
+
+    uint32_t getIndex() const { return value & kIndexMask; }
+    uint32_t getGeneration() const { return value >> kIndexBits; }
+    bool isNull() const { return value == 0; }
+
+    bool operator==(const GameObjectHandle& other) const { return value == other.value; }
+    bool operator!=(const GameObjectHandle& other) const { return value != other.value; }
+};
+
+// 组件本身存放在按类型划分的 ComponentPool 中，GameObject 只记录指向它们的句柄：
+// 按添加顺序的列表 (Inspector 显示用) 与按类型索引的槽位 (getComponent 直接取，无需扫描和虚调用)
+// transform 是相对父对象的局部变换；渲染用的世界矩阵由 Scene::updateWorldTransforms 统一计算
 class GameObject
 {
 public:
     std::string name;
     Transform transform;
-    std::vector<std::unique_ptr<Component>> components;
 
     GameObject(const std::string &n);
+    ~GameObject();
+
+    GameObject(const GameObject &) = delete;
+    GameObject &operator=(const GameObject &) = delete;
 
     int getInstanceID() const { return _instanceId; }
 
+    // 所在的场景与在其中的句柄 (由 Scene 加入时设置；还未加入时为空)
+    Scene *getScene() const { return _scene; }
+    GameObjectHandle getHandle() const { return _handle; }
+
+    // 父子层级 (通过 Scene::setParent 修改)；父对象为空句柄时是根对象
+    GameObjectHandle getParent() const { return _parent; }
+    const std::vector<GameObjectHandle> &getChildren() const { return _children; }
+
+    // 世界变换 (上一次 Scene::updateWorldTransforms 的结果)
+    const glm::mat4 &getWorldMatrix() const { return _worldMatrix; }
+    glm::vec3 getWorldPosition() const { return glm::vec3(_worldMatrix[3]); }
+    glm::quat getWorldRotation() const;
+
     template <typename T, typename... Args>
     T *addComponent(Args &&...args)
     {
-        auto comp = std::make_unique<T>(std::forward<Args>(args)...);
+        T *comp = ComponentPool<T>::Get().create(std::forward<Args>(args)...);
         comp->owner = this;
-        T *ptr = comp.get();
-        components.push_back(std::move(comp));
-        return ptr;
+        _components.push_back(comp);
+
+        // 同类组件有多个时，getComponent 返回最早添加的那个
+        Component *&slot = _slots[static_cast<size_t>(T::Type)];
+        if (!slot) slot = comp;
+        return comp;
     }
 
     template <typename T>
-    T *getComponent()
+    T *getComponent() const
     {
-        for (auto &comp : components)
-        {
-            if (comp->getType() == T::Type)
-            {
-                // 安全的向下转型 (因为我们已经确认了类型)
-                return static_cast<T *>(comp.get());
-            }
-        }
-        return nullptr;
+        return static_cast<T *>(_slots[static_cast<size_t>(T::Type)]);
     }
 
+    const std::vector<Component *> &getComponents() const { return _components; }
+
     void removeComponent(Component *comp);
 
 private:
+    friend class Scene;
+
+    // 渲染快照用的拷贝：实例 ID、句柄、变换与世界矩阵和 source 相同，属于 snapshot 场景，不带组件
+    GameObject(const GameObject &source, Scene *snapshot);
+
+    // 把组件拷贝一份挂到本对象上 (不进入 ComponentPool，随对象一起释放)
+    template <typename T>
+    T *attachCopy(const T &source)
+    {
+        T *comp = new T(source);
+        comp->owner = this;
+        comp->_snapshotCopy = true;
+        comp->_release = [](Component *c) { delete static_cast<T *>(c); };
+        _components.push_back(comp);
+
+        Component *&slot = _slots[static_cast<size_t>(T::Type)];
+        if (!slot) slot = comp;
+        return comp;
+    }
+
     int _instanceId;
+    Scene *_scene = nullptr;
+    GameObjectHandle _handle;
+    bool _pendingDestroy = false;
+    GameObjectHandle _parent;
+    std::vector<GameObjectHandle> _children;
+    glm::mat4 _worldMatrix = glm::mat4(1.0f);
+    std::vector<Component *> _components;
+    std::array<Component *, kComponentTypeCount> _slots{};
 };
@@ -1,4 +1,5 @@
 #include "shadow_map_pass.h"
+#include <algorithm>
 #include <iostream>
 
 ShadowMapPass::ShadowMapPass(int resolution, int maxLights) 
@@ -13,6 +14,7 @@ ShadowMapPass::ShadowMapPass(int resolution, int maxLights)
 
     // 预分配矩阵空间: 灯光数 * 每灯层数
     _lightSpaceMatrices.resize(_maxLights * _layerCountPerLight);
+    _cascadeCasters.resize(_layerCountPerLight, 0);
 
     initShader();
     initFBO();
@@ -70,7 +72,22 @@ void ShadowMapPass::initFBO()
 
 void ShadowMapPass::initShader()
 {
-    // 极简 Vertex Shader：把顶点变换到光空间
+    // 极简 Vertex Shader：只读位置流，把顶点变换到光空间
+    const char* depthVsCode = R"(
+        #version 330 core
+        layout (location = 0) in vec3 aPos;
+
+        uniform mat4 lightSpaceMatrix;
+        uniform mat4 model;
+        uniform vec3 positionScale = vec3(1.0);   // 量化位置的解码参数 (见 VertexPacking)
+        uniform vec3 positionOffset = vec3(0.0);
+
+        void main() {
+            gl_Position = lightSpaceMatrix * model * vec4(aPos * positionScale + positionOffset, 1.0);
+        }
+    )";
+
+    // 带 Normal Bias 的版本：需要法线，读完整顶点
     const char* vsCode = R"(
         #version 330 core
         layout (location = 0) in vec3 aPos;
@@ -80,13 +97,29 @@ void ShadowMapPass::initShader()
         uniform mat4 model;
         uniform float normalBias;
 
+        // 压缩顶点格式的解码参数 (见 VertexPacking)
+        uniform bool packedVertex = false;
+        uniform vec3 positionScale = vec3(1.0);
+        uniform vec3 positionOffset = vec3(0.0);
+
+        vec3 octDecode(vec2 e) {
+            vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+            float t = max(-n.z, 0.0);
+            n.x += n.x >= 0.0 ? -t : t;
+            n.y += n.y >= 0.0 ? -t : t;
+            return normalize(n);
+        }
+
         void main() {
+            vec3 position = aPos * positionScale + positionOffset;
+            vec3 normal = packedVertex ? octDecode(aNormal.xy) : aNormal;
+
             // 1. 计算世界空间位置
-            vec3 posWS = vec3(model * vec4(aPos, 1.0));
+            vec3 posWS = vec3(model * vec4(position, 1.0));
             
             // 2. 计算世界空间法线 (简化计算，假设没有非均匀缩放，或者在CPU传NormalMatrix)
             // 为了性能，且在ShadowPass，我们简单用 model 旋转部分
-            vec3 normWS = normalize(mat3(model) * aNormal);
+            vec3 normWS = normalize(mat3(model) * normal);
 
             // 3. [核心] 应用 Normal Bias
             // 沿着法线反方向向内收缩顶点
@@ -106,12 +139,18 @@ void ShadowMapPass::initShader()
     )";
 
     _depthShader.reset(new GLSLProgram);
-    _depthShader->attachVertexShader(vsCode);
+    _depthShader->attachVertexShader(depthVsCode);
     _depthShader->attachFragmentShader(fsCode);
     _depthShader->link();
+
+    _normalBiasShader.reset(new GLSLProgram);
+    _normalBiasShader->attachVertexShader(vsCode);
+    _normalBiasShader->attachFragmentShader(fsCode);
+    _normalBiasShader->link();
 }
 
-void ShadowMapPass::render(const Scene& scene, const std::vector<ShadowCasterInfo>& casters, Camera* camera)
+void ShadowMapPass::render(const Scene& scene, const FrameVector<ShadowCasterInfo>& casters, Camera* camera, int lodBias,
+                           bool clusterCulling, bool coneCulling)
 {
     // 1. 重置矩阵列表
     // 注意：我们不 clear() 而是 resize，或者直接覆盖，保持大小一致
@@ -135,7 +174,6 @@ void ShadowMapPass::render(const Scene& scene, const std::vector<ShadowCasterInf
     // 2. 准备渲染
     glBindFramebuffer(GL_FRAMEBUFFER, _fbo);
     glViewport(0, 0, _resolution, _resolution);
-    _depthShader->use();
 
     // 为了安全，先清除所有层（或者只清除用到的层）
     // 为了性能，我们可以在下面的循环中 glClear，但需要注意 GL 状态
@@ -143,6 +181,8 @@ void ShadowMapPass::render(const Scene& scene, const std::vector<ShadowCasterInf
     // 必须在循环里 Clear
 
     int lightCount = std::min((int)casters.size(), _maxLights);
+    std::fill(_cascadeCasters.begin(), _cascadeCasters.end(), 0);
+    _culledCasters = 0;
 
     // --- 双重循环：遍历所有光源 ---
     for (int lightIdx = 0; lightIdx < lightCount; ++lightIdx)
@@ -150,7 +190,11 @@ void ShadowMapPass::render(const Scene& scene, const std::vector<ShadowCasterInf
         const auto& caster = casters[lightIdx];
 
         // 设置当前光源的参数
-        _depthShader->setUniformFloat("normalBias", caster.shadowNormalBias);
+        // 不需要 Normal Bias 时只读位置流 (带宽约为完整顶点的 1/4)
+        bool useNormalBias = caster.shadowNormalBias > 0.0f;
+        GLSLProgram* shader = useNormalBias ? _normalBiasShader.get() : _depthShader.get();
+        shader->use();
+        if (useNormalBias) shader->setUniformFloat("normalBias", caster.shadowNormalBias);
         glEnable(GL_CULL_FACE);
         glCullFace(caster.cullFaceMode);
 
@@ -175,20 +219,39 @@ void ShadowMapPass::render(const Scene& scene, const std::vector<ShadowCasterInf
             glClear(GL_DEPTH_BUFFER_BIT);
 
             // 5. 提交矩阵并绘制
-            _depthShader->setUniformMat4("lightSpaceMatrix", matrix);
+            shader->setUniformMat4("lightSpaceMatrix", matrix);
+
+            // 级联是正交投影，视线方向即光线方向；剔除正面时留下的是背对光源的三角形，方向取反
+            Frustum cascadeFrustum = Frustum::createFromMatrix(matrix);
+            ClusterCullView clusterView;
+            clusterView.frustum = &cascadeFrustum;
+            clusterView.orthographic = true;
+            clusterView.coneCulling = coneCulling && (caster.cullFaceMode == GL_BACK || caster.cullFaceMode == GL_FRONT);
+            clusterView.direction = glm::normalize(caster.direction) * (caster.cullFaceMode == GL_FRONT ? -1.0f : 1.0f);
 
             // 绘制场景
-            for (const auto& go : scene.getGameObjects()) {
-                auto meshComp = go->getComponent<MeshComponent>();
-                if (!meshComp || !meshComp->enabled) continue;
+            for (MeshComponent& mesh : scene.view<MeshComponent>()) {
+                MeshComponent* meshComp = &mesh;
+                GameObject* go = mesh.owner;
                 if (meshComp->isGizmo) continue;
 
-                glm::mat4 model = go->transform.getLocalMatrix();
+                glm::mat4 model = go->getWorldMatrix();
                 // 叠加 model 自身的 local matrix (如果有)
                 if (meshComp->model) {
                      model = model * meshComp->model->transform.getLocalMatrix();
-                     _depthShader->setUniformMat4("model", model);
-                     meshComp->model->draw();
+                     shader->setUniformMat4("model", model);
+                     meshComp->model->setVertexDecodeUniforms(*shader);
+                     int lod = meshComp->getLodLevel(lodBias);
+                     if (clusterCulling && meshComp->model->cullClusters(lod, model, clusterView, _clusterDrawList)) {
+                         if (_clusterDrawList.visibleClusters == 0) {
+                             _culledCasters++;
+                             continue;
+                         }
+                         meshComp->model->drawClusters(_clusterDrawList, !useNormalBias);
+                     }
+                     else if (useNormalBias) meshComp->model->draw(lod);
+                     else meshComp->model->drawDepth(lod);
+                     _cascadeCasters[cascadeIdx]++;
                 }
             }
         }
@@ -199,11 +262,12 @@ void ShadowMapPass::render(const Scene& scene, const std::vector<ShadowCasterInf
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
-std::vector<glm::vec4> ShadowMapPass::getFrustumCornersWorldSpace(const glm::mat4& proj, const glm::mat4& view)
+std::array<glm::vec4, 8> ShadowMapPass::getFrustumCornersWorldSpace(const glm::mat4& proj, const glm::mat4& view)
 {
     const auto inv = glm::inverse(proj * view);
     
-    std::vector<glm::vec4> frustumCorners;
+    std::array<glm::vec4, 8> frustumCorners;
+    size_t count = 0;
     for (unsigned int x = 0; x < 2; ++x) {
         for (unsigned int y = 0; y < 2; ++y) {
             for (unsigned int z = 0; z < 2; ++z) {
@@ -212,7 +276,7 @@ std::vector<glm::vec4> ShadowMapPass::getFrustumCornersWorldSpace(const glm::mat
                     2.0f * y - 1.0f,
                     2.0f * z - 1.0f,
                     1.0f);
-                frustumCorners.push_back(pt / pt.w);
+                frustumCorners[count++] = pt / pt.w;
             }
         }
     }
@@ -241,7 +305,7 @@ glm::mat4 ShadowMapPass::getLightSpaceMatrix(const float nearPlane, const float
     for (const auto& v : corners) {
         center += glm::vec3(v);
     }
-    center /= corners.size();
+    center /= (float)corners.size();
 
     // 4. 构建光照视图矩阵
     // 注意：这里的位置其实不重要，重要的是方向。我们将位置定在中心逆光方向远处
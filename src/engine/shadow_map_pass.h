@@ -1,6 +1,7 @@
 #pragma once
 
 #include <glad/gl.h>
+#include <array>
 #include <memory>
 #include <vector>
 #include <glm/glm.hpp>
@@ -9,6 +10,8 @@
 #include "base/glsl_program.h"
 #include "scene.h"
 #include "base/camera.h"
+#include "mesh_clusters.h"
+#include "engine/utils/frame_arena.h"
 
 struct ShadowCasterInfo {
     glm::vec3 direction;
@@ -25,7 +28,10 @@ public:
     ~ShadowMapPass();
 
     // 核心渲染函数：接收光源列表
-    void render(const Scene& scene, const std::vector<ShadowCasterInfo>& casters, Camera* camera);
+    // lodBias: 在主视图选出的 LOD 上再粗几级 (阴影分辨率有限，细节看不出来)
+    // clusterCulling: 有网格簇的模型按每个级联的视锥逐簇剔除 (coneCulling 时再按光线方向做法线锥剔除)
+    void render(const Scene& scene, const FrameVector<ShadowCasterInfo>& casters, Camera* camera, int lodBias = 0,
+                bool clusterCulling = false, bool coneCulling = false);
 
     GLuint getDepthMapArray() const { return _depthMap; }
 
@@ -36,6 +42,11 @@ public:
     const std::vector<float>& getCascadeLevels() const { return _cascadeLevels; }
     int getCascadeCount() const { return (int)_cascadeLevels.size() + 1; } // +1 因为最后一层是 zFar
 
+    // 上一次 render 中每一级级联画出的投射者 (所有光源之和，整个网格的簇都被剔除时不计)
+    const std::vector<int>& getCascadeCasterCounts() const { return _cascadeCasters; }
+    // 上一次 render 中逐簇剔除后整个跳过的投射者 (所有光源与级联之和)
+    int getCulledCasterCount() const { return _culledCasters; }
+
 private:
     int _resolution;
     int _maxLights;
@@ -47,13 +58,19 @@ private:
     // 存储所有光源的矩阵
     std::vector<glm::mat4> _lightSpaceMatrices;
     std::vector<float> _cascadeLevels; 
+    std::vector<int> _cascadeCasters;
+    int _culledCasters = 0;
+
+    ClusterDrawList _clusterDrawList;
     
+    // 只读位置流的深度着色器；Normal Bias 不为 0 的光源需要法线，改用完整顶点的版本
     std::unique_ptr<GLSLProgram> _depthShader;
+    std::unique_ptr<GLSLProgram> _normalBiasShader;
 
     void initFBO();
     void initShader();
 
-    std::vector<glm::vec4> getFrustumCornersWorldSpace(const glm::mat4& proj, const glm::mat4& view);
+    std::array<glm::vec4, 8> getFrustumCornersWorldSpace(const glm::mat4& proj, const glm::mat4& view);
     
     glm::mat4 getLightSpaceMatrix(const float nearPlane, const float farPlane, const glm::vec3& lightDir, Camera* camera);
 };
\ No newline at end of file
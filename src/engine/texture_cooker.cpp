@@ -0,0 +1,565 @@
+#include "texture_cooker.h"
+#include "engine/utils/content_hash.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define YTINU_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#define STB_DXT_IMPLEMENTATION
+#include <stb_dxt.h>
+
+// S3TC 枚举 (EXT_texture_compression_s3tc / EXT_texture_sRGB)，glad 只生成了核心 profile
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+namespace {
+
+std::atomic<bool> g_s3tcSupported{ false };
+
+// ==========================================
+// sRGB <-> Linear 查找表
+// ==========================================
+struct SRGBTables
+{
+    float toLinear[256];
+    uint8_t toSRGB[4096];   // 线性值量化到 12 bit 后查表
+
+    SRGBTables()
+    {
+        for (int i = 0; i < 256; ++i) {
+            float c = i / 255.0f;
+            toLinear[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        for (int i = 0; i < 4096; ++i) {
+            float l = i / 4095.0f;
+            float s = (l <= 0.0031308f) ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+            toSRGB[i] = static_cast<uint8_t>(std::clamp(s * 255.0f + 0.5f, 0.0f, 255.0f));
+        }
+    }
+};
+
+const SRGBTables& srgbTables()
+{
+    static SRGBTables tables;
+    return tables;
+}
+
+// ==========================================
+// 下采样 (2x2 box filter)
+// ==========================================
+
+// 通用标量路径：处理奇数尺寸 (边缘像素 clamp)
+void downsampleScalar(const uint8_t* src, int sw, int sh, uint8_t* dst, int dw, int dh, int ch, bool srgb)
+{
+    const SRGBTables& t = srgbTables();
+    for (int y = 0; y < dh; ++y) {
+        int y0 = std::min(y * 2, sh - 1);
+        int y1 = std::min(y * 2 + 1, sh - 1);
+        for (int x = 0; x < dw; ++x) {
+            int x0 = std::min(x * 2, sw - 1);
+            int x1 = std::min(x * 2 + 1, sw - 1);
+            const uint8_t* p00 = src + (y0 * sw + x0) * ch;
+            const uint8_t* p01 = src + (y0 * sw + x1) * ch;
+            const uint8_t* p10 = src + (y1 * sw + x0) * ch;
+            const uint8_t* p11 = src + (y1 * sw + x1) * ch;
+            uint8_t* d = dst + (y * dw + x) * ch;
+            for (int c = 0; c < ch; ++c) {
+                // alpha 通道永远是线性的
+                bool colorChannel = srgb && (ch == 1 || c < 3);
+                if (colorChannel) {
+                    float l = (t.toLinear[p00[c]] + t.toLinear[p01[c]] + t.toLinear[p10[c]] + t.toLinear[p11[c]]) * 0.25f;
+                    d[c] = t.toSRGB[static_cast<int>(l * 4095.0f + 0.5f)];
+                } else {
+                    d[c] = static_cast<uint8_t>((p00[c] + p01[c] + p10[c] + p11[c] + 2) >> 2);
+                }
+            }
+        }
+    }
+}
+
+#ifdef YTINU_HAS_SSE2
+// SSE2 路径：源尺寸为偶数的线性数据
+// 四个源像素扩展到 16 位后求和再 (+2)>>2，与标量路径逐位一致
+// (嵌套 _mm_avg_epu8 会两次向上取整，每级 mip 偏亮最多 1)
+// RGBA8：一次读 4 个源像素 x 2 行，输出 2 个像素
+void downsampleRGBA_SSE2(const uint8_t* src, int sw, uint8_t* dst, int dw, int dh)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+    for (int y = 0; y < dh; ++y) {
+        const uint8_t* r0 = src + (size_t)(y * 2) * sw * 4;
+        const uint8_t* r1 = r0 + (size_t)sw * 4;
+        uint8_t* d = dst + (size_t)y * dw * 4;
+        int x = 0;
+        for (; x + 2 <= dw; x += 2) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + x * 8));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + x * 8));
+            __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)); // [p0 p1] 纵向和
+            __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)); // [p2 p3] 纵向和
+            lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));                                     // 低 4 个: p0+p1
+            hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));                                     // 低 4 个: p2+p3
+            __m128i sum = _mm_unpacklo_epi64(lo, hi);
+            __m128i h = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(d + x * 4), _mm_packus_epi16(h, h));
+        }
+        for (; x < dw; ++x) {
+            const uint8_t* a = r0 + x * 8;
+            const uint8_t* b = r1 + x * 8;
+            for (int c = 0; c < 4; ++c)
+                d[x * 4 + c] = static_cast<uint8_t>((a[c] + a[c + 4] + b[c] + b[c + 4] + 2) >> 2);
+        }
+    }
+}
+
+// R8：一次读 16 个源像素 x 2 行，输出 8 个像素
+void downsampleR8_SSE2(const uint8_t* src, int sw, uint8_t* dst, int dw, int dh)
+{
+    const __m128i lowMask = _mm_set1_epi16(0x00FF);
+    const __m128i two = _mm_set1_epi16(2);
+    for (int y = 0; y < dh; ++y) {
+        const uint8_t* r0 = src + (size_t)(y * 2) * sw;
+        const uint8_t* r1 = r0 + sw;
+        uint8_t* d = dst + (size_t)y * dw;
+        int x = 0;
+        for (; x + 8 <= dw; x += 8) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + x * 2));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + x * 2));
+            __m128i even = _mm_add_epi16(_mm_and_si128(a, lowMask), _mm_and_si128(b, lowMask));
+            __m128i odd = _mm_add_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+            __m128i h = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(even, odd), two), 2);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(d + x), _mm_packus_epi16(h, h));
+        }
+        for (; x < dw; ++x) {
+            d[x] = static_cast<uint8_t>((r0[x * 2] + r0[x * 2 + 1] + r1[x * 2] + r1[x * 2 + 1] + 2) >> 2);
+        }
+    }
+}
+#endif
+
+void downsample(const CookedMip& src, CookedMip& dst, int ch, bool srgb)
+{
+    dst.width = std::max(1, src.width / 2);
+    dst.height = std::max(1, src.height / 2);
+    dst.data.resize((size_t)dst.width * dst.height * ch);
+
+#ifdef YTINU_HAS_SSE2
+    bool even = (src.width % 2 == 0) && (src.height % 2 == 0);
+    if (even && !srgb) {
+        if (ch == 4) { downsampleRGBA_SSE2(src.data.data(), src.width, dst.data.data(), dst.width, dst.height); return; }
+        if (ch == 1) { downsampleR8_SSE2(src.data.data(), src.width, dst.data.data(), dst.width, dst.height); return; }
+    }
+#endif
+    downsampleScalar(src.data.data(), src.width, src.height, dst.data.data(), dst.width, dst.height, ch, srgb);
+}
+
+// ==========================================
+// 块压缩
+// ==========================================
+std::vector<uint8_t> compressLevel(const CookedMip& mip, int ch, GLenum internalFormat)
+{
+    const int bw = (mip.width + 3) / 4;
+    const int bh = (mip.height + 3) / 4;
+    const bool bc4 = (internalFormat == GL_COMPRESSED_RED_RGTC1);
+    const bool bc3 = (internalFormat == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT ||
+                      internalFormat == GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT);
+    const int blockBytes = (bc4 || !bc3) ? 8 : 16;
+
+    std::vector<uint8_t> out((size_t)bw * bh * blockBytes);
+    uint8_t block[16 * 4];
+
+    for (int by = 0; by < bh; ++by) {
+        for (int bx = 0; bx < bw; ++bx) {
+            // 取 4x4 像素 (越界部分 clamp 到边缘)
+            for (int py = 0; py < 4; ++py) {
+                int sy = std::min(by * 4 + py, mip.height - 1);
+                for (int px = 0; px < 4; ++px) {
+                    int sx = std::min(bx * 4 + px, mip.width - 1);
+                    const uint8_t* p = mip.data.data() + ((size_t)sy * mip.width + sx) * ch;
+                    std::memcpy(block + (py * 4 + px) * ch, p, ch);
+                }
+            }
+            uint8_t* dst = out.data() + ((size_t)by * bw + bx) * blockBytes;
+            if (bc4) stb_compress_bc4_block(dst, block);
+            else stb_compress_dxt_block(dst, block, bc3 ? 1 : 0, STB_DXT_HIGHQUAL);
+        }
+    }
+    return out;
+}
+
+uint64_t fnv1a(const void* data, size_t size, uint64_t h = 14695981039346656037ull)
+{
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+constexpr char kMagic[4] = { 'Y', 'T', 'E', 'X' };
+constexpr uint32_t kVersion = 1;
+
+} // namespace
+
+int CookedTexture::blockBytes() const
+{
+    if (!compressed) return 0;
+    switch (internalFormat) {
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+        return 16;
+    default:
+        return 8;
+    }
+}
+
+size_t CookedTexture::totalBytes() const
+{
+    size_t total = 0;
+    for (const auto& m : mips) total += m.data.size();
+    return total;
+}
+
+CookedTexture TextureCooker::cook(const unsigned char* pixels, int width, int height, int channels,
+                                  const TextureCookOptions& options)
+{
+    CookedTexture tex;
+    if (!pixels || width <= 0 || height <= 0) return tex;
+
+    // 1. 统一通道布局：单通道保持 R8 (除非要求 sRGB)，其余全部扩展为 RGBA8
+    //    GPU 内部 RGB8 本来就按 4 字节对齐存储，扩展后还能走 SIMD 和 BC 压缩
+    int outCh = (channels == 1 && !options.srgb) ? 1 : 4;
+
+    CookedMip base;
+    base.width = width;
+    base.height = height;
+    base.data.resize((size_t)width * height * outCh);
+
+    const size_t count = (size_t)width * height;
+    if (outCh == channels) {
+        std::memcpy(base.data.data(), pixels, base.data.size());
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            const unsigned char* s = pixels + i * channels;
+            uint8_t* d = base.data.data() + i * 4;
+            switch (channels) {
+            case 1: d[0] = d[1] = d[2] = s[0]; d[3] = 255; break;
+            case 2: d[0] = d[1] = d[2] = s[0]; d[3] = s[1]; break;
+            case 3: d[0] = s[0]; d[1] = s[1]; d[2] = s[2]; d[3] = 255; break;
+            default: d[0] = s[0]; d[1] = s[1]; d[2] = s[2]; d[3] = s[3]; break;
+            }
+        }
+    }
+
+    bool hasAlpha = (channels == 2 || channels == 4);
+
+    // 2. 选择格式
+    tex.width = width;
+    tex.height = height;
+    tex.channels = outCh;
+    tex.srgb = options.srgb && outCh == 4;
+    tex.format = (outCh == 1) ? GL_RED : GL_RGBA;
+
+    bool compress = options.compress;
+    if (compress && outCh == 4 && !isS3TCSupported()) compress = false;
+
+    if (compress) {
+        tex.compressed = true;
+        if (outCh == 1) tex.internalFormat = GL_COMPRESSED_RED_RGTC1;                      // BC4
+        else if (hasAlpha) tex.internalFormat = tex.srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+                                                         : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; // BC3
+        else tex.internalFormat = tex.srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+                                           : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;              // BC1
+    } else {
+        if (outCh == 1) tex.internalFormat = GL_R8;
+        else tex.internalFormat = tex.srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+    }
+
+    // 3. 生成 mip 链 (始终在未压缩数据上下采样)
+    std::vector<CookedMip> levels;
+    levels.push_back(std::move(base));
+    if (options.generateMips) {
+        while (levels.back().width > 1 || levels.back().height > 1) {
+            CookedMip next;
+            downsample(levels.back(), next, outCh, tex.srgb);
+            levels.push_back(std::move(next));
+        }
+    }
+
+    // 4. 块压缩
+    if (tex.compressed) {
+        for (auto& lvl : levels) {
+            lvl.data = compressLevel(lvl, outCh, tex.internalFormat);
+        }
+    }
+
+    tex.mips = std::move(levels);
+    return tex;
+}
+
+std::string TextureCooker::getCachePath(const std::string& projectRoot, const std::string& cleanPath,
+                                        const AssetSignature& signature, const TextureCookOptions& options)
+{
+    return getCachePath(projectRoot, cleanPath, std::vector<AssetSignature>{ signature }, options);
+}
+
+uint64_t TextureCooker::sourceHash(const std::string& sourceId, const std::vector<AssetSignature>& signatures)
+{
+    uint64_t h = fnv1a(sourceId.data(), sourceId.size());
+    for (const auto& signature : signatures) {
+        if (!signature.isValid) return 0;
+        int64_t mtime = static_cast<int64_t>(signature.lastWriteTime.time_since_epoch().count());
+        uint64_t size = static_cast<uint64_t>(signature.fileSize);
+        h = fnv1a(&mtime, sizeof(mtime), h);
+        h = fnv1a(&size, sizeof(size), h);
+    }
+    return h;
+}
+
+uint64_t TextureCooker::contentHash(const CookedTexture& tex)
+{
+    ContentHash h;
+    const uint32_t header[4] = { tex.internalFormat, static_cast<uint32_t>(tex.width),
+                                 static_cast<uint32_t>(tex.height), static_cast<uint32_t>(tex.mips.size()) };
+    h.update(header, sizeof(header));
+    for (const auto& mip : tex.mips) h.update(mip.data);
+    return h.digest();
+}
+
+std::string TextureCooker::getCachePath(const std::string& projectRoot, const std::string& sourceId,
+                                        const std::vector<AssetSignature>& signatures, const TextureCookOptions& options)
+{
+    if (projectRoot.empty() || signatures.empty()) return "";
+
+    uint64_t h = sourceHash(sourceId, signatures);
+    if (h == 0) return "";
+
+    uint32_t opts = options.hash();
+    h = fnv1a(&opts, sizeof(opts), h);
+    h = fnv1a(&kVersion, sizeof(kVersion), h);
+
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.ytex", static_cast<unsigned long long>(h));
+    return projectRoot + ".cache/textures/" + name;
+}
+
+std::vector<uint8_t> TextureCooker::packChannels(const ChannelSource (&sources)[3], int& outWidth, int& outHeight)
+{
+    outWidth = 1;
+    outHeight = 1;
+    for (const auto& src : sources) {
+        if (!src.pixels) continue;
+        outWidth = std::max(outWidth, src.width);
+        outHeight = std::max(outHeight, src.height);
+    }
+
+    std::vector<uint8_t> out(static_cast<size_t>(outWidth) * outHeight * 4, 255);
+
+    for (int c = 0; c < 3; ++c)
+    {
+        const ChannelSource& src = sources[c];
+        if (!src.pixels) {
+            for (size_t i = 0; i < out.size(); i += 4) out[i + c] = src.fallback;
+            continue;
+        }
+
+        auto fetch = [&](int x, int y) -> float {
+            return src.pixels[(static_cast<size_t>(y) * src.width + x) * src.channels + src.channel];
+        };
+
+        // 尺寸一致：直接拷贝通道
+        if (src.width == outWidth && src.height == outHeight) {
+            for (int y = 0; y < outHeight; ++y)
+                for (int x = 0; x < outWidth; ++x)
+                    out[(static_cast<size_t>(y) * outWidth + x) * 4 + c] = static_cast<uint8_t>(fetch(x, y));
+            continue;
+        }
+
+        // 尺寸不一致：按像素中心对齐做双线性缩放
+        float sx = static_cast<float>(src.width) / outWidth;
+        float sy = static_cast<float>(src.height) / outHeight;
+        for (int y = 0; y < outHeight; ++y)
+        {
+            float fy = std::max(0.0f, (y + 0.5f) * sy - 0.5f);
+            int y0 = std::min(static_cast<int>(fy), src.height - 1);
+            int y1 = std::min(y0 + 1, src.height - 1);
+            float ty = fy - y0;
+            for (int x = 0; x < outWidth; ++x)
+            {
+                float fx = std::max(0.0f, (x + 0.5f) * sx - 0.5f);
+                int x0 = std::min(static_cast<int>(fx), src.width - 1);
+                int x1 = std::min(x0 + 1, src.width - 1);
+                float tx = fx - x0;
+
+                float top = fetch(x0, y0) + (fetch(x1, y0) - fetch(x0, y0)) * tx;
+                float bottom = fetch(x0, y1) + (fetch(x1, y1) - fetch(x0, y1)) * tx;
+                float v = top + (bottom - top) * ty;
+                out[(static_cast<size_t>(y) * outWidth + x) * 4 + c] = static_cast<uint8_t>(v + 0.5f);
+            }
+        }
+    }
+    return out;
+}
+
+bool TextureCooker::loadFromDisk(const std::string& cachePath, CookedTexture& out)
+{
+    if (cachePath.empty()) return false;
+
+    std::ifstream in(cachePath, std::ios::binary);
+    if (!in) return false;
+
+    char magic[4];
+    uint32_t version = 0, mipCount = 0, internalFormat = 0, format = 0;
+    int32_t w = 0, h = 0, ch = 0;
+    uint8_t compressed = 0, srgb = 0;
+
+    in.read(magic, 4);
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!in || std::memcmp(magic, kMagic, 4) != 0 || version != kVersion) return false;
+
+    in.read(reinterpret_cast<char*>(&w), sizeof(w));
+    in.read(reinterpret_cast<char*>(&h), sizeof(h));
+    in.read(reinterpret_cast<char*>(&ch), sizeof(ch));
+    in.read(reinterpret_cast<char*>(&internalFormat), sizeof(internalFormat));
+    in.read(reinterpret_cast<char*>(&format), sizeof(format));
+    in.read(reinterpret_cast<char*>(&compressed), sizeof(compressed));
+    in.read(reinterpret_cast<char*>(&srgb), sizeof(srgb));
+    in.read(reinterpret_cast<char*>(&mipCount), sizeof(mipCount));
+    if (!in || mipCount == 0 || mipCount > 32) return false;
+
+    // 压缩格式依赖驱动支持，缓存是在别的机器上生成的也要检查
+    if (compressed && internalFormat != GL_COMPRESSED_RED_RGTC1 && !isS3TCSupported()) return false;
+
+    CookedTexture tex;
+    tex.width = w;
+    tex.height = h;
+    tex.channels = ch;
+    tex.internalFormat = internalFormat;
+    tex.format = format;
+    tex.compressed = compressed != 0;
+    tex.srgb = srgb != 0;
+    tex.mips.resize(mipCount);
+
+    for (auto& mip : tex.mips) {
+        int32_t mw = 0, mh = 0;
+        uint64_t size = 0;
+        in.read(reinterpret_cast<char*>(&mw), sizeof(mw));
+        in.read(reinterpret_cast<char*>(&mh), sizeof(mh));
+        in.read(reinterpret_cast<char*>(&size), sizeof(size));
+        if (!in || size > (1ull << 32)) return false;
+        mip.width = mw;
+        mip.height = mh;
+        mip.data.resize(size);
+        in.read(reinterpret_cast<char*>(mip.data.data()), size);
+        if (!in) return false;
+    }
+
+    out = std::move(tex);
+    return true;
+}
+
+bool TextureCooker::saveToDisk(const std::string& cachePath, const CookedTexture& tex)
+{
+    if (cachePath.empty() || !tex.isValid()) return false;
+
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::create_directories(fs::path(cachePath).parent_path(), ec);
+
+    // 先写临时文件再改名，避免其他线程/进程读到写了一半的缓存
+    std::string tmpPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+
+        int32_t w = tex.width, h = tex.height, ch = tex.channels;
+        uint32_t internalFormat = tex.internalFormat, format = tex.format;
+        uint8_t compressed = tex.compressed ? 1 : 0, srgb = tex.srgb ? 1 : 0;
+        uint32_t mipCount = static_cast<uint32_t>(tex.mips.size());
+
+        out.write(kMagic, 4);
+        out.write(reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+        out.write(reinterpret_cast<const char*>(&w), sizeof(w));
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(reinterpret_cast<const char*>(&ch), sizeof(ch));
+        out.write(reinterpret_cast<const char*>(&internalFormat), sizeof(internalFormat));
+        out.write(reinterpret_cast<const char*>(&format), sizeof(format));
+        out.write(reinterpret_cast<const char*>(&compressed), sizeof(compressed));
+        out.write(reinterpret_cast<const char*>(&srgb), sizeof(srgb));
+        out.write(reinterpret_cast<const char*>(&mipCount), sizeof(mipCount));
+
+        for (const auto& mip : tex.mips) {
+            int32_t mw = mip.width, mh = mip.height;
+            uint64_t size = mip.data.size();
+            out.write(reinterpret_cast<const char*>(&mw), sizeof(mw));
+            out.write(reinterpret_cast<const char*>(&mh), sizeof(mh));
+            out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+            out.write(reinterpret_cast<const char*>(mip.data.data()), size);
+        }
+        if (!out) return false;
+    }
+
+    fs::rename(tmpPath, cachePath, ec);
+    if (ec) {
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+void TextureCooker::queryGLCaps()
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    bool s3tc = false;
+    for (GLint i = 0; i < count; ++i) {
+        const char* ext = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (ext && (std::strcmp(ext, "GL_EXT_texture_compression_s3tc") == 0 ||
+                    std::strcmp(ext, "GL_NV_texture_compression_s3tc") == 0)) {
+            s3tc = true;
+            break;
+        }
+    }
+    g_s3tcSupported = s3tc;
+    std::cout << "[TextureCooker] S3TC (BC1/BC3) support: " << (s3tc ? "yes" : "no") << std::endl;
+}
+
+bool TextureCooker::isS3TCSupported()
+{
+    return g_s3tcSupported;
+}
+
+const char* TextureCooker::formatName(GLenum internalFormat)
+{
+    switch (internalFormat) {
+    case GL_R8: return "R8";
+    case GL_RGBA8: return "RGBA8";
+    case GL_SRGB8_ALPHA8: return "SRGB8_A8";
+    case GL_COMPRESSED_RED_RGTC1: return "BC4";
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT: return "BC1";
+    case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT: return "BC1 sRGB";
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT: return "BC3";
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT: return "BC3 sRGB";
+    default: return "?";
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "engine/utils/asset_signature.h"
+
+// 纹理"烘焙"选项
+struct TextureCookOptions
+{
+    bool srgb = false;          // 颜色贴图 (Albedo / Emissive) 使用 sRGB 格式，由硬件做线性化
+    bool generateMips = true;   // 生成完整 mip 链
+    bool compress = false;      // CPU 块压缩 (BC1/BC3/BC4)
+
+    // 参与缓存 key 的选项摘要
+    uint32_t hash() const
+    {
+        return (srgb ? 1u : 0u) | (generateMips ? 2u : 0u) | (compress ? 4u : 0u);
+    }
+};
+
+// 一级 mip 的数据 (未压缩为紧密排列的像素，压缩时为 4x4 块序列)
+struct CookedMip
+{
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> data;
+};
+
+// 烘焙结果：可以直接上传的 GPU 格式 + 完整 mip 链
+struct CookedTexture
+{
+    int width = 0;
+    int height = 0;
+    int channels = 0;               // 上传时每像素通道数 (1 或 4)，压缩格式下仅供参考
+    GLenum internalFormat = 0;      // 带尺寸的内部格式，如 GL_SRGB8_ALPHA8 / GL_COMPRESSED_RED_RGTC1
+    GLenum format = 0;              // 像素格式，如 GL_RGBA / GL_RED (压缩格式无意义)
+    bool compressed = false;
+    bool srgb = false;
+    std::vector<CookedMip> mips;
+
+    bool isValid() const { return !mips.empty() && internalFormat != 0; }
+
+    // 压缩格式每个 4x4 块的字节数 (未压缩返回 0)
+    int blockBytes() const;
+
+    size_t totalBytes() const;
+};
+
+// 通道打包的输入：取 pixels 的第 channel 个通道 (pixels 为空时整张图填 fallback)
+struct ChannelSource
+{
+    const unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    int channel = 0;
+    uint8_t fallback = 255;
+};
+
+// 纹理烘焙器
+// 把 stbi 解码出的 8-bit 像素转换为：
+//   1. 带尺寸的 (并且颜色贴图为 sRGB 的) 内部格式
+//   2. 完整的 mip 链 (线性数据用 SSE2 box filter，sRGB 数据在线性空间下采样)
+//   3. 可选的 BC1/BC3/BC4 块压缩
+// 结果可以缓存到项目目录下，之后加载直接跳过解码和压缩。
+// 所有函数都不访问 GL，可以在工作线程调用 (queryGLCaps 除外)。
+class TextureCooker
+{
+public:
+    static CookedTexture cook(const unsigned char* pixels, int width, int height, int channels,
+                              const TextureCookOptions& options);
+
+    // 磁盘缓存路径: <projectRoot>/.cache/textures/<hash>.ytex
+    // hash 由 (相对路径, 源文件签名, 选项) 决定，源文件变化后自然失配
+    static std::string getCachePath(const std::string& projectRoot, const std::string& cleanPath,
+                                    const AssetSignature& signature, const TextureCookOptions& options);
+
+    // 源数据指纹 (sourceId + 所有源签名)，缓存文件名由它再混入烘焙选项得到
+    // 签名无效时返回 0
+    static uint64_t sourceHash(const std::string& sourceId, const std::vector<AssetSignature>& signatures);
+
+    // 烘焙结果的内容哈希 (格式 + 尺寸 + 全部 mip 数据)
+    // 两张图哈希相同即上传到 GPU 的数据逐字节相同，可以共享同一份存储
+    static uint64_t contentHash(const CookedTexture& tex);
+
+    // 多个源文件合成的纹理 (例如打包的 ORM)：hash 由 sourceId 和所有源签名共同决定
+    static std::string getCachePath(const std::string& projectRoot, const std::string& sourceId,
+                                    const std::vector<AssetSignature>& signatures, const TextureCookOptions& options);
+
+    // 把三张单通道图打包成一张 RGBA8 (A = 255)
+    // 尺寸不一致时以最大的宽高为准，其余输入双线性缩放
+    static std::vector<uint8_t> packChannels(const ChannelSource (&sources)[3], int& outWidth, int& outHeight);
+
+    static bool loadFromDisk(const std::string& cachePath, CookedTexture& out);
+    static bool saveToDisk(const std::string& cachePath, const CookedTexture& tex);
+
+    // [主线程] 查询驱动对 S3TC (BC1/BC3) 的支持，结果缓存供工作线程读取
+    static void queryGLCaps();
+    static bool isS3TCSupported();
+
+    static const char* formatName(GLenum internalFormat);
+};
@@ -0,0 +1,267 @@
+#include "texture_streamer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+TextureStreamer::~TextureStreamer()
+{
+    // GL 上下文可能已销毁，这里不释放 GL 对象
+}
+
+void TextureStreamer::cancelAll()
+{
+    std::deque<Job> dropped;
+    dropped.swap(_active);
+    {
+        std::lock_guard<std::mutex> lock(_incomingMutex);
+        for (auto& job : _incoming) dropped.push_back(std::move(job));
+        _incoming.clear();
+    }
+
+    // 在锁外回调：回调里可能再次投递任务
+    for (auto& job : dropped) {
+        if (job.onResident) job.onResident(false);
+    }
+}
+
+GLuint TextureStreamer::getPlaceholder(TexturePlaceholder kind)
+{
+    int idx = static_cast<int>(kind);
+    if (_placeholders[idx] != 0) return _placeholders[idx];
+
+    // 4x4 RGBA 小图，棋盘格只给 Albedo 用，其余是纯色
+    const int size = 4;
+    unsigned char pixels[size * size * 4];
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            unsigned char* p = pixels + (y * size + x) * 4;
+            switch (kind) {
+            case TexturePlaceholder::Albedo: {
+                unsigned char c = ((x + y) & 1) ? 200 : 140;
+                p[0] = c; p[1] = c; p[2] = c; break;
+            }
+            case TexturePlaceholder::Normal: p[0] = 128; p[1] = 128; p[2] = 255; break;
+            case TexturePlaceholder::ORM:    p[0] = 255; p[1] = 128; p[2] = 0;   break;
+            case TexturePlaceholder::White:  p[0] = 255; p[1] = 255; p[2] = 255; break;
+            default:                         p[0] = 0;   p[1] = 0;   p[2] = 0;   break;
+            }
+            p[3] = 255;
+        }
+    }
+
+    GLuint tex = 0;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    _placeholders[idx] = tex;
+    return tex;
+}
+
+void TextureStreamer::enqueue(std::shared_ptr<ImageTexture2D> target, CookedTexture&& cooked,
+                              std::function<void(bool)> onResident, TextureCancelPolicy cancel)
+{
+    Job job;
+    job.target = std::move(target);
+    job.cooked = std::move(cooked);
+    job.onResident = std::move(onResident);
+    job.cancel = std::move(cancel);
+
+    std::lock_guard<std::mutex> lock(_incomingMutex);
+    _incoming.push_back(std::move(job));
+}
+
+size_t TextureStreamer::rowBytes(const CookedTexture& tex, int level)
+{
+    const CookedMip& mip = tex.mips[level];
+    if (tex.compressed) return static_cast<size_t>((mip.width + 3) / 4) * tex.blockBytes();
+    return static_cast<size_t>(mip.width) * tex.channels;
+}
+
+int TextureStreamer::rowCount(const CookedTexture& tex, int level)
+{
+    const CookedMip& mip = tex.mips[level];
+    return tex.compressed ? (mip.height + 3) / 4 : mip.height;
+}
+
+void TextureStreamer::uploadRows(const CookedTexture& tex, int level, int firstRow, int rows, const void* src)
+{
+    const CookedMip& mip = tex.mips[level];
+    if (tex.compressed) {
+        int y = firstRow * 4;
+        int h = std::min(rows * 4, mip.height - y);
+        GLsizei size = static_cast<GLsizei>(rowBytes(tex, level) * rows);
+        glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, y, mip.width, h, tex.internalFormat, size, src);
+    } else {
+        glTexSubImage2D(GL_TEXTURE_2D, level, 0, firstRow, mip.width, rows, tex.format, GL_UNSIGNED_BYTE, src);
+    }
+}
+
+void TextureStreamer::uploadImmediately(ImageTexture2D& target, const CookedTexture& cooked)
+{
+    if (!cooked.isValid()) return;
+
+    target.allocateLevels(cooked.width, cooked.height, static_cast<int>(cooked.mips.size()),
+                          cooked.internalFormat, cooked.format, cooked.blockBytes(),
+                          cooked.channels, cooked.srgb);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, target.getHandle());
+    for (int level = 0; level < static_cast<int>(cooked.mips.size()); ++level) {
+        uploadRows(cooked, level, 0, rowCount(cooked, level), cooked.mips[level].data.data());
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    target.markResident();
+}
+
+void TextureStreamer::initPBOs()
+{
+    glGenBuffers(kPboCount, _pbos);
+    for (int i = 0; i < kPboCount; ++i) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pbos[i]);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, kPboSize, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void TextureStreamer::pump()
+{
+    // 1. 收取新任务
+    {
+        std::lock_guard<std::mutex> lock(_incomingMutex);
+        for (auto& job : _incoming) _active.push_back(std::move(job));
+        _incoming.clear();
+    }
+
+    _stats.bytesThisFrame = 0;
+    _stats.uploadMsThisFrame = 0.0;
+
+    if (_active.empty()) {
+        _stats.pendingJobs = 0;
+        _stats.pendingBytes = 0;
+        return;
+    }
+
+    if (_pbos[0] == 0) initPBOs();
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    size_t budget = _frameBudget;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    while (!_active.empty())
+    {
+        Job& job = _active.front();
+        const CookedTexture& tex = job.cooked;
+
+        // 目标纹理已被所有使用者释放 (只剩缓存和这个任务) 或数据无效：直接丢弃
+        if (!job.target || job.isUnused() || !tex.isValid()) {
+            std::function<void()> onCancelled = job.isUnused() ? std::move(job.cancel.onCancelled) : nullptr;
+            std::function<void(bool)> onResident = std::move(job.onResident);
+            std::shared_ptr<ImageTexture2D> target = std::move(job.target); // 回调结束后才释放
+            _active.pop_front();
+            if (onCancelled) onCancelled();
+            if (onResident) onResident(false);
+            continue;
+        }
+
+        if (!job.allocated) {
+            job.target->allocateLevels(tex.width, tex.height, static_cast<int>(tex.mips.size()),
+                                       tex.internalFormat, tex.format, tex.blockBytes(),
+                                       tex.channels, tex.srgb);
+            job.allocated = true;
+        }
+
+        const size_t lineBytes = rowBytes(tex, job.level);
+        // 即使超出预算，每帧也至少推进一行，保证一定能完成
+        if (budget < lineBytes && _stats.bytesThisFrame > 0) break;
+
+        int rowsLeft = rowCount(tex, job.level) - job.nextRow;
+        size_t maxRowsByBudget = std::max<size_t>(1, budget / lineBytes);
+        size_t maxRowsByPbo = std::max<size_t>(1, kPboSize / lineBytes);
+        int rows = static_cast<int>(std::min<size_t>({ (size_t)rowsLeft, maxRowsByBudget, maxRowsByPbo }));
+        size_t chunkBytes = lineBytes * rows;
+
+        const uint8_t* src = tex.mips[job.level].data.data() + lineBytes * job.nextRow;
+
+        glBindTexture(GL_TEXTURE_2D, job.target->getHandle());
+        if (chunkBytes <= kPboSize) {
+            // 轮转 PBO，先 orphan 再映射，避免等待 GPU 读完上一次的数据
+            GLuint pbo = _pbos[_pboIndex];
+            _pboIndex = (_pboIndex + 1) % kPboCount;
+
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, kPboSize, nullptr, GL_STREAM_DRAW);
+            void* dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, chunkBytes,
+                                         GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            if (dst) {
+                std::memcpy(dst, src, chunkBytes);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                uploadRows(tex, job.level, job.nextRow, rows, nullptr);
+            }
+            else {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                uploadRows(tex, job.level, job.nextRow, rows, src);
+            }
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+        else {
+            // 单行比 PBO 还大时 (极宽的图)，退化为直接上传
+            uploadRows(tex, job.level, job.nextRow, rows, src);
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        job.nextRow += rows;
+        _stats.bytesThisFrame += chunkBytes;
+        budget = (chunkBytes >= budget) ? 0 : budget - chunkBytes;
+
+        // 当前 mip 级别传完，进入下一级
+        if (job.nextRow >= rowCount(tex, job.level)) {
+            job.level++;
+            job.nextRow = 0;
+        }
+
+        if (job.level >= static_cast<int>(tex.mips.size())) {
+            job.target->markResident();
+            std::function<void(bool)> onResident = std::move(job.onResident);
+            std::shared_ptr<ImageTexture2D> target = std::move(job.target); // 回调结束后才释放
+            _active.pop_front();
+            if (onResident) onResident(true);
+            _stats.completedTotal++;
+        }
+
+        if (budget == 0) break;
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    _stats.uploadMsThisFrame = std::chrono::duration<double, std::milli>(end - start).count();
+    _stats.maxUploadMs = std::max(_stats.maxUploadMs, _stats.uploadMsThisFrame);
+
+    _stats.pendingJobs = _active.size();
+    _stats.pendingBytes = 0;
+    for (const auto& job : _active) {
+        const CookedTexture& tex = job.cooked;
+        for (int level = job.level; level < static_cast<int>(tex.mips.size()); ++level) {
+            _stats.pendingBytes += tex.mips[level].data.size();
+        }
+        if (job.level < static_cast<int>(tex.mips.size())) {
+            _stats.pendingBytes -= rowBytes(tex, job.level) * job.nextRow;
+        }
+    }
+}
+
+TextureStreamer::Stats TextureStreamer::getStats() const
+{
+    return _stats;
+}
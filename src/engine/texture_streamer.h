@@ -0,0 +1,120 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "base/texture2d.h"
+#include "engine/texture_cooker.h"
+
+// 纹理在加载完成前显示的占位图类型
+// 不同槽位需要不同的"中性值"，否则法线/ORM 在加载期间会让表面闪烁
+enum class TexturePlaceholder
+{
+    Albedo,   // 灰白棋盘格
+    Normal,   // (0.5, 0.5, 1.0) 平坦法线
+    ORM,      // AO=1, Roughness=0.5, Metallic=0
+    White,    // AO / Opacity 等
+    Black,    // Metallic / Emissive 等
+    Count
+};
+
+// 流式上传的取消条件：缓存里的占位纹理除了缓存等内部持有者 (ownerRefs 个引用，含上传任务自己) 之外没人再用时，
+// 放弃上传并在主线程调用 onCancelled (通常是移除缓存条目，之后再请求会重新加载)
+// watched 为空时不会因"没人用"而取消 (有人在等 onResident，或目标只由任务持有)
+struct TextureCancelPolicy {
+    std::weak_ptr<const ImageTexture2D> watched;
+    long ownerRefs = 0;
+    std::function<void()> onCancelled;
+};
+
+// 流式纹理上传器
+// 工作线程烘焙好的纹理 (带 mip 链，可能是块压缩格式) 通过 enqueue 投递进来，
+// 主线程每帧调用 pump()，通过 PBO 环形缓冲逐级、分行 glTex(Compressed)SubImage2D，
+// 每帧上传的字节数受 _frameBudget 限制，避免大贴图造成卡顿。
+class TextureStreamer
+{
+public:
+    struct Stats {
+        size_t bytesThisFrame = 0;      // 本帧上传字节数
+        double uploadMsThisFrame = 0.0; // 本帧上传耗时 (CPU 侧)
+        double maxUploadMs = 0.0;       // 历史最大单帧上传耗时 (即"卡顿尖峰")
+        size_t pendingJobs = 0;         // 排队中的纹理数
+        size_t pendingBytes = 0;        // 排队中的剩余字节数
+        size_t completedTotal = 0;      // 累计完成的纹理数
+    };
+
+    TextureStreamer() = default;
+    ~TextureStreamer();
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    // 获取占位纹理句柄 (必须在 GL 线程调用，首次调用时创建)
+    GLuint getPlaceholder(TexturePlaceholder kind);
+
+    // [线程安全] 投递一张烘焙完成的纹理
+    // onResident 总会在主线程被调用恰好一次：纹理完整驻留后传 true，
+    // 任务被丢弃 (取消、数据无效、cancelAll) 时传 false
+    void enqueue(std::shared_ptr<ImageTexture2D> target, CookedTexture&& cooked,
+                 std::function<void(bool)> onResident = nullptr, TextureCancelPolicy cancel = {});
+
+    // [主线程] 不走预算，立即上传全部 mip 并标记驻留 (同步加载路径使用)
+    static void uploadImmediately(ImageTexture2D& target, const CookedTexture& cooked);
+
+    // [主线程] 每帧调用一次，在预算内推进上传
+    void pump();
+
+    // 每帧上传预算 (字节)
+    void setFrameBudget(size_t bytes) { _frameBudget = bytes; }
+    size_t getFrameBudget() const { return _frameBudget; }
+
+    Stats getStats() const;
+    void resetPeak() { _stats.maxUploadMs = 0.0; }
+
+    // [主线程] 丢弃所有未完成的任务并以 false 通知它们的 onResident
+    // (占位纹理和 PBO 保留，已发出的句柄仍然有效)
+    void cancelAll();
+
+private:
+    struct Job {
+        std::shared_ptr<ImageTexture2D> target;
+        CookedTexture cooked;
+        int level = 0;                  // 当前上传的 mip 级别
+        int nextRow = 0;                // 下一行待上传的行号 (压缩格式为块行)
+        bool allocated = false;         // 是否已分配纹理存储
+        std::function<void(bool)> onResident;
+        TextureCancelPolicy cancel;
+
+        bool isUnused() const { return cancel.ownerRefs > 0 && cancel.watched.use_count() <= cancel.ownerRefs; }
+    };
+
+    // 某一级 mip 的"行"信息：未压缩为像素行，压缩格式为 4 像素高的块行
+    static size_t rowBytes(const CookedTexture& tex, int level);
+    static int rowCount(const CookedTexture& tex, int level);
+    static void uploadRows(const CookedTexture& tex, int level, int firstRow, int rows, const void* src);
+
+    // 投递队列 (工作线程写，主线程读)
+    std::mutex _incomingMutex;
+    std::vector<Job> _incoming;
+
+    // 主线程私有的活动队列
+    std::deque<Job> _active;
+
+    // PBO 环形缓冲
+    static constexpr int kPboCount = 3;
+    static constexpr size_t kPboSize = 4 * 1024 * 1024;
+    GLuint _pbos[kPboCount] = { 0, 0, 0 };
+    int _pboIndex = 0;
+
+    GLuint _placeholders[static_cast<int>(TexturePlaceholder::Count)] = {};
+
+    size_t _frameBudget = 8 * 1024 * 1024;
+
+    Stats _stats;
+
+    void initPBOs();
+};
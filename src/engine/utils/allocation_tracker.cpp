@@ -0,0 +1,106 @@
+#include "allocation_tracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef NDEBUG
+
+bool AllocationTracker::isEnabled() { return false; }
+size_t AllocationTracker::getThreadAllocations() { return 0; }
+size_t AllocationTracker::getThreadAllocatedBytes() { return 0; }
+size_t AllocationTracker::getTotalAllocations() { return 0; }
+size_t AllocationTracker::getTotalAllocatedBytes() { return 0; }
+
+#else
+
+namespace {
+
+// 只用平凡类型，operator new 中访问不会触发线程局部变量的动态初始化
+thread_local size_t tlsAllocations = 0;
+thread_local size_t tlsAllocatedBytes = 0;
+std::atomic<size_t> totalAllocations{ 0 };
+std::atomic<size_t> totalAllocatedBytes{ 0 };
+
+void count(size_t size) noexcept
+{
+    ++tlsAllocations;
+    tlsAllocatedBytes += size;
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    totalAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void* countedAlloc(size_t size) noexcept
+{
+    count(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* countedAlignedAlloc(size_t size, size_t alignment) noexcept
+{
+    count(size);
+#ifdef _WIN32
+    return _aligned_malloc(size ? size : 1, alignment);
+#else
+    // aligned_alloc 要求大小是对齐的整数倍
+    size_t rounded = (size + alignment - 1) / alignment * alignment;
+    return std::aligned_alloc(alignment, rounded ? rounded : alignment);
+#endif
+}
+
+void alignedFree(void* ptr) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void* throwingAlloc(size_t size)
+{
+    void* ptr = countedAlloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* throwingAlignedAlloc(size_t size, size_t alignment)
+{
+    void* ptr = countedAlignedAlloc(size, alignment);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+} // namespace
+
+bool AllocationTracker::isEnabled() { return true; }
+size_t AllocationTracker::getThreadAllocations() { return tlsAllocations; }
+size_t AllocationTracker::getThreadAllocatedBytes() { return tlsAllocatedBytes; }
+size_t AllocationTracker::getTotalAllocations() { return totalAllocations.load(std::memory_order_relaxed); }
+size_t AllocationTracker::getTotalAllocatedBytes() { return totalAllocatedBytes.load(std::memory_order_relaxed); }
+
+void* operator new(size_t size) { return throwingAlloc(size); }
+void* operator new[](size_t size) { return throwingAlloc(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+
+void* operator new(size_t size, std::align_val_t al) { return throwingAlignedAlloc(size, static_cast<size_t>(al)); }
+void* operator new[](size_t size, std::align_val_t al) { return throwingAlignedAlloc(size, static_cast<size_t>(al)); }
+void* operator new(size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return countedAlignedAlloc(size, static_cast<size_t>(al)); }
+void* operator new[](size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return countedAlignedAlloc(size, static_cast<size_t>(al)); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(ptr); }
+
+#endif
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+
+// ==========================================
+// 堆分配计数 (调试构建)
+// ==========================================
+// 未定义 NDEBUG 时替换全局 operator new / delete，按线程累计分配次数与字节数，
+// 用来确认稳定状态下的渲染循环没有堆分配。Release 构建不替换，计数恒为 0。
+class AllocationTracker
+{
+public:
+    static bool isEnabled();
+
+    // 当前线程累计的分配次数 / 字节数
+    static size_t getThreadAllocations();
+    static size_t getThreadAllocatedBytes();
+
+    // 所有线程累计的分配次数 / 字节数
+    static size_t getTotalAllocations();
+    static size_t getTotalAllocatedBytes();
+};
+
+// 统计一段代码在当前线程上的堆分配 (可以嵌套；其他线程上的分配不计入)
+class AllocationScope
+{
+public:
+    AllocationScope()
+        : _allocations(AllocationTracker::getThreadAllocations()),
+          _bytes(AllocationTracker::getThreadAllocatedBytes()) {}
+
+    size_t getAllocations() const { return AllocationTracker::getThreadAllocations() - _allocations; }
+    size_t getAllocatedBytes() const { return AllocationTracker::getThreadAllocatedBytes() - _bytes; }
+
+private:
+    size_t _allocations;
+    size_t _bytes;
+};
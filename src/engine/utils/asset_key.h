@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// 资源缓存的键
+// 以前的 key 是 path + ":useFlatShade" + ":" + subMesh 拼出来的字符串，
+// 现在统一哈希成 64 位整数 (FNV-1a)。
+// 哈希只用于分桶与快速排除；相等比较还要比对完整的 id (标准化路径 + 选项的字节串)，
+// 否则两个资源的哈希碰撞时缓存会悄悄返回另一个资源。
+struct AssetKey
+{
+    uint64_t hash = 0;
+    std::string id; // 参与哈希的全部字节 (含分隔字节)
+
+    // 路径标准化：反斜杠统一为正斜杠
+    static std::string normalizePath(const std::string& path)
+    {
+        std::string clean = path;
+        std::replace(clean.begin(), clean.end(), '\\', '/');
+        return clean;
+    }
+
+    // 由 (标准化路径, flat 标记, 子网格名) 生成 key
+    // 各字段之间插入分隔字节，避免 "a"+"bc" 与 "ab"+"c" 碰撞
+    static AssetKey make(const std::string& cleanPath, bool useFlatShade = false, const std::string& subMeshName = "")
+    {
+        AssetKey key;
+        key.hash = kOffsetBasis;
+        key.mix(cleanPath);
+        key.mixByte(0xFF);
+        key.mixByte(useFlatShade ? 1 : 0);
+        key.mixByte(0xFF);
+        key.mix(subMeshName);
+        return key;
+    }
+
+    // 派生 key (例如同一文件的不同子网格)，不需要重新哈希路径
+    AssetKey with(const std::string& suffix) const
+    {
+        AssetKey key = *this;
+        key.mixByte(0xFE);
+        key.mix(suffix);
+        return key;
+    }
+
+    bool operator==(const AssetKey& other) const { return hash == other.hash && id == other.id; }
+    bool operator!=(const AssetKey& other) const { return !(*this == other); }
+
+private:
+    static constexpr uint64_t kOffsetBasis = 14695981039346656037ull;
+    static constexpr uint64_t kPrime = 1099511628211ull;
+
+    void mixByte(uint8_t b)
+    {
+        hash ^= b;
+        hash *= kPrime;
+        id.push_back(static_cast<char>(b));
+    }
+
+    void mix(const std::string& s)
+    {
+        for (unsigned char c : s) {
+            hash ^= c;
+            hash *= kPrime;
+        }
+        id += s;
+    }
+};
+
+namespace std {
+template <>
+struct hash<AssetKey> {
+    size_t operator()(const AssetKey& key) const {
+        return static_cast<size_t>(key.hash);
+    }
+};
+} // namespace std
@@ -0,0 +1,267 @@
+#include "asset_watcher.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+AssetWatcher::~AssetWatcher()
+{
+    stop();
+}
+
+bool AssetWatcher::start(const std::string& rootDir)
+{
+    stop();
+
+    std::error_code ec;
+    if (rootDir.empty() || !fs::is_directory(rootDir, ec)) return false;
+
+    _root = rootDir;
+    _running = true;
+
+#ifdef __linux__
+    if (startInotify()) {
+        _backend = Backend::Inotify;
+        _thread = std::thread([this]() { runInotify(); });
+        std::cout << "[AssetWatcher] Watching " << _root << " (inotify, " << _watchDirs.size() << " dirs)" << std::endl;
+        return true;
+    }
+#endif
+
+    _backend = Backend::Polling;
+    _thread = std::thread([this]() { runPolling(); });
+    std::cout << "[AssetWatcher] Watching " << _root << " (polling)" << std::endl;
+    return true;
+}
+
+void AssetWatcher::stop()
+{
+    _running = false;
+    if (_thread.joinable()) _thread.join();
+
+#ifdef __linux__
+    if (_inotifyFd >= 0) {
+        close(_inotifyFd);
+        _inotifyFd = -1;
+    }
+    _watchDirs.clear();
+#endif
+
+    _backend = Backend::None;
+    _overflowed = false;
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    _pending.clear();
+}
+
+const char* AssetWatcher::getBackendName() const
+{
+    switch (_backend) {
+    case Backend::Inotify: return "inotify";
+    case Backend::Polling: return "polling";
+    default:               return "off";
+    }
+}
+
+bool AssetWatcher::isIgnoredPath(const std::string& relativePath)
+{
+    // 隐藏目录/文件 (.cache, .git ...) 与编辑器的临时文件
+    if (relativePath.empty() || relativePath[0] == '.') return true;
+    if (relativePath.find("/.") != std::string::npos) return true;
+    return relativePath.back() == '~';
+}
+
+void AssetWatcher::record(const std::string& relativePath, ChangeKind kind)
+{
+    if (isIgnoredPath(relativePath)) return;
+
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+
+    auto it = _pending.find(relativePath);
+    if (it == _pending.end()) {
+        _pending[relativePath] = { kind, now };
+        return;
+    }
+
+    // 合并：新建后的写入仍算新建；先删后建 (原子保存) 算修改
+    Pending& p = it->second;
+    if (p.kind == ChangeKind::Added && kind == ChangeKind::Modified) {}
+    else if (p.kind == ChangeKind::Removed && kind == ChangeKind::Added) p.kind = ChangeKind::Modified;
+    else p.kind = kind;
+    p.lastEvent = now;
+}
+
+std::vector<AssetWatcher::Change> AssetWatcher::takeSettledChanges()
+{
+    std::vector<Change> out;
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    for (auto it = _pending.begin(); it != _pending.end();) {
+        if (now - it->second.lastEvent >= _debounce) {
+            out.push_back({ it->first, it->second.kind });
+            it = _pending.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    return out;
+}
+
+// ==========================================
+// inotify 后端
+// ==========================================
+#ifdef __linux__
+
+bool AssetWatcher::startInotify()
+{
+    _inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_inotifyFd < 0) return false;
+
+    addWatchRecursive("");
+    if (_watchDirs.empty()) {
+        close(_inotifyFd);
+        _inotifyFd = -1;
+        return false;
+    }
+    return true;
+}
+
+void AssetWatcher::addWatchRecursive(const std::string& relativeDir)
+{
+    // inotify 不支持递归，每个子目录都要单独添加
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE;
+    std::string dir = _root + relativeDir;
+    int wd = inotify_add_watch(_inotifyFd, dir.c_str(), mask);
+    if (wd < 0) {
+        std::cerr << "[AssetWatcher] inotify_add_watch failed: " << dir << std::endl;
+        return;
+    }
+    _watchDirs[wd] = relativeDir;
+
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(dir, ec)) {
+        if (!entry.is_directory(ec)) continue;
+        std::string name = entry.path().filename().string();
+        if (name.empty() || name[0] == '.') continue;
+        addWatchRecursive(relativeDir + name + "/");
+    }
+}
+
+void AssetWatcher::runInotify()
+{
+    alignas(struct inotify_event) char buffer[16 * 1024];
+    pollfd pfd{ _inotifyFd, POLLIN, 0 };
+
+    while (_running)
+    {
+        // 带超时的 poll，保证 stop() 能及时让线程退出
+        int ready = poll(&pfd, 1, 100);
+        if (ready <= 0) continue;
+
+        ssize_t len = read(_inotifyFd, buffer, sizeof(buffer));
+        if (len <= 0) continue;
+
+        for (char* ptr = buffer; ptr < buffer + len;)
+        {
+            auto* ev = reinterpret_cast<struct inotify_event*>(ptr);
+            ptr += sizeof(struct inotify_event) + ev->len;
+
+            if (ev->mask & IN_Q_OVERFLOW) {
+                std::cerr << "[AssetWatcher] inotify queue overflow, rescanning loaded assets" << std::endl;
+                _overflowed = true;
+                continue;
+            }
+
+            // 目录被删除/移走后内核会自动移除 watch
+            if (ev->mask & IN_IGNORED) {
+                _watchDirs.erase(ev->wd);
+                continue;
+            }
+
+            auto dirIt = _watchDirs.find(ev->wd);
+            if (dirIt == _watchDirs.end() || ev->len == 0) continue;
+            std::string relative = dirIt->second + ev->name;
+
+            if (ev->mask & IN_ISDIR) {
+                // 新建/移入的子目录也要监视；目录事件以 '/' 结尾上报
+                // (整个目录移入时里面的文件不会有单独的事件，需要使用者自己扫描)
+                if (ev->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    if (!isIgnoredPath(relative)) addWatchRecursive(relative + "/");
+                    record(relative + "/", ChangeKind::Added);
+                }
+                else if (ev->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                    record(relative + "/", ChangeKind::Removed);
+                }
+                continue;
+            }
+
+            if (ev->mask & (IN_DELETE | IN_MOVED_FROM)) record(relative, ChangeKind::Removed);
+            else if (ev->mask & IN_CREATE) record(relative, ChangeKind::Added);
+            else if (ev->mask & IN_MOVED_TO) record(relative, ChangeKind::Added);
+            else if (ev->mask & IN_CLOSE_WRITE) record(relative, ChangeKind::Modified);
+        }
+    }
+}
+
+#endif
+
+// ==========================================
+// 轮询后端
+// ==========================================
+
+std::unordered_map<std::string, AssetWatcher::FileStamp> AssetWatcher::scanSnapshot() const
+{
+    std::unordered_map<std::string, FileStamp> snapshot;
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(_root, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+    {
+        std::string name = it->path().filename().string();
+        if (!name.empty() && name[0] == '.') {
+            if (it->is_directory(ec)) it.disable_recursion_pending();
+            continue;
+        }
+        if (!it->is_regular_file(ec)) continue;
+
+        std::string relative = fs::relative(it->path(), _root, ec).generic_string();
+        FileStamp stamp;
+        stamp.mtime = static_cast<long long>(it->last_write_time(ec).time_since_epoch().count());
+        stamp.size = static_cast<unsigned long long>(it->file_size(ec));
+        snapshot[relative] = stamp;
+    }
+    return snapshot;
+}
+
+void AssetWatcher::runPolling()
+{
+    auto previous = scanSnapshot();
+
+    while (_running)
+    {
+        // 分段睡眠，保证 stop() 能及时让线程退出
+        for (int i = 0; i < 10 && _running; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        if (!_running) break;
+
+        auto current = scanSnapshot();
+        for (const auto& [path, stamp] : current) {
+            auto it = previous.find(path);
+            if (it == previous.end()) record(path, ChangeKind::Added);
+            else if (it->second.mtime != stamp.mtime || it->second.size != stamp.size) record(path, ChangeKind::Modified);
+        }
+        for (const auto& [path, stamp] : previous) {
+            if (current.find(path) == current.end()) record(path, ChangeKind::Removed);
+        }
+        previous = std::move(current);
+    }
+}
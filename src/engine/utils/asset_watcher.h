@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// 项目目录监视器
+// 后台线程监听文件变化 (Linux 上用 inotify，不可用时退化为定时轮询)，
+// 主线程每帧调用 takeSettledChanges() 取走"已经安静下来"的变化。
+// 同一文件在 debounce 窗口内的多次事件 (DCC 工具保存时常见的 truncate + 多次 write + rename)
+// 会合并成一条，避免一次保存触发多次重新导入。
+class AssetWatcher
+{
+public:
+    enum class ChangeKind
+    {
+        Modified,
+        Added,
+        Removed
+    };
+
+    struct Change
+    {
+        std::string path;   // 相对项目根目录，使用 '/' 分隔；目录以 '/' 结尾
+        ChangeKind kind;
+    };
+
+    AssetWatcher() = default;
+    ~AssetWatcher();
+
+    AssetWatcher(const AssetWatcher&) = delete;
+    AssetWatcher& operator=(const AssetWatcher&) = delete;
+
+    // 开始监视 rootDir (以 '/' 结尾)，已在运行时会先停止
+    bool start(const std::string& rootDir);
+    void stop();
+
+    bool isRunning() const { return _running; }
+    const char* getBackendName() const;
+
+    // [主线程] 取出最后一次事件距今超过 debounce 的变化
+    std::vector<Change> takeSettledChanges();
+
+    // [主线程] 事件队列溢出过 (inotify 丢了事件) 时返回 true 一次；
+    // 丢失的变化无从得知，使用者需要按签名重新校验所有已加载的资源
+    bool takeOverflow() { return _overflowed.exchange(false); }
+
+    void setDebounce(std::chrono::milliseconds ms) { _debounce = ms; }
+
+    // 内部生成的文件 (纹理烘焙缓存等) 所在目录，不上报
+    static bool isIgnoredPath(const std::string& relativePath);
+
+private:
+    enum class Backend { None, Inotify, Polling };
+
+    struct Pending
+    {
+        ChangeKind kind;
+        std::chrono::steady_clock::time_point lastEvent;
+    };
+
+    std::string _root;
+    Backend _backend = Backend::None;
+    std::thread _thread;
+    std::atomic<bool> _running{ false };
+    std::chrono::milliseconds _debounce{ 300 };
+    std::atomic<bool> _overflowed{ false };
+
+    std::mutex _pendingMutex;
+    std::unordered_map<std::string, Pending> _pending;
+
+    // 记录一次事件 (线程安全)，同一文件的事件合并
+    void record(const std::string& relativePath, ChangeKind kind);
+
+#ifdef __linux__
+    int _inotifyFd = -1;
+    std::unordered_map<int, std::string> _watchDirs;  // wd -> 相对目录 (空串或以 '/' 结尾)
+
+    bool startInotify();
+    void addWatchRecursive(const std::string& relativeDir);
+    void runInotify();
+#endif
+
+    // 轮询后端：定期比较 (修改时间, 大小) 快照
+    struct FileStamp
+    {
+        long long mtime = 0;
+        unsigned long long size = 0;
+    };
+    std::unordered_map<std::string, FileStamp> scanSnapshot() const;
+    void runPolling();
+};
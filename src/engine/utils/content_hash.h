@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// 内容哈希 (XXH64 算法)
+// 用于按"解码后的数据"识别完全相同的资源 (见 ResourceManager 的内容去重)。
+// 与 AssetKey 的 FNV-1a 不同，这里要哈希整张贴图 / 整个网格，
+// 每次处理 32 字节，速度接近内存带宽，可以在工作线程上直接对 MB 级数据计算。
+class ContentHash
+{
+public:
+    explicit ContentHash(uint64_t seed = 0) { reset(seed); }
+
+    void reset(uint64_t seed = 0)
+    {
+        _v[0] = seed + kPrime1 + kPrime2;
+        _v[1] = seed + kPrime2;
+        _v[2] = seed;
+        _v[3] = seed - kPrime1;
+        _seed = seed;
+        _total = 0;
+        _bufferSize = 0;
+    }
+
+    // 追加一段数据 (可多次调用，结果与一次性哈希拼接后的数据相同)
+    void update(const void* data, size_t size)
+    {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        _total += size;
+
+        // 先补齐上次剩下的不足 32 字节的部分
+        if (_bufferSize > 0) {
+            size_t fill = std::min(size, sizeof(_buffer) - _bufferSize);
+            std::memcpy(_buffer + _bufferSize, p, fill);
+            _bufferSize += fill;
+            p += fill;
+            size -= fill;
+            if (_bufferSize < sizeof(_buffer)) return;
+            consumeStripe(_buffer);
+            _bufferSize = 0;
+        }
+
+        while (size >= 32) {
+            consumeStripe(p);
+            p += 32;
+            size -= 32;
+        }
+
+        if (size > 0) {
+            std::memcpy(_buffer, p, size);
+            _bufferSize = size;
+        }
+    }
+
+    template <typename T>
+    void update(const std::vector<T>& values)
+    {
+        // 把元素个数也算进去，避免 [ab][c] 与 [a][bc] 这种拼接碰撞
+        uint64_t count = values.size();
+        update(&count, sizeof(count));
+        if (!values.empty()) update(values.data(), values.size() * sizeof(T));
+    }
+
+    uint64_t digest() const
+    {
+        uint64_t h;
+        if (_total >= 32) {
+            h = rotl(_v[0], 1) + rotl(_v[1], 7) + rotl(_v[2], 12) + rotl(_v[3], 18);
+            for (uint64_t v : _v) h = mergeRound(h, v);
+        } else {
+            h = _seed + kPrime5;
+        }
+        h += _total;
+
+        const uint8_t* p = _buffer;
+        size_t left = _bufferSize;
+        while (left >= 8) {
+            h ^= round(0, read64(p));
+            h = rotl(h, 27) * kPrime1 + kPrime4;
+            p += 8;
+            left -= 8;
+        }
+        if (left >= 4) {
+            h ^= static_cast<uint64_t>(read32(p)) * kPrime1;
+            h = rotl(h, 23) * kPrime2 + kPrime3;
+            p += 4;
+            left -= 4;
+        }
+        while (left > 0) {
+            h ^= (*p) * kPrime5;
+            h = rotl(h, 11) * kPrime1;
+            ++p;
+            --left;
+        }
+
+        // avalanche
+        h ^= h >> 33;
+        h *= kPrime2;
+        h ^= h >> 29;
+        h *= kPrime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    static uint64_t hash(const void* data, size_t size, uint64_t seed = 0)
+    {
+        ContentHash h(seed);
+        h.update(data, size);
+        return h.digest();
+    }
+
+private:
+    static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+    static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+    static constexpr uint64_t kPrime3 = 0x165667B19E3779F9ull;
+    static constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+    static constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+    uint64_t _v[4];
+    uint64_t _seed = 0;
+    uint64_t _total = 0;
+    uint8_t _buffer[32];
+    size_t _bufferSize = 0;
+
+    static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+    static uint64_t read64(const uint8_t* p)
+    {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static uint32_t read32(const uint8_t* p)
+    {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static uint64_t round(uint64_t acc, uint64_t input)
+    {
+        acc += input * kPrime2;
+        acc = rotl(acc, 31);
+        return acc * kPrime1;
+    }
+
+    static uint64_t mergeRound(uint64_t acc, uint64_t v)
+    {
+        acc ^= round(0, v);
+        return acc * kPrime1 + kPrime4;
+    }
+
+    void consumeStripe(const uint8_t* p)
+    {
+        _v[0] = round(_v[0], read64(p));
+        _v[1] = round(_v[1], read64(p + 8));
+        _v[2] = round(_v[2], read64(p + 16));
+        _v[3] = round(_v[3], read64(p + 24));
+    }
+};
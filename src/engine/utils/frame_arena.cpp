@@ -0,0 +1,73 @@
+#include "frame_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+FrameArena::FrameArena(size_t initialCapacity)
+{
+    // 块列表本身也预留好，新增块时不会再为它扩容
+    _blocks.reserve(8);
+    addBlock(std::max<size_t>(initialCapacity, 1024));
+}
+
+void FrameArena::addBlock(size_t size)
+{
+    Block block;
+    block.data.reset(new unsigned char[size]);
+    block.size = size;
+    _blocks.push_back(std::move(block));
+}
+
+size_t FrameArena::getCapacity() const
+{
+    size_t total = 0;
+    for (const Block& block : _blocks) total += block.size;
+    return total;
+}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment)
+{
+    bytes = std::max<size_t>(bytes, 1);
+
+    while (true) {
+        Block& block = _blocks[_current];
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        uintptr_t start = (base + _offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        if (start + bytes <= base + block.size) {
+            _offset = static_cast<size_t>(start + bytes - base);
+            return reinterpret_cast<void*>(start);
+        }
+
+        // 当前块放不下：换到下一块 (上一帧合并前留下的)，没有就按翻倍的大小新建
+        _usedInPreviousBlocks += block.size;
+        _offset = 0;
+        if (++_current == _blocks.size()) {
+            addBlock(std::max(block.size * 2, bytes + alignment));
+        }
+    }
+}
+
+void FrameArena::deallocate(void* ptr, size_t bytes)
+{
+    Block& block = _blocks[_current];
+    unsigned char* p = static_cast<unsigned char*>(ptr);
+    if (p >= block.data.get() && p + bytes == block.data.get() + _offset) {
+        _offset = static_cast<size_t>(p - block.data.get());
+    }
+}
+
+void FrameArena::reset()
+{
+    _peakBytes = std::max(_peakBytes, getUsedBytes());
+
+    // 用到了多个块：合并成一块，下一帧同样的用量一块就够
+    if (_current > 0) {
+        size_t total = getCapacity();
+        _blocks.clear();
+        addBlock(total);
+    }
+
+    _current = 0;
+    _offset = 0;
+    _usedInPreviousBlocks = 0;
+}
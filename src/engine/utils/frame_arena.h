@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// ==========================================
+// 每帧线性分配器 (bump allocator)
+// ==========================================
+// 一帧内的临时数组 (光源列表、渲染队列、排序下标等) 从这里顺序分配，释放基本是空操作，
+// 帧末 reset 一次性回收。当前块用完时追加新块；reset 时如果这一帧用到了多个块，
+// 就把它们合并成一块足够大的，几帧之后稳定下来，每帧不再向系统申请内存。
+// 不是线程安全的：只在渲染线程上分配 (分配好的数组可以交给工作线程读写)。
+class FrameArena
+{
+public:
+    explicit FrameArena(size_t initialCapacity = 64 * 1024);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment);
+
+    // 只能回收最近一次分配 (数组用完立即释放时)，其余情况等到 reset
+    void deallocate(void* ptr, size_t bytes);
+
+    // [帧末] 回收全部内存，从这里分配的数组必须已经销毁
+    void reset();
+
+    size_t getUsedBytes() const { return _usedInPreviousBlocks + _offset; }
+    size_t getCapacity() const;
+    size_t getPeakBytes() const { return _peakBytes; } // 历史上单帧的最大用量
+
+private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size = 0;
+    };
+
+    std::vector<Block> _blocks;
+    size_t _current = 0;              // 正在分配的块
+    size_t _offset = 0;               // 当前块已用的字节数
+    size_t _usedInPreviousBlocks = 0; // 之前的块 (含用不上的尾部) 的字节数
+    size_t _peakBytes = 0;
+
+    void addBlock(size_t size);
+};
+
+// STL 分配器适配：容器的内存来自 FrameArena，容器只能活在这一帧之内
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    ArenaAllocator(FrameArena& arena) noexcept : _arena(&arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : _arena(other.getArena()) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T* ptr, size_t n) noexcept { _arena->deallocate(ptr, n * sizeof(T)); }
+
+    FrameArena* getArena() const noexcept { return _arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return _arena == other.getArena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return _arena != other.getArena(); }
+
+private:
+    FrameArena* _arena;
+};
+
+// 这一帧的临时数组，例如 FrameVector<GameObject*> queue(arena);
+template <typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
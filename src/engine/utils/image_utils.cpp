@@ -1,5 +1,6 @@
 #include "image_utils.h"
 #include <vector>
+#include <cstring>
 #include <iostream>
 #include <algorithm> // for std::reverse (optional) or manual loop
 
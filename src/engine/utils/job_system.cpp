@@ -0,0 +1,278 @@
+#include "job_system.h"
+#include "profiler.h"
+
+#include <algorithm>
+
+namespace {
+
+// 当前线程所属的任务系统与工作线程编号 (非工作线程为空 / -1)
+thread_local const JobSystem* tlsJobSystem = nullptr;
+thread_local int tlsWorkerIndex = -1;
+
+} // namespace
+
+JobSystem& JobSystem::Get()
+{
+    static JobSystem system;
+    return system;
+}
+
+JobSystem::JobSystem(size_t threadCount)
+{
+    if (threadCount == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        // 留一个核给主线程 (GL + UI)，主线程等待时也会参与执行
+        threadCount = std::max(1u, hw > 1 ? hw - 1 : 1u);
+    }
+
+    _activeCount = threadCount;
+    for (size_t i = 0; i < threadCount; ++i) _queues.push_back(std::make_unique<WorkerQueue>());
+    for (size_t i = 0; i < threadCount; ++i) _workers.emplace_back([this, i]() { workerLoop(i); });
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stopping = true;
+        _activeCount = _workers.size(); // 休眠的线程也要醒来把剩余任务做完
+    }
+    _sleepCv.notify_all();
+    for (auto& t : _workers) {
+        if (t.joinable()) t.join();
+    }
+}
+
+int JobSystem::currentWorkerIndex() const
+{
+    return tlsJobSystem == this ? tlsWorkerIndex : -1;
+}
+
+void JobSystem::setActiveThreadCount(size_t count)
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _activeCount = std::min(count, _workers.size());
+    }
+    _sleepCv.notify_all();
+}
+
+void JobSystem::run(std::function<void()> job, JobCounter* counter)
+{
+    if (counter) counter->_pending.fetch_add(1, std::memory_order_relaxed);
+    push({ std::move(job), counter });
+}
+
+void JobSystem::runAfter(JobCounter& dependency, std::function<void()> job, JobCounter* counter)
+{
+    if (counter) counter->_pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        // 与 finish 中的归零在同一把锁下判断，不会漏掉后续任务
+        std::lock_guard<std::mutex> lock(dependency._mutex);
+        if (dependency._pending.load(std::memory_order_acquire) > 0) {
+            dependency._continuations.push_back({ std::move(job), counter });
+            return;
+        }
+    }
+    push({ std::move(job), counter });
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    bool isWorker = currentWorkerIndex() >= 0;
+    while (!counter.isDone()) {
+        // 优先执行自己等待的任务；只有工作线程才帮忙执行其他任务 (见类注释)，
+        // 工作线程全部被限制休眠时没有别人能执行，只好全部接下
+        Job job;
+        bool helpAny = isWorker || _activeCount.load() == 0;
+        if (tryPopFor(counter, job) || (helpAny && tryPop(job))) execute(job);
+        else std::this_thread::yield();
+    }
+    // 最后一个完成的任务在锁内归零，等它释放锁后再返回 (counter 可能随即被销毁)
+    std::lock_guard<std::mutex> lock(counter._mutex);
+}
+
+void JobSystem::parallelForRange(size_t begin, size_t end, size_t chunkSize,
+                                 void* callable, void (*invoke)(void*, size_t, size_t))
+{
+    if (end <= begin) return;
+    chunkSize = std::max<size_t>(1, chunkSize);
+    size_t chunkCount = (end - begin + chunkSize - 1) / chunkSize;
+    if (chunkCount <= 1 || _activeCount.load() == 0) {
+        invoke(callable, begin, end);
+        return;
+    }
+
+    ProfileScope scope("parallelFor");
+
+    // 第一块留给当前线程，其余投递出去 (工作线程内调用时都进自己的队列，由其他线程偷走)
+    // 任务只捕获 range 的地址和块号，std::function 可以原地保存，不需要堆分配
+    ParallelRange range{ callable, invoke, begin, end, chunkSize };
+    JobCounter counter;
+    for (size_t chunk = 1; chunk < chunkCount; ++chunk) {
+        run([&range, chunk]() {
+            size_t chunkBegin = range.begin + chunk * range.chunkSize;
+            range.invoke(range.callable, chunkBegin, std::min(range.end, chunkBegin + range.chunkSize));
+        }, &counter);
+    }
+    invoke(callable, begin, std::min(end, begin + chunkSize));
+    wait(counter);
+}
+
+void JobSystem::push(Job job)
+{
+    int self = currentWorkerIndex();
+    size_t target;
+    if (self >= 0) {
+        target = static_cast<size_t>(self);
+    } else {
+        size_t active = std::max<size_t>(1, _activeCount.load());
+        target = _nextQueue.fetch_add(1, std::memory_order_relaxed) % active;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_queues[target]->mutex);
+        _queues[target]->jobs.pushBack(std::move(job));
+    }
+    _queued.fetch_add(1);
+
+    // 先经过一次锁，保证等待中的线程不会错过通知；有线程被限制休眠时只能全部唤醒
+    { std::lock_guard<std::mutex> lock(_sleepMutex); }
+    if (_activeCount.load() < _workers.size()) _sleepCv.notify_all();
+    else _sleepCv.notify_one();
+}
+
+bool JobSystem::tryPop(Job& out)
+{
+    int self = currentWorkerIndex();
+    if (self >= 0) {
+        WorkerQueue& own = *_queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            out = own.jobs.popBack();
+            _queued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    size_t count = _queues.size();
+    size_t start = self >= 0 ? static_cast<size_t>(self) + 1 : _nextQueue.load(std::memory_order_relaxed);
+    for (size_t k = 0; k < count; ++k) {
+        size_t i = (start + k) % count;
+        if (static_cast<int>(i) == self) continue;
+
+        WorkerQueue& victim = *_queues[i];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.jobs.empty()) continue;
+        out = victim.jobs.popFront();
+        _queued.fetch_sub(1);
+        if (self >= 0) _stolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::tryPopFor(const JobCounter& counter, Job& out)
+{
+    int self = currentWorkerIndex();
+    size_t count = _queues.size();
+    size_t start = self >= 0 ? static_cast<size_t>(self) : 0;
+    for (size_t k = 0; k < count; ++k) {
+        size_t i = (start + k) % count;
+        WorkerQueue& queue = *_queues[i];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.takeLast(&counter, out)) continue;
+        _queued.fetch_sub(1);
+        if (static_cast<int>(i) != self && self >= 0) _stolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::JobRing::takeLast(const JobCounter* counter, Job& out)
+{
+    for (size_t k = _count; k-- > 0;) {
+        size_t slot = (_head + k) % _slots.size();
+        if (_slots[slot].counter != counter) continue;
+
+        out = std::move(_slots[slot]);
+        for (size_t j = k + 1; j < _count; ++j) {
+            _slots[(_head + j - 1) % _slots.size()] = std::move(_slots[(_head + j) % _slots.size()]);
+        }
+        --_count;
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::JobRing::pushBack(Job&& job)
+{
+    if (_count == _slots.size()) {
+        // 按顺序搬进翻倍的新数组，队头回到 0
+        std::vector<Job> grown(std::max<size_t>(16, _slots.size() * 2));
+        for (size_t i = 0; i < _count; ++i) grown[i] = std::move(_slots[(_head + i) % _slots.size()]);
+        _slots.swap(grown);
+        _head = 0;
+    }
+    _slots[(_head + _count) % _slots.size()] = std::move(job);
+    ++_count;
+}
+
+JobSystem::Job JobSystem::JobRing::popBack()
+{
+    --_count;
+    return std::move(_slots[(_head + _count) % _slots.size()]);
+}
+
+JobSystem::Job JobSystem::JobRing::popFront()
+{
+    Job job = std::move(_slots[_head]);
+    _head = (_head + 1) % _slots.size();
+    --_count;
+    return job;
+}
+
+void JobSystem::execute(Job& job)
+{
+    {
+        ProfileScope scope("Job");
+        job.function();
+    }
+    _executed.fetch_add(1, std::memory_order_relaxed);
+    finish(job.counter);
+}
+
+void JobSystem::finish(JobCounter* counter)
+{
+    if (!counter) return;
+
+    std::vector<JobCounter::Continuation> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter->_mutex);
+        if (counter->_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) ready.swap(counter->_continuations);
+    }
+    for (auto& c : ready) push({ std::move(c.function), c.counter });
+}
+
+void JobSystem::workerLoop(size_t index)
+{
+    tlsJobSystem = this;
+    tlsWorkerIndex = static_cast<int>(index);
+    Profiler::Get().setThreadName("Job Worker " + std::to_string(index));
+
+    while (true)
+    {
+        if (index < _activeCount.load()) {
+            Job job;
+            if (tryPop(job)) {
+                execute(job);
+                continue;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        if (_stopping && _queued.load() == 0) return;
+        _sleepCv.wait(lock, [&]() { return _stopping || (index < _activeCount.load() && _queued.load() > 0); });
+        if (_stopping && _queued.load() == 0) return;
+    }
+}
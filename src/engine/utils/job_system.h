@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class JobSystem;
+
+// 任务计数器：提交时加一、任务完成时减一，归零表示这一组任务全部完成
+// 既用于等待 (JobSystem::wait)，也用作依赖 (JobSystem::runAfter 在它归零后才投递后续任务)
+class JobCounter
+{
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool isDone() const { return _pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    struct Continuation {
+        std::function<void()> function;
+        JobCounter* counter;
+    };
+
+    std::atomic<int> _pending{ 0 };
+    std::mutex _mutex;
+    std::vector<Continuation> _continuations;
+};
+
+// ==========================================
+// 工作窃取 (work-stealing) 任务系统
+// ==========================================
+// 每个工作线程有自己的双端队列：自己从队尾取 (后进先出，缓存友好)，
+// 空闲时从其他线程的队头偷 (先进先出，偷走的通常是较大的任务)。
+// 工作线程之外的线程 (主线程、资源加载线程) 提交的任务轮流分到各个队列。
+// 等待 (wait / parallelFor) 的线程不会空等，而是一起执行属于所等计数器的任务，
+// 因此在任务内部再嵌套 parallelFor 也不会死锁。
+// 工作线程等待时队列里没有自己的任务就帮忙执行别的任务；工作线程之外的线程 (主线程、渲染线程) 只执行自己的任务，
+// 否则等待一次剔除可能顺手接下导入、LOD 构建的大块任务而拖慢这一帧。
+class JobSystem
+{
+public:
+    // 全局实例，线程数按硬件并发数确定 (留一个核给主线程)
+    static JobSystem& Get();
+
+    explicit JobSystem(size_t threadCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // 提交任务；counter 非空时提交前加一、完成后减一
+    void run(std::function<void()> job, JobCounter* counter = nullptr);
+
+    // dependency 归零后再投递 job (已经归零则立即投递)
+    void runAfter(JobCounter& dependency, std::function<void()> job, JobCounter* counter = nullptr);
+
+    // 等待 counter 归零，期间当前线程也执行属于它的任务 (工作线程还会执行其他任务)
+    void wait(JobCounter& counter);
+
+    // 把 [begin, end) 按 chunkSize 切块，fn(chunkBegin, chunkEnd) 在各线程上并行执行，返回时全部完成
+    // 只有一块或没有工作线程时直接在当前线程执行
+    // fn 只在调用期间被引用，不会拷贝进 std::function；队列容量稳定后切块投递不分配堆内存
+    template <typename Fn>
+    void parallelFor(size_t begin, size_t end, size_t chunkSize, Fn&& fn)
+    {
+        using Callable = std::remove_reference_t<Fn>;
+        parallelForRange(begin, end, chunkSize, const_cast<void*>(static_cast<const void*>(&fn)),
+                         [](void* callable, size_t chunkBegin, size_t chunkEnd) {
+                             (*static_cast<Callable*>(callable))(chunkBegin, chunkEnd);
+                         });
+    }
+
+    size_t getThreadCount() const { return _workers.size(); }
+
+    // 限制参与执行的工作线程数 (不超过 getThreadCount)，用于扩展性测试；超出的线程休眠
+    // 为 0 时 parallelFor 完全在调用线程上执行
+    void setActiveThreadCount(size_t count);
+    size_t getActiveThreadCount() const { return _activeCount.load(); }
+
+    // 各线程累计执行 / 偷到的任务数 (调试统计)
+    size_t getExecutedCount() const { return _executed.load(); }
+    size_t getStolenCount() const { return _stolen.load(); }
+
+private:
+    struct Job {
+        std::function<void()> function;
+        JobCounter* counter = nullptr;
+    };
+
+    // 环形缓冲区实现的双端队列：只扩容不收缩，容量够用之后投递任务不再分配内存
+    class JobRing
+    {
+    public:
+        bool empty() const { return _count == 0; }
+        void pushBack(Job&& job);
+        // 取出最靠近队尾的、属于 counter 的任务 (后面的任务依次前移，不分配内存)
+        bool takeLast(const JobCounter* counter, Job& out);
+        Job popBack();
+        Job popFront();
+
+    private:
+        std::vector<Job> _slots;
+        size_t _head = 0;
+        size_t _count = 0;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        JobRing jobs;
+    };
+
+    // parallelFor 的一次调用 (在调用者的栈上)，各块的任务只持有它的指针与块号
+    struct ParallelRange {
+        void* callable;
+        void (*invoke)(void*, size_t, size_t);
+        size_t begin;
+        size_t end;
+        size_t chunkSize;
+    };
+
+    void parallelForRange(size_t begin, size_t end, size_t chunkSize,
+                          void* callable, void (*invoke)(void*, size_t, size_t));
+
+    std::vector<std::thread> _workers;
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;
+
+    std::atomic<size_t> _queued{ 0 };
+    std::atomic<size_t> _activeCount{ 0 };
+    std::atomic<size_t> _nextQueue{ 0 };
+    std::atomic<size_t> _executed{ 0 };
+    std::atomic<size_t> _stolen{ 0 };
+
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCv;
+    bool _stopping = false;
+
+    void workerLoop(size_t index);
+
+    void push(Job job);
+
+    // 工作线程先从自己的队尾取，取不到再从其他队列的队头偷
+    bool tryPop(Job& out);
+    // 只取属于 counter 的任务 (先查自己的队列)
+    bool tryPopFor(const JobCounter& counter, Job& out);
+
+    void execute(Job& job);
+    void finish(JobCounter* counter);
+
+    // 当前线程在本任务系统中的工作线程编号，不是工作线程时为 -1
+    int currentWorkerIndex() const;
+};
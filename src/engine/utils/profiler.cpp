@@ -0,0 +1,300 @@
+#include "profiler.h"
+#include "allocation_tracker.h"
+#include "trace_export.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+namespace {
+
+// 一个线程在一帧内最多保留的记录数 (长时间没有帧边界时，例如启动阶段的加载线程)
+constexpr size_t kMaxThreadEvents = 65536;
+
+// 捕获环的帧数上限 (帧率很高时不按秒数无限增长)
+constexpr size_t kMaxCaptureFrames = 20000;
+
+// 超过阈值的帧之后再等几帧导出，让它的 GPU 结果先取回
+constexpr uint64_t kHitchDumpDelayFrames = 3;
+
+} // namespace
+
+double ProfileFrame::getGpuMs() const
+{
+    double total = 0.0;
+    for (const ProfileEvent& event : gpuEvents) total += event.getMs();
+    return total;
+}
+
+Profiler& Profiler::Get()
+{
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() : _origin(std::chrono::steady_clock::now())
+{
+    _pendingCounters.reserve(64);
+}
+
+uint64_t Profiler::now() const
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - _origin).count());
+}
+
+Profiler::ThreadBuffer& Profiler::currentThread()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        // 线程第一次记录时登记 (之后不再释放，线程退出后它的名字仍然有效)
+        auto owned = std::make_unique<ThreadBuffer>();
+        owned->events.reserve(256);
+
+        std::lock_guard<std::mutex> lock(_threadsMutex);
+        owned->index = static_cast<uint16_t>(_threads.size());
+        owned->name = "Thread " + std::to_string(owned->index);
+        buffer = owned.get();
+        _threads.push_back(std::move(owned));
+    }
+    return *buffer;
+}
+
+void Profiler::setThreadName(const std::string& name)
+{
+    ThreadBuffer& thread = currentThread();
+    std::lock_guard<std::mutex> lock(_threadsMutex);
+    thread.name = name;
+}
+
+std::string Profiler::getThreadName(uint16_t threadIndex) const
+{
+    if (threadIndex == kGpuThread) return "GPU";
+    std::lock_guard<std::mutex> lock(_threadsMutex);
+    return threadIndex < _threads.size() ? _threads[threadIndex]->name : std::string();
+}
+
+const char* Profiler::internName(const std::string& name)
+{
+    // unordered_set 的元素地址在插入其他元素后保持不变
+    std::lock_guard<std::mutex> lock(_namesMutex);
+    return _names.insert(name).first->c_str();
+}
+
+uint64_t Profiler::beginScope()
+{
+    currentThread().depth++;
+    return now();
+}
+
+void Profiler::endScope(const char* name, uint64_t startNs, ProfileCategory category)
+{
+    uint64_t endNs = now();
+    ThreadBuffer& thread = currentThread();
+    if (thread.depth > 0) thread.depth--;
+
+    std::lock_guard<std::mutex> lock(thread.mutex);
+    if (thread.events.size() >= kMaxThreadEvents) return;
+
+    ProfileEvent event;
+    event.name = name;
+    event.startNs = startNs;
+    event.endNs = endNs;
+    event.threadIndex = thread.index;
+    event.depth = thread.depth;
+    event.category = category;
+    thread.events.push_back(event);
+}
+
+void Profiler::setCounter(const char* name, double value)
+{
+    if (!isEnabled()) return;
+    ProfileCounter counter;
+    counter.name = name;
+    counter.value = value;
+    counter.timeNs = now();
+
+    std::lock_guard<std::mutex> lock(_counterMutex);
+    _pendingCounters.push_back(counter);
+}
+
+void Profiler::endFrame()
+{
+    uint64_t endNs = now();
+    uint64_t index = _frameIndex.load(std::memory_order_relaxed);
+
+    // 冻结时只丢弃记录，捕获环保持不变
+    ProfileFrame* frame = nullptr;
+    if (!_frozen) {
+        frame = &pushFrame();
+        frame->index = index;
+        frame->startNs = _frameStartNs;
+        frame->endNs = endNs;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_threadsMutex);
+        for (auto& thread : _threads) {
+            std::lock_guard<std::mutex> threadLock(thread->mutex);
+            if (frame) frame->cpuEvents.insert(frame->cpuEvents.end(), thread->events.begin(), thread->events.end());
+            thread->events.clear();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_counterMutex);
+        if (frame) frame->counters.insert(frame->counters.end(), _pendingCounters.begin(), _pendingCounters.end());
+        _pendingCounters.clear();
+    }
+
+    // 这一帧所有线程的堆分配 (调试构建)
+    if (AllocationTracker::isEnabled()) {
+        size_t allocations = AllocationTracker::getTotalAllocations();
+        size_t bytes = AllocationTracker::getTotalAllocatedBytes();
+        if (frame) {
+            frame->counters.push_back({ "Heap Allocations", static_cast<double>(allocations - _frameStartAllocations), endNs });
+            frame->counters.push_back({ "Heap Allocated KB", (bytes - _frameStartAllocatedBytes) / 1024.0, endNs });
+        }
+        _frameStartAllocations = allocations;
+        _frameStartAllocatedBytes = bytes;
+    }
+
+    if (frame) {
+        // 同一线程内按开始时间排序，父作用域排在子作用域之前
+        std::sort(frame->cpuEvents.begin(), frame->cpuEvents.end(), [](const ProfileEvent& a, const ProfileEvent& b) {
+            if (a.threadIndex != b.threadIndex) return a.threadIndex < b.threadIndex;
+            if (a.startNs != b.startNs) return a.startNs < b.startNs;
+            return a.depth < b.depth;
+        });
+        evictFrames();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_gpuMutex);
+        for (size_t i = 0; i < _pendingGpuCount; ++i) {
+            ProfileFrame* target = _frozen ? nullptr : findFrame(_pendingGpu[i].frameIndex);
+            if (!target) continue;
+            target->gpuEvents.assign(_pendingGpu[i].events.begin(), _pendingGpu[i].events.end());
+            target->gpuResolved = true;
+        }
+        _pendingGpuCount = 0;
+    }
+
+    _frameStartNs = endNs;
+    _frameIndex.store(index + 1, std::memory_order_release);
+
+    // 超过阈值的帧：几帧之后导出 (同一次捕获时长内只导出一次，避免导出本身的停顿再次触发)
+    if (frame && _hitchThresholdMs > 0.0f && _hitchDumpFrame == 0 && frame->getMs() > _hitchThresholdMs) {
+        bool coolingDown = _hasHitchDump && endNs - _lastHitchDumpNs < static_cast<uint64_t>(_captureSeconds * 1e9);
+        if (!coolingDown) {
+            std::cout << "[Profiler] Frame " << index << " took " << frame->getMs() << " ms (threshold "
+                      << _hitchThresholdMs << " ms), capturing trace" << std::endl;
+            _hitchDumpFrame = index + kHitchDumpDelayFrames;
+        }
+    }
+
+    if (_dumpRequested) {
+        _dumpRequested = false;
+        dumpNow("requested");
+    }
+    else if (_hitchDumpFrame != 0 && index >= _hitchDumpFrame) {
+        _hitchDumpFrame = 0;
+        _hasHitchDump = true;
+        _lastHitchDumpNs = endNs;
+        dumpNow("frame-time threshold");
+    }
+}
+
+void Profiler::submitGpuEvents(uint64_t frameIndex, const ProfileEvent* events, size_t count)
+{
+    std::lock_guard<std::mutex> lock(_gpuMutex);
+    // 条目与其中的数组都复用，容量稳定后不分配内存
+    if (_pendingGpuCount == _pendingGpu.size()) _pendingGpu.emplace_back();
+    GpuFrame& pending = _pendingGpu[_pendingGpuCount++];
+    pending.frameIndex = frameIndex;
+    pending.events.assign(events, events + count);
+}
+
+size_t Profiler::getHistoryCount() const
+{
+    return std::min(_frames.size(), kHistorySize);
+}
+
+const ProfileFrame& Profiler::getHistoryFrame(size_t age) const
+{
+    return _frames[_frames.size() - 1 - std::min(age, _frames.size() - 1)];
+}
+
+ProfileFrame* Profiler::findFrame(uint64_t frameIndex)
+{
+    // GPU 结果只晚几帧，从最新的帧往回找
+    for (auto it = _frames.rbegin(); it != _frames.rend(); ++it) {
+        if (it->index == frameIndex) return &*it;
+        if (it->index < frameIndex) break;
+    }
+    return nullptr;
+}
+
+ProfileFrame& Profiler::pushFrame()
+{
+    // 复用淘汰帧的数组，容量稳定后不分配内存
+    if (_spareFrames.empty()) {
+        _frames.emplace_back();
+    } else {
+        _frames.push_back(std::move(_spareFrames.back()));
+        _spareFrames.pop_back();
+    }
+
+    ProfileFrame& frame = _frames.back();
+    frame.cpuEvents.clear();
+    frame.gpuEvents.clear();
+    frame.counters.clear();
+    frame.gpuResolved = false;
+    return frame;
+}
+
+void Profiler::evictFrames()
+{
+    // 至少保留 kHistorySize 帧给面板；更早的帧超过捕获时长后淘汰
+    uint64_t window = static_cast<uint64_t>(std::max(_captureSeconds, 0.0f) * 1e9);
+    uint64_t newestNs = _frames.back().endNs;
+    while (_frames.size() > kHistorySize &&
+           (_frames.size() > kMaxCaptureFrames || newestNs - _frames.front().endNs > window)) {
+        _spareFrames.push_back(std::move(_frames.front()));
+        _frames.pop_front();
+    }
+}
+
+bool Profiler::dumpCapture(const std::string& path, TraceFormat format) const
+{
+    std::vector<std::string> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(_threadsMutex);
+        for (const auto& thread : _threads) threadNames.push_back(thread->name);
+    }
+
+    if (format == TraceFormat::Perfetto) return TraceExporter::writePerfetto(path, _frames, threadNames);
+    return TraceExporter::writeChromeJson(path, _frames, threadNames);
+}
+
+void Profiler::dumpNow(const char* reason)
+{
+    if (_frames.empty()) return;
+
+    std::error_code ec;
+    if (!_captureDirectory.empty()) std::filesystem::create_directories(_captureDirectory, ec);
+
+    const char* extension = _captureFormat == TraceFormat::Perfetto ? ".perfetto-trace" : ".json";
+    std::string path = _captureDirectory + "trace_" + std::to_string(_frames.back().index) + extension;
+
+    auto start = std::chrono::steady_clock::now();
+    if (!dumpCapture(path, _captureFormat)) {
+        std::cerr << "[Profiler] Failed to write trace: " << path << std::endl;
+        return;
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    _lastDumpPath = path;
+    std::cout << "[Profiler] Trace written (" << reason << "): " << path << " ("
+              << _frames.size() << " frames, " << ms << " ms)" << std::endl;
+}
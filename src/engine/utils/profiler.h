@@ -1,20 +1,244 @@
 #pragma once
+#include <atomic>
 #include <chrono>
-#include <iostream>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
-class ScopedTimer {
+// 记录的来源 (导出时作为 trace 的分类)
+enum class ProfileCategory : uint8_t {
+    Cpu,   // CPU 作用域
+    Gpu,   // GPU pass
+    Asset  // 资源加载 (名字带文件路径)
+};
+
+// 一次计时记录 (CPU 作用域或 GPU pass)，时间为 Profiler 启动后的纳秒数
+struct ProfileEvent {
+    const char* name = nullptr; // 必须是静态字符串或 Profiler::internName 的结果 (记录时不拷贝)
+    uint64_t startNs = 0;
+    uint64_t endNs = 0;
+    uint16_t threadIndex = 0;   // Profiler 中的线程编号；GPU 事件为 Profiler::kGpuThread
+    uint16_t depth = 0;         // 嵌套深度 (0 为最外层)
+    ProfileCategory category = ProfileCategory::Cpu;
+
+    double getMs() const { return (endNs - startNs) / 1e6; }
+};
+
+// 计数器在某一时刻的取值 (分配次数、帧内存等)
+struct ProfileCounter {
+    const char* name = nullptr; // 静态字符串
+    double value = 0.0;
+    uint64_t timeNs = 0;
+};
+
+// 历史中的一帧：上一个帧边界到这一个帧边界之间完成的所有作用域
+struct ProfileFrame {
+    uint64_t index = 0;
+    uint64_t startNs = 0;
+    uint64_t endNs = 0;
+    std::vector<ProfileEvent> cpuEvents;  // 按线程、开始时间排序
+    std::vector<ProfileEvent> gpuEvents;  // 按提交顺序；GPU 结果晚几帧才取回
+    std::vector<ProfileCounter> counters; // 按记录顺序
+    bool gpuResolved = false;
+
+    double getMs() const { return (endNs - startNs) / 1e6; }
+    double getGpuMs() const;              // GPU pass 的时长之和
+};
+
+// 导出格式
+enum class TraceFormat {
+    ChromeJson, // Chrome trace-event JSON (chrome://tracing、Perfetto UI 均可打开)
+    Perfetto    // Perfetto 的 protobuf trace
+};
+
+// ==========================================
+// 帧分析器 (CPU 部分)
+// ==========================================
+// 任意线程都可以用 ProfileScope 记录嵌套的作用域，记录进各线程自己的缓冲区 (容量稳定后不分配内存)；
+// 帧边界上 endFrame 把各线程这一帧完成的记录收进捕获环。GPU 计时由 GpuProfiler 取回后交给 submitGpuEvents。
+// 捕获环保存最近若干秒的帧 (至少 kHistorySize 帧)，可以按快捷键或在某一帧超过耗时阈值时导出为 trace 文件。
+// 捕获环只在帧边界上修改 (此时 UI 线程阻塞或就是调用者)，UI 线程可以直接读取。
+class Profiler
+{
+public:
+    static Profiler& Get();
+
+    static constexpr size_t kHistorySize = 240;
+    static constexpr uint16_t kGpuThread = 0xFFFF;
+
+    void setEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    // 冻结时捕获环不再更新 (检查某一帧时使用)，各线程的记录照常丢弃
+    void setFrozen(bool frozen) { _frozen = frozen; }
+    bool isFrozen() const { return _frozen; }
+
+    // 给当前线程起名 (显示在时间线上)
+    void setThreadName(const std::string& name);
+    std::string getThreadName(uint16_t threadIndex) const;
+
+    // 把运行时生成的名字 (如带路径的资源名) 变成一直有效的字符串，相同内容返回同一个指针
+    const char* internName(const std::string& name);
+
+    uint64_t now() const;
+
+    // ProfileScope 使用：开始时返回时间戳，结束时写入记录
+    uint64_t beginScope();
+    void endScope(const char* name, uint64_t startNs, ProfileCategory category = ProfileCategory::Cpu);
+
+    // 记录一个计数器取值，归入正在收集的帧
+    void setCounter(const char* name, double value);
+
+    // 正在收集的帧序号 (GPU 查询用它标记所属的帧)
+    uint64_t getFrameIndex() const { return _frameIndex.load(std::memory_order_acquire); }
+
+    // [帧边界] 结束当前帧：收集各线程的记录写入捕获环，挂上此前取回的 GPU 结果，需要时导出 trace
+    void endFrame();
+
+    // [渲染线程] 某一帧的 GPU pass 计时 (在下一个帧边界并入捕获环)
+    void submitGpuEvents(uint64_t frameIndex, const ProfileEvent* events, size_t count);
+
+    // 历史：0 为最近完成的一帧 (最多 kHistorySize 帧)
+    size_t getHistoryCount() const;
+    const ProfileFrame& getHistoryFrame(size_t age) const;
+
+    // ------------------------------------------
+    // 捕获与导出
+    // ------------------------------------------
+    void setCaptureSeconds(float seconds) { _captureSeconds = seconds; }
+    float getCaptureSeconds() const { return _captureSeconds; }
+    size_t getCaptureFrameCount() const { return _frames.size(); }
+
+    // 导出文件的目录与格式 (文件名为 trace_<帧序号>.json / .perfetto-trace)
+    void setCaptureDirectory(const std::string& directory) { _captureDirectory = directory; }
+    void setCaptureFormat(TraceFormat format) { _captureFormat = format; }
+    TraceFormat getCaptureFormat() const { return _captureFormat; }
+
+    // 某一帧超过阈值 (毫秒) 时自动导出，0 为关闭；导出推迟几帧，等这一帧的 GPU 结果取回
+    void setHitchThresholdMs(float ms) { _hitchThresholdMs = ms; }
+    float getHitchThresholdMs() const { return _hitchThresholdMs; }
+
+    // 在下一个帧边界导出当前捕获环
+    void requestDump() { _dumpRequested = true; }
+
+    // 立即把捕获环写到 path；失败时返回 false
+    bool dumpCapture(const std::string& path, TraceFormat format) const;
+    const std::string& getLastDumpPath() const { return _lastDumpPath; }
+
+private:
+    Profiler();
+
+    struct ThreadBuffer {
+        std::mutex mutex;
+        std::vector<ProfileEvent> events;
+        std::string name;
+        uint16_t index = 0;
+        uint16_t depth = 0; // 只有所属线程读写
+    };
+
+    ThreadBuffer& currentThread();
+
+    std::atomic<bool> _enabled{ true };
+    bool _frozen = false;
+    std::chrono::steady_clock::time_point _origin;
+
+    mutable std::mutex _threadsMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> _threads;
+
+    std::mutex _namesMutex;
+    std::unordered_set<std::string> _names;
+
+    std::atomic<uint64_t> _frameIndex{ 0 };
+    uint64_t _frameStartNs = 0;
+    size_t _frameStartAllocations = 0;
+    size_t _frameStartAllocatedBytes = 0;
+
+    // 捕获环：最旧的帧在前；淘汰的帧放进 _spareFrames，数组留给新帧复用
+    std::deque<ProfileFrame> _frames;
+    std::vector<ProfileFrame> _spareFrames;
+    float _captureSeconds = 10.0f;
+
+    // 等待并入捕获环的 GPU 结果与计数器
+    struct GpuFrame {
+        uint64_t frameIndex = 0;
+        std::vector<ProfileEvent> events;
+    };
+    std::mutex _gpuMutex;
+    std::vector<GpuFrame> _pendingGpu;
+    size_t _pendingGpuCount = 0;
+
+    std::mutex _counterMutex;
+    std::vector<ProfileCounter> _pendingCounters;
+
+    // 导出
+    std::string _captureDirectory;
+    TraceFormat _captureFormat = TraceFormat::ChromeJson;
+    float _hitchThresholdMs = 0.0f;
+    bool _dumpRequested = false;
+    uint64_t _hitchDumpFrame = 0;    // 非 0 时到这一帧导出
+    uint64_t _lastHitchDumpNs = 0;
+    bool _hasHitchDump = false;
+    std::string _lastDumpPath;
+
+    ProfileFrame* findFrame(uint64_t frameIndex);
+    ProfileFrame& pushFrame();
+    void evictFrames();
+    void dumpNow(const char* reason);
+};
+
+// 记录一个 CPU 作用域，例如 ProfileScope scope("Shadow CSM");
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name) : _name(name)
+    {
+        Profiler& profiler = Profiler::Get();
+        if (profiler.isEnabled()) {
+            _startNs = profiler.beginScope();
+            _active = true;
+        }
+    }
+
+    ~ProfileScope()
+    {
+        if (_active) Profiler::Get().endScope(_name, _startNs);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* _name;
+    uint64_t _startNs = 0;
+    bool _active = false;
+};
+
+// 记录一次资源加载，名字在运行时拼出 (如 "OBJLoader::loadScene (path)")，导出时归入 asset 分类
+class AssetLoadScope
+{
 public:
-    ScopedTimer(const std::string& name) : _name(name) {
-        _start = std::chrono::high_resolution_clock::now();
+    explicit AssetLoadScope(const std::string& name)
+    {
+        Profiler& profiler = Profiler::Get();
+        if (profiler.isEnabled()) {
+            _name = profiler.internName(name);
+            _startNs = profiler.beginScope();
+        }
     }
-    
-    ~ScopedTimer() {
-        auto end = std::chrono::high_resolution_clock::now();
-        double duration = std::chrono::duration<double, std::milli>(end - _start).count();
-        std::cout << "[Timer] " << _name << " took " << duration << " ms" << std::endl;
+
+    ~AssetLoadScope()
+    {
+        if (_name) Profiler::Get().endScope(_name, _startNs, ProfileCategory::Asset);
     }
+
+    AssetLoadScope(const AssetLoadScope&) = delete;
+    AssetLoadScope& operator=(const AssetLoadScope&) = delete;
+
 private:
-    std::string _name;
-    std::chrono::time_point<std::chrono::high_resolution_clock> _start;
-};
\ No newline at end of file
+    const char* _name = nullptr;
+    uint64_t _startNs = 0;
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+// 分片加锁的哈希表
+// 按 key 的哈希值把数据分散到 ShardCount 个子表，每个子表有独立的互斥锁。
+// 不同资源的并发查询/插入大多落在不同分片上，不会互相阻塞。
+// 注意：接口全部按值返回，绝不把内部元素的引用泄漏到锁外。
+template <typename K, typename V, size_t ShardCount = 16>
+class ShardedMap
+{
+public:
+    // 查找，命中时拷贝到 out
+    bool find(const K& key, V& out) const
+    {
+        const Shard& s = shardFor(key);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto it = s.map.find(key);
+        if (it == s.map.end()) return false;
+        out = it->second;
+        return true;
+    }
+
+    bool contains(const K& key) const
+    {
+        const Shard& s = shardFor(key);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        return s.map.find(key) != s.map.end();
+    }
+
+    // 插入或覆盖
+    void assign(const K& key, V value)
+    {
+        Shard& s = shardFor(key);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.map[key] = std::move(value);
+    }
+
+    bool erase(const K& key)
+    {
+        Shard& s = shardFor(key);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        return s.map.erase(key) > 0;
+    }
+
+    // 在锁内原地修改某个元素，返回是否存在
+    bool update(const K& key, const std::function<void(V&)>& fn)
+    {
+        Shard& s = shardFor(key);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto it = s.map.find(key);
+        if (it == s.map.end()) return false;
+        fn(it->second);
+        return true;
+    }
+
+    // 在锁内查找或插入 (不存在时先默认构造)，再交给 fn 原地修改
+    // 用于"先查后插"必须原子完成的场景
+    void upsert(const K& key, const std::function<void(V&)>& fn)
+    {
+        Shard& s = shardFor(key);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        fn(s.map[key]);
+    }
+
+    // 逐分片遍历 (遍历期间只锁当前分片)
+    void forEach(const std::function<void(const K&, V&)>& fn)
+    {
+        for (Shard& s : _shards) {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            for (auto& kv : s.map) fn(kv.first, kv.second);
+        }
+    }
+
+    // 按条件删除
+    size_t eraseIf(const std::function<bool(const K&, V&)>& pred)
+    {
+        size_t removed = 0;
+        for (Shard& s : _shards) {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            for (auto it = s.map.begin(); it != s.map.end();) {
+                if (pred(it->first, it->second)) { it = s.map.erase(it); ++removed; }
+                else ++it;
+            }
+        }
+        return removed;
+    }
+
+    void clear()
+    {
+        for (Shard& s : _shards) {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.map.clear();
+        }
+    }
+
+    size_t size() const
+    {
+        size_t total = 0;
+        for (const Shard& s : _shards) {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            total += s.map.size();
+        }
+        return total;
+    }
+
+private:
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<K, V> map;
+    };
+
+    std::array<Shard, ShardCount> _shards;
+
+    Shard& shardFor(const K& key)
+    {
+        // 高位再混一次，避免低位分布不均
+        size_t h = std::hash<K>()(key);
+        h ^= (h >> 33);
+        return _shards[h % ShardCount];
+    }
+
+    const Shard& shardFor(const K& key) const
+    {
+        return const_cast<ShardedMap*>(this)->shardFor(key);
+    }
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 简单的固定大小工作线程池
+// 资源加载 (解析/解码) 都丢到这里执行，主线程只负责 GL 上传
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t threadCount = 0)
+    {
+        if (threadCount == 0) {
+            unsigned hw = std::thread::hardware_concurrency();
+            // 留一个核给主线程 (GL + UI)
+            threadCount = std::max(1u, hw > 1 ? hw - 1 : 1u);
+        }
+        for (size_t i = 0; i < threadCount; ++i) {
+            _workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _cv.notify_all();
+        for (auto& t : _workers) {
+            if (t.joinable()) t.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void enqueue(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push_back(std::move(task));
+        }
+        _cv.notify_one();
+    }
+
+    size_t getThreadCount() const { return _workers.size(); }
+
+    // 调用线程是否是本线程池的工作线程
+    // (工作线程里不能等待只有本线程池才能完成的 future，否则所有线程都在等时会死锁)
+    bool isWorkerThread() const { return currentPool() == this; }
+
+    // 阻塞直到队列为空且没有正在执行的任务 (不能在工作线程里调用)
+    void waitIdle()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idleCv.wait(lock, [this]() { return _tasks.empty() && _busy == 0; });
+    }
+
+private:
+    std::vector<std::thread> _workers;
+    std::deque<std::function<void()>> _tasks;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::condition_variable _idleCv;
+    size_t _busy = 0;
+    bool _stopping = false;
+
+    static const ThreadPool*& currentPool()
+    {
+        thread_local const ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    void workerLoop()
+    {
+        currentPool() = this;
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _cv.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+                if (_stopping && _tasks.empty()) return;
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+                _busy++;
+            }
+            task();
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _busy--;
+                if (_busy == 0 && _tasks.empty()) _idleCv.notify_all();
+            }
+        }
+    }
+};
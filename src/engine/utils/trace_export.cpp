@@ -0,0 +1,351 @@
+#include "trace_export.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// 帧区间轨道的线程号 (GPU 使用 Profiler::kGpuThread)
+constexpr uint16_t kFrameTrack = 0xFFFE;
+
+const char* categoryName(ProfileCategory category)
+{
+    switch (category) {
+        case ProfileCategory::Gpu:   return "gpu";
+        case ProfileCategory::Asset: return "asset";
+        default:                     return "cpu";
+    }
+}
+
+// 所有帧的 CPU 作用域，按线程、开始时间、深度排序 (跨帧的父子作用域也能正确嵌套)
+std::vector<const ProfileEvent*> collectCpuEvents(const std::deque<ProfileFrame>& frames)
+{
+    std::vector<const ProfileEvent*> events;
+    for (const ProfileFrame& frame : frames) {
+        for (const ProfileEvent& e : frame.cpuEvents) events.push_back(&e);
+    }
+    std::sort(events.begin(), events.end(), [](const ProfileEvent* a, const ProfileEvent* b) {
+        if (a->threadIndex != b->threadIndex) return a->threadIndex < b->threadIndex;
+        if (a->startNs != b->startNs) return a->startNs < b->startNs;
+        return a->depth < b->depth;
+    });
+    return events;
+}
+
+// ==========================================
+// JSON
+// ==========================================
+std::string jsonString(const char* text)
+{
+    std::string out = "\"";
+    for (const char* c = text; *c; ++c) {
+        switch (*c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(*c));
+                    out += escaped;
+                } else {
+                    out += *c;
+                }
+        }
+    }
+    out += "\"";
+    return out;
+}
+
+// trace-event 的时间单位是微秒
+double toUs(uint64_t ns) { return ns / 1000.0; }
+
+// ==========================================
+// Protobuf 编码 (只用到 varint / fixed64 / length-delimited 三种)
+// ==========================================
+class ProtoWriter
+{
+public:
+    void varint(uint32_t field, uint64_t value)
+    {
+        key(field, 0);
+        rawVarint(value);
+    }
+
+    void fixedDouble(uint32_t field, double value)
+    {
+        key(field, 1);
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for (int i = 0; i < 8; ++i) _data.push_back(static_cast<char>((bits >> (i * 8)) & 0xFF));
+    }
+
+    void bytes(uint32_t field, const char* data, size_t size)
+    {
+        key(field, 2);
+        rawVarint(size);
+        _data.append(data, size);
+    }
+
+    void string(uint32_t field, const std::string& text) { bytes(field, text.data(), text.size()); }
+    void message(uint32_t field, const ProtoWriter& child) { bytes(field, child._data.data(), child._data.size()); }
+
+    const std::string& data() const { return _data; }
+
+private:
+    std::string _data;
+
+    void key(uint32_t field, uint32_t wireType) { rawVarint((static_cast<uint64_t>(field) << 3) | wireType); }
+
+    void rawVarint(uint64_t value)
+    {
+        while (value >= 0x80) {
+            _data.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        _data.push_back(static_cast<char>(value));
+    }
+};
+
+// Perfetto trace.proto 中用到的字段号
+namespace pf {
+    // Trace
+    constexpr uint32_t kPacket = 1;
+    // TracePacket
+    constexpr uint32_t kTimestamp = 8;
+    constexpr uint32_t kSequenceId = 10;
+    constexpr uint32_t kTrackEvent = 11;
+    constexpr uint32_t kSequenceFlags = 13;
+    constexpr uint32_t kTrackDescriptor = 60;
+    constexpr uint64_t kSeqIncrementalStateCleared = 1;
+    // TrackDescriptor
+    constexpr uint32_t kUuid = 1;
+    constexpr uint32_t kName = 2;
+    constexpr uint32_t kProcess = 3;
+    constexpr uint32_t kThread = 4;
+    constexpr uint32_t kParentUuid = 5;
+    constexpr uint32_t kCounter = 8;
+    // ProcessDescriptor / ThreadDescriptor
+    constexpr uint32_t kPid = 1;
+    constexpr uint32_t kTid = 2;
+    constexpr uint32_t kThreadName = 5;
+    constexpr uint32_t kProcessName = 6;
+    // TrackEvent
+    constexpr uint32_t kType = 9;
+    constexpr uint32_t kTrackUuid = 11;
+    constexpr uint32_t kCategories = 22;
+    constexpr uint32_t kEventName = 23;
+    constexpr uint32_t kDoubleCounterValue = 44;
+    constexpr uint64_t kSliceBegin = 1;
+    constexpr uint64_t kSliceEnd = 2;
+    constexpr uint64_t kCounterEvent = 4;
+
+    // 轨道 uuid
+    constexpr uint64_t kProcessTrack = 1;
+    constexpr uint64_t kGpuTrack = 2;
+    constexpr uint64_t kFramesTrack = 3;
+    constexpr uint64_t kThreadTrackBase = 100;
+    constexpr uint64_t kCounterTrackBase = 10000;
+    constexpr uint64_t kProcessId = 1;
+}
+
+class PerfettoWriter
+{
+public:
+    explicit PerfettoWriter(std::ofstream& out) : _out(out) {}
+
+    void packet(ProtoWriter& packet)
+    {
+        packet.varint(pf::kSequenceId, 1);
+        if (_first) {
+            packet.varint(pf::kSequenceFlags, pf::kSeqIncrementalStateCleared);
+            _first = false;
+        }
+        ProtoWriter wrapper;
+        wrapper.message(pf::kPacket, packet);
+        _out.write(wrapper.data().data(), wrapper.data().size());
+    }
+
+    void track(uint64_t uuid, const std::string& name, bool counter)
+    {
+        ProtoWriter desc;
+        desc.varint(pf::kUuid, uuid);
+        desc.string(pf::kName, name);
+        desc.varint(pf::kParentUuid, pf::kProcessTrack);
+        if (counter) desc.message(pf::kCounter, ProtoWriter());
+        ProtoWriter p;
+        p.message(pf::kTrackDescriptor, desc);
+        packet(p);
+    }
+
+    void slice(uint64_t track, uint64_t timeNs, uint64_t type, const char* name = nullptr, const char* category = nullptr)
+    {
+        ProtoWriter event;
+        event.varint(pf::kType, type);
+        event.varint(pf::kTrackUuid, track);
+        if (category) event.string(pf::kCategories, category);
+        if (name) event.string(pf::kEventName, name);
+        ProtoWriter p;
+        p.varint(pf::kTimestamp, timeNs);
+        p.message(pf::kTrackEvent, event);
+        packet(p);
+    }
+
+    void counter(uint64_t track, uint64_t timeNs, double value)
+    {
+        ProtoWriter event;
+        event.varint(pf::kType, pf::kCounterEvent);
+        event.varint(pf::kTrackUuid, track);
+        event.fixedDouble(pf::kDoubleCounterValue, value);
+        ProtoWriter p;
+        p.varint(pf::kTimestamp, timeNs);
+        p.message(pf::kTrackEvent, event);
+        packet(p);
+    }
+
+private:
+    std::ofstream& _out;
+    bool _first = true;
+};
+
+} // namespace
+
+bool TraceExporter::writeChromeJson(const std::string& path, const std::deque<ProfileFrame>& frames,
+                                    const std::vector<std::string>& threadNames)
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    char line[256];
+    auto emit = [&](const std::string& text) {
+        if (!first) out << ",\n";
+        first = false;
+        out << text;
+    };
+    auto threadMeta = [&](uint16_t tid, const std::string& name, int sortIndex) {
+        emit("{\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(tid) +
+             ",\"name\":\"thread_name\",\"args\":{\"name\":" + jsonString(name.c_str()) + "}}");
+        emit("{\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(tid) +
+             ",\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":" + std::to_string(sortIndex) + "}}");
+    };
+    auto complete = [&](const ProfileEvent& e, uint16_t tid) {
+        snprintf(line, sizeof(line), ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                 static_cast<unsigned>(tid), toUs(e.startNs), toUs(e.endNs - e.startNs));
+        emit("{\"name\":" + jsonString(e.name) + ",\"cat\":\"" + categoryName(e.category) + "\"" + line);
+    };
+
+    // 元数据：进程与各轨道的名字 (帧区间在最上，GPU 在最下)
+    emit("{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"ytinU\"}}");
+    threadMeta(kFrameTrack, "Frames", -1);
+    for (size_t i = 0; i < threadNames.size(); ++i) threadMeta(static_cast<uint16_t>(i), threadNames[i], static_cast<int>(i));
+    threadMeta(Profiler::kGpuThread, "GPU", static_cast<int>(threadNames.size()));
+
+    for (const ProfileFrame& frame : frames) {
+        snprintf(line, sizeof(line), "{\"name\":\"Frame %llu\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                 static_cast<unsigned long long>(frame.index), static_cast<unsigned>(kFrameTrack),
+                 toUs(frame.startNs), toUs(frame.endNs - frame.startNs));
+        emit(line);
+
+        for (const ProfileEvent& e : frame.cpuEvents) complete(e, e.threadIndex);
+        for (const ProfileEvent& e : frame.gpuEvents) complete(e, Profiler::kGpuThread);
+        for (const ProfileCounter& c : frame.counters) {
+            snprintf(line, sizeof(line), ",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"value\":%.3f}}", toUs(c.timeNs), c.value);
+            emit("{\"name\":" + jsonString(c.name) + line);
+        }
+    }
+
+    out << "\n]}\n";
+    return out.good();
+}
+
+bool TraceExporter::writePerfetto(const std::string& path, const std::deque<ProfileFrame>& frames,
+                                  const std::vector<std::string>& threadNames)
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+    PerfettoWriter writer(out);
+
+    // 1. 轨道描述：进程 -> 各线程 / GPU / 帧区间 / 计数器
+    {
+        ProtoWriter process;
+        process.varint(pf::kPid, pf::kProcessId);
+        process.string(pf::kProcessName, "ytinU");
+        ProtoWriter desc;
+        desc.varint(pf::kUuid, pf::kProcessTrack);
+        desc.message(pf::kProcess, process);
+        ProtoWriter p;
+        p.message(pf::kTrackDescriptor, desc);
+        writer.packet(p);
+    }
+    for (size_t i = 0; i < threadNames.size(); ++i) {
+        ProtoWriter thread;
+        thread.varint(pf::kPid, pf::kProcessId);
+        thread.varint(pf::kTid, i + 1);
+        thread.string(pf::kThreadName, threadNames[i]);
+        ProtoWriter desc;
+        desc.varint(pf::kUuid, pf::kThreadTrackBase + i);
+        desc.message(pf::kThread, thread);
+        ProtoWriter p;
+        p.message(pf::kTrackDescriptor, desc);
+        writer.packet(p);
+    }
+    writer.track(pf::kGpuTrack, "GPU", false);
+    writer.track(pf::kFramesTrack, "Frames", false);
+
+    std::vector<const char*> counterNames;
+    auto counterTrack = [&](const char* name) -> uint64_t {
+        for (size_t i = 0; i < counterNames.size(); ++i) {
+            if (std::strcmp(counterNames[i], name) == 0) return pf::kCounterTrackBase + i;
+        }
+        counterNames.push_back(name);
+        uint64_t uuid = pf::kCounterTrackBase + counterNames.size() - 1;
+        writer.track(uuid, name, true);
+        return uuid;
+    };
+
+    // 2. 帧区间、GPU pass 与计数器 (GPU pass 在同一轨道上不能重叠，跨帧时顺延)
+    uint64_t gpuCursor = 0;
+    for (const ProfileFrame& frame : frames) {
+        std::string frameName = "Frame " + std::to_string(frame.index);
+        writer.slice(pf::kFramesTrack, frame.startNs, pf::kSliceBegin, frameName.c_str(), "frame");
+        writer.slice(pf::kFramesTrack, frame.endNs, pf::kSliceEnd);
+
+        for (const ProfileEvent& e : frame.gpuEvents) {
+            uint64_t start = std::max(e.startNs, gpuCursor);
+            uint64_t end = start + (e.endNs - e.startNs);
+            writer.slice(pf::kGpuTrack, start, pf::kSliceBegin, e.name, "gpu");
+            writer.slice(pf::kGpuTrack, end, pf::kSliceEnd);
+            gpuCursor = end;
+        }
+
+        for (const ProfileCounter& c : frame.counters) writer.counter(counterTrack(c.name), c.timeNs, c.value);
+    }
+
+    // 3. CPU 作用域：按深度维护一个栈，开始新作用域前结束同层及更深的作用域
+    //    (捕获末尾仍未结束的父作用域没有记录，已经结束的栈顶也要先关掉)
+    std::vector<const ProfileEvent*> events = collectCpuEvents(frames);
+    std::vector<const ProfileEvent*> stack;
+    auto closeUntil = [&](uint16_t thread, size_t depth) {
+        while (stack.size() > depth) {
+            writer.slice(pf::kThreadTrackBase + thread, stack.back()->endNs, pf::kSliceEnd);
+            stack.pop_back();
+        }
+    };
+    for (size_t i = 0; i < events.size(); ++i) {
+        const ProfileEvent& e = *events[i];
+        if (i > 0 && events[i - 1]->threadIndex != e.threadIndex) closeUntil(events[i - 1]->threadIndex, 0);
+        while (!stack.empty() && (stack.back()->depth >= e.depth || stack.back()->endNs <= e.startNs)) {
+            closeUntil(e.threadIndex, stack.size() - 1);
+        }
+        writer.slice(pf::kThreadTrackBase + e.threadIndex, e.startNs, pf::kSliceBegin, e.name, categoryName(e.category));
+        stack.push_back(&e);
+    }
+    if (!events.empty()) closeUntil(events.back()->threadIndex, 0);
+
+    return out.good();
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "profiler.h"
+
+// ==========================================
+// 捕获环导出 (离线分析用)
+// ==========================================
+// 每个线程一条轨道 (CPU 作用域按嵌套深度显示为火焰图)，另有 GPU、帧区间和计数器轨道。
+// threadNames 按 Profiler 的线程编号排列。
+class TraceExporter
+{
+public:
+    // Chrome trace-event JSON ("X" 完整事件 + "C" 计数器)
+    static bool writeChromeJson(const std::string& path, const std::deque<ProfileFrame>& frames,
+                                const std::vector<std::string>& threadNames);
+
+    // Perfetto protobuf (TrackDescriptor + TrackEvent，手写编码，不依赖 protobuf 库)
+    static bool writePerfetto(const std::string& path, const std::deque<ProfileFrame>& frames,
+                              const std::vector<std::string>& threadNames);
+};
@@ -0,0 +1,222 @@
+#include "vertex_packing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#include <glm/gtc/packing.hpp>
+
+namespace {
+
+int16_t toSnorm16(float v)
+{
+    return static_cast<int16_t>(std::lround(std::clamp(v, -1.0f, 1.0f) * 32767.0f));
+}
+
+int8_t toSnorm8(float v)
+{
+    return static_cast<int8_t>(std::lround(std::clamp(v, -1.0f, 1.0f) * 127.0f));
+}
+
+// 与 GL 的 snorm 解码规则一致 (c / (2^(b-1) - 1)，下限 -1)
+float fromSnorm16(int16_t v) { return std::max(v / 32767.0f, -1.0f); }
+float fromSnorm8(int8_t v) { return std::max(v / 127.0f, -1.0f); }
+
+// 两个方向的夹角 (度)，零向量不参与统计
+float angleBetween(const glm::vec3& a, const glm::vec3& b)
+{
+    float la = glm::length(a);
+    float lb = glm::length(b);
+    if (la < 1e-8f || lb < 1e-8f) return 0.0f;
+    float c = std::clamp(glm::dot(a, b) / (la * lb), -1.0f, 1.0f);
+    return glm::degrees(std::acos(c));
+}
+
+// 法线、UV、切线的打包 (两种压缩格式共用)，同时累计误差
+void packAttributes(const Vertex& v, PackedAttributes& out, PackedVertexData& stats)
+{
+    glm::vec2 n = VertexPacking::octEncode(v.normal);
+    out.normal[0] = toSnorm16(n.x);
+    out.normal[1] = toSnorm16(n.y);
+
+    out.texCoord[0] = glm::packHalf1x16(v.texCoord.x);
+    out.texCoord[1] = glm::packHalf1x16(v.texCoord.y);
+
+    glm::vec3 tangent(v.tangent);
+    glm::vec2 t = VertexPacking::octEncode(tangent);
+    out.tangent[0] = toSnorm8(t.x);
+    out.tangent[1] = toSnorm8(t.y);
+    out.tangent[2] = v.tangent.w < 0.0f ? -127 : 127;
+    out.tangent[3] = 0;
+
+    // 误差按 GPU 实际解码出来的值计算
+    glm::vec3 decodedNormal = VertexPacking::octDecode(glm::vec2(fromSnorm16(out.normal[0]), fromSnorm16(out.normal[1])));
+    stats.maxNormalError = std::max(stats.maxNormalError, angleBetween(v.normal, decodedNormal));
+
+    glm::vec3 decodedTangent = VertexPacking::octDecode(glm::vec2(fromSnorm8(out.tangent[0]), fromSnorm8(out.tangent[1])));
+    stats.maxTangentError = std::max(stats.maxTangentError, angleBetween(tangent, decodedTangent));
+
+    glm::vec2 decodedUV(glm::unpackHalf1x16(out.texCoord[0]), glm::unpackHalf1x16(out.texCoord[1]));
+    glm::vec2 uvError = glm::abs(decodedUV - v.texCoord);
+    stats.maxTexCoordError = std::max(stats.maxTexCoordError, std::max(uvError.x, uvError.y));
+}
+
+} // namespace
+
+size_t VertexPacking::getStride(VertexFormat format)
+{
+    switch (format) {
+    case VertexFormat::Compact:          return sizeof(CompactVertex);
+    case VertexFormat::CompactQuantized: return sizeof(CompactQuantizedVertex);
+    default:                             return sizeof(Vertex);
+    }
+}
+
+const char* VertexPacking::getFormatName(VertexFormat format)
+{
+    switch (format) {
+    case VertexFormat::Compact:          return "Compact";
+    case VertexFormat::CompactQuantized: return "Compact (quantized)";
+    default:                             return "Standard";
+    }
+}
+
+glm::vec2 VertexPacking::octEncode(const glm::vec3& n)
+{
+    float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    if (l1 < 1e-8f) return glm::vec2(0.0f);
+
+    glm::vec3 p = n / l1;
+    glm::vec2 e(p.x, p.y);
+    if (p.z < 0.0f) {
+        // 下半球沿对角线折叠到外侧
+        e.x = (1.0f - std::abs(p.y)) * (p.x >= 0.0f ? 1.0f : -1.0f);
+        e.y = (1.0f - std::abs(p.x)) * (p.y >= 0.0f ? 1.0f : -1.0f);
+    }
+    return e;
+}
+
+glm::vec3 VertexPacking::octDecode(const glm::vec2& e)
+{
+    glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+    float t = std::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return glm::normalize(n);
+}
+
+PackedVertexData VertexPacking::pack(const std::vector<Vertex>& vertices, VertexFormat format, const BoundingBox& box)
+{
+    PackedVertexData data;
+    data.format = format;
+    if (format == VertexFormat::Standard) return data;
+
+    data.bytes.resize(vertices.size() * getStride(format));
+
+    if (format == VertexFormat::Compact) {
+        auto* out = reinterpret_cast<CompactVertex*>(data.bytes.data());
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            std::memcpy(out[i].position, &vertices[i].position, sizeof(out[i].position));
+            packAttributes(vertices[i], out[i].attributes, data);
+        }
+        return data;
+    }
+
+    // 量化到包围盒：unorm16 解码为 [0, 1]，再由 positionScale / positionOffset 还原
+    data.positionOffset = box.min;
+    data.positionScale = box.max - box.min;
+    glm::vec3 invScale(0.0f);
+    for (int a = 0; a < 3; ++a) {
+        if (data.positionScale[a] > 0.0f) invScale[a] = 65535.0f / data.positionScale[a];
+    }
+
+    auto* out = reinterpret_cast<CompactQuantizedVertex*>(data.bytes.data());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const glm::vec3& p = vertices[i].position;
+        glm::vec3 q = glm::clamp(glm::round((p - box.min) * invScale), glm::vec3(0.0f), glm::vec3(65535.0f));
+        out[i].position[0] = static_cast<uint16_t>(q.x);
+        out[i].position[1] = static_cast<uint16_t>(q.y);
+        out[i].position[2] = static_cast<uint16_t>(q.z);
+        out[i].position[3] = 0;
+
+        glm::vec3 decoded = q / 65535.0f * data.positionScale + data.positionOffset;
+        data.maxPositionError = std::max(data.maxPositionError, glm::length(decoded - p));
+
+        packAttributes(vertices[i], out[i].attributes, data);
+    }
+    return data;
+}
+
+void VertexPacking::setupAttributes(VertexFormat format)
+{
+    GLsizei stride = static_cast<GLsizei>(getStride(format));
+
+    if (format == VertexFormat::Standard) {
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(Vertex, position));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(Vertex, normal));
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(Vertex, texCoord));
+        glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(Vertex, tangent));
+    } else {
+        size_t attributes = 0;
+        if (format == VertexFormat::Compact) {
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(CompactVertex, position));
+            attributes = offsetof(CompactVertex, attributes);
+        } else {
+            glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void *)offsetof(CompactQuantizedVertex, position));
+            attributes = offsetof(CompactQuantizedVertex, attributes);
+        }
+        glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, stride, (void *)(attributes + offsetof(PackedAttributes, normal)));
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void *)(attributes + offsetof(PackedAttributes, texCoord)));
+        glVertexAttribPointer(3, 4, GL_BYTE, GL_TRUE, stride, (void *)(attributes + offsetof(PackedAttributes, tangent)));
+    }
+
+    for (GLuint location = 0; location < 4; ++location) glEnableVertexAttribArray(location);
+}
+
+size_t VertexPacking::getPositionStride(VertexFormat format)
+{
+    return format == VertexFormat::CompactQuantized ? 4 * sizeof(uint16_t) : 3 * sizeof(float);
+}
+
+std::vector<uint8_t> VertexPacking::extractPositions(const std::vector<Vertex>& vertices, const PackedVertexData& packed)
+{
+    std::vector<uint8_t> bytes;
+    if (packed.format == VertexFormat::CompactQuantized && !packed.bytes.empty()) {
+        size_t count = packed.bytes.size() / sizeof(CompactQuantizedVertex);
+        const auto* in = reinterpret_cast<const CompactQuantizedVertex*>(packed.bytes.data());
+        bytes.resize(count * getPositionStride(packed.format));
+        auto* out = reinterpret_cast<uint16_t*>(bytes.data());
+        for (size_t i = 0; i < count; ++i) std::memcpy(out + i * 4, in[i].position, sizeof(in[i].position));
+        return bytes;
+    }
+
+    bytes.resize(vertices.size() * getPositionStride(VertexFormat::Standard));
+    auto* out = reinterpret_cast<float*>(bytes.data());
+    for (size_t i = 0; i < vertices.size(); ++i) std::memcpy(out + i * 3, &vertices[i].position, 3 * sizeof(float));
+    return bytes;
+}
+
+void VertexPacking::setupPositionAttribute(VertexFormat format)
+{
+    GLsizei stride = static_cast<GLsizei>(getPositionStride(format));
+    if (format == VertexFormat::CompactQuantized) {
+        glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void *)0);
+    } else {
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void *)0);
+    }
+    glEnableVertexAttribArray(0);
+}
+
+std::string VertexPacking::describe(const PackedVertexData& data)
+{
+    std::ostringstream ss;
+    ss << getFormatName(data.format) << ", " << getStride(data.format) << " B/vertex";
+    if (data.format != VertexFormat::Standard) {
+        ss << ", max error: pos " << data.maxPositionError
+           << ", normal " << data.maxNormalError << " deg"
+           << ", tangent " << data.maxTangentError << " deg"
+           << ", uv " << data.maxTexCoordError;
+    }
+    return ss.str();
+}
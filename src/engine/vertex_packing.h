@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/bounding_box.h"
+#include "base/gl_utility.h"
+#include "base/vertex.h"
+
+// 上传到 GPU 的顶点格式
+// Vertex 在 CPU 上是 48 字节的全 float 结构；显存里可以换成压缩格式，减少每个 pass 的顶点读取带宽
+// (阴影 pass 每盏灯都要把场景再读一遍，受益最大)。
+enum class VertexFormat : uint8_t
+{
+    Standard,           // 与 Vertex 相同，48 字节
+    Compact,            // float 位置 + 八面体法线/切线 + half UV，24 字节
+    CompactQuantized    // 同上，位置按包围盒量化为 16 bit，20 字节
+};
+
+// 压缩格式的布局 (location 与 Vertex 相同，着色器按 packedVertex 解码)
+//   location 0: 位置      float3 / unorm16x4 (w 未用)
+//   location 1: 法线      snorm16x2，八面体编码
+//   location 2: UV        half2
+//   location 3: 切线      snorm8x4，xy 为八面体编码，z 为副切线符号
+struct PackedAttributes
+{
+    int16_t normal[2];
+    uint16_t texCoord[2];
+    int8_t tangent[4];
+};
+
+struct CompactVertex
+{
+    float position[3];
+    PackedAttributes attributes;
+};
+
+struct CompactQuantizedVertex
+{
+    uint16_t position[4];
+    PackedAttributes attributes;
+};
+
+static_assert(sizeof(CompactVertex) == 24, "CompactVertex layout");
+static_assert(sizeof(CompactQuantizedVertex) == 20, "CompactQuantizedVertex layout");
+
+// 打包结果与量化误差 (误差都是对整个网格取最大值)
+struct PackedVertexData
+{
+    VertexFormat format = VertexFormat::Standard;
+    std::vector<uint8_t> bytes;
+
+    // 位置解码：p = q * positionScale + positionOffset (未量化时为 1 / 0)
+    glm::vec3 positionScale{ 1.0f };
+    glm::vec3 positionOffset{ 0.0f };
+
+    float maxPositionError = 0.0f;  // 模型局部空间距离
+    float maxNormalError = 0.0f;    // 角度
+    float maxTangentError = 0.0f;   // 角度
+    float maxTexCoordError = 0.0f;
+};
+
+// 顶点压缩 (纯 CPU 计算，可在工作线程调用)
+class VertexPacking
+{
+public:
+    static size_t getStride(VertexFormat format);
+
+    static const char* getFormatName(VertexFormat format);
+
+    // box 用于位置量化，须包含所有顶点
+    static PackedVertexData pack(const std::vector<Vertex>& vertices, VertexFormat format, const BoundingBox& box);
+
+    // 按格式设置当前绑定的 VAO / VBO 的顶点属性 (主线程)
+    static void setupAttributes(VertexFormat format);
+
+    // 只含位置的顶点流 (深度 / 阴影 pass 使用)：量化格式为 unorm16x4 (8 字节)，其余为 float3 (12 字节)
+    // 量化格式从 packed 中取位置，否则从 vertices 中取
+    static size_t getPositionStride(VertexFormat format);
+    static std::vector<uint8_t> extractPositions(const std::vector<Vertex>& vertices, const PackedVertexData& packed);
+    static void setupPositionAttribute(VertexFormat format);
+
+    // 一行的误差汇总，用于日志和面板
+    static std::string describe(const PackedVertexData& data);
+
+    // 八面体编码 / 解码 (与着色器中的 octDecode 一致)
+    static glm::vec2 octEncode(const glm::vec3& n);
+    static glm::vec3 octDecode(const glm::vec2& e);
+};
@@ -3,6 +3,8 @@
 #include <filesystem>
 
 #include "scene_roaming.h"
+#include "engine/job_benchmark.h"
+#include "engine/render_benchmark.h"
 
 std::string getExecutableDir() {
     return std::filesystem::current_path().string(); 
@@ -28,6 +30,20 @@ Options getOptions(int argc, char* argv[]) {
 }
 
 int main(int argc, char* argv[]) {
+    // 任务系统扩展性测试：不创建窗口，跑完直接退出
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--job-benchmark") {
+            JobBenchmark::run();
+            return 0;
+        }
+        // 渲染基准测试：不可见窗口 / 离屏上下文，输出 JSON 并与基线比较
+        if (std::string(argv[i]) == "--benchmark") {
+            RenderBenchmarkOptions benchmarkOptions;
+            if (!RenderBenchmark::parseArguments(argc, argv, benchmarkOptions)) return 2;
+            return RenderBenchmark::run(benchmarkOptions);
+        }
+    }
+
     Options options = getOptions(argc, argv);
 
     try {
@@ -12,6 +12,8 @@
 #include <algorithm> // for std::sort
 
 #include "engine/utils/image_utils.h"
+#include "engine/utils/profiler.h"
+#include "engine/gpu_profiler.h"
 
 // 辅助结构：用于排序轴的绘制顺序
 struct GizmoAxisData {
@@ -35,6 +37,7 @@ void SceneRoaming::updateContentScale()
 SceneRoaming::SceneRoaming(const Options &options) : Application(options)
 {
     glfwSetInputMode(_window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+    Profiler::Get().setThreadName("Main");
 
     // 在初始化 ImGui 之前，必须先获取当前显示器的缩放比例！
     // 否则 initImGui 里的字体加载逻辑会一直使用默认的 1.0f
@@ -46,6 +49,7 @@ SceneRoaming::SceneRoaming(const Options &options) : Application(options)
     // 1. 在做任何场景加载之前，先设置资源根目录！
     // 这样 ResourceManager 才知道去哪里找文件
     ResourceManager::Get().setProjectRoot(options.assetRootDir);
+    Profiler::Get().setCaptureDirectory(ResourceManager::Get().getProjectRoot() + "captures/");
 
     // =================================================
     // [新逻辑] 初始化子系统
@@ -56,6 +60,9 @@ SceneRoaming::SceneRoaming(const Options &options) : Application(options)
     // 1. 初始化渲染资源 (Shader, Skybox 等)
     _renderer->init();
 
+    // 创建 UI 线程使用的共享上下文 (渲染线程在第一帧之后启动)
+    RenderThread::Get().init(_window);
+
     // 2. 初始化场景数据 (创建默认灯光等)
     _scene->createDefaultScene();
 
@@ -65,6 +72,8 @@ SceneRoaming::SceneRoaming(const Options &options) : Application(options)
     _inspectorPanel = std::make_unique<InspectorPanel>();
     _projectPanel = std::make_unique<ProjectPanel>();
     _envPanel = std::make_unique<EnvironmentPanel>();
+    _profilerPanel = std::make_unique<ProfilerPanel>();
+    _statsPanel = std::make_unique<StatsPanel>();
 
     initImGui();
     // initSceneFBO 不需要在这里调，第一次 renderUI 时会根据窗口大小自动调
@@ -72,11 +81,61 @@ SceneRoaming::SceneRoaming(const Options &options) : Application(options)
 
 SceneRoaming::~SceneRoaming()
 {
+    // 先收回窗口上下文 (等渲染线程画完排队的帧)
+    RenderThread::Get().stop();
+    GpuProfiler::Get().release();
+    for (EditorFrame& frame : _frames) {
+        frame.snapshot.clear();
+        frame.clearDrawData();
+    }
+
     // 在 OpenGL 上下文销毁前，清空资源缓存
     ResourceManager::Get().shutdown();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
+    RenderThread::Get().shutdown();
+}
+
+// ==========================================
+// EditorFrame
+// ==========================================
+EditorFrame::~EditorFrame()
+{
+    clearDrawData();
+}
+
+void EditorFrame::clearDrawData()
+{
+    for (ImDrawList* list : drawLists) IM_DELETE(list);
+    drawLists.clear();
+    drawData.Clear();
+}
+
+void EditorFrame::captureDrawData(ImDrawData* source)
+{
+    clearDrawData();
+    if (!source || !source->Valid) return;
+
+    // 纹理的创建 / 更新 / 销毁在这里 (渲染上下文) 完成，渲染时只剩下绘制
+    if (source->Textures) {
+        for (ImTextureData* tex : *source->Textures) {
+            if (tex->Status != ImTextureStatus_OK) ImGui_ImplOpenGL3_UpdateTexture(tex);
+        }
+    }
+
+    drawData = *source;
+    drawData.Textures = nullptr;
+    drawData.CmdLists.clear();
+    for (ImDrawList* list : source->CmdLists) {
+        ImDrawList* copy = list->CloneOutput();
+        // 纹理引用换成 GL 纹理名 (ImTextureData 归 ImGui 所有，下一帧可能就变了)
+        for (ImDrawCmd& cmd : copy->CmdBuffer) {
+            cmd.TexRef = ImTextureRef(cmd.GetTexID());
+        }
+        drawLists.push_back(copy);
+        drawData.CmdLists.push_back(copy);
+    }
 }
 
 void SceneRoaming::initImGui()
@@ -141,8 +200,11 @@ void SceneRoaming::renderFrame()
 
     updateContentScale();
 
+    RenderThread& renderThread = RenderThread::Get();
+    renderThread.beginFrame();
+
     // =========================================================
-    // 2. 开启 ImGui 新帧 (必须在所有逻辑之前)
+    // 1. 开启 ImGui 新帧 (必须在所有逻辑之前)
     // =========================================================
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
@@ -154,65 +216,142 @@ void SceneRoaming::renderFrame()
         _screenshotDelay = 1; 
     }
 
-    // 1. 处理输入 (委托给 SceneViewPanel)
-    // 它内部会调用 _cameraController->update() 和 handleInput()
-    // 需要传入 Scene 指针用于射线检测
-    _sceneViewPanel->onInputUpdate(ImGui::GetIO().DeltaTime, _scene.get(), _selectedObject);
+    // 把最近几秒的分析数据导出为 trace 文件 (在帧边界写出)
+    if (ImGui::IsKeyPressed(ImGuiKey_F9, false)) Profiler::Get().requestDump();
 
-    // =========================================================
-    // 3. 清理主屏幕 (Back Buffer)
-    // =========================================================
-    // 注意：这里的 Viewport 是整个窗口的大小，不是 FBO 的大小
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glViewport(0, 0, currentW, currentH);
-    // 清除为黑色 (ImGui 窗口背后的颜色)
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
+    if (ImGui::IsKeyPressed(ImGuiKey_F8, false) && _isProjectOpen) toggleCameraPathRecording();
+
+    _selectedObject = _scene ? _scene->find(_selectedHandle) : nullptr;
+
+    {
+        ProfileScope scope("UI");
+
+        // 2. 处理输入 (委托给 SceneViewPanel)
+        // 它内部会调用 _cameraController->update() 和 handleInput()
+        // 需要传入 Scene 指针用于射线检测
+        _sceneViewPanel->onInputUpdate(ImGui::GetIO().DeltaTime, _scene.get(), _selectedObject);
+
+        if (_isRecordingCameraPath) {
+            _cameraPathTime += ImGui::GetIO().DeltaTime;
+            _cameraPath.addKey(_cameraPathTime, _sceneViewPanel->getCamera()->transform);
+        }
+
+        // =========================================================
+        // 3. 执行 UI 逻辑 (只修改场景数据，记录视口大小)
+        // =========================================================
+        renderUI();
+    }
+
+    // 选中的物体即使在帧边界被删除，句柄也只会在下一帧解析失败，不会悬空
+    _selectedHandle = _selectedObject ? _selectedObject->getHandle() : GameObjectHandle();
+    _selectedObject = nullptr;
+
+    EditorFrame& frame = _frames[_frameIndex];
+    EditorFrame& previous = _frames[_frameIndex ^ 1];
+    frame.framebufferWidth = currentW;
+    frame.framebufferHeight = currentH;
+    frame.screenshotPath.clear();
+
+    if (_screenshotDelay > 0)
+    {
+        // 倒计时减一
+        _screenshotDelay--;
+    }
+    else if (_screenshotDelay == 0) // 倒计时结束，这一帧画完后截屏
+    {
+        frame.screenshotPath = ResourceManager::Get().getProjectRoot() + "screenshot.png";
+        // 重置为 -1，停止截屏
+        _screenshotDelay = -1;
+    }
 
     // =========================================================
-    // 4. 执行 UI 逻辑 (并在内部触发 3D 渲染)
+    // 4. 帧边界：渲染线程画完上一帧后，交换数据
     // =========================================================
-    // renderUI 会计算布局 -> 调整 FBO -> renderScene -> 提交 ImGui::Image
-    renderUI();
+    renderThread.sync([&]() { prepareFrame(frame, previous); });
 
     // =========================================================
-    // 5. 提交 ImGui 绘制数据
+    // 5. 提交渲染 (渲染线程模式下与下一帧的 UI 逻辑并行)
     // =========================================================
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    renderThread.submit([this, &frame, &previous]() { drawFrame(frame, previous); });
+    _frameIndex ^= 1;
 
-    // 在物理删除之前，检查选中物体是否即将死亡
-    if (_scene && _selectedObject)
-    {
-        // 如果当前选中的物体在删除队列里，说明它将在下面这行代码中变为野指针
-        if (_scene->isMarkedForDestruction(_selectedObject))
-        {
-            _selectedObject = nullptr; // 强制取消选中，保护指针安全
-            // 可选：打印一条日志
-            std::cout << "[System] Auto-deselected object pending destruction." << std::endl;
-        }
-    }
+    // 切换模式放在两帧之间 (stop 会等这一帧画完)
+    if (_useRenderThread && !renderThread.isRunning()) renderThread.start();
+    else if (!_useRenderThread && renderThread.isRunning()) renderThread.stop();
+}
+
+void SceneRoaming::prepareFrame(EditorFrame& frame, const EditorFrame& previous)
+{
+    // 分析器的帧边界：此时渲染线程已画完上一帧，两边这一帧的记录都已完成
+    Profiler::Get().endFrame();
+    ProfileScope scope("Frame Boundary");
+
+    // 渲染统计：上一帧 render() 的结果 (渲染线程此时空闲)
+    _statsPanel->update(_renderer->getFrameStats());
 
     if (_scene) {
+        // 上一帧渲染器在快照上选出的 LOD 写回场景
+        _scene->applyRenderFeedback(previous.snapshot.scene);
         _scene->destroyMarkedObjects();
     }
 
-    if (_screenshotDelay > 0)
+    // 兑现后台加载线程投递回来的 GL 任务 (纹理上传等)
+    ResourceManager::Get().update();
+
+    frame.hasScene = false;
+    if (_scene) {
+        // 推进异步场景导入 (按预算上传子网格并实例化)
+        _scene->updateImports();
+
+        // 沿父子层级传播世界变换 (只重算有变化的子树)，渲染与下一帧的拾取都用这一次的结果
+        _scene->updateWorldTransforms();
+
+        if (_isProjectOpen && _sceneViewPanel->prepareTarget(_renderer.get(), frame.snapshot)) {
+            _renderer->prepareScene(*_scene);
+            frame.snapshot.capture(*_scene, *_sceneViewPanel->getCamera(), _scene->find(_selectedHandle));
+            frame.hasScene = true;
+        }
+    }
+
+    frame.captureDrawData(ImGui::GetDrawData());
+}
+
+void SceneRoaming::drawFrame(EditorFrame& frame, EditorFrame& previous)
+{
+    GpuProfiler::Get().beginFrame();
+    ProfileScope scope("Draw Frame");
+
+    // 上一帧的快照已经在帧边界写回，在这里 (渲染上下文) 释放
+    previous.snapshot.clear();
+
+    // 场景画进视口的 FBO
+    if (frame.hasScene) {
+        RenderSnapshot& snapshot = frame.snapshot;
+        _renderer->render(snapshot.scene, snapshot.getCamera(), snapshot.targetFBO,
+                          snapshot.width, snapshot.height, snapshot.contentScale, snapshot.selected);
+    }
+
+    // 清理主屏幕 (Back Buffer)
+    // 注意：这里的 Viewport 是整个窗口的大小，不是 FBO 的大小
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, frame.framebufferWidth, frame.framebufferHeight);
+    // 清除为黑色 (ImGui 窗口背后的颜色)
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
     {
-        // 倒计时减一
-        _screenshotDelay--;
+        PassProfileScope pass("ImGui");
+        ImGui_ImplOpenGL3_RenderDrawData(&frame.drawData);
     }
-    else if (_screenshotDelay == 0) // 倒计时结束，执行截屏
+
+    if (!frame.screenshotPath.empty())
     {
-        int w, h;
-        glfwGetFramebufferSize(_window, &w, &h);
-        std::string path = ResourceManager::Get().getProjectRoot() + "screenshot.png";
-        
         // 此时这一帧已经是“没有菜单”的全新一帧了
-        ImageUtils::saveScreenshot(path, w, h);
-        
-        // 重置为 -1，停止截屏
-        _screenshotDelay = -1;
+        ImageUtils::saveScreenshot(frame.screenshotPath, frame.framebufferWidth, frame.framebufferHeight);
     }
+
+    ProfileScope swapScope("Swap");
+    glfwSwapBuffers(_window);
 }
 
 void SceneRoaming::renderUI()
@@ -237,39 +376,77 @@ void SceneRoaming::renderUI()
     } else {
         setupDockspace();
 
-        _sceneViewPanel->onImGuiRender(_scene.get(), _renderer.get(), _selectedObject, _contentScale);
+        _sceneViewPanel->onImGuiRender(_contentScale);
 
         // 1. Hierarchy
         _hierarchyPanel->onImGuiRender(_scene, _selectedObject); // 传入引用，允许面板修改选中项
 
-        // 2. Inspector
-        // 注意：我们需要检测 Inspector 是否删除了物体
-        // 如果它删除了，selectedObject 可能会悬空，这里需要一种机制处理
-        // 在 InspectorPanel 里我们直接调用了 removeGameObject。
-        // 为了安全，我们可以在每帧开始时检查 _selectedObject 是否还在 _scene 里（可选但推荐）
-        // 或者简单的：相信用户操作流
+        // 2. Inspector (删除物体时只做标记，帧末统一销毁)
         _inspectorPanel->onImGuiRender(_selectedObject, _scene.get());
-
-        // 如果 Inspector 刚刚把物体删了，我们需要把 _selectedObject 置空
-        // 我们可以通过检查 Scene 是否还包含它来判断，或者让 Inspector 返回状态
-        // 简单的 Hack：如果 _selectedObject 变成了野指针会崩溃。
-        // [修正] InspectorPanel 内部做删除时，我们无法立即把这里的指针置空。
-        // 建议修改 HierarchyPanel/InspectorPanel 的逻辑，或者：
-        // 在 Scene 里加一个 isValid(GameObject*) 函数进行校验。
-        // 鉴于目前架构，如果 Inspector 点击删除，下一帧这个指针就失效了。
-        // 最简单的修复：给 Inspector 传 _selectedObject 的**引用**，让它在删除后置空！
         
         // 3. Project
         _projectPanel->onImGuiRender();
 
         // 4. Environment
         _envPanel->onImGuiRender(_scene.get(), _renderer.get());
+
+        // 5. 帧分析器
+        _profilerPanel->onImGuiRender();
+
+        // 6. 渲染统计
+        _statsPanel->onImGuiRender(_fpsIndicator);
+
+        // 7. 导入进度
+        renderImportProgress();
     }
 
-    // 6. 渲染结束 (保持不变)
+    // 8. 渲染结束 (保持不变)
     ImGui::Render();
 }
 
+void SceneRoaming::renderImportProgress()
+{
+    if (!_scene || _scene->getImportJobs().empty()) return;
+
+    // 固定在主视口右下角的小浮窗
+    ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImVec2 pos(viewport->WorkPos.x + viewport->WorkSize.x - 20.0f,
+               viewport->WorkPos.y + viewport->WorkSize.y - 20.0f);
+    ImGui::SetNextWindowPos(pos, ImGuiCond_Always, ImVec2(1.0f, 1.0f));
+    ImGui::SetNextWindowBgAlpha(0.85f);
+
+    ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+                             ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing |
+                             ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoDocking;
+
+    if (ImGui::Begin("##ImportProgress", nullptr, flags))
+    {
+        for (const auto& job : _scene->getImportJobs())
+        {
+            ImGui::PushID(job.get());
+
+            std::string name = std::filesystem::path(job->getPath()).filename().string();
+            ImGui::Text("Importing %s", name.c_str());
+
+            char overlay[64];
+            if (job->getTotalCount() > 0)
+                snprintf(overlay, sizeof(overlay), "%s %d / %d", job->getStageName().c_str(),
+                         job->getUploadedCount(), job->getTotalCount());
+            else
+                snprintf(overlay, sizeof(overlay), "%s...", job->getStageName().c_str());
+
+            ImGui::ProgressBar(job->getProgress(), ImVec2(260.0f, 0.0f), overlay);
+            ImGui::SameLine();
+            if (ImGui::Button("Cancel")) {
+                job->cancel();
+            }
+
+            ImGui::PopID();
+        }
+    }
+    ImGui::End();
+}
+
 void SceneRoaming::setupDockspace()
 {
     // =======================================================
@@ -307,6 +484,9 @@ void SceneRoaming::setupDockspace()
         // 第三刀：把下面切出来 (占 40%) -> 放 Project
         dock_bottom_id = ImGui::DockBuilderSplitNode(dock_main_id, ImGuiDir_Down, 0.4f, nullptr, &dock_main_id);
         
+        // 第四刀：视口右侧切出一条 (占 25%) -> 放 Render Stats
+        ImGuiID dock_stats_id = ImGui::DockBuilderSplitNode(dock_main_id, ImGuiDir_Right, 0.25f, nullptr, &dock_main_id);
+
         // 剩下的 dock_main_id 就是中间的部分 -> 放 3D Viewport
 
         // 4. 将窗口绑定到对应的 ID
@@ -314,6 +494,8 @@ void SceneRoaming::setupDockspace()
         ImGui::DockBuilderDockWindow("3D Viewport", dock_main_id);
         ImGui::DockBuilderDockWindow("Scene Hierarchy", dock_left_id);
         ImGui::DockBuilderDockWindow("Project / Assets", dock_bottom_id);
+        ImGui::DockBuilderDockWindow("Profiler", dock_bottom_id);
+        ImGui::DockBuilderDockWindow("Render Stats", dock_stats_id);
         ImGui::DockBuilderDockWindow("Inspector", dock_right_id);
         ImGui::DockBuilderDockWindow("Environment", dock_right_id);
 
@@ -399,6 +581,8 @@ void SceneRoaming::setupDockspace()
             if (_inspectorPanel) ImGui::MenuItem("Inspector", nullptr, _inspectorPanel->getOpenPtr());
             if (_projectPanel)   ImGui::MenuItem("Project", nullptr, _projectPanel->getOpenPtr());
             if (_envPanel)       ImGui::MenuItem("Environment", nullptr, _envPanel->getOpenPtr());
+            if (_profilerPanel)  ImGui::MenuItem("Profiler", nullptr, _profilerPanel->getOpenPtr());
+            if (_statsPanel)     ImGui::MenuItem("Render Stats", nullptr, _statsPanel->getOpenPtr());
 
             ImGui::Separator();
             
@@ -408,6 +592,23 @@ void SceneRoaming::setupDockspace()
             ImGui::EndMenu();
         }
 
+        if (ImGui::BeginMenu("Render"))
+        {
+            // 帧末才真正切换 (需要等正在渲染的帧画完)
+            ImGui::MenuItem("Render Thread", nullptr, &_useRenderThread);
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Render scene snapshots on a dedicated thread while the UI builds the next frame.");
+            }
+
+            if (ImGui::MenuItem("Record Camera Path", "F8", _isRecordingCameraPath, _isProjectOpen)) {
+                toggleCameraPathRecording();
+            }
+
+            ImGui::Separator();
+            renderFrameTimings();
+            ImGui::EndMenu();
+        }
+
         ImGui::EndMainMenuBar();
     }
 
@@ -436,9 +637,9 @@ void SceneRoaming::setupDockspace()
             // 获取完整文件路径
             std::string path = ImGuiFileDialog::Instance()->GetFilePathName();
             
-            // 调用我们刚刚写好的 Import 逻辑
+            // 异步导入：解析在后台进行，物体会逐帧出现
             if (_scene) {
-                _scene->importScene(path);
+                _scene->importSceneAsync(path);
             }
         }
         
@@ -447,6 +648,59 @@ void SceneRoaming::setupDockspace()
     }
 }
 
+void SceneRoaming::toggleCameraPathRecording()
+{
+    if (!_isRecordingCameraPath) {
+        _cameraPath.clear();
+        _cameraPathTime = 0.0f;
+        _isRecordingCameraPath = true;
+        std::cout << "[CameraPath] Recording started (F8 to stop)" << std::endl;
+        return;
+    }
+
+    _isRecordingCameraPath = false;
+    std::string directory = ResourceManager::Get().getProjectRoot() + "captures/";
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    std::string path = directory + "camera_path.txt";
+    if (_cameraPath.save(path)) {
+        std::cout << "[CameraPath] Saved " << _cameraPath.getKeyCount() << " keys ("
+                  << _cameraPath.getDuration() << " s) to " << path << std::endl;
+    }
+}
+
+void SceneRoaming::renderFrameTimings()
+{
+    const RenderThreadTimings modes[2] = { RenderThread::Get().getTimings(false), RenderThread::Get().getTimings(true) };
+
+    if (!ImGui::BeginTable("##FrameTimings", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) return;
+
+    ImGui::TableSetupColumn("");
+    ImGui::TableSetupColumn("Single Thread");
+    ImGui::TableSetupColumn("Render Thread");
+    ImGui::TableHeadersRow();
+
+    auto row = [&](const char* label, const char* format, float RenderThreadTimings::*field) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(label);
+        for (const RenderThreadTimings& t : modes) {
+            ImGui::TableNextColumn();
+            if (t.frames == 0) ImGui::TextDisabled("-");
+            else ImGui::Text(format, t.*field);
+        }
+    };
+
+    row("Throughput", "%.1f FPS", &RenderThreadTimings::fps);
+    row("Latency", "%.2f ms", &RenderThreadTimings::latencyMs);
+    row("UI", "%.2f ms", &RenderThreadTimings::uiMs);
+    row("Sync wait", "%.2f ms", &RenderThreadTimings::waitMs);
+    row("Frame boundary", "%.2f ms", &RenderThreadTimings::boundaryMs);
+    row("Render", "%.2f ms", &RenderThreadTimings::renderMs);
+
+    ImGui::EndTable();
+}
+
 void SceneRoaming::renderProjectSelector()
 {
     // 获取视口中心
@@ -520,6 +774,7 @@ void SceneRoaming::renderProjectSelector()
             std::filesystem::create_directories(path);
         }
         ResourceManager::Get().setProjectRoot(path);
+        Profiler::Get().setCaptureDirectory(ResourceManager::Get().getProjectRoot() + "captures/");
         _isProjectOpen = true;
     }
     
@@ -13,9 +13,38 @@
 #include "editor/panels/project_panel.h"
 #include "editor/panels/scene_view_panel.h"
 #include "editor/panels/environment_panel.h"
+#include "editor/panels/profiler_panel.h"
+#include "editor/panels/stats_panel.h"
 #include "engine/scene_object.h"
 #include "engine/outline_pass.h"
 #include "engine/resource_manager.h"
+#include "engine/render_snapshot.h"
+#include "engine/render_thread.h"
+#include "engine/camera_path.h"
+
+// 交给渲染线程的一帧 (两份轮换：渲染线程画第 N 帧时，UI 线程在准备第 N+1 帧)
+struct EditorFrame
+{
+    RenderSnapshot snapshot;   // 场景快照
+    bool hasScene = false;     // 项目未打开或视口不可见时不渲染场景
+
+    // ImGui 绘制数据的拷贝 (纹理引用已解析为 GL 纹理名，不再依赖 ImGui 的帧状态)
+    ImDrawData drawData;
+    std::vector<ImDrawList *> drawLists;
+
+    int framebufferWidth = 0;
+    int framebufferHeight = 0;
+    std::string screenshotPath; // 非空时在 swap 之前截屏
+
+    EditorFrame() = default;
+    ~EditorFrame();
+    EditorFrame(const EditorFrame &) = delete;
+    EditorFrame &operator=(const EditorFrame &) = delete;
+
+    // [帧边界] 执行 ImGui 的纹理更新 (字体图集等) 并拷贝绘制数据
+    void captureDrawData(ImDrawData *source);
+    void clearDrawData();
+};
 
 class SceneRoaming : public Application
 {
@@ -26,6 +55,9 @@ public:
     void handleInput() override {};
     void renderFrame() override;
 
+    // swap 由 drawFrame 完成 (可能在渲染线程上)
+    void presentFrame() override {}
+
 private:
     std::unique_ptr<Scene> _scene;       // 负责数据
     std::unique_ptr<Renderer> _renderer; // 负责画画
@@ -35,6 +67,8 @@ private:
     std::unique_ptr<InspectorPanel> _inspectorPanel;
     std::unique_ptr<ProjectPanel> _projectPanel;
     std::unique_ptr<EnvironmentPanel> _envPanel;
+    std::unique_ptr<ProfilerPanel> _profilerPanel;
+    std::unique_ptr<StatsPanel> _statsPanel;
 
     // 编辑器状态变量
     bool _isLayoutInitialized = false; // 用于只在第一次运行时设置窗口位置
@@ -42,7 +76,8 @@ private:
     char _projectPathBuf[256] = "";
     float _contentScale = 1.0f;
 
-    // 选中状态
+    // 选中状态：跨帧只保存句柄，每帧开始时解析为指针交给各面板 (对象被删除后自然失效)
+    GameObjectHandle _selectedHandle;
     GameObject *_selectedObject = nullptr;
 
     // UI 相关
@@ -50,8 +85,28 @@ private:
     void renderUI();
     void renderProjectSelector();
     void setupDockspace();
+    // 右下角的异步导入进度浮窗 (带取消按钮)
+    void renderImportProgress();
     void updateContentScale();
 
     // -1 表示不截屏，>0 表示倒计时
     int _screenshotDelay = -1;
+
+    // F8 录制视口相机路径 (供 --benchmark --camera 回放)
+    CameraPath _cameraPath;
+    bool _isRecordingCameraPath = false;
+    float _cameraPathTime = 0.0f;
+    void toggleCameraPathRecording();
+
+    // 渲染线程 (Render 菜单中切换，帧末生效) 与双缓冲的帧数据
+    bool _useRenderThread = true;
+    EditorFrame _frames[2];
+    int _frameIndex = 0;
+
+    // [帧边界] 写回上一帧的渲染结果，推进资源与场景，拷贝这一帧的快照
+    void prepareFrame(EditorFrame &frame, const EditorFrame &previous);
+    // [渲染上下文] 画一帧：场景 -> 视口 FBO，ImGui -> 窗口，然后 swap
+    void drawFrame(EditorFrame &frame, EditorFrame &previous);
+    // Render 菜单中两种模式的帧耗时对比
+    void renderFrameTimings();
 };
\ No newline at end of file